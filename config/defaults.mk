@@ -149,6 +149,7 @@ MFEM_USE_CEED          = NO
 MFEM_USE_CALIPER       = NO
 MFEM_USE_UMPIRE        = NO
 MFEM_USE_SIMD          = NO
+MFEM_USE_JIT           = NO
 MFEM_USE_ADIOS2        = NO
 MFEM_USE_MKL_CPARDISO  = NO
 
@@ -171,6 +172,10 @@ ZLIB_RPATH = $(XLINKER)-rpath,$(ZLIB_DIR)/lib
 LIBUNWIND_OPT = -g
 LIBUNWIND_LIB = $(if $(NOTMAC),-lunwind -ldl,)
 
+# Link options for the JIT compilation of kernels (dlopen)
+JIT_OPT =
+JIT_LIB = $(if $(NOTMAC),-ldl,)
+
 # HYPRE library configuration (needed to build the parallel version)
 HYPRE_DIR = @MFEM_DIR@/../hypre/src/hypre
 HYPRE_OPT = -I$(HYPRE_DIR)/include
@@ -13,7 +13,9 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/annotation.hpp"
 #include <cmath>
+#include <algorithm>
 
 namespace mfem
 {
@@ -22,13 +24,39 @@ void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
 
-   if (precompute_sparsity == 0 || fes->GetVDim() > 1)
+   if ((precompute_sparsity == 0 || fes->GetVDim() > 1) && !thread_assembly)
    {
       mat = new SparseMatrix(height);
       return;
    }
 
-   const Table &elem_dof = fes->GetElementToDofTable();
+   // The threaded assembly requires the sparsity pattern also for vector FE
+   // spaces: in that case, it is defined by the element-to-vdof table.
+   Table elem_vdof;
+   if (fes->GetVDim() > 1)
+   {
+      Array<int> el_vdofs;
+      const int ne = fes->GetNE();
+      elem_vdof.MakeI(ne);
+      for (int i = 0; i < ne; i++)
+      {
+         elem_vdof.AddColumnsInRow(i, fes->GetFE(i)->GetDof()*fes->GetVDim());
+      }
+      elem_vdof.MakeJ();
+      for (int i = 0; i < ne; i++)
+      {
+         fes->GetElementVDofs(i, el_vdofs);
+         for (int j = 0; j < el_vdofs.Size(); j++)
+         {
+            const int vd = el_vdofs[j];
+            el_vdofs[j] = (vd >= 0) ? vd : -1-vd;
+         }
+         elem_vdof.AddConnections(i, el_vdofs, el_vdofs.Size());
+      }
+      elem_vdof.ShiftUpI();
+   }
+   const Table &elem_dof = (fes->GetVDim() > 1) ? elem_vdof :
+                           fes->GetElementToDofTable();
    Table dof_dof;
 
    if (interior_face_integs.Size() > 0)
@@ -74,6 +102,8 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   thread_assembly = 0;
+   elem_colors_sequence = -1;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACY;
@@ -92,6 +122,8 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   thread_assembly = 0;
+   elem_colors_sequence = -1;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACY;
@@ -384,6 +416,7 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_FUNCTION;
    if (ext)
    {
       ext->Assemble();
@@ -421,54 +454,62 @@ void BilinearForm::Assemble(int skip_zeros)
          }
       }
 
-      for (int i = 0; i < fes -> GetNE(); i++)
+      if (UseThreadedAssembly())
       {
-         int elem_attr = fes->GetMesh()->GetAttribute(i);
-         fes->GetElementVDofs(i, vdofs);
-         if (element_matrices)
-         {
-            elmat_p = &(*element_matrices)(i);
-         }
-         else
+         AssembleDomainThreaded();
+      }
+      else
+      {
+         for (int i = 0; i < fes -> GetNE(); i++)
          {
-            elmat.SetSize(0);
-            for (int k = 0; k < domain_integs.Size(); k++)
+            int elem_attr = fes->GetMesh()->GetAttribute(i);
+            fes->GetElementVDofs(i, vdofs);
+            if (element_matrices)
+            {
+               elmat_p = &(*element_matrices)(i);
+            }
+            else
             {
-               if ( domain_integs_marker[k] == NULL ||
-                    (*(domain_integs_marker[k]))[elem_attr-1] == 1)
+               elmat.SetSize(0);
+               for (int k = 0; k < domain_integs.Size(); k++)
                {
-                  const FiniteElement &fe = *fes->GetFE(i);
-                  eltrans = fes->GetElementTransformation(i);
-                  domain_integs[k]->AssembleElementMatrix(fe, *eltrans, elemmat);
-                  if (elmat.Size() == 0)
+                  if ( domain_integs_marker[k] == NULL ||
+                       (*(domain_integs_marker[k]))[elem_attr-1] == 1)
                   {
-                     elmat = elemmat;
-                  }
-                  else
-                  {
-                     elmat += elemmat;
+                     const FiniteElement &fe = *fes->GetFE(i);
+                     eltrans = fes->GetElementTransformation(i);
+                     domain_integs[k]->AssembleElementMatrix(fe, *eltrans,
+                                                             elemmat);
+                     if (elmat.Size() == 0)
+                     {
+                        elmat = elemmat;
+                     }
+                     else
+                     {
+                        elmat += elemmat;
+                     }
                   }
                }
+               if (elmat.Size() == 0)
+               {
+                  continue;
+               }
+               else
+               {
+                  elmat_p = &elmat;
+               }
             }
-            if (elmat.Size() == 0)
+            if (static_cond)
             {
-               continue;
+               static_cond->AssembleMatrix(i, *elmat_p);
             }
             else
             {
-               elmat_p = &elmat;
-            }
-         }
-         if (static_cond)
-         {
-            static_cond->AssembleMatrix(i, *elmat_p);
-         }
-         else
-         {
-            mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
-            if (hybridization)
-            {
-               hybridization->AssembleMatrix(i, *elmat_p);
+               mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
+               if (hybridization)
+               {
+                  hybridization->AssembleMatrix(i, *elmat_p);
+               }
             }
          }
       }
@@ -902,6 +943,214 @@ void BilinearForm::ComputeElementMatrices()
    }
 }
 
+void BilinearForm::ComputeElementColoring()
+{
+   // Greedy coloring of the elements: two elements sharing a DOF get different
+   // colors. The coloring depends only on the element order, so it is the same
+   // for any number of threads.
+   const Table &elem_dof = fes->GetElementToDofTable();
+   Table dof_elem;
+   Transpose(elem_dof, dof_elem, fes->GetNDofs());
+
+   const int ne = fes->GetNE();
+   Array<int> color(ne), color_mark;
+   int num_colors = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      // Mark the colors of the already colored neighbors with 'i'.
+      const int *dofs = elem_dof.GetRow(i);
+      for (int j = 0; j < elem_dof.RowSize(i); j++)
+      {
+         const int *els = dof_elem.GetRow(dofs[j]);
+         for (int k = 0; k < dof_elem.RowSize(dofs[j]); k++)
+         {
+            if (els[k] < i) { color_mark[color[els[k]]] = i; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && color_mark[c] == i) { c++; }
+      if (c == num_colors) { color_mark.Append(-1); num_colors++; }
+      color[i] = c;
+   }
+
+   elem_colors.Clear();
+   elem_colors.MakeI(num_colors);
+   for (int i = 0; i < ne; i++) { elem_colors.AddAColumnInRow(color[i]); }
+   elem_colors.MakeJ();
+   for (int i = 0; i < ne; i++) { elem_colors.AddConnection(color[i], i); }
+   elem_colors.ShiftUpI();
+
+   elem_colors_sequence = fes->GetMesh()->GetSequence();
+}
+
+bool BilinearForm::UseThreadedAssembly() const
+{
+   return (thread_assembly && !static_cond && !hybridization &&
+           !element_matrices && mat && mat->Finalized());
+}
+
+// Add the element matrix 'elmat' to the entries of the finalized CSR matrix
+// (I,J,A) with sorted column indices. The sparsity pattern must contain all
+// entries coupled by 'vdofs'.
+static void AddElementMatrixCSR(const int *I, const int *J, double *A,
+                                const Array<int> &vdofs,
+                                const DenseMatrix &elmat, bool atomic)
+{
+   const int n = vdofs.Size();
+   for (int ii = 0; ii < n; ii++)
+   {
+      const int vi = vdofs[ii];
+      const int i = (vi >= 0) ? vi : -1-vi;
+      const double si = (vi >= 0) ? 1.0 : -1.0;
+      const int *row_beg = J + I[i], *row_end = J + I[i+1];
+      for (int jj = 0; jj < n; jj++)
+      {
+         const int vj = vdofs[jj];
+         const int j = (vj >= 0) ? vj : -1-vj;
+         const double sj = (vj >= 0) ? 1.0 : -1.0;
+         const int *pos = std::lower_bound(row_beg, row_end, j);
+         MFEM_ASSERT(pos != row_end && *pos == j,
+                     "entry (" << i << "," << j << ") is not in the sparsity");
+         const double val = si*sj*elmat(ii,jj);
+         double &a = A[pos - J];
+         if (atomic)
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp atomic
+#endif
+            a += val;
+         }
+         else
+         {
+            a += val;
+         }
+      }
+   }
+}
+
+void BilinearForm::AssembleDomainThreaded()
+{
+   const bool deterministic = (thread_assembly == 1);
+   if (deterministic &&
+       elem_colors_sequence != fes->GetMesh()->GetSequence())
+   {
+      ComputeElementColoring();
+   }
+   if (!mat->ColumnsAreSorted()) { mat->SortColumnIndices(); }
+
+   Mesh *mesh = fes->GetMesh();
+   const int *I = mat->HostReadI();
+   const int *J = mat->HostReadJ();
+   double *A = mat->HostReadWriteData();
+
+   // In the deterministic mode the colors are processed one after the other,
+   // otherwise all elements are processed at once.
+   const int num_batches = deterministic ? elem_colors.Size() : 1;
+   for (int c = 0; c < num_batches; c++)
+   {
+      const int nel = deterministic ? elem_colors.RowSize(c) : fes->GetNE();
+      const int *elems = deterministic ? elem_colors.GetRow(c) : NULL;
+
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+      #pragma omp parallel
+#endif
+      {
+         // Per-thread scratch data
+         DenseMatrix elmat, tmp;
+         IsoparametricTransformation eltrans;
+         Array<int> el_vdofs;
+
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+         #pragma omp for schedule(static)
+#endif
+         for (int k = 0; k < nel; k++)
+         {
+            const int i = elems ? elems[k] : k;
+            const int elem_attr = mesh->GetAttribute(i);
+            const FiniteElement &fe = *fes->GetFE(i);
+            bool first = true;
+            for (int m = 0; m < domain_integs.Size(); m++)
+            {
+               if (domain_integs_marker[m] != NULL &&
+                   (*(domain_integs_marker[m]))[elem_attr-1] != 1) { continue; }
+               if (first) { fes->GetElementTransformation(i, &eltrans); }
+               domain_integs[m]->AssembleElementMatrix(fe, eltrans,
+                                                       first ? elmat : tmp);
+               if (!first) { elmat += tmp; }
+               first = false;
+            }
+            if (first) { continue; }
+            fes->GetElementVDofs(i, el_vdofs);
+            AddElementMatrixCSR(I, J, A, el_vdofs, elmat, !deterministic);
+         }
+      }
+   }
+}
+
+BSRMatrix *BilinearForm::AssembleBSR()
+{
+   MFEM_VERIFY(interior_face_integs.Size() == 0 &&
+               boundary_face_integs.Size() == 0,
+               "face integrators are not supported");
+   MFEM_VERIFY(!static_cond && !hybridization, "static condensation and "
+               "hybridization are not supported");
+
+   // The block sparsity pattern is defined by the map: element->node
+   const Table &elem_dof = fes->GetElementToDofTable();
+   Table dof_elem, dof_dof;
+   Transpose(elem_dof, dof_elem, fes->GetNDofs());
+   mfem::Mult(dof_elem, elem_dof, dof_dof);
+
+   BSRMatrix *A = new BSRMatrix(dof_dof, fes->GetNDofs(), fes->GetVDim(),
+                                fes->GetOrdering() == Ordering::byVDIM);
+
+   Mesh *mesh = fes->GetMesh();
+   ElementTransformation *eltrans = NULL;
+   DenseMatrix elmat;
+   Array<int> dofs;
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      const int elem_attr = mesh->GetAttribute(i);
+      const FiniteElement &fe = *fes->GetFE(i);
+      bool first = true;
+      for (int k = 0; k < domain_integs.Size(); k++)
+      {
+         if (domain_integs_marker[k] != NULL &&
+             (*(domain_integs_marker[k]))[elem_attr-1] != 1) { continue; }
+         if (first) { eltrans = fes->GetElementTransformation(i); }
+         domain_integs[k]->AssembleElementMatrix(fe, *eltrans,
+                                                 first ? elmat : elemmat);
+         if (!first) { elmat += elemmat; }
+         first = false;
+      }
+      if (first) { continue; }
+      fes->GetElementDofs(i, dofs);
+      A->AddSubMatrix(dofs, dofs, elmat);
+   }
+
+   for (int i = 0; i < fes->GetNBE(); i++)
+   {
+      const int bdr_attr = mesh->GetBdrAttribute(i);
+      const FiniteElement &be = *fes->GetBE(i);
+      bool first = true;
+      for (int k = 0; k < boundary_integs.Size(); k++)
+      {
+         if (boundary_integs_marker[k] != NULL &&
+             (*boundary_integs_marker[k])[bdr_attr-1] == 0) { continue; }
+         if (first) { eltrans = fes->GetBdrElementTransformation(i); }
+         boundary_integs[k]->AssembleElementMatrix(be, *eltrans,
+                                                   first ? elmat : elemmat);
+         if (!first) { elmat += elemmat; }
+         first = false;
+      }
+      if (first) { continue; }
+      fes->GetBdrElementDofs(i, dofs);
+      A->AddSubMatrix(dofs, dofs, elmat);
+   }
+
+   return A;
+}
+
 void BilinearForm::EliminateEssentialBC(const Array<int> &bdr_attr_is_ess,
                                         const Vector &sol, Vector &rhs,
                                         DiagonalPolicy dpolicy)
@@ -1052,6 +1301,18 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultMany(const MultiVector &X, MultiVector &Y) const
+{
+   if (ext)
+   {
+      ext->MultMany(X, Y);
+   }
+   else
+   {
+      mat->MultMany(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -125,6 +125,24 @@ protected:
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /** @brief Thread-parallel assembly mode of the domain integrators, see
+       EnableThreadedAssembly(): 0 - disabled, 1 - deterministic (element
+       coloring), 2 - atomic updates. */
+   int thread_assembly;
+   /// Element coloring used by the deterministic threaded assembly.
+   Table elem_colors;
+   /// Mesh sequence corresponding to #elem_colors.
+   long elem_colors_sequence;
+
+   /// Compute the element coloring, #elem_colors, of the FE space.
+   void ComputeElementColoring();
+
+   /// Return true if the domain integrators can use the threaded assembly.
+   bool UseThreadedAssembly() const;
+
+   /// Thread-parallel assembly of the domain integrators into #mat.
+   void AssembleDomainThreaded();
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -134,6 +152,8 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      thread_assembly = 0;
+      elem_colors_sequence = -1;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACY;
       batch = 1;
@@ -211,6 +231,26 @@ public:
        present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /** @brief Enable thread-parallel legacy assembly of the domain integrators.
+
+       The element matrices are computed concurrently, each thread using its
+       own scratch matrices and element transformation, and they are added to
+       a matrix with precomputed sparsity (also for vector FE spaces). When
+       @a deterministic is true, the elements are processed by colors such
+       that no two elements of the same color share a DOF: the assembled
+       matrix is then bitwise reproducible, independently of the number of
+       threads. Otherwise, the element matrices are added with atomic updates.
+
+       The assembly runs in parallel when MFEM is configured with OpenMP
+       (MFEM_USE_OPENMP) and MFEM_THREAD_SAFE, which makes the integrators
+       thread-safe; otherwise the same algorithm runs on a single thread.
+
+       This method should be called before assembly. Static condensation,
+       hybridization and precomputed element matrices are not supported and
+       fall back to the serial assembly. */
+   void EnableThreadedAssembly(bool deterministic = true)
+   { thread_assembly = deterministic ? 1 : 2; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -264,6 +304,9 @@ public:
    /// Matrix vector multiplication:  \f$ y = M x \f$
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Multiply all the vectors of @a X, see Operator::MultMany().
+   virtual void MultMany(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Matrix vector multiplication with the original uneliminated
        matrix.  The original matrix is \f$ M + M_e \f$ so we have:
        \f$ y = M x + M_e x \f$ */
@@ -379,6 +422,15 @@ public:
    /// Assembles the form i.e. sums over all domain/bdr integrators.
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Assemble the domain and boundary integrators into a new BSRMatrix
+       with vdim x vdim blocks, one for each pair of coupled nodes, without
+       forming the SparseMatrix. */
+   /** The returned matrix is owned by the caller. It acts on the vdofs of the
+       FiniteElementSpace, i.e. before the conforming prolongation, with the
+       Ordering of the space. Face integrators, static condensation and
+       hybridization are not supported. */
+   BSRMatrix *AssembleBSR();
+
    /** @brief Assemble the diagonal of the bilinear form into @a diag. Note that
        @a diag is a tdof Vector.
 
@@ -251,10 +251,23 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 {
-   ElementDofOrdering ordering = UsesTensorBasis(*a->FESpace())?
-                                 ElementDofOrdering::LEXICOGRAPHIC:
-                                 ElementDofOrdering::NATIVE;
-   elem_restrict = trialFes->GetElementRestriction(ordering);
+   // Meshes with several element geometries use per-geometry batches, see
+   // PAElementBatch.
+   const Mesh *mesh = trialFes->GetMesh();
+   if (mesh->GetNumGeometries(mesh->Dimension()) > 1)
+   {
+      ElementDofOrdering ordering = UsesTensorBasisPerGeometry(*trialFes)?
+                                    ElementDofOrdering::LEXICOGRAPHIC:
+                                    ElementDofOrdering::NATIVE;
+      elem_restrict = trialFes->GetBatchedElementRestriction(ordering);
+   }
+   else
+   {
+      ElementDofOrdering ordering = UsesTensorBasis(*a->FESpace())?
+                                    ElementDofOrdering::LEXICOGRAPHIC:
+                                    ElementDofOrdering::NATIVE;
+      elem_restrict = trialFes->GetElementRestriction(ordering);
+   }
    if (elem_restrict)
    {
       localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
@@ -288,6 +301,7 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -329,10 +343,16 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
       }
       const ElementRestriction* H1elem_restrict =
          dynamic_cast<const ElementRestriction*>(elem_restrict);
+      const BatchedElementRestriction* batch_restrict =
+         dynamic_cast<const BatchedElementRestriction*>(elem_restrict);
       if (H1elem_restrict)
       {
          H1elem_restrict->MultTransposeUnsigned(localY, y);
       }
+      else if (batch_restrict)
+      {
+         batch_restrict->MultTransposeUnsigned(localY, y);
+      }
       else
       {
          elem_restrict->MultTranspose(localY, y);
@@ -382,6 +402,7 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -438,8 +459,49 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::MultMany(const MultiVector &X,
+                                       MultiVector &Y) const
+{
+   const bool faces =
+      (int_face_restrict_lex && a->GetFBFI()->Size() > 0) ||
+      (bdr_face_restrict_lex && a->GetBFBFI()->Size() > 0);
+   if (DeviceCanUseCeed() || !elem_restrict || faces)
+   {
+      Operator::MultMany(X, Y);
+      return;
+   }
+
+   const int nv = X.NumVectors();
+   localXs.SetSize(elem_restrict->Height(), nv);
+   localYs.SetSize(elem_restrict->Height(), nv);
+   localXs.UseDevice(true);
+   localYs.UseDevice(true);
+   Vector x, y, lx, ly;
+   for (int j = 0; j < nv; j++)
+   {
+      X.GetVectorView(j, x);
+      localXs.GetVectorView(j, lx);
+      elem_restrict->Mult(x, lx);
+      lx.SyncAliasMemory(localXs);
+   }
+   localYs = 0.0;
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AddMultManyPA(localXs, localYs);
+   }
+   for (int j = 0; j < nv; j++)
+   {
+      localYs.GetVectorView(j, ly);
+      Y.GetVectorView(j, y);
+      elem_restrict->MultTranspose(ly, y);
+      y.SyncAliasMemory(Y);
+   }
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
@@ -504,6 +566,11 @@ EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
 
 void EABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
+   Mesh *mesh = trialFes->GetMesh();
+   MFEM_VERIFY(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
+               "Element and full assembly do not support meshes with mixed "
+               "element geometries, use partial or legacy assembly.");
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trialFes->GetMesh()->GetNE();
@@ -569,6 +636,7 @@ void EABilinearFormExtension::Assemble()
 
 void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    // Apply the Element Restriction
    const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
    if (!useRestrict)
@@ -836,6 +904,7 @@ FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
 
 void FABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
    EABilinearFormExtension::Assemble();
    FiniteElementSpace &fes = *a->FESpace();
    int width = fes.GetVSize();
@@ -863,7 +932,8 @@ void FABilinearFormExtension::Assemble()
       if (fes.IsDGSpace())
       {
          const L2ElementRestriction *restE =
-            static_cast<const L2ElementRestriction*>(elem_restrict);
+            dynamic_cast<const L2ElementRestriction*>(elem_restrict);
+         MFEM_VERIFY(restE, "Unsupported element restriction.");
          const L2FaceRestriction *restF =
             static_cast<const L2FaceRestriction*>(int_face_restrict_lex);
          // 1. Fill J and Data
@@ -881,9 +951,10 @@ void FABilinearFormExtension::Assemble()
       }
       else
       {
-         const ElementRestriction &rest =
-            static_cast<const ElementRestriction&>(*elem_restrict);
-         rest.FillJAndData(ea_data, *mat);
+         const ElementRestriction *rest =
+            dynamic_cast<const ElementRestriction*>(elem_restrict);
+         MFEM_VERIFY(rest, "Unsupported element restriction.");
+         rest->FillJAndData(ea_data, *mat);
       }
    }
    else // We create, compute the sparsity, and fill the sparse matrix
@@ -892,7 +963,8 @@ void FABilinearFormExtension::Assemble()
       if (fes.IsDGSpace())
       {
          const L2ElementRestriction *restE =
-            static_cast<const L2ElementRestriction*>(elem_restrict);
+            dynamic_cast<const L2ElementRestriction*>(elem_restrict);
+         MFEM_VERIFY(restE, "Unsupported element restriction.");
          const L2FaceRestriction *restF =
             static_cast<const L2FaceRestriction*>(int_face_restrict_lex);
          // 1. Fill I
@@ -929,9 +1001,10 @@ void FABilinearFormExtension::Assemble()
       }
       else // continuous Galerkin case
       {
-         const ElementRestriction &rest =
-            static_cast<const ElementRestriction&>(*elem_restrict);
-         rest.FillSparseMatrix(ea_data, *mat);
+         const ElementRestriction *rest =
+            dynamic_cast<const ElementRestriction*>(elem_restrict);
+         MFEM_VERIFY(rest, "Unsupported element restriction.");
+         rest->FillSparseMatrix(ea_data, *mat);
       }
       a->mat = mat;
    }
@@ -988,6 +1061,7 @@ void FABilinearFormExtension::DGMult(const Vector &x, Vector &y) const
 
 void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    if ( a->GetFBFI()->Size()>0 )
    {
       DGMult(x, y);
@@ -998,6 +1072,19 @@ void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void FABilinearFormExtension::MultMany(const MultiVector &X,
+                                       MultiVector &Y) const
+{
+   if ( a->GetFBFI()->Size()>0 )
+   {
+      Operator::MultMany(X, Y);
+   }
+   else
+   {
+      mat->MultMany(X, Y);
+   }
+}
+
 void FABilinearFormExtension::DGMultTranspose(const Vector &x, Vector &y) const
 {
 #ifdef MFEM_USE_MPI
@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "fespace.hpp"
 #include "../general/device.hpp"
+#include "../linalg/multivector.hpp"
 
 namespace mfem
 {
@@ -86,10 +87,15 @@ public:
                          OperatorHandle &A, Vector &X, Vector &B,
                          int copy_interior = 0);
    void Mult(const Vector &x, Vector &y) const;
+   /** @brief Apply the operator to all the vectors of @a X with a single
+       call of BilinearFormIntegrator::AddMultManyPA() per domain integrator. */
+   void MultMany(const MultiVector &X, MultiVector &Y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
 protected:
+   mutable MultiVector localXs, localYs;
+
    void SetupRestrictionOperators(const L2FaceValues m);
 };
 
@@ -111,6 +117,8 @@ public:
 
    void Assemble();
    void Mult(const Vector &x, Vector &y) const;
+   void MultMany(const MultiVector &X, MultiVector &Y) const
+   { Operator::MultMany(X, Y); }
    void MultTranspose(const Vector &x, Vector &y) const;
 };
 
@@ -126,6 +134,7 @@ public:
 
    void Assemble();
    void Mult(const Vector &x, Vector &y) const;
+   void MultMany(const MultiVector &X, MultiVector &Y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
 
    /** DGMult and DGMultTranspose use the extended L-vector to perform the
@@ -96,6 +96,19 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultManyPA(const MultiVector &x,
+                                           MultiVector &y) const
+{
+   Vector xj, yj;
+   for (int j = 0; j < x.NumVectors(); j++)
+   {
+      x.GetVectorView(j, xj);
+      y.GetVectorView(j, yj);
+      AddMultPA(xj, yj);
+      yj.SyncAliasMemory(y);
+   }
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
@@ -721,6 +734,48 @@ const IntegrationRule &GradientIntegrator::GetRule(const FiniteElement
 }
 
 
+PAElementBatch::PAElementBatch(const FiniteElementSpace &fes,
+                               Geometry::Type g)
+   : mesh(fes.GetMesh()), ir(NULL), maps(NULL), geom(NULL), nq(0)
+{
+   mesh->GetGeometryElements(g, elems);
+   MFEM_VERIFY(elems.Size() > 0, "no elements with the given geometry");
+   fe = fes.GetFE(elems[0]);
+   tensor = dynamic_cast<const TensorBasisElement*>(fe) != NULL;
+   nd = fe->GetDof();
+}
+
+void PAElementBatch::Setup(const IntegrationRule &rule, int geom_flags,
+                           MemoryType mt)
+{
+   ir = &rule;
+   nq = ir->GetNPoints();
+   maps = &fe->GetDofToQuad(*ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
+   geom = mesh->GetGeometricFactors(*ir, geom_flags, fe->GetGeomType(), mt);
+}
+
+void PAElementBatch::EvalCoefficient(Coefficient *Q, Vector &coeff) const
+{
+   if (Q == NULL)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+      return;
+   }
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   // The batch elements are in ascending order, so the points of the
+   // QuadratureSpace below are ordered as the NQ x NE layout.
+   QuadratureSpace qs(mesh, *ir, fe->GetGeomType());
+   QuadratureFunction qf(&qs);
+   Q->Project(qf);
+   coeff.Swap(qf);
+}
+
 void DiffusionIntegrator::AssembleElementMatrix
 ( const FiniteElement &el, ElementTransformation &Trans,
   DenseMatrix &elmat )
@@ -2668,6 +2723,13 @@ void VectorDiffusionIntegrator::AssembleElementVector(
 }
 
 
+const IntegrationRule &ElasticityIntegrator::GetRule(
+   const FiniteElement &el, ElementTransformation &Trans)
+{
+   int order = 2 * Trans.OrderGrad(&el); // correct order?
+   return IntRules.Get(el.GetGeomType(), order);
+}
+
 void ElasticityIntegrator::AssembleElementMatrix(
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
 {
@@ -2689,12 +2751,7 @@ void ElasticityIntegrator::AssembleElementMatrix(
 
    elmat.SetSize(dof * dim);
 
-   const IntegrationRule *ir = IntRule;
-   if (ir == NULL)
-   {
-      int order = 2 * Trans.OrderGrad(&el); // correct order?
-      ir = &IntRules.Get(el.GetGeomType(), order);
-   }
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
 
    elmat = 0.0;
 
@@ -88,6 +88,13 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on several E-vectors.
+   /** Perform the action of the integrator on all the vectors of @a x and add
+       the results to the vectors of @a y, see AddMultPA(). The default
+       implementation calls AddMultPA() for each vector; integrators override
+       it to read their partially assembled data once for all the vectors. */
+   virtual void AddMultManyPA(const MultiVector &x, MultiVector &y) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -1954,6 +1961,44 @@ public:
                                          ElementTransformation &Trans);
 };
 
+/** @brief Partial assembly data for a batch of elements with the same geometry
+    and finite element. */
+/** Integrators use a list of such batches on meshes with several element
+    geometries and on meshes with non tensor-product elements. The batches
+    follow the E-vector layout of
+    FiniteElementSpace::GetBatchedElementRestriction(), see
+    BatchedElementRestriction. */
+class PAElementBatch
+{
+public:
+   Mesh *mesh;                    ///< Not owned
+   Array<int> elems;              ///< Mesh elements in the batch
+   const FiniteElement *fe;       ///< Not owned
+   const IntegrationRule *ir;     ///< Not owned
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   bool tensor;                   ///< Use the tensor-product kernels
+   int nd, nq;
+   Vector pa_data;
+
+   /// Collect the elements of @a fes with the given geometry @a g.
+   PAElementBatch(const FiniteElementSpace &fes, Geometry::Type g);
+
+   /** @brief Set the quadrature rule and compute the DofToQuad maps and the
+       GeometricFactors given by @a geom_flags, see GeometricFactors. */
+   void Setup(const IntegrationRule &rule, int geom_flags, MemoryType mt);
+
+   int GetNE() const { return elems.Size(); }
+
+   /// Size of the batch data in the E-vector: @a nd times GetNE().
+   int GetESize() const { return nd*elems.Size(); }
+
+   /** @brief Evaluate the scalar coefficient @a Q at the quadrature points of
+       the batch, with layout NQ x NE, using Coefficient::Project(). A NULL or
+       constant coefficient gives a vector of size 1. */
+   void EvalCoefficient(Coefficient *Q, Vector &coeff) const;
+};
+
 /** Class for integrating the bilinear form a(u,v) := (Q grad u, grad v) where Q
     can be a scalar or a matrix coefficient. */
 class DiffusionIntegrator: public BilinearFormIntegrator
@@ -1979,6 +2024,13 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+   /// Interleaved E-vectors of the 'simd-cpu' backend, reused by AddMultPA()
+   mutable Vector pa_simd_x, pa_simd_y;
+   /// Element batches used on mixed meshes and non tensor-product elements
+   Array<PAElementBatch*> pa_batches;
+
+   void AssemblePABatches(const FiniteElementSpace &fes);
+   void DeletePABatches();
 
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
@@ -2001,6 +2053,8 @@ public:
    DiffusionIntegrator(SymmetricMatrixCoefficient &q)
       : Q(NULL), VQ(NULL), MQ(NULL), SMQ(&q), maps(NULL), geom(NULL) { }
 
+   virtual ~DiffusionIntegrator() { DeletePABatches(); }
+
    /** Given a particular Finite Element computes the element stiffness matrix
        elmat. */
    virtual void AssembleElementMatrix(const FiniteElement &el,
@@ -2044,12 +2098,20 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultManyPA(const MultiVector&, MultiVector&) const;
+
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
    bool SupportsCeed() const { return DeviceCanUseCeed(); }
+
+   /// Return the scalar coefficient, or NULL for a unit or non-scalar one.
+   Coefficient *GetCoefficient() const { return Q; }
+
+   /// Return true if a vector or matrix coefficient is used.
+   bool IsAnisotropic() const { return VQ || MQ || SMQ; }
 };
 
 /** Class for local mass matrix assembling a(u,v) := (Q u, v) */
@@ -2066,6 +2128,13 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   /// Interleaved E-vectors of the 'simd-cpu' backend, reused by AddMultPA()
+   mutable Vector pa_simd_x, pa_simd_y;
+   /// Element batches used on mixed meshes and non tensor-product elements
+   Array<PAElementBatch*> pa_batches;
+
+   void AssemblePABatches(const FiniteElementSpace &fes);
+   void DeletePABatches();
 
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
@@ -2075,6 +2144,8 @@ public:
    MassIntegrator(Coefficient &q, const IntegrationRule *ir = NULL)
       : BilinearFormIntegrator(ir), Q(&q), maps(NULL), geom(NULL) { }
 
+   virtual ~MassIntegrator() { DeletePABatches(); }
+
    /** Given a particular Finite Element computes the element mass matrix
        elmat. */
    virtual void AssembleElementMatrix(const FiniteElement &el,
@@ -2102,6 +2173,8 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultManyPA(const MultiVector&, MultiVector&) const;
+
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
@@ -2109,6 +2182,9 @@ public:
                                          ElementTransformation &Trans);
 
    bool SupportsCeed() const { return DeviceCanUseCeed(); }
+
+   /// Return the coefficient, or NULL if the coefficient is 1.
+   Coefficient *GetCoefficient() const { return Q; }
 };
 
 /** Mass integrator (u, v) restricted to the boundary of a domain */
@@ -2136,6 +2212,8 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   /// Interleaved E-vectors of the 'simd-cpu' backend, reused by AddMultPA()
+   mutable Vector pa_simd_x, pa_simd_y;
 
 private:
 #ifndef MFEM_THREAD_SAFE
@@ -2450,6 +2528,12 @@ public:
    virtual void AssemblePA(const FiniteElementSpace &fes);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AssembleDiagonalPA(Vector& diag);
+
+   /// Return the scalar coefficient, or NULL for a unit or non-scalar one.
+   Coefficient *GetCoefficient() const { return Q; }
+
+   /// Return true if a diagonal or matrix coefficient is used.
+   bool IsAnisotropic() const { return DQ || MQ || SMQ; }
 };
 
 /** Integrator for (curl u, curl v) for FE spaces defined by 'dim' copies of a
@@ -2540,6 +2624,12 @@ public:
                            const FiniteElementSpace &test_fes);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AssembleDiagonalPA(Vector& diag);
+
+   /// Return the scalar coefficient, or NULL for a unit or non-scalar one.
+   Coefficient *GetCoefficient() const { return Q; }
+
+   /// Return true if a diagonal or matrix coefficient is used.
+   bool IsAnisotropic() const { return DQ || MQ || SMQ; }
 };
 
 /** Integrator for (Q div u, p) where u=(v1,...,vn) and all vi are in the same
@@ -2617,6 +2707,9 @@ public:
    DivDivIntegrator() { Q = NULL; }
    DivDivIntegrator(Coefficient &q) : Q(&q) { }
 
+   /// Return the coefficient, or NULL if the coefficient is 1.
+   Coefficient *GetCoefficient() const { return Q; }
+
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
                                       DenseMatrix &elmat);
@@ -2737,18 +2830,36 @@ private:
    Vector divshape;
 #endif
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 public:
    ElasticityIntegrator(Coefficient &l, Coefficient &m)
+      : maps(NULL), geom(NULL), ne(0)
    { lambda = &l; mu = &m; }
    /** With this constructor lambda = q_l * m and mu = q_m * m;
        if dim * q_l + 2 * q_m = 0 then trace(sigma) = 0. */
    ElasticityIntegrator(Coefficient &m, double q_l, double q_m)
+      : maps(NULL), geom(NULL), ne(0)
    { lambda = NULL; mu = &m; q_lambda = q_l; q_mu = q_m; }
 
+   static const IntegrationRule &GetRule(const FiniteElement &el,
+                                         ElementTransformation &Trans);
+
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
 
+   using BilinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleDiagonalPA(Vector &diag);
+
    /** Compute the stress corresponding to the local displacement @a u and
        interpolate it at the nodes of the given @a fluxelem. Only the symmetric
        part of the stress is stored, so that the size of @a flux is equal to
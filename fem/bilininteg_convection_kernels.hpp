@@ -0,0 +1,324 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_CONVECTION_KERNELS_HPP
+#define MFEM_BILININTEG_CONVECTION_KERNELS_HPP
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
+
+// Element kernels of the partially assembled convection operator. They are
+// shared by the MFEM_FORALL loops of bilininteg_convection_pa.cpp and by the
+// 'simd-cpu' backend, which instantiates them with the type T of the quadrature
+// data and of the E-vectors set to an AutoSIMD type (see bilininteg_simd.hpp).
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/// Apply the 2D PA convection operator to the element @a e of the E-vector
+/// @a x_, adding the result to @a y_.
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double>
+MFEM_HOST_DEVICE inline
+void PAConvectionApply2D_Element(const int e,
+                                 const int NE,
+                                 const double *b,
+                                 const double *g,
+                                 const double *bt,
+                                 const T *op_,
+                                 const T *x_,
+                                 T *y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   DeviceTensor<2,const double> B(b, Q1D, D1D);
+   DeviceTensor<2,const double> G(g, Q1D, D1D);
+   DeviceTensor<2,const double> Bt(bt, D1D, Q1D);
+   DeviceTensor<4,const T> op(op_, Q1D, Q1D, 2, NE);
+   DeviceTensor<3,const T> x(x_, D1D, D1D, NE);
+   DeviceTensor<3,T> y(y_, D1D, D1D, NE);
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   T u[max_D1D][max_D1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         u[dy][dx] = x(dx,dy,e);
+      }
+   }
+   T Bu[max_D1D][max_Q1D];
+   T Gu[max_D1D][max_Q1D];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         Bu[dy][qx] = 0.0;
+         Gu[dy][qx] = 0.0;
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double bx = B(qx,dx);
+            const double gx = G(qx,dx);
+            const T x = u[dy][dx];
+            Bu[dy][qx] += bx * x;
+            Gu[dy][qx] += gx * x;
+         }
+      }
+   }
+   T GBu[max_Q1D][max_Q1D];
+   T BGu[max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         GBu[qy][qx] = 0.0;
+         BGu[qy][qx] = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double bx = B(qy,dy);
+            const double gx = G(qy,dy);
+            GBu[qy][qx] += gx * Bu[dy][qx];
+            BGu[qy][qx] += bx * Gu[dy][qx];
+         }
+      }
+   }
+   // Calculate Dxy, xDy in plane
+   T DGu[max_Q1D][max_Q1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const T O1 = op(qx,qy,0,e);
+         const T O2 = op(qx,qy,1,e);
+
+         const T gradX = BGu[qy][qx];
+         const T gradY = GBu[qy][qx];
+
+         DGu[qy][qx] = (O1 * gradX) + (O2 * gradY);
+      }
+   }
+   T BDGu[max_D1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         BDGu[dy][qx] = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double w = Bt(dy,qy);
+            BDGu[dy][qx] += w * DGu[qy][qx];
+         }
+      }
+   }
+   for (int dx = 0; dx < D1D; ++dx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         T BBDGu;
+         BBDGu = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double w = Bt(dx,qx);
+            BBDGu += w * BDGu[dy][qx];
+         }
+         y(dx,dy,e) += BBDGu;
+      }
+   }
+}
+
+/// Apply the 3D PA convection operator to the element @a e of the E-vector
+/// @a x_, adding the result to @a y_.
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double>
+MFEM_HOST_DEVICE inline
+void PAConvectionApply3D_Element(const int e,
+                                 const int NE,
+                                 const double *b,
+                                 const double *g,
+                                 const double *bt,
+                                 const T *op_,
+                                 const T *x_,
+                                 T *y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   DeviceTensor<2,const double> B(b, Q1D, D1D);
+   DeviceTensor<2,const double> G(g, Q1D, D1D);
+   DeviceTensor<2,const double> Bt(bt, D1D, Q1D);
+   DeviceTensor<5,const T> op(op_, Q1D, Q1D, Q1D, 3, NE);
+   DeviceTensor<4,const T> x(x_, D1D, D1D, D1D, NE);
+   DeviceTensor<4,T> y(y_, D1D, D1D, D1D, NE);
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   T u[max_D1D][max_D1D][max_D1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            u[dz][dy][dx] = x(dx,dy,dz,e);
+         }
+      }
+   }
+   T Bu[max_D1D][max_D1D][max_Q1D];
+   T Gu[max_D1D][max_D1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            Bu[dz][dy][qx] = 0.0;
+            Gu[dz][dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double bx = B(qx,dx);
+               const double gx = G(qx,dx);
+               const T x = u[dz][dy][dx];
+               Bu[dz][dy][qx] += bx * x;
+               Gu[dz][dy][qx] += gx * x;
+            }
+         }
+      }
+   }
+   T BBu[max_D1D][max_Q1D][max_Q1D];
+   T GBu[max_D1D][max_Q1D][max_Q1D];
+   T BGu[max_D1D][max_Q1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            BBu[dz][qy][qx] = 0.0;
+            GBu[dz][qy][qx] = 0.0;
+            BGu[dz][qy][qx] = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double bx = B(qy,dy);
+               const double gx = G(qy,dy);
+               BBu[dz][qy][qx] += bx * Bu[dz][dy][qx];
+               GBu[dz][qy][qx] += gx * Bu[dz][dy][qx];
+               BGu[dz][qy][qx] += bx * Gu[dz][dy][qx];
+            }
+         }
+      }
+   }
+   T GBBu[max_Q1D][max_Q1D][max_Q1D];
+   T BGBu[max_Q1D][max_Q1D][max_Q1D];
+   T BBGu[max_Q1D][max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            GBBu[qz][qy][qx] = 0.0;
+            BGBu[qz][qy][qx] = 0.0;
+            BBGu[qz][qy][qx] = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double bx = B(qz,dz);
+               const double gx = G(qz,dz);
+               GBBu[qz][qy][qx] += gx * BBu[dz][qy][qx];
+               BGBu[qz][qy][qx] += bx * GBu[dz][qy][qx];
+               BBGu[qz][qy][qx] += bx * BGu[dz][qy][qx];
+            }
+         }
+      }
+   }
+   // Calculate Dxy, xDy in plane
+   T DGu[max_Q1D][max_Q1D][max_Q1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const T O1 = op(qx,qy,qz,0,e);
+            const T O2 = op(qx,qy,qz,1,e);
+            const T O3 = op(qx,qy,qz,2,e);
+
+            const T gradX = BBGu[qz][qy][qx];
+            const T gradY = BGBu[qz][qy][qx];
+            const T gradZ = GBBu[qz][qy][qx];
+
+            DGu[qz][qy][qx] = (O1 * gradX) + (O2 * gradY) + (O3 * gradZ);
+         }
+      }
+   }
+   T BDGu[max_D1D][max_Q1D][max_Q1D];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            BDGu[dz][qy][qx] = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double w = Bt(dz,qz);
+               BDGu[dz][qy][qx] += w * DGu[qz][qy][qx];
+            }
+         }
+      }
+   }
+   T BBDGu[max_D1D][max_D1D][max_Q1D];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            BBDGu[dz][dy][qx] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double w = Bt(dy,qy);
+               BBDGu[dz][dy][qx] += w * BDGu[dz][qy][qx];
+            }
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            T BBBDGu;
+            BBBDGu = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double w = Bt(dx,qx);
+               BBBDGu += w * BBDGu[dz][dy][qx];
+            }
+            y(dx,dy,dz,e) += BBBDGu;
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_CONVECTION_KERNELS_HPP
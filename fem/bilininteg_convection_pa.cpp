@@ -11,6 +11,8 @@
 
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
+#include "bilininteg_convection_kernels.hpp"
+#include "bilininteg_simd.hpp"
 #include "gridfunc.hpp"
 #include "ceed/convection.hpp"
 #include "quadinterpolator.hpp"
@@ -152,104 +154,16 @@ void PAConvectionApply2D(const int ne,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto op = Reshape(op_.Read(), Q1D, Q1D, 2, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *G = g.Read();
+   const double *Bt = bt.Read();
+   const double *op = op_.Read();
+   const double *x = x_.Read();
+   double *y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double u[max_D1D][max_D1D];
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            u[dy][dx] = x(dx,dy,e);
-         }
-      }
-      double Bu[max_D1D][max_Q1D];
-      double Gu[max_D1D][max_Q1D];
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            Bu[dy][qx] = 0.0;
-            Gu[dy][qx] = 0.0;
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double bx = B(qx,dx);
-               const double gx = G(qx,dx);
-               const double x = u[dy][dx];
-               Bu[dy][qx] += bx * x;
-               Gu[dy][qx] += gx * x;
-            }
-         }
-      }
-      double GBu[max_Q1D][max_Q1D];
-      double BGu[max_Q1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            GBu[qy][qx] = 0.0;
-            BGu[qy][qx] = 0.0;
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double bx = B(qy,dy);
-               const double gx = G(qy,dy);
-               GBu[qy][qx] += gx * Bu[dy][qx];
-               BGu[qy][qx] += bx * Gu[dy][qx];
-            }
-         }
-      }
-      // Calculate Dxy, xDy in plane
-      double DGu[max_Q1D][max_Q1D];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double O1 = op(qx,qy,0,e);
-            const double O2 = op(qx,qy,1,e);
-
-            const double gradX = BGu[qy][qx];
-            const double gradY = GBu[qy][qx];
-
-            DGu[qy][qx] = (O1 * gradX) + (O2 * gradY);
-         }
-      }
-      double BDGu[max_D1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            BDGu[dy][qx] = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double w = Bt(dy,qy);
-               BDGu[dy][qx] += w * DGu[qy][qx];
-            }
-         }
-      }
-      for (int dx = 0; dx < D1D; ++dx)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double BBDGu = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double w = Bt(dx,qx);
-               BBDGu += w * BDGu[dy][qx];
-            }
-            y(dx,dy,e) += BBDGu;
-         }
-      }
+      internal::PAConvectionApply2D_Element<T_D1D,T_Q1D>(
+         e, NE, B, G, Bt, op, x, y, d1d, q1d);
    });
 }
 
@@ -399,166 +313,16 @@ void PAConvectionApply3D(const int ne,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto op = Reshape(op_.Read(), Q1D, Q1D, Q1D, 3, NE);
-   auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *G = g.Read();
+   const double *Bt = bt.Read();
+   const double *op = op_.Read();
+   const double *x = x_.Read();
+   double *y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double u[max_D1D][max_D1D][max_D1D];
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               u[dz][dy][dx] = x(dx,dy,dz,e);
-            }
-         }
-      }
-      double Bu[max_D1D][max_D1D][max_Q1D];
-      double Gu[max_D1D][max_D1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               Bu[dz][dy][qx] = 0.0;
-               Gu[dz][dy][qx] = 0.0;
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double bx = B(qx,dx);
-                  const double gx = G(qx,dx);
-                  const double x = u[dz][dy][dx];
-                  Bu[dz][dy][qx] += bx * x;
-                  Gu[dz][dy][qx] += gx * x;
-               }
-            }
-         }
-      }
-      double BBu[max_D1D][max_Q1D][max_Q1D];
-      double GBu[max_D1D][max_Q1D][max_Q1D];
-      double BGu[max_D1D][max_Q1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               BBu[dz][qy][qx] = 0.0;
-               GBu[dz][qy][qx] = 0.0;
-               BGu[dz][qy][qx] = 0.0;
-               for (int dy = 0; dy < D1D; ++dy)
-               {
-                  const double bx = B(qy,dy);
-                  const double gx = G(qy,dy);
-                  BBu[dz][qy][qx] += bx * Bu[dz][dy][qx];
-                  GBu[dz][qy][qx] += gx * Bu[dz][dy][qx];
-                  BGu[dz][qy][qx] += bx * Gu[dz][dy][qx];
-               }
-            }
-         }
-      }
-      double GBBu[max_Q1D][max_Q1D][max_Q1D];
-      double BGBu[max_Q1D][max_Q1D][max_Q1D];
-      double BBGu[max_Q1D][max_Q1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qz = 0; qz < Q1D; ++qz)
-            {
-               GBBu[qz][qy][qx] = 0.0;
-               BGBu[qz][qy][qx] = 0.0;
-               BBGu[qz][qy][qx] = 0.0;
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  const double bx = B(qz,dz);
-                  const double gx = G(qz,dz);
-                  GBBu[qz][qy][qx] += gx * BBu[dz][qy][qx];
-                  BGBu[qz][qy][qx] += bx * GBu[dz][qy][qx];
-                  BBGu[qz][qy][qx] += bx * BGu[dz][qy][qx];
-               }
-            }
-         }
-      }
-      // Calculate Dxy, xDy in plane
-      double DGu[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double O1 = op(qx,qy,qz,0,e);
-               const double O2 = op(qx,qy,qz,1,e);
-               const double O3 = op(qx,qy,qz,2,e);
-
-               const double gradX = BBGu[qz][qy][qx];
-               const double gradY = BGBu[qz][qy][qx];
-               const double gradZ = GBBu[qz][qy][qx];
-
-               DGu[qz][qy][qx] = (O1 * gradX) + (O2 * gradY) + (O3 * gradZ);
-            }
-         }
-      }
-      double BDGu[max_D1D][max_Q1D][max_Q1D];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               BDGu[dz][qy][qx] = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  const double w = Bt(dz,qz);
-                  BDGu[dz][qy][qx] += w * DGu[qz][qy][qx];
-               }
-            }
-         }
-      }
-      double BBDGu[max_D1D][max_D1D][max_Q1D];
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               BBDGu[dz][dy][qx] = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  const double w = Bt(dy,qy);
-                  BBDGu[dz][dy][qx] += w * BDGu[dz][qy][qx];
-               }
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               double BBBDGu = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double w = Bt(dx,qx);
-                  BBBDGu += w * BBDGu[dz][dy][qx];
-               }
-               y(dx,dy,dz,e) += BBBDGu;
-            }
-         }
-      }
+      internal::PAConvectionApply3D_Element<T_D1D,T_Q1D>(
+         e, NE, B, G, Bt, op, x, y, d1d, q1d);
    });
 }
 
@@ -853,6 +617,131 @@ void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    PAConvectionSetup(dim, nq, ne, ir->GetWeights(), geom->J,
                      vel, alpha, pa_data);
+   if (Device::Allows(Backend::SIMD_CPU))
+   {
+      Vector pa_simd;
+      internal::SimdPAInterleave(symmDims*nq, ne, pa_data, pa_simd);
+      pa_data.Swap(pa_simd);
+   }
+}
+
+// Apply the PA convection operator to the groups of interleaved elements of the
+// 'simd-cpu' backend, see bilininteg_simd.hpp.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPAConvectionApply2D(const int NG,
+                                    const double *B,
+                                    const double *G,
+                                    const double *Bt,
+                                    const internal::simd_pa_t *D,
+                                    const internal::simd_pa_t *X,
+                                    internal::simd_pa_t *Y,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PAConvectionApply2D_Element<T_D1D,T_Q1D>(
+         g, NG, B, G, Bt, D, X, Y, d1d, q1d);
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPAConvectionApply3D(const int NG,
+                                    const double *B,
+                                    const double *G,
+                                    const double *Bt,
+                                    const internal::simd_pa_t *D,
+                                    const internal::simd_pa_t *X,
+                                    internal::simd_pa_t *Y,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PAConvectionApply3D_Element<T_D1D,T_Q1D>(
+         g, NG, B, G, Bt, D, X, Y, d1d, q1d);
+   }
+}
+
+// The quadrature data d is interleaved by AssemblePA, the E-vectors x and y are
+// interleaved here, into the buffers xs and ys kept by the integrator.
+static void SimdPAConvectionApply(const int dim,
+                                  const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const Array<double> &b,
+                                  const Array<double> &g,
+                                  const Array<double> &bt,
+                                  const Vector &d,
+                                  const Vector &x,
+                                  Vector &y,
+                                  Vector &xs,
+                                  Vector &ys)
+{
+   using internal::simd_pa_t;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = dim == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NG = internal::SimdPAGroups(NE);
+   internal::SimdPAInterleave(ND, NE, x, xs);
+   ys.SetSize(xs.Size(), MemoryType::HOST_64);
+   ys = 0.0;
+   const double *B = b.HostRead();
+   const double *G = g.HostRead();
+   const double *Bt = bt.HostRead();
+   const simd_pa_t *D = reinterpret_cast<const simd_pa_t*>(d.HostRead());
+   const simd_pa_t *X = reinterpret_cast<const simd_pa_t*>(xs.HostRead());
+   simd_pa_t *Y = reinterpret_cast<simd_pa_t*>(ys.HostReadWrite());
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPAConvectionApply2D<2,2>(NG,B,G,Bt,D,X,Y); break;
+         case 0x23: SimdPAConvectionApply2D<2,3>(NG,B,G,Bt,D,X,Y); break;
+         case 0x24: SimdPAConvectionApply2D<2,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x33: SimdPAConvectionApply2D<3,3>(NG,B,G,Bt,D,X,Y); break;
+         case 0x34: SimdPAConvectionApply2D<3,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x35: SimdPAConvectionApply2D<3,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x44: SimdPAConvectionApply2D<4,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x45: SimdPAConvectionApply2D<4,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x46: SimdPAConvectionApply2D<4,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x55: SimdPAConvectionApply2D<5,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x56: SimdPAConvectionApply2D<5,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x57: SimdPAConvectionApply2D<5,7>(NG,B,G,Bt,D,X,Y); break;
+         case 0x66: SimdPAConvectionApply2D<6,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x67: SimdPAConvectionApply2D<6,7>(NG,B,G,Bt,D,X,Y); break;
+         case 0x68: SimdPAConvectionApply2D<6,8>(NG,B,G,Bt,D,X,Y); break;
+         default: SimdPAConvectionApply2D(NG,B,G,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPAConvectionApply3D<2,2>(NG,B,G,Bt,D,X,Y); break;
+         case 0x23: SimdPAConvectionApply3D<2,3>(NG,B,G,Bt,D,X,Y); break;
+         case 0x24: SimdPAConvectionApply3D<2,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x33: SimdPAConvectionApply3D<3,3>(NG,B,G,Bt,D,X,Y); break;
+         case 0x34: SimdPAConvectionApply3D<3,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x35: SimdPAConvectionApply3D<3,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x44: SimdPAConvectionApply3D<4,4>(NG,B,G,Bt,D,X,Y); break;
+         case 0x45: SimdPAConvectionApply3D<4,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x46: SimdPAConvectionApply3D<4,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x55: SimdPAConvectionApply3D<5,5>(NG,B,G,Bt,D,X,Y); break;
+         case 0x56: SimdPAConvectionApply3D<5,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x57: SimdPAConvectionApply3D<5,7>(NG,B,G,Bt,D,X,Y); break;
+         case 0x66: SimdPAConvectionApply3D<6,6>(NG,B,G,Bt,D,X,Y); break;
+         case 0x67: SimdPAConvectionApply3D<6,7>(NG,B,G,Bt,D,X,Y); break;
+         case 0x68: SimdPAConvectionApply3D<6,8>(NG,B,G,Bt,D,X,Y); break;
+         default: SimdPAConvectionApply3D(NG,B,G,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   internal::SimdPADeinterleave(ND, NE, ys, y, true);
 }
 
 static void PAConvectionApply(const int dim,
@@ -913,6 +802,12 @@ void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    {
       ceedOp->AddMult(x, y);
    }
+   else if (Device::Allows(Backend::SIMD_CPU))
+   {
+      SimdPAConvectionApply(dim, dofs1D, quad1D, ne,
+                            maps->B, maps->G, maps->Bt, pa_data, x, y,
+                            pa_simd_x, pa_simd_y);
+   }
    else
    {
       PAConvectionApply(dim, dofs1D, quad1D, ne,
@@ -0,0 +1,344 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+#define MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
+
+// Element kernels of the partially assembled diffusion operator. They are shared by
+// the MFEM_FORALL loops of bilininteg_diffusion_pa.cpp, by the kernels compiled
+// at runtime when MFEM is built with MFEM_USE_JIT (see general/jit.hpp), and
+// by the 'simd-cpu' backend, which instantiates them with the type T of the
+// quadrature data and of the E-vectors set to an AutoSIMD type (see
+// bilininteg_simd.hpp).
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/// Apply the 2D PA diffusion operator to the element @a e of the E-vector
+/// @a x, adding the result to @a y.
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply2D_Element(const int e,
+                                const int NE,
+                                const bool symmetric,
+                                const double *b,
+                                const double *g,
+                                const double *bt,
+                                const double *gt,
+                                const T *d,
+                                const T *x,
+                                T *y,
+                                const int d1d = 0,
+                                const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   DeviceTensor<2,const double> B(b, Q1D, D1D);
+   DeviceTensor<2,const double> G(g, Q1D, D1D);
+   DeviceTensor<2,const double> Bt(bt, D1D, Q1D);
+   DeviceTensor<2,const double> Gt(gt, D1D, Q1D);
+   DeviceTensor<3,const T> D(d, Q1D*Q1D, symmetric ? 3 : 4, NE);
+   DeviceTensor<3,const T> X(x, D1D, D1D, NE);
+   DeviceTensor<3,T> Y(y, D1D, D1D, NE);
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+   T grad[max_Q1D][max_Q1D][2];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      T gradX[max_Q1D][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const T s = X(dx,dy,e);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B(qx,dx);
+            gradX[qx][1] += s * G(qx,dx);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy  = B(qy,dy);
+         const double wDy = G(qy,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+   // Calculate Dxy, xDy in plane
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const int q = qx + qy * Q1D;
+
+         const T O11 = D(q,0,e);
+         const T O21 = D(q,1,e);
+         const T O12 = symmetric ? O21 : D(q,2,e);
+         const T O22 = symmetric ? D(q,2,e) : D(q,3,e);
+
+         const T gradX = grad[qy][qx][0];
+         const T gradY = grad[qy][qx][1];
+
+         grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+         grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      T gradX[max_D1D][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0;
+         gradX[dx][1] = 0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const T gX = grad[qy][qx][0];
+         const T gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double wx  = Bt(dx,qx);
+            const double wDx = Gt(dx,qx);
+            gradX[dx][0] += gX * wDx;
+            gradX[dx][1] += gY * wx;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy  = Bt(dy,qy);
+         const double wDy = Gt(dy,qy);
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+         }
+      }
+   }
+}
+
+/// Apply the 3D PA diffusion operator to the element @a e of the E-vector
+/// @a x, adding the result to @a y.
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply3D_Element(const int e,
+                                const int NE,
+                                const bool symmetric,
+                                const double *b,
+                                const double *g,
+                                const double *bt,
+                                const double *gt,
+                                const T *d,
+                                const T *x,
+                                T *y,
+                                const int d1d = 0,
+                                const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   DeviceTensor<2,const double> B(b, Q1D, D1D);
+   DeviceTensor<2,const double> G(g, Q1D, D1D);
+   DeviceTensor<2,const double> Bt(bt, D1D, Q1D);
+   DeviceTensor<2,const double> Gt(gt, D1D, Q1D);
+   DeviceTensor<3,const T> D(d, Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   DeviceTensor<4,const T> X(x, D1D, D1D, D1D, NE);
+   DeviceTensor<4,T> Y(y, D1D, D1D, D1D, NE);
+   constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+   T grad[max_Q1D][max_Q1D][max_Q1D][3];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      T gradXY[max_Q1D][max_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         T gradX[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const T s = X(dx,dy,dz,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const T wx  = gradX[qx][0];
+               const T wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz  = B(qz,dz);
+         const double wDz = G(qz,dz);
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+            }
+         }
+      }
+   }
+   // Calculate Dxyz, xDyz, xyDz in plane
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + (qy + qz * Q1D) * Q1D;
+            const T O11 = D(q,0,e);
+            const T O12 = D(q,1,e);
+            const T O13 = D(q,2,e);
+            const T O21 = symmetric ? O12 : D(q,3,e);
+            const T O22 = symmetric ? D(q,3,e) : D(q,4,e);
+            const T O23 = symmetric ? D(q,4,e) : D(q,5,e);
+            const T O31 = symmetric ? O13 : D(q,6,e);
+            const T O32 = symmetric ? O23 : D(q,7,e);
+            const T O33 = symmetric ? D(q,5,e) : D(q,8,e);
+            const T gradX = grad[qz][qy][qx][0];
+            const T gradY = grad[qz][qy][qx][1];
+            const T gradZ = grad[qz][qy][qx][2];
+            grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+            grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
+            grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      T gradXY[max_D1D][max_D1D][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0;
+            gradXY[dy][dx][1] = 0;
+            gradXY[dy][dx][2] = 0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         T gradX[max_D1D][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0;
+            gradX[dx][1] = 0;
+            gradX[dx][2] = 0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const T gX = grad[qz][qy][qx][0];
+            const T gY = grad[qz][qy][qx][1];
+            const T gZ = grad[qz][qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz  = Bt(dz,qz);
+         const double wDz = Gt(dz,qz);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,dz,e) +=
+                  ((gradXY[dy][dx][0] * wz) +
+                   (gradXY[dy][dx][1] * wz) +
+                   (gradXY[dy][dx][2] * wDz));
+            }
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
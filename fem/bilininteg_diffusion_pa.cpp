@@ -10,8 +10,12 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/jit.hpp"
+#include "../linalg/kernels.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "bilininteg_diffusion_kernels.hpp"
+#include "bilininteg_simd.hpp"
 #include "ceed/diffusion.hpp"
 
 using namespace std;
@@ -356,7 +360,14 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    // Assuming the same element type
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
+   DeletePABatches();
    if (mesh->GetNE() == 0) { return; }
+   if (!DeviceCanUseCeed() &&
+       (mesh->GetNumGeometries(mesh->Dimension()) > 1 || !UsesTensorBasis(fes)))
+   {
+      AssemblePABatches(fes);
+      return;
+   }
    const FiniteElement &el = *fes.GetFE(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
    if (DeviceCanUseCeed())
@@ -388,25 +399,11 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
       coeffDim = MQfullDim;
 
-      coeff.SetSize(MQfullDim * nq * ne);
-
-      DenseMatrix M;
-      M.SetSize(dim);
-
-      auto C = Reshape(coeff.HostWrite(), MQfullDim, nq, ne);
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            MQ->Eval(M, *tr, ir->IntPoint(p));
-            for (int i=0; i<dim; ++i)
-               for (int j=0; j<dim; ++j)
-               {
-                  C(j+(i*dim), p, e) = M(i,j);
-               }
-         }
-      }
+      // The setup kernels expect the matrices in row-major order
+      QuadratureSpace qs(mesh, *ir);
+      QuadratureFunction qf(&qs, MQfullDim);
+      MQ->Project(qf, true);
+      coeff.Swap(qf);
    }
    else if (SMQ)
    {
@@ -438,21 +435,10 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    {
       MFEM_VERIFY(VQ->GetVDim() == dim, "");
       coeffDim = VQ->GetVDim();
-      coeff.SetSize(coeffDim * nq * ne);
-      auto C = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-      Vector D(coeffDim);
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            VQ->Eval(D, *tr, ir->IntPoint(p));
-            for (int i=0; i<coeffDim; ++i)
-            {
-               C(i, p, e) = D[i];
-            }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      QuadratureFunction qf(&qs, coeffDim);
+      VQ->Project(qf);
+      coeff.Swap(qf);
    }
    else if (Q == nullptr)
    {
@@ -479,20 +465,110 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
+      QuadratureSpace qs(mesh, *ir);
+      QuadratureFunction qf(&qs);
+      Q->Project(qf);
+      coeff.Swap(qf);
+   }
+   pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne, mt);
+   PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeffDim, ne, ir->GetWeights(),
+                    geom->J, coeff, pa_data);
+   if (Device::Allows(Backend::SIMD_CPU))
+   {
+      Vector pa_simd;
+      internal::SimdPAInterleave(pa_data.Size()/ne, ne, pa_data, pa_simd);
+      pa_data.Swap(pa_simd);
+   }
+}
+
+// PA Diffusion setup kernel for element batches: the quadrature points are
+// not assumed to have a tensor-product structure. The symmetric matrices are
+// stored with the same layout as in the tensor-product kernels.
+template<int DIM>
+static void PADiffusionSetupBatch(const int NQ,
+                                  const int NE,
+                                  const Array<double> &w,
+                                  const Vector &j,
+                                  const Vector &c,
+                                  Vector &d)
+{
+   constexpr int SYM = (DIM * (DIM + 1)) / 2;
+   const bool const_c = c.Size() == 1;
+   const auto W = w.Read();
+   const auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto D = Reshape(d.Write(), NQ, SYM, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jq[DIM*DIM], A[DIM*DIM];
+      for (int k = 0; k < DIM; k++)
+      {
+         for (int l = 0; l < DIM; l++) { Jq[l+k*DIM] = J(q,l,k,e); }
+      }
+      kernels::CalcAdjugate<DIM>(Jq, A);
+      const double coeff = const_c ? C(0,0) : C(q,e);
+      const double w_detJ = W[q] * coeff / kernels::Det<DIM>(Jq);
+      // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
+      for (int r = 0, idx = 0; r < DIM; r++)
       {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
+         for (int s = r; s < DIM; s++, idx++)
          {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
+            double val = 0.0;
+            for (int k = 0; k < DIM; k++) { val += A[r+k*DIM] * A[s+k*DIM]; }
+            D(q,idx,e) = w_detJ * val;
          }
       }
+   });
+}
+
+void DiffusionIntegrator::AssemblePABatches(const FiniteElementSpace &fes)
+{
+   const MemoryType mt = (pa_mt == MemoryType::DEFAULT) ?
+                         Device::GetDeviceMemoryType() : pa_mt;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = mesh->GetNE();
+   symmetric = true;
+   MFEM_VERIFY(!VQ && !MQ && !SMQ, "Only scalar coefficients are supported"
+               " with element batches");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "Element batches require"
+               " SpaceDimension() == Dimension()");
+   MFEM_VERIFY(dim == 2 || dim == 3, "Element batches require dim 2 or 3");
+   Array<Geometry::Type> geoms;
+   mesh->GetGeometries(dim, geoms);
+   MFEM_VERIFY(IntRule == NULL || geoms.Size() == 1,
+               "a single IntegrationRule can not be used on a mesh with"
+               " several element geometries");
+   const int symmDims = (dim * (dim + 1)) / 2;
+   for (int g = 0; g < geoms.Size(); g++)
+   {
+      PAElementBatch *batch = new PAElementBatch(fes, geoms[g]);
+      const IntegrationRule *ir =
+         IntRule ? IntRule : &GetRule(*batch->fe, *batch->fe);
+      batch->Setup(*ir, GeometricFactors::JACOBIANS, mt);
+      Vector coeff;
+      batch->EvalCoefficient(Q, coeff);
+      batch->pa_data.SetSize(symmDims * batch->nq * batch->GetNE(), mt);
+      if (dim == 2)
+      {
+         PADiffusionSetupBatch<2>(batch->nq, batch->GetNE(), ir->GetWeights(),
+                                  batch->geom->J, coeff, batch->pa_data);
+      }
+      else
+      {
+         PADiffusionSetupBatch<3>(batch->nq, batch->GetNE(), ir->GetWeights(),
+                                  batch->geom->J, coeff, batch->pa_data);
+      }
+      pa_batches.Append(batch);
    }
-   pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne, mt);
-   PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeffDim, ne, ir->GetWeights(),
-                    geom->J, coeff, pa_data);
+}
+
+void DiffusionIntegrator::DeletePABatches()
+{
+   for (int b = 0; b < pa_batches.Size(); b++) { delete pa_batches[b]; }
+   pa_batches.SetSize(0);
 }
 
 template<int T_D1D = 0, int T_Q1D = 0>
@@ -917,15 +993,79 @@ static void PADiffusionAssembleDiagonal(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Diffusion diagonal kernel for element batches with general DofToQuad maps
+static void PADiffusionDiagonalBatch(const int dim,
+                                     const int NE,
+                                     const int ND,
+                                     const int NQ,
+                                     const Array<double> &g,
+                                     const Vector &d,
+                                     Vector &y)
+{
+   const int SYM = (dim * (dim + 1)) / 2;
+   const auto G = Reshape(g.Read(), NQ, dim, ND);
+   const auto D = Reshape(d.Read(), NQ, SYM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double val = 0.0;
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int r = 0, idx = 0; r < dim; r++)
+         {
+            for (int s = r; s < dim; s++, idx++)
+            {
+               const double gg = G(q,r,dof) * G(q,s,dof);
+               val += (r == s ? 1.0 : 2.0) * D(q,idx,e) * gg;
+            }
+         }
+      }
+      Y(dof,e) += val;
+   });
+}
+
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (DeviceCanUseCeed())
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (pa_batches.Size() > 0)
+   {
+      Vector diag_b;
+      for (int b = 0, offset = 0; b < pa_batches.Size(); b++)
+      {
+         const PAElementBatch &batch = *pa_batches[b];
+         diag_b.MakeRef(diag, offset, batch.GetESize());
+         if (batch.tensor)
+         {
+            PADiffusionAssembleDiagonal(dim, batch.maps->ndof, batch.maps->nqpt,
+                                        batch.GetNE(), true, batch.maps->B,
+                                        batch.maps->G, batch.pa_data, diag_b);
+         }
+         else
+         {
+            PADiffusionDiagonalBatch(dim, batch.GetNE(), batch.nd, batch.nq,
+                                     batch.maps->G, batch.pa_data, diag_b);
+         }
+         offset += batch.GetESize();
+      }
+   }
    else
    {
       if (pa_data.Size()==0) { AssemblePA(*fespace); }
+      if (Device::Allows(Backend::SIMD_CPU))
+      {
+         const int N = pa_data.Size() /
+                       (internal::SimdPAGroups(ne)*internal::SIMD_PA_LANES);
+         Vector d(N*ne);
+         internal::SimdPADeinterleave(N, ne, pa_data, d);
+         PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
+                                     maps->B, maps->G, d, diag);
+         return;
+      }
       PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
                                   maps->B, maps->G, pa_data, diag);
    }
@@ -1050,107 +1190,17 @@ static void PADiffusionApply2D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto G = Reshape(g_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *G = g_.Read();
+   const double *Bt = bt_.Read();
+   const double *Gt = gt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double grad[max_Q1D][max_Q1D][2];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         double gradX[max_Q1D][2];
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double wy  = B(qy,dy);
-            const double wDy = G(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
-            }
-         }
-      }
-      // Calculate Dxy, xDy in plane
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const int q = qx + qy * Q1D;
-
-            const double O11 = D(q,0,e);
-            const double O21 = D(q,1,e);
-            const double O12 = symmetric ? O21 : D(q,2,e);
-            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
-
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
-
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double gradX[max_D1D][2];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double wx  = Bt(dx,qx);
-               const double wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double wy  = Bt(dy,qy);
-            const double wDy = Gt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
-            }
-         }
-      }
+      internal::PADiffusionApply2D_Element<T_D1D,T_Q1D>(
+         e, NE, symmetric, B, G, Bt, Gt, D, X, Y, d1d, q1d);
    });
 }
 
@@ -1329,179 +1379,17 @@ static void PADiffusionApply3D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *G = g.Read();
+   const double *Bt = bt.Read();
+   const double *Gt = gt.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double gradXY[max_Q1D][max_Q1D][3];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double gradX[max_Q1D][2];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy  = B(qy,dy);
-               const double wDy = G(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz  = B(qz,dz);
-            const double wDz = G(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-               }
-            }
-         }
-      }
-      // Calculate Dxyz, xDyz, xyDz in plane
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const int q = qx + (qy + qz * Q1D) * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O21 = symmetric ? O12 : D(q,3,e);
-               const double O22 = symmetric ? D(q,3,e) : D(q,4,e);
-               const double O23 = symmetric ? D(q,4,e) : D(q,5,e);
-               const double O31 = symmetric ? O13 : D(q,6,e);
-               const double O32 = symmetric ? O23 : D(q,7,e);
-               const double O33 = symmetric ? D(q,5,e) : D(q,8,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double gradXY[max_D1D][max_D1D][3];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            double gradX[max_D1D][3];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double wx  = Bt(dx,qx);
-                  const double wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy  = Bt(dy,qy);
-               const double wDy = Gt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz  = Bt(dz,qz);
-            const double wDz = Gt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
-               }
-            }
-         }
-      }
+      internal::PADiffusionApply3D_Element<T_D1D,T_Q1D>(
+         e, NE, symmetric, B, G, Bt, Gt, D, X, Y, d1d, q1d);
    });
 }
 
@@ -1826,6 +1714,186 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+// Apply the PA diffusion operator to the groups of interleaved elements of the
+// 'simd-cpu' backend, see bilininteg_simd.hpp.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPADiffusionApply2D(const int NG,
+                                   const bool symmetric,
+                                   const double *B,
+                                   const double *G,
+                                   const double *Bt,
+                                   const double *Gt,
+                                   const internal::simd_pa_t *D,
+                                   const internal::simd_pa_t *X,
+                                   internal::simd_pa_t *Y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PADiffusionApply2D_Element<T_D1D,T_Q1D>(
+         g, NG, symmetric, B, G, Bt, Gt, D, X, Y, d1d, q1d);
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPADiffusionApply3D(const int NG,
+                                   const bool symmetric,
+                                   const double *B,
+                                   const double *G,
+                                   const double *Bt,
+                                   const double *Gt,
+                                   const internal::simd_pa_t *D,
+                                   const internal::simd_pa_t *X,
+                                   internal::simd_pa_t *Y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PADiffusionApply3D_Element<T_D1D,T_Q1D>(
+         g, NG, symmetric, B, G, Bt, Gt, D, X, Y, d1d, q1d);
+   }
+}
+
+// The quadrature data d is interleaved by AssemblePA, the E-vectors x and y are
+// interleaved here, into the buffers xs and ys kept by the integrator.
+static void SimdPADiffusionApply(const int dim,
+                                 const int D1D,
+                                 const int Q1D,
+                                 const int NE,
+                                 const bool symm,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Array<double> &bt,
+                                 const Array<double> &gt,
+                                 const Vector &d,
+                                 const Vector &x,
+                                 Vector &y,
+                                 Vector &xs,
+                                 Vector &ys)
+{
+   using internal::simd_pa_t;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = dim == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NG = internal::SimdPAGroups(NE);
+   internal::SimdPAInterleave(ND, NE, x, xs);
+   ys.SetSize(xs.Size(), MemoryType::HOST_64);
+   ys = 0.0;
+   const double *B = b.HostRead();
+   const double *G = g.HostRead();
+   const double *Bt = bt.HostRead();
+   const double *Gt = gt.HostRead();
+   const simd_pa_t *D = reinterpret_cast<const simd_pa_t*>(d.HostRead());
+   const simd_pa_t *X = reinterpret_cast<const simd_pa_t*>(xs.HostRead());
+   simd_pa_t *Y = reinterpret_cast<simd_pa_t*>(ys.HostReadWrite());
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPADiffusionApply2D<2,2>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x23: SimdPADiffusionApply2D<2,3>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x24: SimdPADiffusionApply2D<2,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x33: SimdPADiffusionApply2D<3,3>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x34: SimdPADiffusionApply2D<3,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x35: SimdPADiffusionApply2D<3,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x44: SimdPADiffusionApply2D<4,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x45: SimdPADiffusionApply2D<4,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x46: SimdPADiffusionApply2D<4,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x55: SimdPADiffusionApply2D<5,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x56: SimdPADiffusionApply2D<5,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x57: SimdPADiffusionApply2D<5,7>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x66: SimdPADiffusionApply2D<6,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x67: SimdPADiffusionApply2D<6,7>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x68: SimdPADiffusionApply2D<6,8>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         default: SimdPADiffusionApply2D(NG,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPADiffusionApply3D<2,2>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x23: SimdPADiffusionApply3D<2,3>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x24: SimdPADiffusionApply3D<2,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x33: SimdPADiffusionApply3D<3,3>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x34: SimdPADiffusionApply3D<3,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x35: SimdPADiffusionApply3D<3,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x44: SimdPADiffusionApply3D<4,4>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x45: SimdPADiffusionApply3D<4,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x46: SimdPADiffusionApply3D<4,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x55: SimdPADiffusionApply3D<5,5>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x56: SimdPADiffusionApply3D<5,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x57: SimdPADiffusionApply3D<5,7>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x66: SimdPADiffusionApply3D<6,6>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x67: SimdPADiffusionApply3D<6,7>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         case 0x68: SimdPADiffusionApply3D<6,8>(NG,symm,B,G,Bt,Gt,D,X,Y); break;
+         default: SimdPADiffusionApply3D(NG,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   internal::SimdPADeinterleave(ND, NE, ys, y, true);
+}
+
+#ifdef MFEM_USE_JIT
+// Apply the PA diffusion operator with the element kernel compiled at runtime
+// for the given D1D and Q1D. Returns false if the JIT kernel is not available.
+static bool JitPADiffusionApply(const int dim,
+                                const int D1D,
+                                const int Q1D,
+                                const int NE,
+                                const bool symm,
+                                const Array<double> &b,
+                                const Array<double> &g,
+                                const Array<double> &bt,
+                                const Array<double> &gt,
+                                const Vector &d,
+                                const Vector &x,
+                                Vector &y)
+{
+   // The runtime compiled kernels are host functions
+   if (Device::Allows(Backend::DEVICE_MASK)) { return false; }
+   typedef void (*Kernel)(const int, const int, const bool, const double*,
+                          const double*, const double*, const double*,
+                          const double*, const double*, double*);
+   const Kernel kernel = (Kernel) jit::GetKernel(
+                            "fem/bilininteg_diffusion_kernels.hpp",
+                            dim == 2 ? "PADiffusionApply2D_Element" :
+                            "PADiffusionApply3D_Element", {D1D, Q1D},
+                            "const int e, const int NE, const bool symmetric, "
+                            "const double *b, const double *g, "
+                            "const double *bt, const double *gt, "
+                            "const double *d, const double *x, double *y",
+                            "e, NE, symmetric, b, g, bt, gt, d, x, y");
+   if (!kernel) { return false; }
+   const double *B = b.HostRead();
+   const double *G = g.HostRead();
+   const double *Bt = bt.HostRead();
+   const double *Gt = gt.HostRead();
+   const double *D = d.HostRead();
+   const double *X = x.HostRead();
+   double *Y = y.HostReadWrite();
+#ifdef MFEM_USE_OPENMP
+   // The elements are independent: thread them with the host OpenMP backends
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      OmpWrap(NE, [=](int e) { kernel(e, NE, symm, B, G, Bt, Gt, D, X, Y); });
+      return true;
+   }
+#endif
+   for (int e = 0; e < NE; e++)
+   {
+      kernel(e, NE, symm, B, G, Bt, Gt, D, X, Y);
+   }
+   return true;
+}
+#endif // MFEM_USE_JIT
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1869,7 +1937,14 @@ static void PADiffusionApply(const int dim,
          case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,symm,B,G,D,X,Y);
          case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,symm,B,G,D,X,Y);
          case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(2,D1D,Q1D,NE,symm,B,G,Bt,Gt,D,X,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
 
@@ -1886,27 +1961,221 @@ static void PADiffusionApply(const int dim,
          case 0x67: return SmemPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y);
          case 0x78: return SmemPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y);
          case 0x89: return SmemPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(3,D1D,Q1D,NE,symm,B,G,Bt,Gt,D,X,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Diffusion apply kernel for element batches with general DofToQuad maps
+static void PADiffusionApplyBatch(const int dim,
+                                  const int NE,
+                                  const int ND,
+                                  const int NQ,
+                                  const Array<double> &g,
+                                  const Vector &d,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   MFEM_VERIFY(dim <= 3, "");
+   const int SYM = (dim * (dim + 1)) / 2;
+   const auto G = Reshape(g.Read(), NQ, dim, ND);
+   const auto D = Reshape(d.Read(), NQ, SYM, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double grad[3] = {0.0, 0.0, 0.0}, flux[3] = {0.0, 0.0, 0.0};
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            const double s = X(dof,e);
+            for (int r = 0; r < dim; r++) { grad[r] += G(q,r,dof) * s; }
+         }
+         for (int r = 0, idx = 0; r < dim; r++)
+         {
+            for (int s = r; s < dim; s++, idx++)
+            {
+               const double Drs = D(q,idx,e);
+               flux[r] += Drs * grad[s];
+               if (s != r) { flux[s] += Drs * grad[r]; }
+            }
+         }
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            double val = 0.0;
+            for (int r = 0; r < dim; r++) { val += G(q,r,dof) * flux[r]; }
+            Y(dof,e) += val;
+         }
+      }
+   });
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (pa_batches.Size() > 0)
+   {
+      Vector x_b, y_b;
+      for (int b = 0, offset = 0; b < pa_batches.Size(); b++)
+      {
+         const PAElementBatch &batch = *pa_batches[b];
+         x_b.MakeRef(const_cast<Vector&>(x), offset, batch.GetESize());
+         y_b.MakeRef(y, offset, batch.GetESize());
+         if (batch.tensor)
+         {
+            PADiffusionApply(dim, batch.maps->ndof, batch.maps->nqpt,
+                             batch.GetNE(), true, batch.maps->B, batch.maps->G,
+                             batch.maps->Bt, batch.maps->Gt, batch.pa_data,
+                             x_b, y_b);
+         }
+         else
+         {
+            PADiffusionApplyBatch(dim, batch.GetNE(), batch.nd, batch.nq,
+                                  batch.maps->G, batch.pa_data, x_b, y_b);
+         }
+         offset += batch.GetESize();
+      }
+   }
+   else if (Device::Allows(Backend::SIMD_CPU))
+   {
+      SimdPADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
+                           maps->B, maps->G, maps->Bt, maps->Gt,
+                           pa_data, x, y, pa_simd_x, pa_simd_y);
+   }
    else
    {
+      // E-vectors and quadrature data; the gradient and its transpose need
+      // dim one-dimensional contractions per component
+      MFEM_PERF_WORK(8.0*(x.Size() + 2.0*y.Size() + pa_data.Size()),
+                     4.0*dim*dim*ne*pow(std::max(dofs1D, quad1D), dim+1));
       PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
                        maps->B, maps->G, maps->Bt, maps->Gt,
                        pa_data, x, y);
    }
 }
 
+// PA Diffusion apply kernel for the NV E-vectors of x: the data of an element
+// is applied to all the vectors before moving to the next element.
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyMany(const int NE,
+                                 const int NV,
+                                 const bool symmetric,
+                                 const Array<double> &b_,
+                                 const Array<double> &g_,
+                                 const Array<double> &bt_,
+                                 const Array<double> &gt_,
+                                 const Vector &d_,
+                                 const Vector &x_,
+                                 Vector &y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ESIZE = NE*(DIM == 2 ? D1D*D1D : D1D*D1D*D1D);
+   const double *B = b_.Read();
+   const double *G = g_.Read();
+   const double *Bt = bt_.Read();
+   const double *Gt = gt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      for (int v = 0; v < NV; v++)
+      {
+         if (DIM == 2)
+         {
+            internal::PADiffusionApply2D_Element<T_D1D,T_Q1D>(
+               e, NE, symmetric, B, G, Bt, Gt, D, X + v*ESIZE, Y + v*ESIZE,
+               d1d, q1d);
+         }
+         else
+         {
+            internal::PADiffusionApply3D_Element<T_D1D,T_Q1D>(
+               e, NE, symmetric, B, G, Bt, Gt, D, X + v*ESIZE, Y + v*ESIZE,
+               d1d, q1d);
+         }
+      }
+   });
+}
+
+template<int DIM>
+static void PADiffusionApplyMany(const int D1D,
+                                 const int Q1D,
+                                 const int NE,
+                                 const int NV,
+                                 const bool symm,
+                                 const Array<double> &B,
+                                 const Array<double> &G,
+                                 const Array<double> &Bt,
+                                 const Array<double> &Gt,
+                                 const Vector &D,
+                                 const Vector &X,
+                                 Vector &Y)
+{
+   switch ((D1D << 4) | Q1D)
+   {
+      case 0x22:
+         return PADiffusionApplyMany<DIM,2,2>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x23:
+         return PADiffusionApplyMany<DIM,2,3>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x33:
+         return PADiffusionApplyMany<DIM,3,3>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x34:
+         return PADiffusionApplyMany<DIM,3,4>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x44:
+         return PADiffusionApplyMany<DIM,4,4>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x45:
+         return PADiffusionApplyMany<DIM,4,5>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x55:
+         return PADiffusionApplyMany<DIM,5,5>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      case 0x56:
+         return PADiffusionApplyMany<DIM,5,6>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+      default:
+         return PADiffusionApplyMany<DIM>(NE,NV,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+   }
+}
+
+void DiffusionIntegrator::AddMultManyPA(const MultiVector &x,
+                                        MultiVector &y) const
+{
+   if (DeviceCanUseCeed() || pa_batches.Size() > 0 ||
+       Device::Allows(Backend::SIMD_CPU) || (dim != 2 && dim != 3) ||
+       dofs1D > MAX_D1D || quad1D > MAX_Q1D)
+   {
+      BilinearFormIntegrator::AddMultManyPA(x, y);
+   }
+   else if (dim == 2)
+   {
+      PADiffusionApplyMany<2>(dofs1D, quad1D, ne, x.NumVectors(), symmetric,
+                              maps->B, maps->G, maps->Bt, maps->Gt, pa_data,
+                              x, y);
+   }
+   else
+   {
+      PADiffusionApplyMany<3>(dofs1D, quad1D, ne, x.NumVectors(), symmetric,
+                              maps->B, maps->G, maps->Bt, maps->Gt, pa_data,
+                              x, y);
+   }
+}
+
 void DiffusionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
    if (symmetric)
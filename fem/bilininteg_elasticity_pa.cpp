@@ -0,0 +1,725 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "../linalg/kernels.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Elasticity Integrator
+
+// The PA data at each quadrature point is: lambda w det(J), mu w det(J) and
+// the DIM x DIM inverse Jacobian, stored in column-major order.
+
+// PA Elasticity Assemble kernel
+template<int DIM>
+static void PAElasticitySetup(const int NQ,
+                              const int NE,
+                              const Array<double> &w,
+                              const Vector &j,
+                              const Vector &lambda,
+                              const Vector &mu,
+                              Vector &op)
+{
+   constexpr int NJ = DIM*DIM;
+   const bool const_l = lambda.Size() == 1;
+   const bool const_m = mu.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto L = const_l ? Reshape(lambda.Read(), 1, 1) :
+            Reshape(lambda.Read(), NQ, NE);
+   auto M = const_m ? Reshape(mu.Read(), 1, 1) : Reshape(mu.Read(), NQ, NE);
+   auto y = Reshape(op.Write(), NQ, 2 + NJ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double Jq[NJ], iJ[NJ];
+         for (int i = 0; i < NJ; i++) { Jq[i] = J(q,i%DIM,i/DIM,e); }
+         const double w_detJ = W[q] * kernels::Det<DIM>(Jq);
+         kernels::CalcInverse<DIM>(Jq, iJ);
+         y(q,0,e) = w_detJ * (const_l ? L(0,0) : L(q,e));
+         y(q,1,e) = w_detJ * (const_m ? M(0,0) : M(q,e));
+         for (int i = 0; i < NJ; i++) { y(q,2+i,e) = iJ[i]; }
+      }
+   });
+}
+
+// Replace the reference gradient g(c,k) = d(u_c)/d(xi_k) of the displacement
+// at a quadrature point by the reference flux of the weighted stress,
+// w det(J) sigma(u) J^{-T}, where sigma(u) = lambda div(u) I + mu (grad(u) +
+// grad(u)^T) and grad(u) = g J^{-1}.
+template<int DIM> MFEM_HOST_DEVICE inline
+void PAElasticityQFunction(const double lw, const double mw,
+                           const double *iJ, double (&g)[DIM][DIM])
+{
+   double gu[DIM][DIM];
+   double div = 0.0;
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++) { s += g[c][k] * iJ[k+j*DIM]; }
+         gu[c][j] = s;
+      }
+      div += gu[c][c];
+   }
+   double sigma[DIM][DIM];
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         sigma[c][j] = mw * (gu[c][j] + gu[j][c]) + (c == j ? lw * div : 0.0);
+      }
+   }
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int k = 0; k < DIM; k++)
+      {
+         double s = 0.0;
+         for (int j = 0; j < DIM; j++) { s += sigma[c][j] * iJ[k+j*DIM]; }
+         g[c][k] = s;
+      }
+   }
+}
+
+// Coefficient (k,l) of the symmetric matrix D_c such that the diagonal of the
+// elasticity operator for the component c is grad(phi)^T D_c grad(phi) in
+// reference coordinates: D_c = (lambda + mu) a a^T + mu J^{-1} J^{-T} with a
+// the c-th column of J^{-1}, all weighted by w det(J).
+template<int DIM> MFEM_HOST_DEVICE inline
+double PAElasticityDiagonalCoeff(const double lw, const double mw,
+                                 const double *iJ, const int c,
+                                 const int k, const int l)
+{
+   double s = 0.0;
+   for (int j = 0; j < DIM; j++) { s += iJ[k+j*DIM] * iJ[l+j*DIM]; }
+   return (lw + mw) * iJ[k+c*DIM] * iJ[l+c*DIM] + mw * s;
+}
+
+// PA Elasticity Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply2D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // Reference gradients of all the components
+      double grad[max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][c][0] = 0.0;
+               grad[qy][qx][c][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][c][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double iJ[DIM*DIM];
+            for (int i = 0; i < DIM*DIM; i++) { iJ[i] = D(q,2+i,e); }
+            PAElasticityQFunction<DIM>(D(q,0,e), D(q,1,e), iJ, grad[qy][qx]);
+         }
+      }
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][c][0];
+               const double gY = grad[qy][qx][c][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply3D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // Reference gradients of all the components
+      double grad[max_Q1D][max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] = 0.0;
+                  grad[qz][qy][qx][c][1] = 0.0;
+                  grad[qz][qy][qx][c][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double iJ[DIM*DIM];
+               for (int i = 0; i < DIM*DIM; i++) { iJ[i] = D(q,2+i,e); }
+               PAElasticityQFunction<DIM>(D(q,0,e), D(q,1,e), iJ,
+                                          grad[qz][qy][qx]);
+            }
+         }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][c][0];
+                  const double gY = grad[qz][qy][qx][c][1];
+                  const double gZ = grad[qz][qy][qx][c][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Diagonal 2D kernel
+static void PAElasticityDiagonal2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int D1D,
+                                   const int Q1D)
+{
+   constexpr int DIM = 2;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int MD1 = MAX_D1D;
+      constexpr int MQ1 = MAX_Q1D;
+      for (int c = 0; c < DIM; c++)
+      {
+         // gradphi \cdot D_c \gradphi has four terms
+         double QD0[MQ1][MD1];
+         double QD1[MQ1][MD1];
+         double QD2[MQ1][MD1];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               QD0[qx][dy] = 0.0;
+               QD1[qx][dy] = 0.0;
+               QD2[qx][dy] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const int q = qx + qy * Q1D;
+                  double iJ[DIM*DIM];
+                  for (int i = 0; i < DIM*DIM; i++) { iJ[i] = D(q,2+i,e); }
+                  const double lw = D(q,0,e), mw = D(q,1,e);
+                  const double D00 =
+                     PAElasticityDiagonalCoeff<DIM>(lw, mw, iJ, c, 0, 0);
+                  const double D01 =
+                     PAElasticityDiagonalCoeff<DIM>(lw, mw, iJ, c, 0, 1);
+                  const double D11 =
+                     PAElasticityDiagonalCoeff<DIM>(lw, mw, iJ, c, 1, 1);
+                  QD0[qx][dy] += B(qy, dy) * B(qy, dy) * D00;
+                  QD1[qx][dy] += B(qy, dy) * G(qy, dy) * 2.0 * D01;
+                  QD2[qx][dy] += G(qy, dy) * G(qy, dy) * D11;
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  Y(dx,dy,c,e) += G(qx, dx) * G(qx, dx) * QD0[qx][dy];
+                  Y(dx,dy,c,e) += G(qx, dx) * B(qx, dx) * QD1[qx][dy];
+                  Y(dx,dy,c,e) += B(qx, dx) * B(qx, dx) * QD2[qx][dy];
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Diagonal 3D kernel
+static void PAElasticityDiagonal3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int D1D,
+                                   const int Q1D)
+{
+   constexpr int DIM = 3;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int MD1 = MAX_D1D;
+      constexpr int MQ1 = MAX_Q1D;
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               // first tensor contraction, along z direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        QQD[qx][qy][dz] = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const int q = qx + (qy + qz * Q1D) * Q1D;
+                           double iJ[DIM*DIM];
+                           for (int k = 0; k < DIM*DIM; k++)
+                           {
+                              iJ[k] = D(q,2+k,e);
+                           }
+                           const double O = PAElasticityDiagonalCoeff<DIM>(
+                                               D(q,0,e), D(q,1,e), iJ, c, i, j);
+                           const double Bz = B(qz,dz);
+                           const double Gz = G(qz,dz);
+                           const double L = i==2 ? Gz : Bz;
+                           const double R = j==2 ? Gz : Bz;
+                           QQD[qx][qy][dz] += L * O * R;
+                        }
+                     }
+                  }
+               }
+               // second tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        QDD[qx][dy][dz] = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double By = B(qy,dy);
+                           const double Gy = G(qy,dy);
+                           const double L = i==1 ? Gy : By;
+                           const double R = j==1 ? Gy : By;
+                           QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                        }
+                     }
+                  }
+               }
+               // third tensor contraction, along x direction
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Bx = B(qx,dx);
+                           const double Gx = G(qx,dx);
+                           const double L = i==0 ? Gx : Bx;
+                           const double R = j==0 ? Gx : Bx;
+                           Y(dx,dy,dz,c,e) += L * QDD[qx][dy][dz] * R;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Evaluate the coefficient at the quadrature points, unless it is constant.
+static void PAElasticityEvalCoefficient(const FiniteElementSpace &fes,
+                                        const IntegrationRule &ir,
+                                        Coefficient &Q, Vector &coeff)
+{
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   const int ne = fes.GetNE();
+   const int nq = ir.GetNPoints();
+   coeff.SetSize(nq * ne);
+   auto C = Reshape(coeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      for (int q = 0; q < nq; ++q)
+      {
+         C(q,e) = Q.Eval(T, ir.IntPoint(q));
+      }
+   }
+}
+
+void ElasticityIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement*>(&el),
+               "PA ElasticityIntegrator requires tensor-product elements");
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "ElasticityIntegrator requires vdim == sdim == dim");
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &GetRule(el, *fes.GetElementTransformation(0));
+   const int nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize((2 + dim*dim) * nq * ne, Device::GetDeviceMemoryType());
+
+   Vector lambda_coeff, mu_coeff;
+   PAElasticityEvalCoefficient(fes, *ir, *mu, mu_coeff);
+   if (lambda)
+   {
+      PAElasticityEvalCoefficient(fes, *ir, *lambda, lambda_coeff);
+   }
+   else
+   {
+      lambda_coeff = mu_coeff;
+      lambda_coeff *= q_lambda;
+      mu_coeff *= q_mu;
+   }
+
+   const Array<double> &w = ir->GetWeights();
+   if (dim == 2)
+   {
+      PAElasticitySetup<2>(nq, ne, w, geom->J, lambda_coeff, mu_coeff,
+                           pa_data);
+   }
+   else
+   {
+      PAElasticitySetup<3>(nq, ne, w, geom->J, lambda_coeff, mu_coeff,
+                           pa_data);
+   }
+}
+
+void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int D1D = dofs1D;
+   const int Q1D = quad1D;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   const Array<double> &Bt = maps->Bt;
+   const Array<double> &Gt = maps->Gt;
+   const Vector &D = pa_data;
+
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply2D<2,2>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x23: return PAElasticityApply2D<2,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x33: return PAElasticityApply2D<3,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x34: return PAElasticityApply2D<3,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x44: return PAElasticityApply2D<4,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x45: return PAElasticityApply2D<4,5>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x55: return PAElasticityApply2D<5,5>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x56: return PAElasticityApply2D<5,6>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply2D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply3D<2,2>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x23: return PAElasticityApply3D<2,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x33: return PAElasticityApply3D<3,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x34: return PAElasticityApply3D<3,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x44: return PAElasticityApply3D<4,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x45: return PAElasticityApply3D<4,5>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x55: return PAElasticityApply3D<5,5>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x56: return PAElasticityApply3D<5,6>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply3D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void ElasticityIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (ne == 0) { return; }
+   if (dim == 2)
+   {
+      return PAElasticityDiagonal2D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   if (dim == 3)
+   {
+      return PAElasticityDiagonal3D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   MFEM_ABORT("Dimension not implemented.");
+}
+
+} // namespace mfem
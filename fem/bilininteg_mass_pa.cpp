@@ -10,8 +10,11 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/jit.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "bilininteg_mass_kernels.hpp"
+#include "bilininteg_simd.hpp"
 #include "ceed/mass.hpp"
 
 using namespace std;
@@ -31,7 +34,14 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    // Assuming the same element type
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
+   DeletePABatches();
    if (mesh->GetNE() == 0) { return; }
+   if (!DeviceCanUseCeed() &&
+       (mesh->GetNumGeometries(mesh->Dimension()) > 1 || !UsesTensorBasis(fes)))
+   {
+      AssemblePABatches(fes);
+      return;
+   }
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation *T = mesh->GetElementTransformation(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
@@ -76,16 +86,10 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      QuadratureFunction qf(&qs);
+      Q->Project(qf);
+      coeff.Swap(qf);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -152,6 +156,70 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       });
    }
+   if (Device::Allows(Backend::SIMD_CPU))
+   {
+      Vector pa_simd;
+      internal::SimdPAInterleave(nq, ne, pa_data, pa_simd);
+      pa_data.Swap(pa_simd);
+   }
+}
+
+// PA Mass setup kernel for element batches: the quadrature points are not
+// assumed to have a tensor-product structure.
+static void PAMassSetupBatch(const int NQ,
+                             const int NE,
+                             const Array<double> &w,
+                             const Vector &detj,
+                             const Vector &c,
+                             Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   const auto W = w.Read();
+   const auto detJ = Reshape(detj.Read(), NQ, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto D = Reshape(d.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      const double coeff = const_c ? C(0,0) : C(q,e);
+      D(q,e) = W[q] * coeff * detJ(q,e);
+   });
+}
+
+void MassIntegrator::AssemblePABatches(const FiniteElementSpace &fes)
+{
+   const MemoryType mt = (pa_mt == MemoryType::DEFAULT) ?
+                         Device::GetDeviceMemoryType() : pa_mt;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = mesh->GetNE();
+   Array<Geometry::Type> geoms;
+   mesh->GetGeometries(dim, geoms);
+   MFEM_VERIFY(IntRule == NULL || geoms.Size() == 1,
+               "a single IntegrationRule can not be used on a mesh with"
+               " several element geometries");
+   for (int g = 0; g < geoms.Size(); g++)
+   {
+      PAElementBatch *batch = new PAElementBatch(fes, geoms[g]);
+      ElementTransformation &T =
+         *mesh->GetElementTransformation(batch->elems[0]);
+      const IntegrationRule *ir =
+         IntRule ? IntRule : &GetRule(*batch->fe, *batch->fe, T);
+      batch->Setup(*ir, GeometricFactors::DETERMINANTS, mt);
+      Vector coeff;
+      batch->EvalCoefficient(Q, coeff);
+      batch->pa_data.SetSize(batch->nq * batch->GetNE(), mt);
+      PAMassSetupBatch(batch->nq, batch->GetNE(), ir->GetWeights(),
+                       batch->geom->detJ, coeff, batch->pa_data);
+      pa_batches.Append(batch);
+   }
+}
+
+void MassIntegrator::DeletePABatches()
+{
+   for (int b = 0; b < pa_batches.Size(); b++) { delete pa_batches[b]; }
+   pa_batches.SetSize(0);
 }
 
 template<int T_D1D = 0, int T_Q1D = 0>
@@ -463,12 +531,63 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Mass diagonal kernel for element batches with general DofToQuad maps
+static void PAMassAssembleDiagonalBatch(const int NE,
+                                        const int ND,
+                                        const int NQ,
+                                        const Array<double> &b,
+                                        const Vector &d,
+                                        Vector &y)
+{
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double val = 0.0;
+      for (int q = 0; q < NQ; ++q)
+      {
+         val += B(q,dof) * B(q,dof) * D(q,e);
+      }
+      Y(dof,e) += val;
+   });
+}
+
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (DeviceCanUseCeed())
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (pa_batches.Size() > 0)
+   {
+      Vector diag_b;
+      for (int b = 0, offset = 0; b < pa_batches.Size(); b++)
+      {
+         const PAElementBatch &batch = *pa_batches[b];
+         diag_b.MakeRef(diag, offset, batch.GetESize());
+         if (batch.tensor)
+         {
+            PAMassAssembleDiagonal(dim, batch.maps->ndof, batch.maps->nqpt,
+                                   batch.GetNE(), batch.maps->B, batch.pa_data,
+                                   diag_b);
+         }
+         else
+         {
+            PAMassAssembleDiagonalBatch(batch.GetNE(), batch.nd, batch.nq,
+                                        batch.maps->B, batch.pa_data, diag_b);
+         }
+         offset += batch.GetESize();
+      }
+   }
+   else if (Device::Allows(Backend::SIMD_CPU))
+   {
+      Vector d(ne*nq);
+      internal::SimdPADeinterleave(nq, ne, pa_data, d);
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, d, diag);
+   }
    else
    {
       PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
@@ -582,81 +701,15 @@ static void PAMassApply2D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *Bt = bt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xy[max_Q1D][max_Q1D];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         double sol_x[max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            sol_x[qy] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] += B(qx,dx)* s;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double d2q = B(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] += d2q * sol_x[qx];
-            }
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] *= D(qx,qy,e);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double sol_x[max_D1D];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            sol_x[dx] = 0.0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double s = sol_xy[qy][qx];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] += Bt(dx,qx) * s;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double q2d = Bt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += q2d * sol_x[dx];
-            }
-         }
-      }
+      internal::PAMassApply2D_Element<T_D1D,T_Q1D>(e, NE, B, Bt, D, X, Y,
+                                                   d1d, q1d);
    });
 }
 
@@ -797,130 +850,15 @@ static void PAMassApply3D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *Bt = bt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double sol_xy[max_Q1D][max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double sol_x[max_Q1D];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] = 0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_x[qx] += B(qx,dx) * s;
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy = B(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xy[qy][qx] += wy * sol_x[qx];
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz = B(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
-               }
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] *= D(qx,qy,qz,e);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double sol_xy[max_D1D][max_D1D];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_xy[dy][dx] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            double sol_x[max_D1D];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double s = sol_xyz[qz][qy][qx];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_x[dx] += Bt(dx,qx) * s;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy = Bt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_xy[dy][dx] += wy * sol_x[dx];
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz = Bt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
-               }
-            }
-         }
-      }
+      internal::PAMassApply3D_Element<T_D1D,T_Q1D>(e, NE, B, Bt, D, X, Y,
+                                                   d1d, q1d);
    });
 }
 
@@ -1151,6 +1089,165 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+// Apply the PA mass operator to the groups of interleaved elements of the
+// 'simd-cpu' backend, see bilininteg_simd.hpp.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPAMassApply2D(const int NG,
+                              const double *B,
+                              const double *Bt,
+                              const internal::simd_pa_t *D,
+                              const internal::simd_pa_t *X,
+                              internal::simd_pa_t *Y,
+                              const int d1d = 0,
+                              const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PAMassApply2D_Element<T_D1D,T_Q1D>(g, NG, B, Bt, D, X, Y,
+                                                   d1d, q1d);
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void SimdPAMassApply3D(const int NG,
+                              const double *B,
+                              const double *Bt,
+                              const internal::simd_pa_t *D,
+                              const internal::simd_pa_t *X,
+                              internal::simd_pa_t *Y,
+                              const int d1d = 0,
+                              const int q1d = 0)
+{
+   for (int g = 0; g < NG; g++)
+   {
+      internal::PAMassApply3D_Element<T_D1D,T_Q1D>(g, NG, B, Bt, D, X, Y,
+                                                   d1d, q1d);
+   }
+}
+
+// The quadrature data d is interleaved by AssemblePA, the E-vectors x and y are
+// interleaved here, into the buffers xs and ys kept by the integrator.
+static void SimdPAMassApply(const int dim,
+                            const int D1D,
+                            const int Q1D,
+                            const int NE,
+                            const Array<double> &b,
+                            const Array<double> &bt,
+                            const Vector &d,
+                            const Vector &x,
+                            Vector &y,
+                            Vector &xs,
+                            Vector &ys)
+{
+   using internal::simd_pa_t;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = dim == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NG = internal::SimdPAGroups(NE);
+   internal::SimdPAInterleave(ND, NE, x, xs);
+   ys.SetSize(xs.Size(), MemoryType::HOST_64);
+   ys = 0.0;
+   const double *B = b.HostRead();
+   const double *Bt = bt.HostRead();
+   const simd_pa_t *D = reinterpret_cast<const simd_pa_t*>(d.HostRead());
+   const simd_pa_t *X = reinterpret_cast<const simd_pa_t*>(xs.HostRead());
+   simd_pa_t *Y = reinterpret_cast<simd_pa_t*>(ys.HostReadWrite());
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPAMassApply2D<2,2>(NG,B,Bt,D,X,Y); break;
+         case 0x23: SimdPAMassApply2D<2,3>(NG,B,Bt,D,X,Y); break;
+         case 0x24: SimdPAMassApply2D<2,4>(NG,B,Bt,D,X,Y); break;
+         case 0x33: SimdPAMassApply2D<3,3>(NG,B,Bt,D,X,Y); break;
+         case 0x34: SimdPAMassApply2D<3,4>(NG,B,Bt,D,X,Y); break;
+         case 0x35: SimdPAMassApply2D<3,5>(NG,B,Bt,D,X,Y); break;
+         case 0x44: SimdPAMassApply2D<4,4>(NG,B,Bt,D,X,Y); break;
+         case 0x45: SimdPAMassApply2D<4,5>(NG,B,Bt,D,X,Y); break;
+         case 0x46: SimdPAMassApply2D<4,6>(NG,B,Bt,D,X,Y); break;
+         case 0x55: SimdPAMassApply2D<5,5>(NG,B,Bt,D,X,Y); break;
+         case 0x56: SimdPAMassApply2D<5,6>(NG,B,Bt,D,X,Y); break;
+         case 0x57: SimdPAMassApply2D<5,7>(NG,B,Bt,D,X,Y); break;
+         case 0x66: SimdPAMassApply2D<6,6>(NG,B,Bt,D,X,Y); break;
+         case 0x67: SimdPAMassApply2D<6,7>(NG,B,Bt,D,X,Y); break;
+         case 0x68: SimdPAMassApply2D<6,8>(NG,B,Bt,D,X,Y); break;
+         default: SimdPAMassApply2D(NG,B,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPAMassApply3D<2,2>(NG,B,Bt,D,X,Y); break;
+         case 0x23: SimdPAMassApply3D<2,3>(NG,B,Bt,D,X,Y); break;
+         case 0x24: SimdPAMassApply3D<2,4>(NG,B,Bt,D,X,Y); break;
+         case 0x33: SimdPAMassApply3D<3,3>(NG,B,Bt,D,X,Y); break;
+         case 0x34: SimdPAMassApply3D<3,4>(NG,B,Bt,D,X,Y); break;
+         case 0x35: SimdPAMassApply3D<3,5>(NG,B,Bt,D,X,Y); break;
+         case 0x44: SimdPAMassApply3D<4,4>(NG,B,Bt,D,X,Y); break;
+         case 0x45: SimdPAMassApply3D<4,5>(NG,B,Bt,D,X,Y); break;
+         case 0x46: SimdPAMassApply3D<4,6>(NG,B,Bt,D,X,Y); break;
+         case 0x55: SimdPAMassApply3D<5,5>(NG,B,Bt,D,X,Y); break;
+         case 0x56: SimdPAMassApply3D<5,6>(NG,B,Bt,D,X,Y); break;
+         case 0x57: SimdPAMassApply3D<5,7>(NG,B,Bt,D,X,Y); break;
+         case 0x66: SimdPAMassApply3D<6,6>(NG,B,Bt,D,X,Y); break;
+         case 0x67: SimdPAMassApply3D<6,7>(NG,B,Bt,D,X,Y); break;
+         case 0x68: SimdPAMassApply3D<6,8>(NG,B,Bt,D,X,Y); break;
+         default: SimdPAMassApply3D(NG,B,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   internal::SimdPADeinterleave(ND, NE, ys, y, true);
+}
+
+#ifdef MFEM_USE_JIT
+// Apply the PA mass operator with the element kernel compiled at runtime for
+// the given D1D and Q1D. Returns false if the JIT kernel is not available.
+static bool JitPAMassApply(const int dim,
+                           const int D1D,
+                           const int Q1D,
+                           const int NE,
+                           const Array<double> &b,
+                           const Array<double> &bt,
+                           const Vector &d,
+                           const Vector &x,
+                           Vector &y)
+{
+   // The runtime compiled kernels are host functions
+   if (Device::Allows(Backend::DEVICE_MASK)) { return false; }
+   typedef void (*Kernel)(const int, const int, const double*, const double*,
+                          const double*, const double*, double*);
+   const Kernel kernel = (Kernel) jit::GetKernel(
+                            "fem/bilininteg_mass_kernels.hpp",
+                            dim == 2 ? "PAMassApply2D_Element" :
+                            "PAMassApply3D_Element", {D1D, Q1D},
+                            "const int e, const int NE, const double *b, "
+                            "const double *bt, const double *d, "
+                            "const double *x, double *y",
+                            "e, NE, b, bt, d, x, y");
+   if (!kernel) { return false; }
+   const double *B = b.HostRead();
+   const double *Bt = bt.HostRead();
+   const double *D = d.HostRead();
+   const double *X = x.HostRead();
+   double *Y = y.HostReadWrite();
+#ifdef MFEM_USE_OPENMP
+   // The elements are independent: thread them with the host OpenMP backends
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      OmpWrap(NE, [=](int e) { kernel(e, NE, B, Bt, D, X, Y); });
+      return true;
+   }
+#endif
+   for (int e = 0; e < NE; e++) { kernel(e, NE, B, Bt, D, X, Y); }
+   return true;
+}
+#endif // MFEM_USE_JIT
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1196,7 +1293,11 @@ static void PAMassApply(const int dim,
          case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
          case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
          case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(2,D1D,Q1D,NE,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    else if (dim == 3)
@@ -1218,25 +1319,177 @@ static void PAMassApply(const int dim,
          case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
          case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
          case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(3,D1D,Q1D,NE,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Mass apply kernel for element batches with general DofToQuad maps
+static void PAMassApplyBatch(const int NE,
+                             const int ND,
+                             const int NQ,
+                             const Array<double> &b,
+                             const Vector &d,
+                             const Vector &x,
+                             Vector &y)
+{
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double u = 0.0;
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            u += B(q,dof) * X(dof,e);
+         }
+         u *= D(q,e);
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            Y(dof,e) += B(q,dof) * u;
+         }
+      }
+   });
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (pa_batches.Size() > 0)
+   {
+      Vector x_b, y_b;
+      for (int b = 0, offset = 0; b < pa_batches.Size(); b++)
+      {
+         const PAElementBatch &batch = *pa_batches[b];
+         x_b.MakeRef(const_cast<Vector&>(x), offset, batch.GetESize());
+         y_b.MakeRef(y, offset, batch.GetESize());
+         if (batch.tensor)
+         {
+            PAMassApply(dim, batch.maps->ndof, batch.maps->nqpt, batch.GetNE(),
+                        batch.maps->B, batch.maps->Bt, batch.pa_data, x_b, y_b);
+         }
+         else
+         {
+            PAMassApplyBatch(batch.GetNE(), batch.nd, batch.nq, batch.maps->B,
+                             batch.pa_data, x_b, y_b);
+         }
+         offset += batch.GetESize();
+      }
+   }
+   else if (Device::Allows(Backend::SIMD_CPU))
+   {
+      SimdPAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y,
+                      pa_simd_x, pa_simd_y);
+   }
    else
    {
+      // E-vectors and quadrature data; B and B^T applied in each direction
+      MFEM_PERF_WORK(8.0*(x.Size() + 2.0*y.Size() + pa_data.Size()),
+                     4.0*dim*ne*pow(std::max(dofs1D, quad1D), dim+1));
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
    }
 }
 
+// PA Mass apply kernel for the NV E-vectors of x: the data of an element is
+// applied to all the vectors before moving to the next element.
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void PAMassApplyMany(const int NE,
+                            const int NV,
+                            const Array<double> &b_,
+                            const Array<double> &bt_,
+                            const Vector &d_,
+                            const Vector &x_,
+                            Vector &y_,
+                            const int d1d = 0,
+                            const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ESIZE = NE*(DIM == 2 ? D1D*D1D : D1D*D1D*D1D);
+   const double *B = b_.Read();
+   const double *Bt = bt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      for (int v = 0; v < NV; v++)
+      {
+         if (DIM == 2)
+         {
+            internal::PAMassApply2D_Element<T_D1D,T_Q1D>(
+               e, NE, B, Bt, D, X + v*ESIZE, Y + v*ESIZE, d1d, q1d);
+         }
+         else
+         {
+            internal::PAMassApply3D_Element<T_D1D,T_Q1D>(
+               e, NE, B, Bt, D, X + v*ESIZE, Y + v*ESIZE, d1d, q1d);
+         }
+      }
+   });
+}
+
+template<int DIM>
+static void PAMassApplyMany(const int D1D,
+                            const int Q1D,
+                            const int NE,
+                            const int NV,
+                            const Array<double> &B,
+                            const Array<double> &Bt,
+                            const Vector &D,
+                            const Vector &X,
+                            Vector &Y)
+{
+   switch ((D1D << 4) | Q1D)
+   {
+      case 0x22: return PAMassApplyMany<DIM,2,2>(NE,NV,B,Bt,D,X,Y);
+      case 0x23: return PAMassApplyMany<DIM,2,3>(NE,NV,B,Bt,D,X,Y);
+      case 0x33: return PAMassApplyMany<DIM,3,3>(NE,NV,B,Bt,D,X,Y);
+      case 0x34: return PAMassApplyMany<DIM,3,4>(NE,NV,B,Bt,D,X,Y);
+      case 0x44: return PAMassApplyMany<DIM,4,4>(NE,NV,B,Bt,D,X,Y);
+      case 0x45: return PAMassApplyMany<DIM,4,5>(NE,NV,B,Bt,D,X,Y);
+      case 0x55: return PAMassApplyMany<DIM,5,5>(NE,NV,B,Bt,D,X,Y);
+      case 0x56: return PAMassApplyMany<DIM,5,6>(NE,NV,B,Bt,D,X,Y);
+      default:
+         return PAMassApplyMany<DIM>(NE,NV,B,Bt,D,X,Y,D1D,Q1D);
+   }
+}
+
+void MassIntegrator::AddMultManyPA(const MultiVector &x, MultiVector &y) const
+{
+   if (DeviceCanUseCeed() || pa_batches.Size() > 0 ||
+       Device::Allows(Backend::SIMD_CPU) || (dim != 2 && dim != 3) ||
+       dofs1D > MAX_D1D || quad1D > MAX_Q1D)
+   {
+      BilinearFormIntegrator::AddMultManyPA(x, y);
+   }
+   else if (dim == 2)
+   {
+      PAMassApplyMany<2>(dofs1D, quad1D, ne, x.NumVectors(), maps->B,
+                         maps->Bt, pa_data, x, y);
+   }
+   else
+   {
+      PAMassApplyMany<3>(dofs1D, quad1D, ne, x.NumVectors(), maps->B,
+                         maps->Bt, pa_data, x, y);
+   }
+}
+
 void MassIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
    // Mass integrator is symmetric
@@ -0,0 +1,74 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bilininteg_simd.hpp"
+
+namespace mfem
+{
+
+namespace internal
+{
+
+void SimdPAInterleave(const int N, const int NE, const Vector &x,
+                      Vector &x_simd)
+{
+   MFEM_ASSERT(x.Size() == N*NE, "invalid input size");
+   const int L = SIMD_PA_LANES;
+   const int NG = SimdPAGroups(NE);
+   x_simd.SetSize(N*NG*L, MemoryType::HOST_64);
+   const double *X = x.HostRead();
+   double *XS = x_simd.HostWrite();
+   for (int g = 0; g < NG; g++)
+   {
+      for (int l = 0; l < L; l++)
+      {
+         const int e = g*L + l;
+         double *xs = XS + N*L*g + l;
+         if (e < NE)
+         {
+            const double *xe = X + N*e;
+            for (int i = 0; i < N; i++) { xs[L*i] = xe[i]; }
+         }
+         else
+         {
+            for (int i = 0; i < N; i++) { xs[L*i] = 0.0; }
+         }
+      }
+   }
+}
+
+void SimdPADeinterleave(const int N, const int NE, const Vector &x_simd,
+                        Vector &x, const bool add)
+{
+   MFEM_ASSERT(x.Size() == N*NE, "invalid output size");
+   MFEM_ASSERT(x_simd.Size() == N*SimdPAGroups(NE)*SIMD_PA_LANES,
+               "invalid input size");
+   const int L = SIMD_PA_LANES;
+   const double *XS = x_simd.HostRead();
+   double *X = add ? x.HostReadWrite() : x.HostWrite();
+   for (int e = 0; e < NE; e++)
+   {
+      const double *xs = XS + N*L*(e/L) + e%L;
+      double *xe = X + N*e;
+      if (add)
+      {
+         for (int i = 0; i < N; i++) { xe[i] += xs[L*i]; }
+      }
+      else
+      {
+         for (int i = 0; i < N; i++) { xe[i] = xs[L*i]; }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
@@ -0,0 +1,72 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_SIMD_HPP
+#define MFEM_BILININTEG_SIMD_HPP
+
+#include "../config/config.hpp"
+#include "../linalg/simd.hpp"
+#include "../linalg/vector.hpp"
+
+// Support for the 'simd-cpu' backend (Backend::SIMD_CPU), which applies the
+// partially assembled operators of the mass, diffusion and convection
+// integrators to groups of SIMD_PA_LANES elements at once. The element data of
+// a group is interleaved ("structure of arrays" layout): entry i of element e
+// is stored in lane e % SIMD_PA_LANES of the AutoSIMD value i of the group
+// e / SIMD_PA_LANES, so that the element kernels, instantiated with the type
+// simd_pa_t, process all the elements of a group with SIMD instructions.
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/** @brief Number of elements interleaved by the 'simd-cpu' backend.
+
+    When MFEM is built without MFEM_USE_SIMD, the generic AutoSIMD type is
+    used, with a width of MFEM_ALIGN_BYTES, and its vectorization is left to the
+    compiler. */
+#ifdef MFEM_USE_SIMD
+constexpr int SIMD_PA_LANES = MFEM_SIMD_BYTES/sizeof(double);
+#else
+constexpr int SIMD_PA_LANES = MFEM_ALIGN_BYTES/sizeof(double);
+#endif
+
+/// Value type of the interleaved element data of the 'simd-cpu' backend.
+typedef AutoSIMD<double,SIMD_PA_LANES,SIMD_PA_LANES*sizeof(double)> simd_pa_t;
+
+/// Return the number of element groups needed for @a NE elements.
+inline int SimdPAGroups(const int NE)
+{
+   return (NE + SIMD_PA_LANES - 1) / SIMD_PA_LANES;
+}
+
+/** @brief Interleave the @a NE blocks of @a N entries of @a x, e.g. the
+    E-vector or the quadrature data of an integrator, into @a x_simd.
+
+    The vector @a x_simd is resized to N*SimdPAGroups(NE)*SIMD_PA_LANES entries
+    in 64-byte aligned host memory. The lanes of the last group that do not
+    correspond to an element are set to zero. */
+void SimdPAInterleave(const int N, const int NE, const Vector &x,
+                      Vector &x_simd);
+
+/** @brief The inverse of SimdPAInterleave(): copy the interleaved @a x_simd
+    into the @a NE blocks of @a N entries of @a x, or add it to @a x if @a add
+    is true. */
+void SimdPADeinterleave(const int N, const int NE, const Vector &x_simd,
+                        Vector &x, const bool add = false);
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_SIMD_HPP
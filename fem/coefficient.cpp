@@ -12,6 +12,8 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +23,156 @@ namespace mfem
 
 using namespace std;
 
+// Compute the offsets of the mesh elements in a QuadratureFunction on qs.
+static void GetQuadratureOffsets(const QuadratureSpace &qs,
+                                 Array<int> &offsets)
+{
+   const int NE = qs.GetNE();
+   offsets.SetSize(NE + 1);
+   offsets[0] = 0;
+   for (int e = 0; e < NE; e++)
+   {
+      offsets[e+1] = offsets[e] + qs.GetElementIntRule(e).GetNPoints();
+   }
+}
+
+// Call f(i, x) for all points of the QuadratureSpace qs, where i is the index
+// of the point in a QuadratureFunction on qs and x holds its physical
+// coordinates. The coordinates are taken from the (cached) GeometricFactors of
+// the mesh, computed per element geometry on mixed meshes; geometries without
+// points in qs are skipped. Returns false, and does not call f, if the mesh has
+// no nodes.
+template <typename F>
+static bool ForEachQuadraturePoint(const QuadratureSpace &qs, F &&f)
+{
+   Mesh &mesh = *qs.GetMesh();
+   if (mesh.GetNE() == 0) { return true; }
+   if (!mesh.GetNodes()) { return false; }
+
+   const int sdim = mesh.SpaceDimension();
+   Array<int> offsets, elems;
+   GetQuadratureOffsets(qs, offsets);
+   Array<Geometry::Type> geoms;
+   mesh.GetGeometries(mesh.Dimension(), geoms);
+   Vector x(sdim);
+   for (int g = 0; g < geoms.Size(); g++)
+   {
+      mesh.GetGeometryElements(geoms[g], elems);
+      const IntegrationRule &ir = qs.GetElementIntRule(elems[0]);
+      if (ir.GetNPoints() == 0) { continue; }
+      const int flags = GeometricFactors::COORDINATES;
+      const GeometricFactors *geom = (geoms.Size() == 1) ?
+                                     mesh.GetGeometricFactors(ir, flags) :
+                                     mesh.GetGeometricFactors(ir, flags,
+                                                              geoms[g]);
+      const int NQ = ir.GetNPoints();
+      const int NE = elems.Size();
+      const auto X = Reshape(geom->X.HostRead(), NQ, sdim, NE);
+      for (int k = 0; k < NE; k++)
+      {
+         const int offset = offsets[elems[k]];
+         for (int q = 0; q < NQ; q++)
+         {
+            for (int d = 0; d < sdim; d++) { x(d) = X(q,d,k); }
+            f(offset + q, x);
+         }
+      }
+   }
+   return true;
+}
+
+// Multiply the values at all points of qf by the scalar coefficient Q.
+static void ScaleQuadratureFunction(Coefficient &Q, QuadratureFunction &qf)
+{
+   QuadratureFunction qQ(qf.GetSpace());
+   Q.Project(qQ);
+   const int vdim = qf.GetVDim();
+   const auto C = qQ.Read();
+   auto V = qf.ReadWrite();
+   MFEM_FORALL(i, qf.Size(), V[i] *= C[i/vdim];);
+}
+
+// Return true if the values of GridFunctions in fes at the points of qs can be
+// computed with a QuadratureInterpolator of fes; tensor is set to indicate
+// whether the interpolator uses tensor-product evaluation.
+static bool UseQuadratureInterpolator(const FiniteElementSpace &fes,
+                                      const QuadratureSpace &qs, bool &tensor)
+{
+   const Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   const int vdim = fes.GetVDim();
+   if (mesh != qs.GetMesh() || mesh->GetNE() == 0 || dim < 2 || dim > 3 ||
+       mesh->GetNumGeometries(dim) > 1 || fes.IsVariableOrder() ||
+       fes.GetNURBSext())
+   {
+      return false;
+   }
+   const FiniteElement *fe = fes.GetFE(0);
+   if (dynamic_cast<const ScalarFiniteElement*>(fe) == NULL) { return false; }
+   const int nd = fe->GetDof();
+   const int nq = qs.GetElementIntRule(0).GetNPoints();
+   tensor = UsesTensorBasis(fes);
+   if (tensor)
+   {
+      const int d1d = fe->GetOrder() + 1;
+      const int q1d = (int) floor(pow(nq, 1.0/dim) + 0.5);
+      const int max_1d = (dim == 2) ? MAX_D1D : 8;
+      return d1d <= max_1d && q1d <= max_1d;
+   }
+   typedef QuadratureInterpolator QI;
+   const int max_nd = (dim == 2) ? QI::MAX_ND2D : QI::MAX_ND3D;
+   const int max_nq = (dim == 2) ? QI::MAX_NQ2D : QI::MAX_NQ3D;
+   return nd <= max_nd && nq <= max_nq &&
+          (vdim == 1 || vdim == dim || (vdim == 3 && dim == 2));
+}
+
+// Interpolate the GridFunction gf at all points of qs; the values are returned
+// in q_val using the QVectorLayout::byVDIM layout.
+static void InterpolateGridFunction(const GridFunction &gf, bool tensor,
+                                    const QuadratureSpace &qs, Vector &q_val)
+{
+   const FiniteElementSpace &fes = *gf.FESpace();
+   const ElementDofOrdering ordering = tensor ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+   Vector e_vec(R->Height());
+   e_vec.UseDevice(true);
+   R->Mult(gf, e_vec);
+   // Not using fes.GetQuadratureInterpolator(qs): qs is often a temporary.
+   QuadratureInterpolator qi(fes, qs);
+   qi.SetOutputLayout(QVectorLayout::byVDIM);
+   qi.Values(e_vec, q_val);
+}
+
+void Coefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   Mesh &mesh = *qs.GetMesh();
+   double *Q = qf.HostWrite();
+   for (int e = 0, i = 0; e < mesh.GetNE(); e++)
+   {
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      if (ir.GetNPoints() == 0) { continue; }
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < ir.GetNPoints(); q++, i++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Q[i] = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   const double c = constant;
+   auto Q = qf.Write();
+   MFEM_FORALL(i, qf.Size(), Q[i] = c;);
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +180,31 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   const Mesh &mesh = *qs.GetMesh();
+   const int NE = mesh.GetNE();
+   Array<int> offsets, attr(NE);
+   GetQuadratureOffsets(qs, offsets);
+   for (int e = 0; e < NE; e++)
+   {
+      attr[e] = mesh.GetAttribute(e);
+      MFEM_VERIFY(attr[e] >= 1 && attr[e] <= constants.Size(),
+                  "element attribute " << attr[e] << " is out of range");
+   }
+   const auto O = offsets.Read();
+   const auto A = attr.Read();
+   const auto C = constants.Read();
+   auto Q = qf.Write();
+   MFEM_FORALL(e, NE,
+   {
+      const double c = C[A[e]-1];
+      for (int i = O[e]; i < O[e+1]; i++) { Q[i] = c; }
+   });
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +223,50 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   double *Q = qf.HostWrite();
+   const double t = GetTime();
+   const bool ok = ForEachQuadraturePoint(*qf.GetSpace(),
+                                          [&](int i, const Vector &x)
+   {
+      Q[i] = Function ? Function(x) : TDFunction(x, t);
+   });
+   if (!ok) { Coefficient::Project(qf); }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T, ip, Component);
 }
 
+void GridFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   const int vdim = GridF->FESpace()->GetVDim();
+   bool tensor;
+   if (!UseQuadratureInterpolator(*GridF->FESpace(), qs, tensor))
+   {
+      Coefficient::Project(qf);
+      return;
+   }
+   if (vdim == 1)
+   {
+      InterpolateGridFunction(*GridF, tensor, qs, qf);
+      return;
+   }
+   Vector q_val(vdim*qf.Size());
+   q_val.UseDevice(true);
+   InterpolateGridFunction(*GridF, tensor, qs, q_val);
+   const int c = Component - 1;
+   const auto V = q_val.Read();
+   auto Q = qf.Write();
+   MFEM_FORALL(i, qf.Size(), Q[i] = V[i*vdim + c];);
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -101,6 +316,37 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == vdim, "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   Mesh &mesh = *qs.GetMesh();
+   double *Q = qf.HostWrite();
+   Vector V;
+   for (int e = 0, i = 0; e < mesh.GetNE(); e++)
+   {
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      if (ir.GetNPoints() == 0) { continue; }
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < ir.GetNPoints(); q++, i++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         V.SetDataAndSize(Q + i*vdim, vdim);
+         Eval(V, T, ip);
+      }
+   }
+}
+
+void VectorConstantCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == vdim, "invalid QuadratureFunction vdim");
+   const int vd = vdim;
+   const auto C = vec.Read();
+   auto Q = qf.Write();
+   MFEM_FORALL(i, qf.Size(), Q[i] = C[i%vd];);
+}
+
 void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -124,6 +370,23 @@ void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    }
 }
 
+void VectorFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == vdim, "invalid QuadratureFunction vdim");
+   double *data = qf.HostWrite();
+   const double t = GetTime();
+   Vector V;
+   const bool ok = ForEachQuadraturePoint(*qf.GetSpace(),
+                                          [&](int i, const Vector &x)
+   {
+      V.SetDataAndSize(data + i*vdim, vdim);
+      if (Function) { Function(x, V); }
+      else { TDFunction(x, t, V); }
+   });
+   if (!ok) { VectorCoefficient::Project(qf); return; }
+   if (Q) { ScaleQuadratureFunction(*Q, qf); }
+}
+
 VectorArrayCoefficient::VectorArrayCoefficient (int dim)
    : VectorCoefficient(dim), Coeff(dim), ownCoeff(dim)
 {
@@ -183,6 +446,19 @@ void VectorGridFunctionCoefficient::Eval(
    GridFunc->GetVectorValues(T, ir, M);
 }
 
+void VectorGridFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == vdim, "invalid QuadratureFunction vdim");
+   bool tensor;
+   if (!UseQuadratureInterpolator(*GridFunc->FESpace(), *qf.GetSpace(),
+                                  tensor))
+   {
+      VectorCoefficient::Project(qf);
+      return;
+   }
+   InterpolateGridFunction(*GridFunc, tensor, *qf.GetSpace(), qf);
+}
+
 GradientGridFunctionCoefficient::GradientGridFunctionCoefficient (
    const GridFunction *gf)
    : VectorCoefficient((gf) ?
@@ -291,6 +567,48 @@ void VectorRestrictedCoefficient::Eval(
    }
 }
 
+void MatrixCoefficient::Project(QuadratureFunction &qf, bool transpose)
+{
+   MFEM_VERIFY(qf.GetVDim() == height*width,
+               "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   Mesh &mesh = *qs.GetMesh();
+   double *data = qf.HostWrite();
+   DenseMatrix M(height, width);
+   for (int e = 0, i = 0; e < mesh.GetNE(); e++)
+   {
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      if (ir.GetNPoints() == 0) { continue; }
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < ir.GetNPoints(); q++, i++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         M.SetSize(height, width);
+         Eval(M, T, ip);
+         if (transpose) { M.Transpose(); }
+         const double *Md = M.Data();
+         for (int k = 0; k < height*width; k++)
+         {
+            data[i*height*width + k] = Md[k];
+         }
+      }
+   }
+}
+
+void MatrixConstantCoefficient::Project(QuadratureFunction &qf,
+                                        bool transpose)
+{
+   MFEM_VERIFY(qf.GetVDim() == height*width,
+               "invalid QuadratureFunction vdim");
+   DenseMatrix M(mat);
+   if (transpose) { M.Transpose(); }
+   const int hw = height*width;
+   const auto C = M.Read();
+   auto Q = qf.Write();
+   MFEM_FORALL(i, qf.Size(), Q[i] = C[i%hw];);
+}
+
 void MatrixFunctionCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -371,6 +689,35 @@ void MatrixFunctionCoefficient::EvalSymmetric(Vector &K,
    }
 }
 
+void MatrixFunctionCoefficient::Project(QuadratureFunction &qf,
+                                        bool transpose)
+{
+   if (symmetric)
+   {
+      MatrixCoefficient::Project(qf, transpose);
+      return;
+   }
+   MFEM_VERIFY(qf.GetVDim() == height*width,
+               "invalid QuadratureFunction vdim");
+   const int hw = height*width;
+   double *data = qf.HostWrite();
+   const double t = GetTime();
+   DenseMatrix K(height, width);
+   const bool ok = ForEachQuadraturePoint(*qf.GetSpace(),
+                                          [&](int i, const Vector &x)
+   {
+      K.SetSize(height, width);
+      if (Function) { Function(x, K); }
+      else if (TDFunction) { TDFunction(x, t, K); }
+      else { K = mat; }
+      if (transpose) { K.Transpose(); }
+      const double *Kd = K.Data();
+      for (int k = 0; k < hw; k++) { data[i*hw + k] = Kd[k]; }
+   });
+   if (!ok) { MatrixCoefficient::Project(qf, transpose); return; }
+   if (Q) { ScaleQuadratureFunction(*Q, qf); }
+}
+
 void SymmetricMatrixFunctionCoefficient::Eval(DenseSymmetricMatrix &K,
                                               ElementTransformation &T,
                                               const IntegrationPoint &ip)
@@ -991,4 +1338,38 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction vdim");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   const QuadratureSpace &src_qs = *QuadF.GetSpace();
+   if (&qs == &src_qs)
+   {
+      qf = QuadF;
+      return;
+   }
+   MFEM_VERIFY(qs.GetMesh() == src_qs.GetMesh(), "incompatible meshes");
+   // Gather the values of QuadF in the elements where qf has points; the
+   // integration rules must be the same in these elements.
+   const int NE = qs.GetNE();
+   Array<int> offsets, src_offsets;
+   GetQuadratureOffsets(qs, offsets);
+   GetQuadratureOffsets(src_qs, src_offsets);
+   for (int e = 0; e < NE; e++)
+   {
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      MFEM_VERIFY(ir.GetNPoints() == 0 || &ir == &src_qs.GetElementIntRule(e),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+   }
+   const auto O = offsets.Read();
+   const auto SO = src_offsets.Read();
+   const auto S = QuadF.Read();
+   auto Q = qf.Write();
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = O[e]; i < O[e+1]; i++) { Q[i] = S[SO[e] + i - O[e]]; }
+   });
+}
+
 }
@@ -23,6 +23,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureFunction;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -70,6 +71,14 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all quadrature points of the
+       QuadratureFunction @a qf, which must have vector dimension 1. */
+   /** The base class implementation loops over the mesh elements on the host
+       and calls Eval() at every point. Derived classes override this method
+       with batched evaluations that do not construct ElementTransformation
+       objects; these run on the device when possible. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~Coefficient() { }
 };
 
@@ -87,6 +96,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Set all values of @a qf to the constant.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -123,6 +135,9 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// Evaluate the coefficient at all points of @a qf using the attributes.
+   virtual void Project(QuadratureFunction &qf);
 };
 
 /// A general function coefficient
@@ -166,6 +181,12 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the function at the physical coordinates of all points
+       of @a qf. */
+   /** The coordinates are obtained from the GeometricFactors of the mesh. The
+       function itself is called on the host. */
+   virtual void Project(QuadratureFunction &qf);
 };
 
 class GridFunction;
@@ -193,6 +214,10 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Interpolate the GridFunction at all points of @a qf using a
+       QuadratureInterpolator. */
+   virtual void Project(QuadratureFunction &qf);
 };
 
 
@@ -381,6 +406,12 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all quadrature points of the
+       QuadratureFunction @a qf, which must have vector dimension GetVDim(). */
+   /** The base class implementation loops over the mesh elements on the host
+       and calls Eval(); derived classes provide batched evaluations. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -400,6 +431,9 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip) { V = vec; }
 
+   /// Set the values at all points of @a qf to the constant vector.
+   virtual void Project(QuadratureFunction &qf);
+
    /// Return a reference to the constant vector in this class.
    const Vector& GetVec() { return vec; }
 };
@@ -438,6 +472,10 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** @brief Evaluate the function at the physical coordinates of all points
+       of @a qf, see FunctionCoefficient::Project(). */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
@@ -512,6 +550,10 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Interpolate the GridFunction at all points of @a qf using a
+       QuadratureInterpolator. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~VectorGridFunctionCoefficient() { }
 };
 
@@ -744,6 +786,15 @@ public:
                               const IntegrationPoint &ip)
    { mfem_error("MatrixCoefficient::EvalSymmetric"); }
 
+   /** @brief Evaluate the matrix coefficient at all quadrature points of the
+       QuadratureFunction @a qf, which must have vector dimension
+       GetHeight()*GetWidth(). */
+   /** The matrices are stored column-major at every point, or row-major if
+       @a transpose is true. The base class implementation loops over the mesh
+       elements on the host and calls Eval(); derived classes provide batched
+       evaluations. */
+   virtual void Project(QuadratureFunction &qf, bool transpose = false);
+
    virtual ~MatrixCoefficient() { }
 };
 
@@ -761,6 +812,9 @@ public:
    /// Evaluate the matrix coefficient at @a ip.
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationPoint &ip) { M = mat; }
+
+   /// Set the values at all points of @a qf to the constant matrix.
+   virtual void Project(QuadratureFunction &qf, bool transpose = false);
 };
 
 
@@ -826,6 +880,10 @@ public:
    virtual void EvalSymmetric(Vector &K, ElementTransformation &T,
                               const IntegrationPoint &ip);
 
+   /** @brief Evaluate the function at the physical coordinates of all points
+       of @a qf, see FunctionCoefficient::Project(). */
+   virtual void Project(QuadratureFunction &qf, bool transpose = false);
+
    virtual ~MatrixFunctionCoefficient() { }
 };
 
@@ -1658,8 +1716,6 @@ public:
 };
 ///@}
 
-class QuadratureFunction;
-
 /** @brief Vector quadrature function coefficient which requires that the
     quadrature rules used for this vector coefficient be the same as those that
     live within the supplied QuadratureFunction. */
@@ -1703,6 +1759,12 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the values of the QuadratureFunction at the points of
+       @a qf. */
+   /** In the elements where @a qf has points, its QuadratureSpace must use
+       the same IntegrationRule as the QuadratureFunction of the coefficient. */
+   virtual void Project(QuadratureFunction &qf);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
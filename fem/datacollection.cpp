@@ -158,6 +158,7 @@ void DataCollection::SetFormat(int fmt)
 #ifdef MFEM_USE_MPI
       case PARALLEL_FORMAT: break;
 #endif
+      case BINARY_FORMAT: break;
       default: MFEM_ABORT("unknown format: " << fmt);
    }
    format = fmt;
@@ -229,6 +230,12 @@ void DataCollection::SaveMesh()
    }
 
    std::string mesh_name = GetMeshFileName();
+   if (format == BINARY_FORMAT)
+   {
+      // ParMesh::SaveBinary() also writes the parallel data
+      mesh->SaveBinary(mesh_name, compression);
+      return;
+   }
    mfem::ofgzstream mesh_file(mesh_name, compression);
    mesh_file.precision(precision);
 #ifdef MFEM_USE_MPI
@@ -251,7 +258,8 @@ void DataCollection::SaveMesh()
 
 std::string DataCollection::GetMeshShortFileName() const
 {
-   return (serial || format == SERIAL_FORMAT) ? "mesh" : "pmesh";
+   return (serial || format == SERIAL_FORMAT || format == BINARY_FORMAT) ?
+          "mesh" : "pmesh";
 }
 
 std::string DataCollection::GetMeshFileName() const
@@ -277,6 +285,11 @@ const
 
 void DataCollection::SaveOneField(const FieldMapIterator &it)
 {
+   if (format == BINARY_FORMAT)
+   {
+      (it->second)->SaveBinary(GetFieldFileName(it->first), compression);
+      return;
+   }
    mfem::ofgzstream field_file(GetFieldFileName(it->first), compression);
 
    field_file.precision(precision);
@@ -501,7 +514,7 @@ void VisItDataCollection::Load(int cycle_)
                            to_padded_string(cycle, pad_digits_cycle) +
                            ".mfem_root";
    LoadVisItRootFile(root_name);
-   if (format != SERIAL_FORMAT || num_procs > 1)
+   if (!serial || num_procs > 1)
    {
 #ifndef MFEM_USE_MPI
       MFEM_WARNING("Cannot load parallel VisIt root file in serial.");
@@ -564,9 +577,37 @@ void VisItDataCollection::LoadVisItRootFile(const std::string& root_name)
 
 void VisItDataCollection::LoadMesh()
 {
-   // GetMeshFileName() uses 'serial', so we need to set it in advance.
-   serial = (format == SERIAL_FORMAT);
+   // GetMeshFileName() uses 'serial', which was set from the root file.
    std::string mesh_fname = GetMeshFileName();
+   if (format == BINARY_FORMAT)
+   {
+      std::ifstream test_file(mesh_fname.c_str());
+      if (!test_file)
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Unable to open mesh file: " << mesh_fname);
+         return;
+      }
+      BinaryContainerReader reader(mesh_fname);
+      if (serial)
+      {
+         mesh = new Mesh(reader, 1, 0, false);
+      }
+      else
+      {
+#ifdef MFEM_USE_MPI
+         mesh = new ParMesh(m_comm, reader);
+#else
+         error = READ_ERROR;
+         MFEM_WARNING("Reading parallel format in serial is not supported");
+         return;
+#endif
+      }
+      spatial_dim = mesh->SpaceDimension();
+      topo_dim = mesh->Dimension();
+      own_data = true;
+      return;
+   }
    named_ifgzstream file(mesh_fname);
    // TODO: in parallel, check for errors on all processors
    if (!file)
@@ -576,16 +617,14 @@ void VisItDataCollection::LoadMesh()
       return;
    }
    // TODO: 1) load parallel mesh on one processor
-   if (format == SERIAL_FORMAT)
+   if (serial)
    {
       mesh = new Mesh(file, 1, 0, false);
-      serial = true;
    }
    else
    {
 #ifdef MFEM_USE_MPI
       mesh = new ParMesh(m_comm, file);
-      serial = false;
 #else
       error = READ_ERROR;
       MFEM_WARNING("Reading parallel format in serial is not supported");
@@ -608,6 +647,30 @@ void VisItDataCollection::LoadFields()
         it != field_info_map.end(); ++it)
    {
       std::string fname = path_left + it->first + path_right;
+      if (format == BINARY_FORMAT && (it->second).association == "nodes")
+      {
+         std::ifstream test_file(fname.c_str());
+         if (!test_file)
+         {
+            error = READ_ERROR;
+            MFEM_WARNING("Unable to open field file: " << fname);
+            return;
+         }
+         BinaryContainerReader reader(fname);
+#ifdef MFEM_USE_MPI
+         if (!serial)
+         {
+            field_map.Register(
+               it->first,
+               new ParGridFunction(dynamic_cast<ParMesh*>(mesh), reader),
+               own_data);
+            continue;
+         }
+#endif
+         field_map.Register(it->first, new GridFunction(mesh, reader),
+                            own_data);
+         continue;
+      }
       mfem::ifgzstream file(fname);
       // TODO: in parallel, check for errors on all processors
       if (!file)
@@ -685,6 +748,9 @@ std::string VisItDataCollection::GetVisItRootString()
    main["time"] = picojson::value(time);
    main["time_step"] = picojson::value(time_step);
    main["domains"] = picojson::value(double(num_procs));
+   // Do the mesh files contain parallel data? (independent of the number of
+   // domains: a ParMesh on one rank is still written in parallel)
+   main["parallel"] = picojson::value(!serial && format != SERIAL_FORMAT);
    main["mesh"] = picojson::value(mesh);
    if (!field_info_map.empty())
    {
@@ -738,6 +804,16 @@ void VisItDataCollection::ParseVisItRootString(const std::string& json)
    {
       format = to_int(mesh.get("format").get<std::string>());
    }
+   if (main.contains("parallel"))
+   {
+      serial = !main.get("parallel").get<bool>();
+   }
+   else
+   {
+      // older root files, without the "parallel" entry
+      serial = (format == SERIAL_FORMAT) ||
+               (format == BINARY_FORMAT && num_procs == 1);
+   }
    spatial_dim = to_int(mesh.get("tags").get("spatial_dim").get<std::string>());
    topo_dim = to_int(mesh.get("tags").get("topo_dim").get<std::string>());
    visit_max_levels_of_detail =
@@ -149,9 +149,16 @@ public:
       SERIAL_FORMAT = 0, /**<
          MFEM's serial ascii format, using the methods Mesh::Print() /
          ParMesh::Print(), and GridFunction::Save() / ParGridFunction::Save().*/
-      PARALLEL_FORMAT = 1  /**<
+      PARALLEL_FORMAT = 1, /**<
          MFEM's parallel ascii format, using the methods ParMesh::ParPrint() and
          GridFunction::Save() / ParGridFunction::Save(). */
+      BINARY_FORMAT = 2    /**<
+         MFEM's binary container format, using the methods Mesh::SaveBinary() /
+         ParMesh::SaveBinary() and GridFunction::SaveBinary(). In parallel, each
+         rank writes and reads only its own files, so a collection has one
+         mesh file and one file per field for every rank; shared files are not
+         supported. The compression setting applies per data block.
+         QuadratureFunction%s are saved in ascii. */
    };
 
 protected:
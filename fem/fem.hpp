@@ -39,6 +39,7 @@
 #include "quadinterpolator.hpp"
 #include "quadinterpolator_face.hpp"
 #include "transfer.hpp"
+#include "transfermap.hpp"
 #include "fespacehierarchy.hpp"
 #include "multigrid.hpp"
 #include "ceed/algebraic.hpp"
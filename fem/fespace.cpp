@@ -174,6 +174,18 @@ int FiniteElementSpace::GetElementOrderImpl(int i) const
    return elem_order.Size() ? elem_order[i] : fec->GetOrder();
 }
 
+void FiniteElementSpace::GetElementCosts(Array<double> &costs) const
+{
+   costs.SetSize(GetNE());
+   for (int i = 0; i < GetNE(); i++)
+   {
+      const FiniteElement *fe = GetFE(i);
+      const IntegrationRule &ir =
+         IntRules.Get(fe->GetGeomType(), 2*fe->GetOrder());
+      costs[i] = double(fe->GetDof() * vdim) * ir.GetNPoints();
+   }
+}
+
 void FiniteElementSpace::GetVDofs(int vd, Array<int>& dofs, int ndofs) const
 {
    if (ndofs < 0) { ndofs = this->ndofs; }
@@ -1225,6 +1237,29 @@ const Operator *FiniteElementSpace::GetElementRestriction(
    return L2E_nat.Ptr();
 }
 
+const BatchedElementRestriction *
+FiniteElementSpace::GetBatchedElementRestriction(
+   ElementDofOrdering e_ordering) const
+{
+   OperatorHandle &L2E = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC) ?
+                         L2E_batch_lex : L2E_batch_nat;
+   if (L2E.Ptr() == NULL)
+   {
+      L2E.Reset(new BatchedElementRestriction(*this, e_ordering));
+   }
+   return static_cast<const BatchedElementRestriction*>(L2E.Ptr());
+}
+
+const BdrElementRestriction *FiniteElementSpace::GetBdrElementRestriction()
+const
+{
+   if (L2E_bdr.Ptr() == NULL)
+   {
+      L2E_bdr.Reset(new BdrElementRestriction(*this));
+   }
+   return static_cast<const BdrElementRestriction*>(L2E_bdr.Ptr());
+}
+
 const FaceRestriction *FiniteElementSpace::GetFaceRestriction(
    ElementDofOrdering e_ordering, FaceType type, L2FaceValues mul) const
 {
@@ -2774,6 +2809,9 @@ void FiniteElementSpace::Destroy()
    Th.Clear();
    L2E_nat.Clear();
    L2E_lex.Clear();
+   L2E_batch_nat.Clear();
+   L2E_batch_lex.Clear();
+   L2E_bdr.Clear();
    for (int i = 0; i < E2Q_array.Size(); i++)
    {
       delete E2Q_array[i];
@@ -3199,6 +3237,49 @@ void QuadratureSpace::Construct()
    element_offsets[num_elem] = size = offset;
 }
 
+QuadratureSpace::QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir)
+   : mesh(mesh_), order(ir.GetOrder())
+{
+   MFEM_VERIFY(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
+               "mixed meshes are not supported");
+   const int num_elem = mesh->GetNE();
+   element_offsets = new int[num_elem + 1];
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      int_rule[g] = NULL;
+   }
+   if (num_elem > 0)
+   {
+      int_rule[mesh->GetElementBaseGeometry(0)] = &ir;
+   }
+   for (int i = 0; i <= num_elem; i++)
+   {
+      element_offsets[i] = i*ir.GetNPoints();
+   }
+   size = element_offsets[num_elem];
+}
+
+QuadratureSpace::QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir,
+                                 Geometry::Type geom)
+   : mesh(mesh_), order(ir.GetOrder())
+{
+   static const IntegrationRule no_points;
+   const int num_elem = mesh->GetNE();
+   element_offsets = new int[num_elem + 1];
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      int_rule[g] = &no_points;
+   }
+   int_rule[geom] = &ir;
+   int offset = 0;
+   for (int i = 0; i < num_elem; i++)
+   {
+      element_offsets[i] = offset;
+      offset += int_rule[mesh->GetElementBaseGeometry(i)]->GetNPoints();
+   }
+   element_offsets[num_elem] = size = offset;
+}
+
 QuadratureSpace::QuadratureSpace(Mesh *mesh_, std::istream &in)
    : mesh(mesh_)
 {
@@ -152,6 +152,12 @@ protected:
 
    /// The element restriction operators, see GetElementRestriction().
    mutable OperatorHandle L2E_nat, L2E_lex;
+   /// The batched element restriction operators, see
+   /// GetBatchedElementRestriction().
+   mutable OperatorHandle L2E_batch_nat, L2E_batch_lex;
+   /// The boundary element restriction operator, see
+   /// GetBdrElementRestriction().
+   mutable OperatorHandle L2E_bdr;
    /// The face restriction operators, see GetFaceRestriction().
    using key_face = std::tuple<bool, ElementDofOrdering, FaceType, L2FaceValues>;
    struct key_hash
@@ -428,6 +434,14 @@ public:
    int GetMaxElementOrder() const
    { return IsVariableOrder() ? elem_order.Max() : fec->GetOrder(); }
 
+   /** @brief Estimate the relative computational cost of each element, e.g.
+       for load balancing with Mesh::GeneratePartitioning() or
+       ParMesh::Rebalance(). */
+   /** The cost of an element is its number of vector DOFs times the number of
+       points of the quadrature rule of order 2p, which grows quickly with the
+       order p in variable order spaces. */
+   void GetElementCosts(Array<double> &costs) const;
+
    /// Returns true if the space contains elements of varying polynomial orders.
    bool IsVariableOrder() const { return elem_order.Size(); }
 
@@ -487,6 +501,26 @@ public:
        The returned Operator is owned by the FiniteElementSpace. */
    const Operator *GetElementRestriction(ElementDofOrdering e_ordering) const;
 
+   /** @brief Return an Operator that converts L-vectors to E-vectors, with the
+       elements split into per-geometry batches.
+
+       Used by partial assembly on meshes with several element geometries, see
+       BatchedElementRestriction for the E-vector layout.
+
+       The returned Operator is owned by the FiniteElementSpace. */
+   const BatchedElementRestriction *GetBatchedElementRestriction(
+      ElementDofOrdering e_ordering) const;
+
+   /** @brief Return an Operator that converts L-vectors to boundary E-vectors,
+       using the native ordering of the boundary element dofs.
+
+       The boundary E-vector layout is ND x VDIM x NBE, where ND is the number
+       of dofs of the boundary elements. All the boundary elements are assumed
+       to have the same number of dofs.
+
+       The returned Operator is owned by the FiniteElementSpace. */
+   const BdrElementRestriction *GetBdrElementRestriction() const;
+
    /// Return an Operator that converts L-vectors to E-vectors on each face.
    virtual const FaceRestriction *GetFaceRestriction(
       ElementDofOrdering e_ordering, FaceType,
@@ -929,6 +963,20 @@ public:
    QuadratureSpace(Mesh *mesh_, int order_)
       : mesh(mesh_), order(order_) { Construct(); }
 
+   /** @brief Create a QuadratureSpace using the IntegrationRule @a ir in all
+       elements; the mesh must have a single element geometry. */
+   /** The rule @a ir is not copied and must remain valid. The order of the
+       space, used by Save(), is ir.GetOrder(). */
+   QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir);
+
+   /** @brief Create a QuadratureSpace using the IntegrationRule @a ir in the
+       elements with geometry @a geom and no points in all other elements. */
+   /** This is used to evaluate coefficients on the elements of a single
+       geometry of a mixed mesh. The rule @a ir is not copied and must remain
+       valid. */
+   QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir,
+                   Geometry::Type geom);
+
    /// Read a QuadratureSpace from the stream @a in.
    QuadratureSpace(Mesh *mesh_, std::istream &in);
 
@@ -964,6 +1012,27 @@ inline bool UsesTensorBasis(const FiniteElementSpace& fes)
    return dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
 }
 
+/** @brief Return true if the FE collection of @a fes returns a
+    TensorBasisElement for at least one element geometry of the local mesh.
+
+    On meshes with a single element geometry this is UsesTensorBasis(). It
+    selects the dof ordering of a BatchedElementRestriction, whose batches of
+    non tensor-product elements always use the native ordering. */
+inline bool UsesTensorBasisPerGeometry(const FiniteElementSpace& fes)
+{
+   const Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   if (mesh->GetNumGeometries(dim) <= 1) { return UsesTensorBasis(fes); }
+   Array<Geometry::Type> geoms;
+   mesh->GetGeometries(dim, geoms);
+   for (int i = 0; i < geoms.Size(); i++)
+   {
+      const FiniteElement *fe = fes.FEColl()->FiniteElementForGeometry(geoms[i]);
+      if (dynamic_cast<const mfem::TensorBasisElement *>(fe)) { return true; }
+   }
+   return false;
+}
+
 }
 
 #endif
@@ -14,6 +14,8 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
+#include "../mesh/point_locator.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -24,6 +26,7 @@
 #include <string>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 
 
@@ -73,6 +76,33 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
    fes_sequence = fes->GetSequence();
 }
 
+GridFunction::GridFunction(Mesh *m, const BinaryContainerReader &reader,
+                           const std::string &prefix, bool zero_copy)
+   : Vector()
+{
+   // Grid functions are stored on the device
+   UseDevice(true);
+
+   std::istringstream fes_input(reader.GetString(prefix + ".fes"));
+   fes = new FiniteElementSpace;
+   fec = fes->Load(m, fes_input);
+
+   size_t n;
+   const double *gf_data = reader.GetDoubles(prefix + ".data", n);
+   MFEM_VERIFY(n == (size_t) fes->GetVSize(),
+               "invalid size of block '" << prefix << ".data'");
+   if (zero_copy)
+   {
+      NewDataAndSize(const_cast<double*>(gf_data), n);
+   }
+   else
+   {
+      SetSize(n);
+      std::copy(gf_data, gf_data + n, HostWrite());
+   }
+   fes_sequence = fes->GetSequence();
+}
+
 GridFunction::GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces)
 {
    UseDevice(true);
@@ -661,6 +691,48 @@ void GridFunction::GetVectorValues(int i, const IntegrationRule &ir,
    GetVectorValues(*Tr, ir, vals);
 }
 
+int GridFunction::GetValues(const DenseMatrix &phys_pts, Vector &vals) const
+{
+   Mesh *mesh = fes->GetMesh();
+   const int vdim = VectorDim();
+   const int npts = phys_pts.Width();
+
+   // Use the elements found in the previous call as hints
+   if (point_elem_ids.Size() != npts)
+   {
+      point_elem_ids.SetSize(npts);
+      point_elem_ids = -1;
+   }
+   const Array<int> hints(point_elem_ids);
+   Array<IntegrationPoint> ips;
+   InverseElementTransformation inv_tr;
+   const int pts_found =
+      mesh->GetPointLocator().FindPoints(phys_pts, hints, point_elem_ids, ips,
+                                         inv_tr);
+
+   vals.SetSize(vdim*npts);
+   vals.HostWrite();
+   Vector val;
+   for (int j = 0; j < npts; j++)
+   {
+      const int e = point_elem_ids[j];
+      if (e < 0)
+      {
+         for (int c = 0; c < vdim; c++) { vals(c + vdim*j) = 0.0; }
+      }
+      else if (vdim == 1)
+      {
+         vals(j) = GetValue(e, ips[j]);
+      }
+      else
+      {
+         val.SetDataAndSize(vals.GetData() + vdim*j, vdim);
+         GetVectorValue(e, ips[j], val);
+      }
+   }
+   return pts_found;
+}
+
 void be_to_bfe(Geometry::Type geom, int o, const IntegrationPoint &ip,
                IntegrationPoint &fip)
 {
@@ -3506,6 +3578,22 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::AddBinaryBlocks(BinaryContainerWriter &writer,
+                                   const std::string &prefix) const
+{
+   std::ostringstream fes_output;
+   fes->Save(fes_output);
+   writer.AddString(prefix + ".fes", fes_output.str());
+   writer.AddBlock(prefix + ".data", HostRead(), Size());
+}
+
+void GridFunction::SaveBinary(const std::string &fname, bool compress) const
+{
+   BinaryContainerWriter writer(compress);
+   AddBinaryBlocks(writer);
+   writer.Save(fname);
+}
+
 void GridFunction::Save(const char *fname, int precision) const
 {
    ofstream ofs(fname);
@@ -46,6 +46,10 @@ protected:
        associated true-dof values - either owned or external. */
    Vector t_vec;
 
+   /// Elements containing the points of the last call to GetValues() with
+   /// physical points, used as search hints by the next call.
+   mutable Array<int> point_elem_ids;
+
    void SaveSTLTri(std::ostream &out, double p1[], double p2[], double p3[]);
 
    void GetVectorGradientHat(ElementTransformation &T, DenseMatrix &gh) const;
@@ -101,6 +105,17 @@ public:
        are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
+   /** @brief Construct a GridFunction on the given Mesh, using the blocks with
+       the given @a prefix of an MFEM binary container, see SaveBinary().
+
+       If @a zero_copy is true and the data block is not compressed, the
+       GridFunction data is a view of the memory mapping of the file: it is not
+       copied, but the @a reader must outlive the GridFunction. The
+       reconstructed FiniteElementSpace and FiniteElementCollection are owned by
+       the GridFunction. */
+   GridFunction(Mesh *m, const BinaryContainerReader &reader,
+                const std::string &prefix = "gf", bool zero_copy = false);
+
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
 
    /// Copy assignment. Only the data of the base class Vector is copied.
@@ -196,6 +211,27 @@ public:
                         DenseMatrix &vals, DenseMatrix &tr) const;
    ///@}
 
+   /** @brief Evaluate the GridFunction at the physical points given as the
+       columns of @a phys_pts (of size SpaceDimension x npts).
+
+       On return, @a vals has size VectorDim x npts, i.e. vals(c + vdim*j) is
+       the component c at point j. The values at the points that are not found
+       in the mesh are set to zero.
+
+       The elements containing the points are located with the spatial index of
+       the mesh, see Mesh::GetPointLocator(). The elements found are cached and
+       are used as the starting points of a walking search in the next call
+       with the same number of points, so that points that moved only a little
+       (e.g. sensors or particles between time steps) are located with a few
+       element transformation inversions.
+
+       @returns The number of points found. */
+   int GetValues(const DenseMatrix &phys_pts, Vector &vals) const;
+
+   /** @brief Return the elements containing the points of the last call to
+       GetValues(const DenseMatrix&, Vector&), -1 for points not found. */
+   const Array<int> &GetPointElements() const { return point_elem_ids; }
+
    /** @name ElementTransformation Get Value Methods
 
        These member functions are designed for use within
@@ -677,6 +713,17 @@ public:
    /// ASCII output.
    virtual void Save(const char *fname, int precision=16) const;
 
+   /** @brief Add the blocks describing the GridFunction, named with the given
+       @a prefix, to a binary container. The data is not copied, so the
+       GridFunction must not change before the container is saved. */
+   void AddBinaryBlocks(BinaryContainerWriter &writer,
+                        const std::string &prefix = "gf") const;
+
+   /** @brief Save the GridFunction to the file @a fname in the MFEM binary
+       container format, optionally compressed with zlib. */
+   virtual void SaveBinary(const std::string &fname,
+                           bool compress = false) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
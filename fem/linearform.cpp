@@ -24,13 +24,16 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   ext = NULL;
 
    // Copy the pointers to the integrators
    domain_integs = lf->domain_integs;
+   domain_integs_marker = lf->domain_integs_marker;
 
    domain_delta_integs = lf->domain_delta_integs;
 
    boundary_integs = lf->boundary_integs;
+   boundary_integs_marker = lf->boundary_integs_marker;
 
    boundary_face_integs = lf->boundary_face_integs;
    boundary_face_integs_marker = lf->boundary_face_integs_marker;
@@ -99,8 +102,28 @@ void LinearForm::AddInteriorFaceIntegrator(LinearFormIntegrator *lfi)
    interior_face_integs.Append(lfi);
 }
 
+void LinearForm::UseFastAssembly(bool use_fa)
+{
+   if (use_fa && ext == NULL)
+   {
+      ext = new LinearFormExtension(this);
+   }
+   else if (!use_fa)
+   {
+      delete ext;
+      ext = NULL;
+   }
+}
+
 void LinearForm::Assemble()
 {
+   if (ext && ext->SupportsDevice())
+   {
+      ext->Assemble();
+      AssembleDelta();
+      return;
+   }
+
    Array<int> vdofs;
    ElementTransformation *eltrans;
    Vector elemvect;
@@ -265,6 +288,13 @@ void LinearForm::Assemble()
    }
 }
 
+void LinearForm::Update()
+{
+   SetSize(fes->GetVSize());
+   ResetDeltaLocations();
+   if (ext) { ext->Update(); }
+}
+
 void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
 {
    MFEM_ASSERT(v.Size() >= v_offset + f->GetVSize(), "");
@@ -272,6 +302,7 @@ void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
    v.UseDevice(true);
    this->Vector::MakeRef(v, v_offset, fes->GetVSize());
    ResetDeltaLocations();
+   if (ext) { ext->Update(); }
 }
 
 void LinearForm::MakeRef(FiniteElementSpace *f, Vector &v, int v_offset)
@@ -335,6 +366,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
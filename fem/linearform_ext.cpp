@@ -0,0 +1,145 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class LinearFormExtension
+
+#include "fem.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *lf)
+   : lf(lf), elem_restrict(NULL), bdr_restrict(NULL)
+{
+   Update();
+}
+
+void LinearFormExtension::SetMarkers(const Array<int> &attr,
+                                     const Array<int> *attr_marker,
+                                     Array<int> &mark)
+{
+   const int n = attr.Size();
+   mark.SetSize(n);
+   if (attr_marker == NULL)
+   {
+      mark = 1;
+      return;
+   }
+   const int max_attr = attr_marker->Size();
+   const auto d_attr = attr.Read();
+   const auto d_attr_marker = attr_marker->Read();
+   auto d_mark = mark.Write();
+   MFEM_FORALL(i, n,
+   {
+      const int a = d_attr[i];
+      d_mark[i] = (a > 0 && a <= max_attr) ? d_attr_marker[a-1] : 0;
+   });
+}
+
+bool LinearFormExtension::SupportsDevice() const
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+
+   if (mesh.GetNE() == 0 || mesh.GetNumGeometries(dim) > 1) { return false; }
+   if (lf->GetFLFI()->Size() > 0 || lf->GetIFLFI()->Size() > 0)
+   {
+      return false;
+   }
+
+   const Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
+   for (int k = 0; k < domain_integs.Size(); k++)
+   {
+      if (!domain_integs[k]->SupportsDevice(fes)) { return false; }
+   }
+
+   const Array<LinearFormIntegrator*> &boundary_integs = *lf->GetBLFI();
+   if (boundary_integs.Size() > 0 && mesh.GetNBE() > 0)
+   {
+      if (dim == 1 || mesh.GetNumGeometries(dim-1) > 1) { return false; }
+      for (int k = 0; k < boundary_integs.Size(); k++)
+      {
+         if (!boundary_integs[k]->SupportsDevice(fes)) { return false; }
+      }
+   }
+   return true;
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   MFEM_VERIFY(lf->Size() == fes.GetVSize(), "LinearForm size does not "
+               "match the size of the FiniteElementSpace, call Update()");
+   MFEM_VERIFY(attributes.Size() == fes.GetNE(), "the FiniteElementSpace "
+               "was modified, call LinearForm::Update()");
+
+   const Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
+   const Array<Array<int>*> &domain_integs_marker = *lf->GetDLFI_Marker();
+   if (domain_integs.Size() > 0)
+   {
+      b.SetSize(elem_restrict->Height());
+      b.UseDevice(true);
+      b = 0.0;
+      for (int k = 0; k < domain_integs.Size(); k++)
+      {
+         SetMarkers(attributes, domain_integs_marker[k], markers);
+         domain_integs[k]->AssembleDevice(fes, markers, b);
+      }
+      elem_restrict->MultTranspose(b, *lf);
+   }
+   else
+   {
+      *lf = 0.0;
+   }
+
+   const Array<LinearFormIntegrator*> &boundary_integs = *lf->GetBLFI();
+   const Array<Array<int>*> &boundary_integs_marker = *lf->GetBLFI_Marker();
+   if (boundary_integs.Size() > 0 && fes.GetNBE() > 0)
+   {
+      if (bdr_restrict == NULL)
+      {
+         bdr_restrict = fes.GetBdrElementRestriction();
+      }
+      bdr_b.SetSize(bdr_restrict->Height());
+      bdr_b.UseDevice(true);
+      bdr_b = 0.0;
+      for (int k = 0; k < boundary_integs.Size(); k++)
+      {
+         SetMarkers(bdr_attributes, boundary_integs_marker[k], bdr_markers);
+         boundary_integs[k]->AssembleDevice(fes, bdr_markers, bdr_b);
+      }
+      bdr_restrict->AddMultTranspose(bdr_b, *lf);
+   }
+}
+
+void LinearFormExtension::Update()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const Mesh &mesh = *fes.GetMesh();
+
+   elem_restrict = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   bdr_restrict = NULL; // set on first use
+
+   attributes.SetSize(mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      attributes[i] = mesh.GetAttribute(i);
+   }
+   bdr_attributes.SetSize(mesh.GetNBE());
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      bdr_attributes[i] = mesh.GetBdrAttribute(i);
+   }
+}
+
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LINEARFORM_EXTENSION
+#define MFEM_LINEARFORM_EXTENSION
+
+#include "../config/config.hpp"
+#include "../linalg/vector.hpp"
+#include "../general/array.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+class Operator;
+class BdrElementRestriction;
+
+/** @brief Class extending the LinearForm class to support assembly on devices.
+
+    The domain integrators compute their element contributions in E-vector
+    layout with batched kernels, which are then added to the L-vector with
+    ElementRestriction::MultTranspose(). The boundary integrators use the
+    same approach with the boundary element restriction, see
+    FiniteElementSpace::GetBdrElementRestriction(). */
+class LinearFormExtension
+{
+protected:
+   /// Linear form from which this extension depends. Not owned.
+   LinearForm *lf;
+
+   /// Attributes of the mesh elements and boundary elements.
+   Array<int> attributes, bdr_attributes;
+
+   /// Element and boundary element markers, see AssembleDevice().
+   Array<int> markers, bdr_markers;
+
+   /// Operators converting L-vectors to (boundary) E-vectors. Not owned.
+   const Operator *elem_restrict;
+   const BdrElementRestriction *bdr_restrict;
+
+   /// Internal (boundary) E-vectors.
+   Vector b, bdr_b;
+
+   /// Set @a mark to the marker of @a attr defined by @a attr_marker.
+   static void SetMarkers(const Array<int> &attr, const Array<int> *attr_marker,
+                          Array<int> &mark);
+
+public:
+   /// Create a LinearForm extension of @a lf.
+   LinearFormExtension(LinearForm *lf);
+
+   /** @brief Return true if all the integrators of the linear form and the
+       associated FiniteElementSpace support the device assembly. */
+   bool SupportsDevice() const;
+
+   /// Assemble the linear form on the device.
+   void Assemble();
+
+   /// Update the data after a change of the FiniteElementSpace or Mesh.
+   void Update();
+};
+
+}
+
+#endif
@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -40,6 +42,22 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /// Method probing for device assembly support of the integrator.
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const
+   { return false; }
+
+   /** @brief Add the contributions of the integrator to the E-vector @a b,
+       using batched device kernels.
+
+       For domain integrators, @a b has layout (ND x VDIM x NE), the E-vector
+       layout of the native ElementRestriction of @a fes; for boundary
+       integrators, the layout is the one of the boundary element restriction,
+       see FiniteElementSpace::GetBdrElementRestriction(). Only the
+       (boundary) elements with a nonzero entry in @a markers are assembled. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    virtual void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -120,6 +138,12 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -146,6 +170,12 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -171,6 +201,12 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -233,6 +269,12 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -0,0 +1,145 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "fem.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+// Add the contributions of the marked boundary elements to the boundary
+// E-vector y. The Jacobians of the boundary elements are computed from the
+// boundary E-vector of the mesh nodes, x, of size NDX x SDIM x NBE.
+template<int DIMB>
+static void BoundaryLFAssemble(const int SDIM, const int NBE, const int ND,
+                               const int NDX, const int NQ,
+                               const Array<int> &markers,
+                               const Array<double> &b, const Array<double> &gx,
+                               const Array<double> &w, const Vector &x,
+                               const Vector &coeff, Vector &y)
+{
+   const bool cst = coeff.Size() == 1;
+   const auto M = markers.Read();
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto GX = Reshape(gx.Read(), NQ, DIMB, NDX);
+   const auto W = w.Read();
+   const auto X = Reshape(x.Read(), NDX, SDIM, NBE);
+   const auto C = Reshape(coeff.Read(), cst ? 1 : NQ, cst ? 1 : NBE);
+   auto Y = Reshape(y.ReadWrite(), ND, NBE);
+   MFEM_FORALL(e, NBE,
+   {
+      if (M[e] == 0) { return; }
+      for (int q = 0; q < NQ; q++)
+      {
+         // Metric tensor J^T J of the SDIM x DIMB Jacobian
+         double JtJ[DIMB*DIMB];
+         for (int k = 0; k < DIMB*DIMB; k++) { JtJ[k] = 0.0; }
+         for (int c = 0; c < SDIM; c++)
+         {
+            double Jc[DIMB];
+            for (int k = 0; k < DIMB; k++)
+            {
+               Jc[k] = 0.0;
+               for (int j = 0; j < NDX; j++) { Jc[k] += GX(q,k,j) * X(j,c,e); }
+            }
+            for (int k = 0; k < DIMB; k++)
+            {
+               for (int l = 0; l < DIMB; l++) { JtJ[k+l*DIMB] += Jc[k]*Jc[l]; }
+            }
+         }
+         const double detJ = (DIMB == 1) ? sqrt(JtJ[0]) :
+                             sqrt(JtJ[0]*JtJ[DIMB*DIMB-1] -
+                                  JtJ[DIMB/2]*JtJ[DIMB/2]);
+         const double val = W[q] * detJ * (cst ? C(0,0) : C(q,e));
+         for (int d = 0; d < ND; d++) { Y(d,e) += B(q,d) * val; }
+      }
+   });
+}
+
+bool BoundaryLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   const Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   if (mesh.GetNBE() == 0 || mesh.NURBSext) { return false; }
+   if (dim != 2 && dim != 3) { return false; }
+   if (mesh.GetNumGeometries(dim-1) > 1) { return false; }
+   if (fes.IsVariableOrder()) { return false; }
+   const FiniteElement *fe = fes.GetBE(0);
+   return fe && fe->GetRangeType() == FiniteElement::SCALAR &&
+          fe->GetMapType() == FiniteElement::VALUE &&
+          fes.GetVDim() == 1;
+}
+
+void BoundaryLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers,
+                                          Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   mesh.EnsureNodes();
+   const GridFunction &nodes = *mesh.GetNodes();
+   const FiniteElementSpace &nfes = *nodes.FESpace();
+   const int dim = mesh.Dimension();
+   const int sdim = mesh.SpaceDimension();
+   const int NBE = fes.GetNBE();
+
+   const FiniteElement &fe = *fes.GetBE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(fe.GetGeomType(),
+                                             oa * fe.GetOrder() + ob);
+   const DofToQuad &maps = fe.GetDofToQuad(*ir, DofToQuad::FULL);
+   const DofToQuad &nmaps = nfes.GetBE(0)->GetDofToQuad(*ir, DofToQuad::FULL);
+
+   const Operator *nodes_restrict = nfes.GetBdrElementRestriction();
+   Vector x(nodes_restrict->Height());
+   x.UseDevice(true);
+   nodes_restrict->Mult(nodes, x);
+
+   // Evaluate the coefficient on the host, unless it is constant
+   Vector coeff;
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      const int NQ = ir->GetNPoints();
+      const int *M = markers.HostRead();
+      coeff.SetSize(NQ*NBE);
+      auto C = Reshape(coeff.HostWrite(), NQ, NBE);
+      for (int e = 0; e < NBE; e++)
+      {
+         if (M[e] == 0) { continue; }
+         ElementTransformation &T = *mesh.GetBdrElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            C(q,e) = Q.Eval(T, ip);
+         }
+      }
+   }
+
+   if (dim == 2)
+   {
+      BoundaryLFAssemble<1>(sdim, NBE, maps.ndof, nmaps.ndof, maps.nqpt,
+                            markers, maps.B, nmaps.G, ir->GetWeights(), x,
+                            coeff, b);
+   }
+   else
+   {
+      BoundaryLFAssemble<2>(sdim, NBE, maps.ndof, nmaps.ndof, maps.nqpt,
+                            markers, maps.B, nmaps.G, ir->GetWeights(), x,
+                            coeff, b);
+   }
+}
+
+}
@@ -0,0 +1,241 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "fem.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+
+namespace mfem
+{
+
+// Check the restrictions common to the device assembly of the domain linear
+// form integrators: single element geometry, fixed order, scalar H1/L2 type
+// elements with VALUE map type, and same dimension of the mesh and of the
+// space.
+static bool DomainLFSupportsDevice(const FiniteElementSpace &fes,
+                                   const int vdim)
+{
+   const Mesh &mesh = *fes.GetMesh();
+   if (mesh.GetNE() == 0 || mesh.NURBSext) { return false; }
+   if (mesh.GetNumGeometries(mesh.Dimension()) > 1) { return false; }
+   if (mesh.Dimension() != mesh.SpaceDimension()) { return false; }
+   if (fes.IsVariableOrder()) { return false; }
+   const FiniteElement &fe = *fes.GetFE(0);
+   return fe.GetRangeType() == FiniteElement::SCALAR &&
+          fe.GetMapType() == FiniteElement::VALUE &&
+          fes.GetVDim() == vdim;
+}
+
+// Evaluate the scalar coefficient Q at the points of the integration rule in
+// all elements, with Coefficient::Project. A ConstantCoefficient results in a
+// vector of size 1.
+static void DomainLFEvalCoefficient(Coefficient &Q, Mesh &mesh,
+                                    const IntegrationRule &ir, Vector &coeff)
+{
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction qf(&qs);
+   Q.Project(qf);
+   coeff.Swap(qf);
+}
+
+// Evaluate the vector coefficient Q at the points of the integration rule in
+// all elements, with VectorCoefficient::Project. A VectorConstantCoefficient
+// results in a vector of size Q.GetVDim().
+static void DomainLFEvalCoefficient(VectorCoefficient &Q, Mesh &mesh,
+                                    const IntegrationRule &ir, Vector &coeff)
+{
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+      return;
+   }
+   QuadratureSpace qs(&mesh, ir);
+   QuadratureFunction qf(&qs, Q.GetVDim());
+   Q.Project(qf);
+   coeff.Swap(qf);
+}
+
+// Add the contributions of the marked elements to the E-vector y. The
+// coefficient is either constant, of size vdim, or given at all the
+// quadrature points, of size vdim x NQ x NE.
+static void DomainLFAssemble(const int vdim, const int NE, const int ND,
+                             const int NQ, const Array<int> &markers,
+                             const Array<double> &b, const Array<double> &w,
+                             const Vector &detJ, const Vector &coeff,
+                             Vector &y)
+{
+   const bool cst = coeff.Size() == vdim;
+   const auto M = markers.Read();
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto W = w.Read();
+   const auto DETJ = Reshape(detJ.Read(), NQ, NE);
+   const auto C = Reshape(coeff.Read(), vdim, cst ? 1 : NQ, cst ? 1 : NE);
+   auto Y = Reshape(y.ReadWrite(), ND, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      if (M[e] == 0) { return; }
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int d = 0; d < ND; d++)
+         {
+            double s = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               const double f = cst ? C(c,0,0) : C(c,q,e);
+               s += B(q,d) * W[q] * DETJ(q,e) * f;
+            }
+            Y(d,c,e) += s;
+         }
+      }
+   });
+}
+
+// Add the contributions of the marked elements to the E-vector y for the
+// integrand (Q, grad v). With grad v = J^{-T} of the reference gradient, the
+// quadrature point data is w det(J) J^{-1} Q = w adj(J) Q.
+template<int DIM>
+static void DomainLFGradAssemble(const int NE, const int ND, const int NQ,
+                                 const Array<int> &markers,
+                                 const Array<double> &g, const Array<double> &w,
+                                 const Vector &j, const Vector &coeff,
+                                 Vector &y)
+{
+   const bool cst = coeff.Size() == DIM;
+   const auto M = markers.Read();
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto W = w.Read();
+   const auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   const auto C = Reshape(coeff.Read(), DIM, cst ? 1 : NQ, cst ? 1 : NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      if (M[e] == 0) { return; }
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jq[DIM*DIM], A[DIM*DIM], u[DIM];
+         for (int k = 0; k < DIM; k++)
+         {
+            for (int i = 0; i < DIM; i++) { Jq[i+k*DIM] = J(q,i,k,e); }
+         }
+         kernels::CalcAdjugate<DIM>(Jq, A);
+         for (int k = 0; k < DIM; k++)
+         {
+            u[k] = 0.0;
+            for (int i = 0; i < DIM; i++)
+            {
+               u[k] += A[k+i*DIM] * (cst ? C(i,0,0) : C(i,q,e));
+            }
+            u[k] *= W[q];
+         }
+         for (int d = 0; d < ND; d++)
+         {
+            double s = 0.0;
+            for (int k = 0; k < DIM; k++) { s += G(q,k,d) * u[k]; }
+            Y(d,e) += s;
+         }
+      }
+   });
+}
+
+bool DomainLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   return DomainLFSupportsDevice(fes, 1);
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        const Array<int> &markers,
+                                        Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const FiniteElement &fe = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(fe.GetGeomType(),
+                                             oa * fe.GetOrder() + ob);
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS);
+   const DofToQuad &maps = fe.GetDofToQuad(*ir, DofToQuad::FULL);
+
+   Vector coeff;
+   DomainLFEvalCoefficient(Q, mesh, *ir, coeff);
+   DomainLFAssemble(1, mesh.GetNE(), maps.ndof, maps.nqpt, markers, maps.B,
+                    ir->GetWeights(), geom->detJ, coeff, b);
+}
+
+bool VectorDomainLFIntegrator::SupportsDevice(const FiniteElementSpace &fes)
+const
+{
+   return DomainLFSupportsDevice(fes, Q.GetVDim());
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              const Array<int> &markers,
+                                              Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const FiniteElement &fe = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(fe.GetGeomType(),
+                                             2 * fe.GetOrder());
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS);
+   const DofToQuad &maps = fe.GetDofToQuad(*ir, DofToQuad::FULL);
+
+   Vector coeff;
+   DomainLFEvalCoefficient(Q, mesh, *ir, coeff);
+   DomainLFAssemble(Q.GetVDim(), mesh.GetNE(), maps.ndof, maps.nqpt, markers,
+                    maps.B, ir->GetWeights(), geom->detJ, coeff, b);
+}
+
+bool DomainLFGradIntegrator::SupportsDevice(const FiniteElementSpace &fes)
+const
+{
+   const int dim = fes.GetMesh()->Dimension();
+   return (dim == 2 || dim == 3) && Q.GetVDim() == dim &&
+          DomainLFSupportsDevice(fes, 1);
+}
+
+void DomainLFGradIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                            const Array<int> &markers,
+                                            Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   const FiniteElement &fe = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(fe.GetGeomType(),
+                                             2 * fe.GetOrder());
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   const DofToQuad &maps = fe.GetDofToQuad(*ir, DofToQuad::FULL);
+
+   Vector coeff;
+   DomainLFEvalCoefficient(Q, mesh, *ir, coeff);
+   const int NE = mesh.GetNE();
+   if (dim == 2)
+   {
+      DomainLFGradAssemble<2>(NE, maps.ndof, maps.nqpt, markers, maps.G,
+                              ir->GetWeights(), geom->J, coeff, b);
+   }
+   else
+   {
+      DomainLFGradAssemble<3>(NE, maps.ndof, maps.nqpt, markers, maps.G,
+                              ir->GetWeights(), geom->J, coeff, b);
+   }
+}
+
+}
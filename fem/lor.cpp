@@ -74,6 +74,13 @@ int LORBase::GetLOROrder() const
    return (type == L2 || type == RT) ? 0 : 1;
 }
 
+int LORBase::GetRefinementFactor() const
+{
+   int order = fes_ho.GetMaxElementOrder();
+   if (GetFESpaceType() == L2) { ++order; }
+   return order;
+}
+
 void LORBase::ConstructLocalDofPermutation(Array<int> &perm_) const
 {
    FESpaceType type = GetFESpaceType();
@@ -87,7 +94,7 @@ void LORBase::ConstructLocalDofPermutation(Array<int> &perm_) const
       return tfe->GetDofMap();
    };
 
-   FiniteElementSpace &fes_lor = *fes;
+   FiniteElementSpace &fes_lor = GetFESpace();
    Mesh &mesh_lor = *fes_lor.GetMesh();
    int dim = mesh_lor.Dimension();
    const CoarseFineTransformations &cf_tr = mesh_lor.GetRefinementTransforms();
@@ -180,11 +187,10 @@ void LORBase::ConstructLocalDofPermutation(Array<int> &perm_) const
 
 void LORBase::ConstructDofPermutation() const
 {
-   FESpaceType type = GetFESpaceType();
-   if (type == H1 || type == L2 || nonconforming)
+   if (!RequiresDofPermutation())
    {
       // H1 and L2: no permutation necessary, return identity
-      perm.SetSize(fes->GetTrueVSize());
+      perm.SetSize(fes_ho.GetTrueVSize());
       for (int i=0; i<perm.Size(); ++i) { perm[i] = i; }
       return;
    }
@@ -192,7 +198,8 @@ void LORBase::ConstructDofPermutation() const
 #ifdef MFEM_USE_MPI
    ParFiniteElementSpace *pfes_ho
       = dynamic_cast<ParFiniteElementSpace*>(&fes_ho);
-   ParFiniteElementSpace *pfes_lor = dynamic_cast<ParFiniteElementSpace*>(fes);
+   ParFiniteElementSpace *pfes_lor =
+      dynamic_cast<ParFiniteElementSpace*>(&GetFESpace());
    if (pfes_ho && pfes_lor)
    {
       Array<int> l_perm;
@@ -232,14 +239,113 @@ bool LORBase::RequiresDofPermutation() const
    return (type == H1 || type == L2 || nonconforming) ? false : true;
 }
 
+FiniteElementSpace &LORBase::GetFESpace() const
+{
+   if (fes == NULL) { FormLORSpace(); }
+   return *fes;
+}
+
 const OperatorHandle &LORBase::GetAssembledSystem() const
 {
-   MFEM_VERIFY(a != NULL && A.Ptr() != NULL, "No LOR system assembled");
+   MFEM_VERIFY(A.Ptr() != NULL, "No LOR system assembled");
    return A;
 }
 
+void LORBase::GetLOREssentialDofs(const Array<int> &ess_dofs,
+                                  Array<int> &ess_dofs_lor) const
+{
+   if (!RequiresDofPermutation())
+   {
+      ess_dofs_lor.MakeRef(ess_dofs);
+      return;
+   }
+   const Array<int> &p = GetDofPermutation();
+   // Form inverse permutation: given high-order dof i, pi[i] is corresp. LO
+   Array<int> pi(p.Size());
+   for (int i=0; i<p.Size(); ++i)
+   {
+      pi[absdof(p[i])] = i;
+   }
+   ess_dofs_lor.SetSize(ess_dofs.Size());
+   for (int i=0; i<ess_dofs.Size(); ++i)
+   {
+      ess_dofs_lor[i] = pi[ess_dofs[i]];
+   }
+}
+
 void LORBase::AssembleSystem(BilinearForm &a_ho, const Array<int> &ess_dofs)
 {
+   if (!SupportsBatchedAssembly(a_ho))
+   {
+      LegacyAssembleSystem(a_ho, ess_dofs);
+      return;
+   }
+
+   // The LOR and high-order DOFs coincide for H1. The ND and RT matrices are
+   // assembled in the local DOF numbering of the LOR space.
+   if (!RequiresDofPermutation())
+   {
+      FormAssembledSystem(fes_ho, AssembleBatched(a_ho), ess_dofs);
+      return;
+   }
+   Array<int> ldof_perm, ess_dofs_lor;
+   ConstructLocalDofPermutation(ldof_perm);
+   GetLOREssentialDofs(ess_dofs, ess_dofs_lor);
+   FormAssembledSystem(GetFESpace(), AssembleBatched(a_ho, &ldof_perm),
+                       ess_dofs_lor);
+}
+
+void LORBase::FormAssembledSystem(FiniteElementSpace &space,
+                                  SparseMatrix *A_local,
+                                  const Array<int> &ess_dofs)
+{
+#ifdef MFEM_USE_MPI
+   if (A.Type() == Operator::Hypre_ParCSR)
+   {
+      ParFiniteElementSpace &pspace =
+         static_cast<ParFiniteElementSpace&>(space);
+      {
+         OperatorHandle dA(A.Type()), Ph(A.Type());
+         dA.MakeSquareBlockDiag(pspace.GetComm(), pspace.GlobalVSize(),
+                                pspace.GetDofOffsets(), A_local);
+         Ph.ConvertFrom(pspace.Dof_TrueDof_Matrix());
+         A.MakePtAP(dA, Ph);
+      }
+      delete A_local;
+      OperatorHandle A_e(A.Type());
+      A_e.EliminateRowsCols(A, ess_dofs);
+      return;
+   }
+#endif
+   const SparseMatrix *P = space.GetConformingProlongation();
+   if (P)
+   {
+      SparseMatrix *A_t = RAP(*P, *A_local, *P);
+      delete A_local;
+      A_local = A_t;
+   }
+   for (int i=0; i<ess_dofs.Size(); ++i)
+   {
+      A_local->EliminateRowCol(ess_dofs[i], Operator::DIAG_KEEP);
+   }
+   A.Reset(A_local);
+}
+
+void LORBase::LegacyAssembleSystem(BilinearForm &a_ho,
+                                   const Array<int> &ess_dofs)
+{
+   if (a == NULL)
+   {
+#ifdef MFEM_USE_MPI
+      ParFiniteElementSpace *pfes =
+         dynamic_cast<ParFiniteElementSpace*>(&GetFESpace());
+      if (pfes) { a = new ParBilinearForm(pfes); }
+      else
+#endif
+      {
+         a = new BilinearForm(&GetFESpace());
+      }
+   }
    a->UseExternalIntegrators();
    AddIntegrators(a_ho, *a, &BilinearForm::GetDBFI,
                   &BilinearForm::AddDomainIntegrator, ir_el);
@@ -252,33 +358,16 @@ void LORBase::AssembleSystem(BilinearForm &a_ho, const Array<int> &ess_dofs)
                             &BilinearForm::GetBFBFI_Marker,
                             &BilinearForm::AddBdrFaceIntegrator, ir_face);
    a->Assemble();
-   if (RequiresDofPermutation())
-   {
-      const Array<int> &p = GetDofPermutation();
-      // Form inverse permutation: given high-order dof i, pi[i] is corresp. LO
-      Array<int> pi(p.Size());
-      for (int i=0; i<p.Size(); ++i)
-      {
-         pi[absdof(p[i])] = i;
-      }
-      Array<int> ess_dofs_perm(ess_dofs.Size());
-      for (int i=0; i<ess_dofs.Size(); ++i)
-      {
-         ess_dofs_perm[i] = pi[ess_dofs[i]];
-      }
-      a->FormSystemMatrix(ess_dofs_perm, A);
-   }
-   else
-   {
-      a->FormSystemMatrix(ess_dofs, A);
-   }
+   Array<int> ess_dofs_lor;
+   GetLOREssentialDofs(ess_dofs, ess_dofs_lor);
+   a->FormSystemMatrix(ess_dofs_lor, A);
    ResetIntegrationRules(&BilinearForm::GetDBFI);
    ResetIntegrationRules(&BilinearForm::GetFBFI);
    ResetIntegrationRules(&BilinearForm::GetBBFI);
    ResetIntegrationRules(&BilinearForm::GetBFBFI);
 }
 
-void LORBase::SetupNonconforming()
+void LORBase::SetupNonconforming() const
 {
    if (RequiresDofPermutation())
    {
@@ -290,7 +379,6 @@ void LORBase::SetupNonconforming()
    {
       fes->CopyProlongationAndRestriction(fes_ho, NULL);
    }
-   nonconforming = true;
 }
 
 template <typename FEC>
@@ -340,8 +428,10 @@ void CheckBasisType(const FiniteElementSpace &fes)
    // L2 is a bit more complicated, for now don't verify basis type
 }
 
-LORBase::LORBase(FiniteElementSpace &fes_ho_)
-   : irs(0, Quadrature1D::GaussLobatto), fes_ho(fes_ho_)
+LORBase::LORBase(FiniteElementSpace &fes_ho_, int ref_type_)
+   : irs(0, Quadrature1D::GaussLobatto), fes_ho(fes_ho_), ref_type(ref_type_),
+     mesh(NULL), fec(NULL), fes(NULL), a(NULL),
+     nonconforming(fes_ho_.Nonconforming())
 {
    Mesh &mesh_ = *fes_ho_.GetMesh();
    int dim = mesh_.Dimension();
@@ -357,7 +447,6 @@ LORBase::LORBase(FiniteElementSpace &fes_ho_)
       ir_el = NULL;
       ir_face = NULL;
    }
-   a = NULL;
 }
 
 LORBase::~LORBase()
@@ -373,12 +462,11 @@ LORDiscretization::LORDiscretization(BilinearForm &a_ho_,
                                      int ref_type)
    : LORDiscretization(*a_ho_.FESpace(), ref_type)
 {
-   a = new BilinearForm(fes);
    AssembleSystem(a_ho_, ess_tdof_list);
 }
 
 LORDiscretization::LORDiscretization(FiniteElementSpace &fes_ho,
-                                     int ref_type) : LORBase(fes_ho)
+                                     int ref_type) : LORBase(fes_ho, ref_type)
 {
    CheckBasisType(fes_ho);
 
@@ -386,22 +474,22 @@ LORDiscretization::LORDiscretization(FiniteElementSpace &fes_ho,
    MFEM_VERIFY(!fes_ho.IsVariableOrder(),
                "Cannot construct LOR operators on variable-order spaces");
 
-   int order = fes_ho.GetMaxElementOrder();
-   if (GetFESpaceType() == L2) { ++order; }
+   A.SetType(Operator::MFEM_SPARSEMAT);
+}
 
+void LORDiscretization::FormLORSpace() const
+{
    Mesh &mesh_ho = *fes_ho.GetMesh();
-   mesh = new Mesh(Mesh::MakeRefined(mesh_ho, order, ref_type));
+   mesh = new Mesh(Mesh::MakeRefined(mesh_ho, GetRefinementFactor(), ref_type));
 
    fec = fes_ho.FEColl()->Clone(GetLOROrder());
    fes = new FiniteElementSpace(mesh, fec);
-   if (fes_ho.Nonconforming()) { SetupNonconforming(); }
-
-   A.SetType(Operator::MFEM_SPARSEMAT);
+   if (nonconforming) { SetupNonconforming(); }
 }
 
 SparseMatrix &LORDiscretization::GetAssembledMatrix() const
 {
-   MFEM_VERIFY(a != NULL && A.Ptr() != NULL, "No LOR system assembled");
+   MFEM_VERIFY(A.Ptr() != NULL, "No LOR system assembled");
    return *A.As<SparseMatrix>();
 }
 
@@ -412,42 +500,43 @@ ParLORDiscretization::ParLORDiscretization(ParBilinearForm &a_ho_,
                                            int ref_type)
    : ParLORDiscretization(*a_ho_.ParFESpace(), ref_type)
 {
-   a = new ParBilinearForm(static_cast<ParFiniteElementSpace*>(fes));
    AssembleSystem(a_ho_, ess_tdof_list);
 }
 
 ParLORDiscretization::ParLORDiscretization(ParFiniteElementSpace &fes_ho,
-                                           int ref_type) : LORBase(fes_ho)
+                                           int ref_type)
+   : LORBase(fes_ho, ref_type)
 {
    if (fes_ho.GetMyRank() == 0) { CheckBasisType(fes_ho); }
    // TODO: support variable-order spaces
    MFEM_VERIFY(!fes_ho.IsVariableOrder(),
                "Cannot construct LOR operators on variable-order spaces");
 
-   int order = fes_ho.GetMaxElementOrder();
-   if (GetFESpaceType() == L2) { ++order; }
+   A.SetType(Operator::Hypre_ParCSR);
+}
 
-   ParMesh &mesh_ho = *fes_ho.GetParMesh();
-   ParMesh *pmesh = new ParMesh(ParMesh::MakeRefined(mesh_ho, order, ref_type));
+void ParLORDiscretization::FormLORSpace() const
+{
+   ParMesh &mesh_ho = *static_cast<ParFiniteElementSpace&>(fes_ho).GetParMesh();
+   ParMesh *pmesh = new ParMesh(
+      ParMesh::MakeRefined(mesh_ho, GetRefinementFactor(), ref_type));
    mesh = pmesh;
 
    fec = fes_ho.FEColl()->Clone(GetLOROrder());
    ParFiniteElementSpace *pfes = new ParFiniteElementSpace(pmesh, fec);
    fes = pfes;
-   if (fes_ho.Nonconforming()) { SetupNonconforming(); }
-
-   A.SetType(Operator::Hypre_ParCSR);
+   if (nonconforming) { SetupNonconforming(); }
 }
 
 HypreParMatrix &ParLORDiscretization::GetAssembledMatrix() const
 {
-   MFEM_VERIFY(a != NULL && A.Ptr() != NULL, "No LOR system assembled");
+   MFEM_VERIFY(A.Ptr() != NULL, "No LOR system assembled");
    return *A.As<HypreParMatrix>();
 }
 
 ParFiniteElementSpace &ParLORDiscretization::GetParFESpace() const
 {
-   return static_cast<ParFiniteElementSpace&>(*fes);
+   return static_cast<ParFiniteElementSpace&>(GetFESpace());
 }
 
 #endif
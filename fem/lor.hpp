@@ -62,14 +62,20 @@ protected:
    enum FESpaceType { H1, ND, RT, L2, INVALID };
 
    FiniteElementSpace &fes_ho;
-   Mesh *mesh;
-   FiniteElementCollection *fec;
-   FiniteElementSpace *fes;
+   int ref_type;
+   // The refined mesh and the %LOR space are only constructed when needed,
+   // see FormLORSpace.
+   mutable Mesh *mesh;
+   mutable FiniteElementCollection *fec;
+   mutable FiniteElementSpace *fes;
    BilinearForm *a;
    OperatorHandle A;
    mutable Array<int> perm;
    bool nonconforming = false;
 
+   /// Constructs the refined mesh and the %LOR space.
+   virtual void FormLORSpace() const = 0;
+
    /// Constructs the local DOF (ldof) permutation. In parallel this is used as
    /// an intermediate step in computing the DOF permutation (see
    /// ConstructDofPermutation and GetDofPermutation).
@@ -81,7 +87,7 @@ protected:
 
    /// Sets up the prolongation and restriction operators required for
    /// nonconforming spaces.
-   void SetupNonconforming();
+   void SetupNonconforming() const;
 
    /// Returns the type of finite element space: H1, ND, RT or L2.
    FESpaceType GetFESpaceType() const;
@@ -89,15 +95,59 @@ protected:
    /// Returns the order of the %LOR space. 1 for H1 or ND, 0 for L2 or RT.
    int GetLOROrder() const;
 
-   LORBase(FiniteElementSpace &fes_ho_);
+   /// Returns the number of subdivisions of the high-order elements in each
+   /// direction.
+   int GetRefinementFactor() const;
+
+   /// Returns true if the %LOR system of @a a_ho can be assembled directly from
+   /// the high-order mesh with AssembleBatched.
+   bool SupportsBatchedAssembly(BilinearForm &a_ho) const;
+
+   /// @brief Assembles the %LOR matrix of @a a_ho directly from the high-order
+   /// mesh, without constructing the refined mesh.
+   ///
+   /// The sub-element matrices are computed one high-order element at a time,
+   /// and are added to a matrix whose sparsity pattern is known in advance.
+   /// The returned matrix uses the local DOF numbering of the high-order space,
+   /// or the local DOF numbering of the %LOR space if the local DOF
+   /// permutation @a ldof_perm is given (see ConstructLocalDofPermutation).
+   SparseMatrix *AssembleBatched(BilinearForm &a_ho,
+                                 const Array<int> *ldof_perm = NULL) const;
+
+   /// Forms the %LOR system #A from the matrix @a A_local, given in the local
+   /// DOF numbering of @a space, and takes ownership of @a A_local.
+   void FormAssembledSystem(FiniteElementSpace &space, SparseMatrix *A_local,
+                            const Array<int> &ess_dofs);
+
+   /// Returns the essential DOFs @a ess_dofs in the %LOR numbering.
+   void GetLOREssentialDofs(const Array<int> &ess_dofs,
+                            Array<int> &ess_dofs_lor) const;
+
+   LORBase(FiniteElementSpace &fes_ho_, int ref_type_);
 
 public:
    /// Returns the assembled %LOR system.
    const OperatorHandle &GetAssembledSystem() const;
 
-   /// Assembles the %LOR system.
+   /// @brief Assembles the %LOR system.
+   ///
+   /// When possible (see LegacyAssembleSystem), the %LOR matrix is assembled
+   /// directly from the high-order mesh. For H1 spaces, the refined mesh is
+   /// then not constructed. For ND and RT spaces, the %LOR space is still
+   /// constructed, since the system uses the %LOR DOF numbering (see
+   /// GetDofPermutation), as required e.g. by HypreAMS and HypreADS.
    void AssembleSystem(BilinearForm &a_ho, const Array<int> &ess_dofs);
 
+   /// @brief Assembles the %LOR system with a BilinearForm on the %LOR space.
+   ///
+   /// AssembleSystem uses this method unless all the following hold: the mesh
+   /// consists of quadrilaterals or hexahedra, the space is a scalar H1, ND or
+   /// RT space, and @a a_ho contains only domain integrators: MassIntegrator
+   /// and DiffusionIntegrator (H1), VectorFEMassIntegrator and
+   /// CurlCurlIntegrator (ND), or VectorFEMassIntegrator and DivDivIntegrator
+   /// (RT), with scalar coefficients.
+   void LegacyAssembleSystem(BilinearForm &a_ho, const Array<int> &ess_dofs);
+
    /// @brief Returns the permutation that maps %LOR DOFs to high-order DOFs.
    ///
    /// This permutation is constructed the first time it is requested, and then
@@ -118,10 +168,13 @@ public:
    /// prolongation operators.
    bool RequiresDofPermutation() const;
 
-   /// Returns the low-order refined finite element space.
-   FiniteElementSpace &GetFESpace() const { return *fes; }
+   /// @brief Returns the low-order refined finite element space.
+   ///
+   /// The refined mesh and the space are constructed the first time they are
+   /// requested.
+   FiniteElementSpace &GetFESpace() const;
 
-   ~LORBase();
+   virtual ~LORBase();
 };
 
 /// Create and assemble a low-order refined version of a BilinearForm.
@@ -146,6 +199,9 @@ public:
 
    /// Return the assembled %LOR operator as a SparseMatrix.
    SparseMatrix &GetAssembledMatrix() const;
+
+protected:
+   virtual void FormLORSpace() const;
 };
 
 #ifdef MFEM_USE_MPI
@@ -175,6 +231,9 @@ public:
 
    /// Return the %LOR ParFiniteElementSpace.
    ParFiniteElementSpace &GetParFESpace() const;
+
+protected:
+   virtual void FormLORSpace() const;
 };
 
 #endif
@@ -0,0 +1,854 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "lor.hpp"
+#include "pfespace.hpp"
+#include "../general/annotation.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include <algorithm>
+
+// Direct assembly of the LOR matrices on quadrilateral and hexahedral meshes.
+//
+// The LOR sub-elements are straight-sided, with vertices at the images of the
+// tensor product points of type ref_type in the high-order elements. The LOR
+// integrators use the collocated (2-point closed) quadrature, i.e. the
+// quadrature points are the vertices of the sub-elements, see LORBase::LORBase.
+// The vertices of a sub-element are numbered lexicographically: bit d of the
+// vertex index v is its coordinate in the direction d. At the vertex v, the
+// Jacobian of the sub-element map has the columns X(v | 1<<d) - X(v & ~(1<<d)),
+// and the quadrature weight is 1/2^dim.
+
+namespace mfem
+{
+
+namespace
+{
+
+// Sub-element DOFs, numbered as follows:
+// - H1: the vertex v;
+// - ND: the edge of direction d at the vertex v with bit d of v removed, with
+//   index d*2^(dim-1) + Compress(v, d);
+// - RT: the face normal to the direction d at the coordinate t in {0,1} in
+//   this direction, with index 2*d + t.
+// The basis functions are oriented along the positive directions, like the
+// lexicographic basis functions of the high-order tensor product elements.
+
+MFEM_HOST_DEVICE inline int Compress(int v, int d)
+{
+   return (v & ((1 << d) - 1)) | ((v >> (d + 1)) << d);
+}
+
+MFEM_HOST_DEVICE inline int Expand(int t, int d)
+{
+   return (t & ((1 << d) - 1)) | ((t >> d) << (d + 1));
+}
+
+template <int DIM> MFEM_HOST_DEVICE
+inline void VertexJacobian(const double (*X)[3], int v, double *J)
+{
+   for (int d = 0; d < DIM; d++)
+   {
+      const int v0 = v & ~(1 << d), v1 = v | (1 << d);
+      for (int c = 0; c < DIM; c++) { J[c + d*DIM] = X[v1][c] - X[v0][c]; }
+   }
+}
+
+// Mass and diffusion in H1. The mass matrix is diagonal.
+template <int DIM> MFEM_HOST_DEVICE
+void H1SubElementMatrix(const double (*X)[3], const double *qm,
+                        const double *qs, double *A)
+{
+   const int NV = 1 << DIM;
+   const double w = 1.0 / NV;
+   for (int i = 0; i < NV*NV; i++) { A[i] = 0.0; }
+   for (int v = 0; v < NV; v++)
+   {
+      double J[DIM*DIM], adj[DIM*DIM];
+      VertexJacobian<DIM>(X, v, J);
+      kernels::CalcAdjugate<DIM>(J, adj);
+      const double detJ = kernels::Det<DIM>(J);
+      A[v + v*NV] += w*qm[v]*detJ;
+      if (qs[v] == 0.0) { continue; }
+
+      // g(c,a): component c of adj(J)^T times the reference gradient of the
+      // basis function of the vertex a, which is nonzero in the direction d if
+      // a and v only differ in the bit d.
+      double g[DIM][NV];
+      for (int a = 0; a < NV; a++)
+      {
+         for (int c = 0; c < DIM; c++) { g[c][a] = 0.0; }
+         for (int d = 0; d < DIM; d++)
+         {
+            if ((a ^ v) & ~(1 << d)) { continue; }
+            const double gd = ((a >> d) & 1) ? 1.0 : -1.0;
+            for (int c = 0; c < DIM; c++) { g[c][a] += adj[d + c*DIM]*gd; }
+         }
+      }
+      const double f = w*qs[v]/detJ;
+      for (int b = 0; b < NV; b++)
+      {
+         for (int a = 0; a < NV; a++)
+         {
+            double gg = 0.0;
+            for (int c = 0; c < DIM; c++) { gg += g[c][a]*g[c][b]; }
+            A[a + b*NV] += f*gg;
+         }
+      }
+   }
+}
+
+// Mass and curl-curl in ND.
+template <int DIM> MFEM_HOST_DEVICE
+void NDSubElementMatrix(const double (*X)[3], const double *qm,
+                        const double *qs, double *A)
+{
+   const int NV = 1 << DIM, NT = NV/2, NE = DIM*NT;
+   const double w = 1.0 / NV;
+   for (int i = 0; i < NE*NE; i++) { A[i] = 0.0; }
+   for (int v = 0; v < NV; v++)
+   {
+      double J[DIM*DIM], adj[DIM*DIM];
+      VertexJacobian<DIM>(X, v, J);
+      kernels::CalcAdjugate<DIM>(J, adj);
+      const double detJ = kernels::Det<DIM>(J);
+
+      // The basis function of the edge of direction d at the vertex v is the
+      // row d of adj(J) divided by det(J); the other ones vanish at v.
+      int edge[DIM];
+      for (int d = 0; d < DIM; d++) { edge[d] = d*NT + Compress(v, d); }
+      double f = w*qm[v]/detJ;
+      for (int d2 = 0; d2 < DIM; d2++)
+      {
+         for (int d1 = 0; d1 < DIM; d1++)
+         {
+            double uu = 0.0;
+            for (int c = 0; c < DIM; c++)
+            {
+               uu += adj[d1 + c*DIM]*adj[d2 + c*DIM];
+            }
+            A[edge[d1] + edge[d2]*NE] += f*uu;
+         }
+      }
+      if (qs[v] == 0.0) { continue; }
+
+      // u(c,a): component c of det(J) times the curl of the basis function a.
+      const int NC = (DIM == 2) ? 1 : 3;
+      double u[NC][NE];
+      for (int a = 0; a < NE; a++)
+      {
+         const int d = a / NT, t = Expand(a % NT, d);
+         if (DIM == 2)
+         {
+            // Scalar curl, constant in the sub-element
+            const int e = 1 - d;
+            u[0][a] = ((d == 0) ? -1.0 : 1.0)*(((t >> e) & 1) ? 1.0 : -1.0);
+            continue;
+         }
+         // The basis function is psi e_d with psi = prod_{e != d} (1 - x_e)
+         // or x_e, so that curl = sum_{e != d} (d psi/d x_e) e_e x e_d.
+         double c_ref[3] = { 0.0, 0.0, 0.0 };
+         for (int e = 0; e < DIM; e++)
+         {
+            if (e == d) { continue; }
+            const int o = 3 - d - e; // the third direction
+            if (((t >> o) & 1) != ((v >> o) & 1)) { continue; }
+            const double dpsi = ((t >> e) & 1) ? 1.0 : -1.0;
+            // e_e x e_d = e_o if (e,d,o) is a cyclic permutation of (0,1,2)
+            const double s = ((d - e + 3) % 3 == 1) ? 1.0 : -1.0;
+            c_ref[o] += s*dpsi;
+         }
+         for (int c = 0; c < NC; c++)
+         {
+            u[c][a] = 0.0;
+            for (int k = 0; k < DIM; k++) { u[c][a] += J[c + k*DIM]*c_ref[k]; }
+         }
+      }
+      f = w*qs[v]/detJ;
+      for (int b = 0; b < NE; b++)
+      {
+         for (int a = 0; a < NE; a++)
+         {
+            double uu = 0.0;
+            for (int c = 0; c < NC; c++) { uu += u[c][a]*u[c][b]; }
+            A[a + b*NE] += f*uu;
+         }
+      }
+   }
+}
+
+// Mass and div-div in RT.
+template <int DIM> MFEM_HOST_DEVICE
+void RTSubElementMatrix(const double (*X)[3], const double *qm,
+                        const double *qs, double *A)
+{
+   const int NV = 1 << DIM, NF = 2*DIM;
+   const double w = 1.0 / NV;
+   for (int i = 0; i < NF*NF; i++) { A[i] = 0.0; }
+   for (int v = 0; v < NV; v++)
+   {
+      double J[DIM*DIM];
+      VertexJacobian<DIM>(X, v, J);
+      const double detJ = kernels::Det<DIM>(J);
+
+      // The basis function of the face normal to the direction d at the
+      // vertex v is the column d of J divided by det(J); the other ones vanish
+      // at v.
+      int face[DIM];
+      for (int d = 0; d < DIM; d++) { face[d] = 2*d + ((v >> d) & 1); }
+      double f = w*qm[v]/detJ;
+      for (int d2 = 0; d2 < DIM; d2++)
+      {
+         for (int d1 = 0; d1 < DIM; d1++)
+         {
+            double uu = 0.0;
+            for (int c = 0; c < DIM; c++)
+            {
+               uu += J[c + d1*DIM]*J[c + d2*DIM];
+            }
+            A[face[d1] + face[d2]*NF] += f*uu;
+         }
+      }
+
+      // The reference divergence of the basis function 2*d + t is 2*t - 1.
+      f = w*qs[v]/detJ;
+      for (int b = 0; b < NF; b++)
+      {
+         for (int a = 0; a < NF; a++)
+         {
+            A[a + b*NF] += f*(2*(a & 1) - 1)*(2*(b & 1) - 1);
+         }
+      }
+   }
+}
+
+// Computes the lexicographic index, in the high-order element, of each DOF of
+// each of the p^dim sub-elements, see the numbering above.
+void GetSubElementDofs(bool nd, bool rt, int dim, int p, int nv,
+                       Array<int> &sub_dofs)
+{
+   int nsub = 1;
+   for (int d = 0; d < dim; d++) { nsub *= p; }
+   sub_dofs.SetSize(nv*nsub);
+   for (int s = 0; s < nsub; s++)
+   {
+      int sub[3];
+      for (int d = 0, r = s; d < dim; d++, r /= p) { sub[d] = r % p; }
+      for (int a = 0; a < nv; a++)
+      {
+         // The DOFs of the high-order element are grouped by direction; in
+         // each group, they form a grid with n[e] points in the direction e.
+         int dir = 0, offset = 0, pos[3], n[3];
+         for (int e = 0; e < dim; e++) { pos[e] = sub[e]; n[e] = p + 1; }
+         if (nd)
+         {
+            const int nt = nv/dim, t = Expand(a % nt, a / nt);
+            dir = a / nt;
+            for (int e = 0; e < dim; e++)
+            {
+               if (e == dir) { n[e] = p; }
+               else { pos[e] += (t >> e) & 1; }
+            }
+         }
+         else if (rt)
+         {
+            dir = a / 2;
+            for (int e = 0; e < dim; e++)
+            {
+               if (e == dir) { pos[e] += a & 1; }
+               else { n[e] = p; }
+            }
+         }
+         else
+         {
+            for (int e = 0; e < dim; e++) { pos[e] += (a >> e) & 1; }
+         }
+         int size = 1, idx = 0;
+         for (int e = 0; e < dim; e++)
+         {
+            idx += pos[e]*size;
+            size *= n[e];
+         }
+         offset = dir*size;
+         sub_dofs[a + s*nv] = offset + idx;
+      }
+   }
+}
+
+// Returns the coefficients of the mass and of the stiffness (diffusion,
+// curl-curl or div-div) integrators of a, with NULL for a unit coefficient.
+// Returns false if a contains other integrators.
+bool GetLORCoefficients(BilinearForm &a, bool h1,
+                        Array<Coefficient*> &mass, Array<Coefficient*> &stiff)
+{
+   mass.SetSize(0);
+   stiff.SetSize(0);
+   Array<BilinearFormIntegrator*> &integs = *a.GetDBFI();
+   for (int i = 0; i < integs.Size(); i++)
+   {
+      BilinearFormIntegrator *integ = integs[i];
+      if (h1)
+      {
+         if (MassIntegrator *m = dynamic_cast<MassIntegrator*>(integ))
+         {
+            mass.Append(m->GetCoefficient());
+         }
+         else if (DiffusionIntegrator *k =
+                     dynamic_cast<DiffusionIntegrator*>(integ))
+         {
+            if (k->IsAnisotropic()) { return false; }
+            stiff.Append(k->GetCoefficient());
+         }
+         else { return false; }
+      }
+      else if (VectorFEMassIntegrator *m =
+                  dynamic_cast<VectorFEMassIntegrator*>(integ))
+      {
+         if (m->IsAnisotropic()) { return false; }
+         mass.Append(m->GetCoefficient());
+      }
+      else if (CurlCurlIntegrator *k = dynamic_cast<CurlCurlIntegrator*>(integ))
+      {
+         if (k->IsAnisotropic()) { return false; }
+         stiff.Append(k->GetCoefficient());
+      }
+      else if (DivDivIntegrator *k = dynamic_cast<DivDivIntegrator*>(integ))
+      {
+         stiff.Append(k->GetCoefficient());
+      }
+      else { return false; }
+   }
+   return integs.Size() > 0;
+}
+
+// Evaluates the sum of the coefficients at the points of ir in all the
+// elements of the mesh, with layout (nq, ne).
+void EvalCoefficients(const Array<Coefficient*> &coeffs, Mesh &mesh,
+                      const IntegrationRule &ir, Vector &values)
+{
+   const int nq = ir.GetNPoints(), ne = mesh.GetNE();
+   double constant = 0.0;
+   Array<Coefficient*> variable;
+   for (int i = 0; i < coeffs.Size(); i++)
+   {
+      ConstantCoefficient *cc = dynamic_cast<ConstantCoefficient*>(coeffs[i]);
+      if (coeffs[i] == NULL || cc) { constant += (cc ? cc->constant : 1.0); }
+      else { variable.Append(coeffs[i]); }
+   }
+   values.SetSize(nq*ne);
+   values = constant;
+   if (variable.Size() == 0) { return; }
+   double *v = values.HostReadWrite();
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         for (int i = 0; i < variable.Size(); i++)
+         {
+            v[q + e*nq] += variable[i]->Eval(T, ip);
+         }
+      }
+   }
+}
+
+// Contracts the direction d of the data in, with sizes (n[0], n[1], n[2]) for
+// each of the vdim components of the ne elements, with the matrix B of size
+// (m, n[d]). The result, with n[d] replaced by m, is written to out.
+void Contract(int ne, int vdim, const int n[3], int d, int m, const Vector &B,
+              const Vector &in, Vector &out)
+{
+   const int before = (d == 0) ? 1 : (d == 1) ? n[0] : n[0]*n[1];
+   const int after = (d == 0) ? n[1]*n[2] : (d == 1) ? n[2] : 1;
+   const int nd = n[d], nc = vdim*ne;
+   out.SetSize(before*m*after*nc);
+   const auto b = Reshape(B.Read(), m, nd);
+   const auto x = Reshape(in.Read(), before, nd, after, nc);
+   auto y = Reshape(out.Write(), before, m, after, nc);
+   MFEM_FORALL(c, nc,
+   {
+      for (int k = 0; k < after; k++)
+      {
+         for (int q = 0; q < m; q++)
+         {
+            for (int j = 0; j < before; j++)
+            {
+               double o = 0.0;
+               for (int i = 0; i < nd; i++) { o += b(q,i)*x(j,i,k,c); }
+               y(j,q,k,c) = o;
+            }
+         }
+      }
+   });
+}
+
+// The sub-element matrix kernels, with the size NA of the matrices.
+template <int DIM> struct H1SubElement
+{
+   static constexpr int NA = 1 << DIM;
+   MFEM_HOST_DEVICE void operator()(const double (*X)[3], const double *qm,
+                                    const double *qs, double *A) const
+   { H1SubElementMatrix<DIM>(X, qm, qs, A); }
+};
+
+template <int DIM> struct NDSubElement
+{
+   static constexpr int NA = DIM*(1 << (DIM-1));
+   MFEM_HOST_DEVICE void operator()(const double (*X)[3], const double *qm,
+                                    const double *qs, double *A) const
+   { NDSubElementMatrix<DIM>(X, qm, qs, A); }
+};
+
+template <int DIM> struct RTSubElement
+{
+   static constexpr int NA = 2*DIM;
+   MFEM_HOST_DEVICE void operator()(const double (*X)[3], const double *qm,
+                                    const double *qs, double *A) const
+   { RTSubElementMatrix<DIM>(X, qm, qs, A); }
+};
+
+// Computes the sub-element matrices of all the elements and sums them into the
+// element matrices Ae, stored in the local sparsity pattern of the elements,
+// with layout (lnnz, ne). The entry (a,b) of the sub-element s is added to the
+// position sub_pos[a + b*NA + s*NA*NA]. The vertex coordinates Xq and the
+// coefficients Qm and Qs have layouts (nq, DIM, ne) and (nq, ne).
+template <int DIM, typename SubElement>
+void AssembleSubElements(int ne, int p, const Vector &Xq, const Vector &Qm,
+                         const Vector &Qs, const Array<int> &sub_pos,
+                         int lnnz, Vector &Ae)
+{
+   constexpr int NA = SubElement::NA;
+   const int nd1 = p + 1, nq = (DIM == 2) ? nd1*nd1 : nd1*nd1*nd1;
+   const int nsub = (DIM == 2) ? p*p : p*p*p;
+   const SubElement kernel = SubElement();
+   const auto X = Reshape(Xq.Read(), nq, DIM, ne);
+   const auto QM = Reshape(Qm.Read(), nq, ne);
+   const auto QS = Reshape(Qs.Read(), nq, ne);
+   const auto pos = Reshape(sub_pos.Read(), NA*NA, nsub);
+   Ae.SetSize(lnnz*ne);
+   auto A = Reshape(Ae.Write(), lnnz, ne);
+   MFEM_FORALL(e, ne,
+   {
+      for (int k = 0; k < lnnz; k++) { A(k,e) = 0.0; }
+      // One sub-element (sx, sy, sz) at a time
+      for (int s = 0; s < nsub; s++)
+      {
+         const int sx = s % p, sy = (s / p) % p, sz = s / (p*p);
+         double Xv[8][3], qm[8], qs[8], As[NA*NA];
+         for (int v = 0; v < (1 << DIM); v++)
+         {
+            const int q = (sx + (v & 1)) + (sy + ((v >> 1) & 1))*nd1 +
+                          (sz + ((v >> 2) & 1))*nd1*nd1;
+            for (int c = 0; c < DIM; c++) { Xv[v][c] = X(q,c,e); }
+            qm[v] = QM(q,e);
+            qs[v] = QS(q,e);
+         }
+         kernel(Xv, qm, qs, As);
+         for (int k = 0; k < NA*NA; k++) { A(pos(k,s),e) += As[k]; }
+      }
+   });
+}
+
+} // anonymous namespace
+
+bool LORBase::SupportsBatchedAssembly(BilinearForm &a_ho) const
+{
+   const FESpaceType type = GetFESpaceType();
+   Mesh &mesh_ho = *fes_ho.GetMesh();
+   const int dim = mesh_ho.Dimension();
+   Array<Geometry::Type> geoms;
+   mesh_ho.GetGeometries(dim, geoms);
+
+   bool supported = (type == H1 || type == ND || type == RT) &&
+                    (dim == 2 || dim == 3) && mesh_ho.SpaceDimension() == dim &&
+                    fes_ho.GetVDim() == 1 && !fes_ho.IsVariableOrder() &&
+                    geoms.Size() <= 1 &&
+                    a_ho.GetFBFI()->Size() == 0 &&
+                    a_ho.GetBBFI()->Size() == 0 &&
+                    a_ho.GetBFBFI()->Size() == 0;
+   if (supported && geoms.Size() == 1)
+   {
+      const FiniteElement *fe = fes_ho.GetFE(0);
+      supported = Geometry::IsTensorProduct(geoms[0]) &&
+                  dynamic_cast<const TensorBasisElement*>(fe) != NULL;
+      const GridFunction *nodes = mesh_ho.GetNodes();
+      if (supported && nodes)
+      {
+         const FiniteElement *nodal_fe = nodes->FESpace()->GetFE(0);
+         supported = dynamic_cast<const TensorBasisElement*>(nodal_fe) != NULL;
+      }
+   }
+   if (supported)
+   {
+      Array<Coefficient*> mass, stiff;
+      supported = GetLORCoefficients(a_ho, type == H1, mass, stiff);
+   }
+
+#ifdef MFEM_USE_MPI
+   // All the ranks must take the same path.
+   if (A.Type() == Operator::Hypre_ParCSR)
+   {
+      MPI_Comm comm = static_cast<ParFiniteElementSpace&>(fes_ho).GetComm();
+      int local = supported, global;
+      MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, comm);
+      supported = global;
+   }
+#endif
+   return supported;
+}
+
+SparseMatrix *LORBase::AssembleBatched(BilinearForm &a_ho,
+                                       const Array<int> *ldof_perm) const
+{
+   MFEM_PERF_FUNCTION;
+
+   const FESpaceType type = GetFESpaceType();
+   Mesh &mesh_ho = *fes_ho.GetMesh();
+   const int dim = mesh_ho.Dimension();
+   const int ne = fes_ho.GetNE();
+   const int ndofs = fes_ho.GetVSize();
+   if (ne == 0)
+   {
+      SparseMatrix *A_empty = new SparseMatrix(ndofs);
+      A_empty->Finalize();
+      return A_empty;
+   }
+
+   const int p = GetRefinementFactor();
+   const int nd1 = p + 1, nq = (dim == 2) ? nd1*nd1 : nd1*nd1*nd1;
+   const int nv = (type == H1) ? (1 << dim) :
+                  (type == ND) ? dim*(1 << (dim-1)) : 2*dim;
+   const int nsub = (dim == 2) ? p*p : p*p*p;
+
+   Array<Coefficient*> mass, stiff;
+   GetLORCoefficients(a_ho, type == H1, mass, stiff);
+
+   Array<int> sub_dofs;
+   GetSubElementDofs(type == ND, type == RT, dim, p, nv, sub_dofs);
+
+   // The inverse of the local DOF permutation, from the high-order DOFs to the
+   // LOR DOFs, with the sign changes encoded as in the element DOF arrays.
+   Array<int> ldof_inv;
+   if (ldof_perm)
+   {
+      ldof_inv.SetSize(ldof_perm->Size());
+      for (int i = 0; i < ldof_inv.Size(); i++)
+      {
+         const int j = (*ldof_perm)[i];
+         ldof_inv[absdof(j)] = (j < 0) ? -1-i : i;
+      }
+   }
+
+   // The DOFs of the elements in lexicographic order, with the sign of the
+   // lexicographic basis functions relative to the global ones encoded as in
+   // the element DOF arrays.
+   const FiniteElement &fe = *fes_ho.GetFE(0);
+   const int ndof_el = fe.GetDof();
+   const Array<int> &dof_map =
+      dynamic_cast<const TensorBasisElement&>(fe).GetDofMap();
+   Array<int> el_dofs(ndof_el*ne), dofs;
+   for (int e = 0; e < ne; e++)
+   {
+      fes_ho.GetElementDofs(e, dofs);
+      for (int i = 0; i < ndof_el; i++)
+      {
+         int j = dof_map.Size() ? dof_map[i] : i;
+         bool flip = j < 0;
+         j = absdof(j);
+         int g = dofs[j];
+         if (g < 0) { flip = !flip; g = -1-g; }
+         if (ldof_perm)
+         {
+            g = ldof_inv[g];
+            if (g < 0) { flip = !flip; g = -1-g; }
+         }
+         el_dofs[i + e*ndof_el] = flip ? -1-g : g;
+      }
+   }
+
+   // Local sparsity pattern of the elements, (lex_I, lex_J): the columns of
+   // the row of a lexicographic DOF are the DOFs of the sub-elements containing
+   // it, which are found from the sub-element DOFs of each lexicographic index.
+   Table lex_sub;
+   lex_sub.MakeI(ndof_el);
+   for (int k = 0; k < sub_dofs.Size(); k++)
+   {
+      lex_sub.AddAColumnInRow(sub_dofs[k]);
+   }
+   lex_sub.MakeJ();
+   for (int k = 0; k < sub_dofs.Size(); k++)
+   {
+      lex_sub.AddConnection(sub_dofs[k], k);
+   }
+   lex_sub.ShiftUpI();
+
+   Array<int> lex_I(ndof_el+1), lex_J, lex_marker(ndof_el);
+   lex_marker = -1;
+   auto for_each_lex_column = [&](int i, int *row)
+   {
+      int n = 0;
+      const int *sub = lex_sub.GetRow(i);
+      for (int m = 0; m < lex_sub.RowSize(i); m++)
+      {
+         const int s = sub[m] / nv;
+         for (int b = 0; b < nv; b++)
+         {
+            const int j = sub_dofs[b + s*nv];
+            if (lex_marker[j] != i)
+            {
+               lex_marker[j] = i;
+               if (row) { row[n] = j; }
+               n++;
+            }
+         }
+      }
+      return n;
+   };
+   lex_I[0] = 0;
+   for (int i = 0; i < ndof_el; i++)
+   {
+      lex_I[i+1] = lex_I[i] + for_each_lex_column(i, NULL);
+   }
+   const int lnnz = lex_I[ndof_el];
+   lex_J.SetSize(lnnz);
+   lex_marker = -1;
+   for (int i = 0; i < ndof_el; i++)
+   {
+      for_each_lex_column(i, lex_J + lex_I[i]);
+      std::sort(lex_J + lex_I[i], lex_J + lex_I[i+1]);
+   }
+   // The position of the entry (a,b) of each sub-element matrix in (lex_I,
+   // lex_J).
+   Array<int> sub_pos(nsub*nv*nv);
+   for (int s = 0; s < nsub; s++)
+   {
+      for (int b = 0; b < nv; b++)
+      {
+         for (int a = 0; a < nv; a++)
+         {
+            const int i = sub_dofs[a + s*nv], j = sub_dofs[b + s*nv];
+            const int *row = lex_J.GetData() + lex_I[i];
+            const int *row_end = lex_J.GetData() + lex_I[i+1];
+            sub_pos[a + b*nv + s*nv*nv] =
+               lex_I[i] + (std::lower_bound(row, row_end, j) - row);
+         }
+      }
+   }
+
+   // Global sparsity pattern: the columns of the row of a DOF are the columns
+   // of the local rows of the pairs (element, lexicographic index) of the DOF.
+   Table dof_el;
+   dof_el.MakeI(ndofs);
+   for (int k = 0; k < el_dofs.Size(); k++)
+   {
+      dof_el.AddAColumnInRow(absdof(el_dofs[k]));
+   }
+   dof_el.MakeJ();
+   for (int k = 0; k < el_dofs.Size(); k++)
+   {
+      dof_el.AddConnection(absdof(el_dofs[k]), k);
+   }
+   dof_el.ShiftUpI();
+
+   Array<int> marker(ndofs);
+   marker = -1;
+   auto for_each_column = [&](int i, int *row)
+   {
+      int n = 0;
+      const int *el = dof_el.GetRow(i);
+      for (int t = 0; t < dof_el.RowSize(i); t++)
+      {
+         const int e = el[t] / ndof_el, lex = el[t] % ndof_el;
+         for (int kl = lex_I[lex]; kl < lex_I[lex+1]; kl++)
+         {
+            const int j = absdof(el_dofs[lex_J[kl] + e*ndof_el]);
+            if (marker[j] != i)
+            {
+               marker[j] = i;
+               if (row) { row[n] = j; }
+               n++;
+            }
+         }
+      }
+      return n;
+   };
+   int *I = Memory<int>(ndofs+1);
+   I[0] = 0;
+   for (int i = 0; i < ndofs; i++) { I[i+1] = I[i] + for_each_column(i, NULL); }
+   int *J = Memory<int>(I[ndofs]);
+   double *V = Memory<double>(I[ndofs]);
+   marker = -1;
+   for (int i = 0; i < ndofs; i++)
+   {
+      for_each_column(i, J + I[i]);
+      std::sort(J + I[i], J + I[i+1]);
+   }
+
+   // The position in the global matrix of each entry of the local patterns of
+   // the elements, with layout (lnnz, ne), encoded as -1-k when the entry
+   // changes sign.
+   Array<int> el_pos(lnnz*ne);
+   for (int i = 0; i < ndofs; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++) { marker[J[k]] = k; }
+      const int *el = dof_el.GetRow(i);
+      for (int t = 0; t < dof_el.RowSize(i); t++)
+      {
+         const int e = el[t] / ndof_el, lex = el[t] % ndof_el;
+         const int ia = el_dofs[lex + e*ndof_el];
+         for (int kl = lex_I[lex]; kl < lex_I[lex+1]; kl++)
+         {
+            const int jb = el_dofs[lex_J[kl] + e*ndof_el];
+            const int k = marker[absdof(jb)];
+            el_pos[kl + e*lnnz] = ((ia < 0) == (jb < 0)) ? k : -1-k;
+         }
+      }
+   }
+
+   // The points of the high-order elements at the vertices of the
+   // sub-elements, in lexicographic order.
+   const int q_type = BasisType::GetQuadrature1D(ref_type);
+   MFEM_VERIFY(Quadrature1D::CheckClosed(q_type) != Quadrature1D::Invalid,
+               "Invalid refinement type. Must use closed basis type.");
+   const double *pts1d = poly1d.GetPoints(p, ref_type);
+   IntegrationRule ir(nq);
+   for (int q = 0; q < nq; q++)
+   {
+      IntegrationPoint &ip = ir.IntPoint(q);
+      ip.x = pts1d[q % nd1];
+      ip.y = pts1d[(q / nd1) % nd1];
+      ip.z = (dim == 3) ? pts1d[q / (nd1*nd1)] : 0.0;
+   }
+   Vector Qm, Qs;
+   EvalCoefficients(mass, mesh_ho, ir, Qm);
+   EvalCoefficients(stiff, mesh_ho, ir, Qs);
+
+   // The element nodes, in lexicographic order with layout (nn, dim, ne), are
+   // interpolated at the points with sum factorization, using the 1D basis of
+   // the nodal space. Meshes without nodes use their vertices, with a linear
+   // basis.
+   const GridFunction *nodes = mesh_ho.GetNodes();
+   const Poly_1D::Basis *basis1d = &poly1d.GetBasis(1, BasisType::GaussLobatto);
+   int nn1 = 2;
+   Vector Xe;
+   if (nodes)
+   {
+      const FiniteElementSpace &nodal_fes = *nodes->FESpace();
+      const FiniteElement &nodal_fe = *nodal_fes.GetFE(0);
+      basis1d = &dynamic_cast<const TensorBasisElement&>(nodal_fe).GetBasis1D();
+      nn1 = nodal_fe.GetOrder() + 1;
+      const Operator *R =
+         nodal_fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+      Xe.SetSize(R->Height());
+      R->Mult(*nodes, Xe);
+   }
+   else
+   {
+      // The vertices of quadrilaterals and hexahedra in lexicographic order
+      const int vertex_map[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+      const int nn = 1 << dim;
+      Xe.SetSize(nn*dim*ne);
+      double *x = Xe.HostWrite();
+      Array<int> v;
+      for (int e = 0; e < ne; e++)
+      {
+         mesh_ho.GetElementVertices(e, v);
+         for (int i = 0; i < nn; i++)
+         {
+            const double *vx = mesh_ho.GetVertex(v[vertex_map[i]]);
+            for (int c = 0; c < dim; c++) { x[i + (c + e*dim)*nn] = vx[c]; }
+         }
+      }
+   }
+   Vector B(nd1*nn1);
+   {
+      Vector shape(nn1);
+      for (int q = 0; q < nd1; q++)
+      {
+         basis1d->Eval(pts1d[q], shape);
+         for (int i = 0; i < nn1; i++) { B(q + i*nd1) = shape(i); }
+      }
+   }
+   Vector Xq, work1, work2;
+   {
+      int n[3] = { nn1, nn1, (dim == 3) ? nn1 : 1 };
+      const Vector *in = &Xe;
+      for (int d = 0; d < dim; d++)
+      {
+         Vector &out = (d == dim-1) ? Xq : (in == &work1) ? work2 : work1;
+         Contract(ne, dim, n, d, nd1, B, *in, out);
+         n[d] = nd1;
+         in = &out;
+      }
+   }
+
+   // The element matrices, in the local sparsity pattern
+   Vector Ae;
+   switch (10*dim + type)
+   {
+      case 20 + H1:
+         AssembleSubElements<2, H1SubElement<2>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      case 30 + H1:
+         AssembleSubElements<3, H1SubElement<3>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      case 20 + ND:
+         AssembleSubElements<2, NDSubElement<2>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      case 30 + ND:
+         AssembleSubElements<3, NDSubElement<3>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      case 20 + RT:
+         AssembleSubElements<2, RTSubElement<2>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      case 30 + RT:
+         AssembleSubElements<3, RTSubElement<3>>(ne, p, Xq, Qm, Qs, sub_pos,
+                                                 lnnz, Ae);
+         break;
+      default: MFEM_ABORT("Unsupported space type.");
+   }
+
+   // Sum the element matrices into the rows of their DOFs: the entries of the
+   // local row of each pair (element, lexicographic index) of a DOF.
+   SparseMatrix *A = new SparseMatrix(I, J, V, ndofs, ndofs);
+   const int *d_el_I = Read(dof_el.GetIMemory(), ndofs+1);
+   const int *d_el_J = Read(dof_el.GetJMemory(), el_dofs.Size());
+   const int *d_lex_I = lex_I.Read();
+   const int *d_pos = el_pos.Read();
+   const double *d_Ae = Ae.Read();
+   const int *d_I = A->ReadI();
+   double *d_V = A->WriteData();
+   MFEM_FORALL(i, ndofs,
+   {
+      for (int k = d_I[i]; k < d_I[i+1]; k++) { d_V[k] = 0.0; }
+      for (int t = d_el_I[i]; t < d_el_I[i+1]; t++)
+      {
+         const int e = d_el_J[t] / ndof_el, lex = d_el_J[t] % ndof_el;
+         for (int kl = d_lex_I[lex]; kl < d_lex_I[lex+1]; kl++)
+         {
+            const int k = d_pos[kl + e*lnnz];
+            const double val = d_Ae[kl + e*lnnz];
+            if (k >= 0) { d_V[k] += val; }
+            else { d_V[-1-k] -= val; }
+         }
+      }
+   });
+   return A;
+}
+
+} // namespace mfem
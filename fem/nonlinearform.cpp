@@ -424,8 +424,18 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
    {
       if (cP)
       {
-         delete cGrad;
-         cGrad = RAP(*cP, *Grad, *cP);
+         // The sparsity pattern of Grad does not change after it is finalized,
+         // so the pattern of cGrad is computed only once.
+         if (cGradRAP == NULL)
+         {
+            cGradRAP = new SparseMatrixRAP(*cP, *Grad, *cP);
+            delete cGrad;
+            cGrad = cGradRAP->Mult(*Grad);
+         }
+         else
+         {
+            cGradRAP->Mult(*Grad, *cGrad);
+         }
          mGrad = cGrad;
       }
       for (int i = 0; i < ess_tdof_list.Size(); i++)
@@ -442,6 +452,7 @@ void NonlinearForm::Update()
    if (sequence == fes->GetSequence()) { return; }
 
    height = width = fes->GetTrueVSize();
+   delete cGradRAP; cGradRAP = NULL;
    delete cGrad; cGrad = NULL;
    delete Grad; Grad = NULL;
    hGrad.Clear();
@@ -461,6 +472,7 @@ void NonlinearForm::Setup()
 
 NonlinearForm::~NonlinearForm()
 {
+   delete cGradRAP;
    delete cGrad;
    delete Grad;
    for (int i = 0; i <  dnfi.Size(); i++) { delete  dnfi[i]; }
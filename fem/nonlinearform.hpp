@@ -46,6 +46,8 @@ protected:
    Array<Array<int>*>              bfnfi_marker; // not owned
 
    mutable SparseMatrix *Grad, *cGrad; // owned
+   /// Cached sparsity pattern of cGrad = cP^t Grad cP.
+   mutable SparseMatrixRAP *cGradRAP; // owned
    /// Gradient Operator when not assembled as a matrix.
    mutable OperatorHandle hGrad; // has internal ownership flag
 
@@ -72,7 +74,7 @@ public:
        number of true degrees of freedom, i.e. f->GetTrueVSize(). */
    NonlinearForm(FiniteElementSpace *f)
       : Operator(f->GetTrueVSize()), assembly(AssemblyLevel::LEGACY),
-        ext(NULL), fes(f), Grad(NULL), cGrad(NULL),
+        ext(NULL), fes(f), Grad(NULL), cGrad(NULL), cGradRAP(NULL),
         sequence(f->GetSequence()), P(f->GetProlongationMatrix()),
         cP(dynamic_cast<const SparseMatrix*>(P))
    { }
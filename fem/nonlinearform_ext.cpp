@@ -25,7 +25,9 @@ PANonlinearFormExtension::PANonlinearFormExtension(const NonlinearForm *nlf):
    NonlinearFormExtension(nlf),
    fes(*nlf->FESpace()),
    dnfi(*nlf->GetDNFI()),
-   elemR(fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC)),
+   elemR(fes.GetElementRestriction(UsesTensorBasis(fes) ?
+                                   ElementDofOrdering::LEXICOGRAPHIC :
+                                   ElementDofOrdering::NATIVE)),
    Grad(*this)
 {
    // TODO: optimize for the case when 'elemR' is identity
@@ -84,7 +86,9 @@ Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
 void PANonlinearFormExtension::Update()
 {
    height = width = fes.GetVSize();
-   elemR = fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   elemR = fes.GetElementRestriction(UsesTensorBasis(fes) ?
+                                     ElementDofOrdering::LEXICOGRAPHIC :
+                                     ElementDofOrdering::NATIVE);
    xe.SetSize(elemR->Height());
    ye.SetSize(elemR->Height());
    Grad.Update();
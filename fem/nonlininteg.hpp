@@ -271,6 +271,8 @@ protected:
 
    inline void EvalCoeffs() const;
 
+   friend class HyperelasticNLFIntegrator;
+
 public:
    NeoHookeanModel(double mu_, double K_, double g_ = 1.0)
       : mu(mu_), K(K_), g(g_), have_coeffs(false) { c_mu = c_K = c_g = NULL; }
@@ -312,9 +314,16 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension, supported for NeoHookeanModel and InverseHarmonicModel
+   int dim, ne, nq, nd, pa_model;
+   Vector pa_G;     // reference gradients of the basis, NQ x DIM x ND
+   Vector pa_data;  // w det(Jtr) and Jrt at the points, NQ x (1+DIM^2) x NE
+   Vector pa_coeff; // model parameters (mu, K, g), size 3 or 3 x NQ x NE
+   Vector pa_Jpt;   // Jpt at the points, set by AssembleGradPA()
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m), ne(0) { }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -331,6 +340,24 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   using NonlinearFormIntegrator::AssemblePA;
+   /** @brief Partial assembly for the target configuration given by the
+       current mesh, supported for NeoHookeanModel and InverseHarmonicModel. */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual double GetLocalStateEnergyPA(const Vector &x) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   /** @brief Store the deformation gradients at the quadrature points, used
+       by the matrix-free action of the gradient, AddMultGradPA(), and by
+       AssembleGradDiagonalPA(). */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
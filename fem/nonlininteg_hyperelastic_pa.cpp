@@ -0,0 +1,545 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "nonlininteg.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+// Partial assembly of the HyperelasticNLFIntegrator.
+//
+// All matrices below are DIM x DIM and stored column-major. For a given
+// deformation gradient J, the models are written in terms of W = J^{-T}:
+//
+//  - NeoHookeanModel:      P = a J + b W, with a = mu det(J)^{-2/DIM} and
+//                          b = K det(J) (det(J)/g - 1)/g - a (J:J)/DIM,
+//  - InverseHarmonicModel: P = det(J) (1/2 (W:W) W - W W^t W).
+//
+// Their directional derivatives along H use d(det J) = det(J) (W:H) and
+// dW = -W H^t W.
+
+// Values of HyperelasticNLFIntegrator::pa_model
+enum { HYPERELASTIC_PA_INVERSE_HARMONIC, HYPERELASTIC_PA_NEO_HOOKEAN };
+
+// C = op(A) op(B), where op(M) is M or M^t.
+template<int DIM> MFEM_HOST_DEVICE inline
+void HyperelasticPAMult(const double *A, const bool tA,
+                        const double *B, const bool tB, double *C)
+{
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++)
+         {
+            s += (tA ? A[k+i*DIM] : A[i+k*DIM]) *
+                 (tB ? B[j+k*DIM] : B[k+j*DIM]);
+         }
+         C[i+j*DIM] = s;
+      }
+   }
+}
+
+template<int DIM> MFEM_HOST_DEVICE inline
+double HyperelasticPAInner(const double *A, const double *B)
+{
+   double s = 0.0;
+   for (int k = 0; k < DIM*DIM; k++) { s += A[k]*B[k]; }
+   return s;
+}
+
+// Strain energy density W(J).
+template<int DIM> MFEM_HOST_DEVICE inline
+double HyperelasticPAEnergy(const int model, const double *c, const double *J)
+{
+   const double dJ = kernels::Det<DIM>(J);
+   if (model == HYPERELASTIC_PA_NEO_HOOKEAN)
+   {
+      const double sJ = dJ/c[2];
+      const double JJ = HyperelasticPAInner<DIM>(J, J);
+      return 0.5*(c[0]*(pow(dJ, -2.0/DIM)*JJ - DIM) + c[1]*(sJ-1.0)*(sJ-1.0));
+   }
+   double Ji[DIM*DIM];
+   kernels::CalcInverse<DIM>(J, Ji);
+   return 0.5*dJ*HyperelasticPAInner<DIM>(Ji, Ji);
+}
+
+// First Piola-Kirchhoff stress P(J).
+template<int DIM> MFEM_HOST_DEVICE inline
+void HyperelasticPAStress(const int model, const double *c, const double *J,
+                          double *P)
+{
+   double Ji[DIM*DIM], W[DIM*DIM];
+   const double dJ = kernels::Det<DIM>(J);
+   kernels::CalcInverse<DIM>(J, Ji);
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++) { W[i+j*DIM] = Ji[j+i*DIM]; }
+   }
+   if (model == HYPERELASTIC_PA_NEO_HOOKEAN)
+   {
+      const double a = c[0]*pow(dJ, -2.0/DIM);
+      const double b = c[1]*dJ*(dJ/c[2] - 1.0)/c[2] -
+                       a*HyperelasticPAInner<DIM>(J, J)/DIM;
+      for (int k = 0; k < DIM*DIM; k++) { P[k] = a*J[k] + b*W[k]; }
+      return;
+   }
+   double WWt[DIM*DIM], WWtW[DIM*DIM];
+   HyperelasticPAMult<DIM>(W, false, W, true, WWt);
+   HyperelasticPAMult<DIM>(WWt, false, W, false, WWtW);
+   const double t = 0.5*HyperelasticPAInner<DIM>(W, W);
+   for (int k = 0; k < DIM*DIM; k++) { P[k] = dJ*(t*W[k] - WWtW[k]); }
+}
+
+// Directional derivative dP = dP/dJ : H of the stress.
+template<int DIM> MFEM_HOST_DEVICE inline
+void HyperelasticPAStressDerivative(const int model, const double *c,
+                                    const double *J, const double *H,
+                                    double *dP)
+{
+   double Ji[DIM*DIM], W[DIM*DIM], T[DIM*DIM], dW[DIM*DIM];
+   const double dJ = kernels::Det<DIM>(J);
+   kernels::CalcInverse<DIM>(J, Ji);
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++) { W[i+j*DIM] = Ji[j+i*DIM]; }
+   }
+   HyperelasticPAMult<DIM>(H, true, W, false, T);
+   HyperelasticPAMult<DIM>(W, false, T, false, dW);
+   for (int k = 0; k < DIM*DIM; k++) { dW[k] = -dW[k]; }
+   const double WH = HyperelasticPAInner<DIM>(W, H);
+
+   if (model == HYPERELASTIC_PA_NEO_HOOKEAN)
+   {
+      const double mu = c[0], K = c[1], g = c[2];
+      const double sJ = dJ/g;
+      const double JJ = HyperelasticPAInner<DIM>(J, J);
+      const double JH = HyperelasticPAInner<DIM>(J, H);
+      const double a = mu*pow(dJ, -2.0/DIM);
+      const double b = K*sJ*(sJ - 1.0) - a*JJ/DIM;
+      const double da = -2.0*a*WH/DIM;
+      const double db = K*sJ*(2.0*sJ - 1.0)*WH +
+                        2.0*a*(JJ*WH/DIM - JH)/DIM;
+      for (int k = 0; k < DIM*DIM; k++)
+      {
+         dP[k] = da*J[k] + a*H[k] + db*W[k] + b*dW[k];
+      }
+      return;
+   }
+
+   // P = det(J) Q with Q = 1/2 (W:W) W - W W^t W
+   double WtW[DIM*DIM], WWt[DIM*DIM], Q[DIM*DIM];
+   HyperelasticPAMult<DIM>(W, true, W, false, WtW);
+   HyperelasticPAMult<DIM>(W, false, W, true, WWt);
+   const double t = 0.5*HyperelasticPAInner<DIM>(W, W);
+   const double dt = HyperelasticPAInner<DIM>(W, dW);
+   HyperelasticPAMult<DIM>(WWt, false, W, false, Q);
+   for (int k = 0; k < DIM*DIM; k++) { Q[k] = t*W[k] - Q[k]; }
+   double A[DIM*DIM], B[DIM*DIM], C[DIM*DIM];
+   HyperelasticPAMult<DIM>(dW, false, WtW, false, A);
+   HyperelasticPAMult<DIM>(dW, true, W, false, T);
+   HyperelasticPAMult<DIM>(W, false, T, false, B);
+   HyperelasticPAMult<DIM>(WWt, false, dW, false, C);
+   for (int k = 0; k < DIM*DIM; k++)
+   {
+      const double dQ = dt*W[k] + t*dW[k] - A[k] - B[k] - C[k];
+      dP[k] = dJ*(WH*Q[k] + dQ);
+   }
+}
+
+// Deformation gradient Jpt = Jpr Jrt at the point q of element e, where Jpr
+// is the reference gradient of the E-vector X.
+template<int DIM, typename TG, typename TX, typename TD> MFEM_HOST_DEVICE inline
+void HyperelasticPAGradient(const int ND, const int q, const int e,
+                            const TG &G, const TX &X, const TD &D, double *Jpt)
+{
+   double Jpr[DIM*DIM];
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int d = 0; d < ND; d++) { s += X(d,c,e) * G(q,j,d); }
+         Jpr[c+j*DIM] = s;
+      }
+   }
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int k = 0; k < DIM; k++)
+      {
+         double s = 0.0;
+         for (int j = 0; j < DIM; j++) { s += Jpr[c+j*DIM] * D(q,1+j+k*DIM,e); }
+         Jpt[c+k*DIM] = s;
+      }
+   }
+}
+
+// Add the contribution w det(Jtr) DS P^t of the point q of element e to Y,
+// where DS = G Jrt are the gradients of the shape functions in the target
+// configuration.
+template<int DIM, typename TG, typename TD, typename TY> MFEM_HOST_DEVICE inline
+void HyperelasticPAAddFlux(const int ND, const int q, const int e,
+                           const TG &G, const TD &D, const double *P,
+                           TY &Y)
+{
+   double A[DIM*DIM];
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++) { s += P[c+k*DIM] * D(q,1+j+k*DIM,e); }
+         A[c+j*DIM] = D(q,0,e) * s;
+      }
+   }
+   for (int d = 0; d < ND; d++)
+   {
+      for (int c = 0; c < DIM; c++)
+      {
+         double s = 0.0;
+         for (int j = 0; j < DIM; j++) { s += G(q,j,d) * A[c+j*DIM]; }
+         Y(d,c,e) += s;
+      }
+   }
+}
+
+template<int DIM>
+static double HyperelasticPAEnergyKernel(const int model, const int NE,
+                                         const int ND, const int NQ,
+                                         const Vector &g, const Vector &pa,
+                                         const Vector &coeff, const Vector &x)
+{
+   const bool cst = coeff.Size() == 3;
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(pa.Read(), NQ, 1+DIM*DIM, NE);
+   const auto C = Reshape(coeff.Read(), 3, cst ? 1 : NQ, cst ? 1 : NE);
+   const auto X = Reshape(x.Read(), ND, DIM, NE);
+   Vector energy(NE);
+   energy.UseDevice(true);
+   auto E = energy.Write();
+   MFEM_FORALL(e, NE,
+   {
+      double s = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jpt[DIM*DIM];
+         HyperelasticPAGradient<DIM>(ND, q, e, G, X, D, Jpt);
+         const double *c = cst ? &C(0,0,0) : &C(0,q,e);
+         s += D(q,0,e) * HyperelasticPAEnergy<DIM>(model, c, Jpt);
+      }
+      E[e] = s;
+   });
+   return energy.Sum();
+}
+
+template<int DIM>
+static void HyperelasticPAMultKernel(const int model, const int NE,
+                                     const int ND, const int NQ,
+                                     const Vector &g, const Vector &pa,
+                                     const Vector &coeff, const Vector &x,
+                                     Vector &y)
+{
+   const bool cst = coeff.Size() == 3;
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(pa.Read(), NQ, 1+DIM*DIM, NE);
+   const auto C = Reshape(coeff.Read(), 3, cst ? 1 : NQ, cst ? 1 : NE);
+   const auto X = Reshape(x.Read(), ND, DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jpt[DIM*DIM], P[DIM*DIM];
+         HyperelasticPAGradient<DIM>(ND, q, e, G, X, D, Jpt);
+         const double *c = cst ? &C(0,0,0) : &C(0,q,e);
+         HyperelasticPAStress<DIM>(model, c, Jpt, P);
+         HyperelasticPAAddFlux<DIM>(ND, q, e, G, D, P, Y);
+      }
+   });
+}
+
+template<int DIM>
+static void HyperelasticPAAssembleGradKernel(const int NE, const int ND,
+                                             const int NQ, const Vector &g,
+                                             const Vector &pa, const Vector &x,
+                                             Vector &jpt)
+{
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(pa.Read(), NQ, 1+DIM*DIM, NE);
+   const auto X = Reshape(x.Read(), ND, DIM, NE);
+   auto J = Reshape(jpt.Write(), DIM*DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         HyperelasticPAGradient<DIM>(ND, q, e, G, X, D, &J(0,q,e));
+      }
+   });
+}
+
+template<int DIM>
+static void HyperelasticPAMultGradKernel(const int model, const int NE,
+                                         const int ND, const int NQ,
+                                         const Vector &g, const Vector &pa,
+                                         const Vector &coeff,
+                                         const Vector &jpt, const Vector &x,
+                                         Vector &y)
+{
+   const bool cst = coeff.Size() == 3;
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(pa.Read(), NQ, 1+DIM*DIM, NE);
+   const auto C = Reshape(coeff.Read(), 3, cst ? 1 : NQ, cst ? 1 : NE);
+   const auto J = Reshape(jpt.Read(), DIM*DIM, NQ, NE);
+   const auto X = Reshape(x.Read(), ND, DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double H[DIM*DIM], dP[DIM*DIM];
+         HyperelasticPAGradient<DIM>(ND, q, e, G, X, D, H);
+         const double *c = cst ? &C(0,0,0) : &C(0,q,e);
+         HyperelasticPAStressDerivative<DIM>(model, c, &J(0,q,e), H, dP);
+         HyperelasticPAAddFlux<DIM>(ND, q, e, G, D, dP, Y);
+      }
+   });
+}
+
+template<int DIM>
+static void HyperelasticPADiagonalKernel(const int model, const int NE,
+                                         const int ND, const int NQ,
+                                         const Vector &g, const Vector &pa,
+                                         const Vector &coeff,
+                                         const Vector &jpt, Vector &diag)
+{
+   const bool cst = coeff.Size() == 3;
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(pa.Read(), NQ, 1+DIM*DIM, NE);
+   const auto C = Reshape(coeff.Read(), 3, cst ? 1 : NQ, cst ? 1 : NE);
+   const auto J = Reshape(jpt.Read(), DIM*DIM, NQ, NE);
+   auto Y = Reshape(diag.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const double *c = cst ? &C(0,0,0) : &C(0,q,e);
+         for (int d = 0; d < ND; d++)
+         {
+            double ds[DIM];
+            for (int k = 0; k < DIM; k++)
+            {
+               ds[k] = 0.0;
+               for (int j = 0; j < DIM; j++)
+               {
+                  ds[k] += G(q,j,d) * D(q,1+j+k*DIM,e);
+               }
+            }
+            for (int c0 = 0; c0 < DIM; c0++)
+            {
+               // H = e_c0 ds^t is the gradient of the basis function (d,c0)
+               double H[DIM*DIM], dP[DIM*DIM];
+               for (int i = 0; i < DIM; i++)
+               {
+                  for (int k = 0; k < DIM; k++)
+                  {
+                     H[i+k*DIM] = (i == c0) ? ds[k] : 0.0;
+                  }
+               }
+               HyperelasticPAStressDerivative<DIM>(model, c, &J(0,q,e), H, dP);
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += ds[k] * dP[c0+k*DIM]; }
+               Y(d,c0,e) += D(q,0,e) * s;
+            }
+         }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = mesh->GetNE();
+   MFEM_VERIFY(dim == 2 || dim == 3, "PA is supported only in 2D and 3D!");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "PA requires vdim == space dim == mesh dim!");
+   if (ne == 0) { return; }
+   MFEM_VERIFY(mesh->GetNumGeometries(dim) == 1,
+               "PA requires a single element geometry!");
+
+   NeoHookeanModel *neo = dynamic_cast<NeoHookeanModel*>(model);
+   if (neo) { pa_model = HYPERELASTIC_PA_NEO_HOOKEAN; }
+   else if (dynamic_cast<InverseHarmonicModel*>(model))
+   {
+      pa_model = HYPERELASTIC_PA_INVERSE_HARMONIC;
+   }
+   else { MFEM_ABORT("PA is not supported for this HyperelasticModel!"); }
+
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2*el.GetOrder() + 3);
+   nq = ir->GetNPoints();
+   nd = el.GetDof();
+
+   // Reference gradients of the basis functions, with the dofs ordered as in
+   // the E-vectors of PANonlinearFormExtension, i.e. lexicographically for
+   // tensor-product elements.
+   const DofToQuad &maps = el.GetDofToQuad(*ir, DofToQuad::FULL);
+   const TensorBasisElement *tel = dynamic_cast<const TensorBasisElement*>(&el);
+   const Array<int> *dof_map = tel ? &tel->GetDofMap() : NULL;
+   pa_G.SetSize(nq*dim*nd, Device::GetMemoryType());
+   {
+      const auto G = Reshape(maps.G.HostRead(), nq, dim, nd);
+      auto Glex = Reshape(pa_G.HostWrite(), nq, dim, nd);
+      for (int d = 0; d < nd; d++)
+      {
+         const int dn = (dof_map && dof_map->Size() > 0) ? (*dof_map)[d] : d;
+         for (int j = 0; j < dim; j++)
+         {
+            for (int q = 0; q < nq; q++) { Glex(q,j,d) = G(q,j,dn); }
+         }
+      }
+   }
+
+   // Target configuration: w det(Jtr) and Jrt = Jtr^{-1}
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS |
+                                GeometricFactors::DETERMINANTS);
+   const int NE = ne, NQ = nq, DIM = dim;
+   pa_data.SetSize(NQ*(1+DIM*DIM)*NE, Device::GetMemoryType());
+   const auto W = ir->GetWeights().Read();
+   const auto J = Reshape(geom->J.Read(), NQ, DIM, DIM, NE);
+   const auto DETJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto D = Reshape(pa_data.Write(), NQ, 1+DIM*DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jq[9], Ji[9];
+         for (int k = 0; k < DIM; k++)
+         {
+            for (int i = 0; i < DIM; i++) { Jq[i+k*DIM] = J(q,i,k,e); }
+         }
+         if (DIM == 2) { kernels::CalcInverse<2>(Jq, Ji); }
+         else { kernels::CalcInverse<3>(Jq, Ji); }
+         D(q,0,e) = W[q] * DETJ(q,e);
+         for (int k = 0; k < DIM*DIM; k++) { D(q,1+k,e) = Ji[k]; }
+      }
+   });
+
+   // Model parameters (mu, K, g), evaluated on the host unless constant
+   if (!neo || !neo->have_coeffs)
+   {
+      pa_coeff.SetSize(3);
+      pa_coeff(0) = neo ? neo->mu : 0.0;
+      pa_coeff(1) = neo ? neo->K : 0.0;
+      pa_coeff(2) = neo ? neo->g : 1.0;
+   }
+   else
+   {
+      pa_coeff.SetSize(3*NQ*NE);
+      auto C = Reshape(pa_coeff.HostWrite(), 3, NQ, NE);
+      for (int e = 0; e < NE; e++)
+      {
+         ElementTransformation &T = *mesh->GetElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            C(0,q,e) = neo->c_mu->Eval(T, ip);
+            C(1,q,e) = neo->c_K->Eval(T, ip);
+            C(2,q,e) = neo->c_g ? neo->c_g->Eval(T, ip) : 1.0;
+         }
+      }
+   }
+}
+
+double HyperelasticNLFIntegrator::GetLocalStateEnergyPA(const Vector &x) const
+{
+   if (ne == 0) { return 0.0; }
+   if (dim == 2)
+   {
+      return HyperelasticPAEnergyKernel<2>(pa_model, ne, nd, nq, pa_G,
+                                           pa_data, pa_coeff, x);
+   }
+   return HyperelasticPAEnergyKernel<3>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                        pa_coeff, x);
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   if (dim == 2)
+   {
+      HyperelasticPAMultKernel<2>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                  pa_coeff, x, y);
+   }
+   else
+   {
+      HyperelasticPAMultKernel<3>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                  pa_coeff, x, y);
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &)
+{
+   if (ne == 0) { return; }
+   pa_Jpt.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   if (dim == 2)
+   {
+      HyperelasticPAAssembleGradKernel<2>(ne, nd, nq, pa_G, pa_data, x,
+                                          pa_Jpt);
+   }
+   else
+   {
+      HyperelasticPAAssembleGradKernel<3>(ne, nd, nq, pa_G, pa_data, x,
+                                          pa_Jpt);
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x,
+                                              Vector &y) const
+{
+   if (ne == 0) { return; }
+   if (dim == 2)
+   {
+      HyperelasticPAMultGradKernel<2>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                      pa_coeff, pa_Jpt, x, y);
+   }
+   else
+   {
+      HyperelasticPAMultGradKernel<3>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                      pa_coeff, pa_Jpt, x, y);
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   if (dim == 2)
+   {
+      HyperelasticPADiagonalKernel<2>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                      pa_coeff, pa_Jpt, diag);
+   }
+   else
+   {
+      HyperelasticPADiagonalKernel<3>(pa_model, ne, nd, nq, pa_G, pa_data,
+                                      pa_coeff, pa_Jpt, diag);
+   }
+}
+
+} // namespace mfem
@@ -3165,6 +3165,7 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
 
@@ -3201,6 +3202,7 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
 
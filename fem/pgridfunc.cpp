@@ -78,6 +78,18 @@ ParGridFunction::ParGridFunction(ParMesh *pmesh, std::istream &input)
    fes = pfes;
 }
 
+ParGridFunction::ParGridFunction(ParMesh *pmesh,
+                                 const BinaryContainerReader &reader,
+                                 const std::string &prefix)
+   : GridFunction(pmesh, reader, prefix)
+{
+   // Convert the FiniteElementSpace, fes, to a ParFiniteElementSpace:
+   pfes = new ParFiniteElementSpace(pmesh, fec, fes->GetVDim(),
+                                    fes->GetOrdering());
+   delete fes;
+   fes = pfes;
+}
+
 void ParGridFunction::Update()
 {
    face_nbr_data.Destroy();
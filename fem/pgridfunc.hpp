@@ -88,6 +88,14 @@ public:
        constructed. The new ParGridFunction assumes ownership of both. */
    ParGridFunction(ParMesh *pmesh, std::istream &input);
 
+   /** @brief Construct a ParGridFunction on a given ParMesh, @a pmesh, reading
+       from an MFEM binary container, see GridFunction::SaveBinary().
+
+       The ParFiniteElementSpace and the FiniteElementCollection are owned by the
+       new ParGridFunction, as in ParGridFunction(ParMesh*, std::istream&). */
+   ParGridFunction(ParMesh *pmesh, const BinaryContainerReader &reader,
+                   const std::string &prefix = "gf");
+
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use ParFiniteElementSpace%s
        that have the same size.
@@ -121,11 +121,18 @@ void TensorValues<QVectorLayout::byNODES>(const int NE,
          {
             constexpr int MD = 8;
             constexpr int MQ = 8;
-            MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
+            // Highest orders that fit in the device thread block
+            if (D1D <= MD && Q1D <= MQ)
+            { return Values3D<L,0,0,0,MD,MQ>(NE,B,X,Y,vdim,D1D,Q1D); }
+            // Last fall-back, on the host only
+            MFEM_VERIFY(!Device::Allows(Backend::DEVICE_MASK),
+                        "Orders higher than " << MD-1 << " are not supported"
+                        " on device!");
+            MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
-            MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than "
-                        << MQ << " 1D points are not supported!");
-            Values3D<L,0,0,0,MD,MQ>(NE,B,X,Y,vdim,D1D,Q1D);
+            MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
+                        << MAX_Q1D << " 1D points are not supported!");
+            Values3D<L,0,0,0,MAX_D1D,MAX_Q1D>(NE,B,X,Y,vdim,D1D,Q1D);
             return;
          }
       }
@@ -32,6 +32,29 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
      gatherMap(ne*dof)
 {
    // Assuming all finite elements are the same.
+   Setup(e_ordering, NULL);
+}
+
+ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
+                                       ElementDofOrdering e_ordering,
+                                       const Array<int> &elems)
+   : fes(f),
+     ne(elems.Size()),
+     vdim(fes.GetVDim()),
+     byvdim(fes.GetOrdering() == Ordering::byVDIM),
+     ndofs(fes.GetNDofs()),
+     dof(ne > 0 ? fes.GetFE(elems[0])->GetDof() : 0),
+     nedofs(ne*dof),
+     offsets(ndofs+1),
+     indices(ne*dof),
+     gatherMap(ne*dof)
+{
+   // Assuming all finite elements in the list are the same.
+   Setup(e_ordering, elems.GetData());
+}
+
+void ElementRestriction::Setup(ElementDofOrdering e_ordering, const int *elems)
+{
    height = vdim*ne*dof;
    width = fes.GetVSize();
    const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
@@ -40,13 +63,13 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    {
       for (int e = 0; e < ne; ++e)
       {
-         const FiniteElement *fe = fes.GetFE(e);
+         const FiniteElement *fe = fes.GetFE(elems ? elems[e] : e);
          const TensorBasisElement* el =
             dynamic_cast<const TensorBasisElement*>(fe);
          if (el) { continue; }
          mfem_error("Finite element not suitable for lexicographic ordering");
       }
-      const FiniteElement *fe = fes.GetFE(0);
+      const FiniteElement *fe = fes.GetFE(elems ? elems[0] : 0);
       const TensorBasisElement* el =
          dynamic_cast<const TensorBasisElement*>(fe);
       const Array<int> &fe_dof_map = el->GetDofMap();
@@ -55,6 +78,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    }
    const Table& e2dTable = fes.GetElementToDofTable();
    const int* elementMap = e2dTable.GetJ();
+   const int* elementOffsets = e2dTable.GetI();
    // We will be keeping a count of how many local nodes point to its global dof
    for (int i = 0; i <= ndofs; ++i)
    {
@@ -62,9 +86,10 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    }
    for (int e = 0; e < ne; ++e)
    {
+      const int *elem_dofs = elementMap + elementOffsets[elems ? elems[e] : e];
       for (int d = 0; d < dof; ++d)
       {
-         const int sgid = elementMap[dof*e + d];  // signed
+         const int sgid = elem_dofs[d];  // signed
          const int gid = (sgid >= 0) ? sgid : -1 - sgid;
          ++offsets[gid + 1];
       }
@@ -77,11 +102,12 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    // For each global dof, fill in all local nodes that point to it
    for (int e = 0; e < ne; ++e)
    {
+      const int *elem_dofs = elementMap + elementOffsets[elems ? elems[e] : e];
       for (int d = 0; d < dof; ++d)
       {
          const int sdid = dof_reorder ? dof_map[d] : 0;  // signed
          const int did = (!dof_reorder)?d:(sdid >= 0 ? sdid : -1-sdid);
-         const int sgid = elementMap[dof*e + did];  // signed
+         const int sgid = elem_dofs[did];  // signed
          const int gid = (sgid >= 0) ? sgid : -1-sgid;
          const int lid = dof*e + d;
          const bool plus = (sgid >= 0 && sdid >= 0) || (sgid < 0 && sdid < 0);
@@ -100,6 +126,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_FUNCTION;
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -107,6 +134,8 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
    auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
    auto d_y = Reshape(y.Write(), nd, vd, ne);
    auto d_gatherMap = gatherMap.Read();
+   // gather map, E-vector and (at least) the L-vector
+   MFEM_PERF_WORK(4.0*dof*ne + 8.0*vd*(dof*ne + ndofs), 0.0);
    MFEM_FORALL(i, dof*ne,
    {
       const int gid = d_gatherMap[i];
@@ -143,6 +172,7 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_FUNCTION;
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -151,6 +181,9 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
    auto d_indices = indices.Read();
    auto d_x = Reshape(x.Read(), nd, vd, ne);
    auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   // offsets, indices, E-vector and L-vector
+   MFEM_PERF_WORK(4.0*(ndofs + dof*ne) + 8.0*vd*(dof*ne + ndofs),
+                  1.0*vd*dof*ne);
    MFEM_FORALL(i, ndofs,
    {
       const int offset = d_offsets[i];
@@ -462,6 +495,187 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
    h_I[0] = 0;
 }
 
+BatchedElementRestriction::BatchedElementRestriction(
+   const FiniteElementSpace &f, ElementDofOrdering e_ordering)
+   : fes(f)
+{
+   tmp.UseDevice(true);
+   const Mesh *mesh = fes.GetMesh();
+   mesh->GetGeometries(mesh->Dimension(), geoms);
+   e_offsets.SetSize(geoms.Size() + 1);
+   e_offsets[0] = 0;
+   Array<int> elems;
+   for (int b = 0; b < geoms.Size(); b++)
+   {
+      mesh->GetGeometryElements(geoms[b], elems);
+      // Elements without a lexicographic dof map (e.g. L2 tensor-product
+      // elements) are already numbered lexicographically.
+      const TensorBasisElement *tfe =
+         dynamic_cast<const TensorBasisElement*>(fes.GetFE(elems[0]));
+      const bool lex = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC) &&
+                       tfe && tfe->GetDofMap().Size() > 0;
+      batches.Append(new ElementRestriction(
+                        fes, lex ? ElementDofOrdering::LEXICOGRAPHIC :
+                        ElementDofOrdering::NATIVE, elems));
+      e_offsets[b+1] = e_offsets[b] + batches[b]->Height();
+   }
+   height = e_offsets.Last();
+   width = fes.GetVSize();
+}
+
+BatchedElementRestriction::~BatchedElementRestriction()
+{
+   for (int b = 0; b < batches.Size(); b++) { delete batches[b]; }
+}
+
+void BatchedElementRestriction::Mult(const Vector &x, Vector &y) const
+{
+   Vector yb;
+   for (int b = 0; b < batches.Size(); b++)
+   {
+      yb.MakeRef(y, e_offsets[b], batches[b]->Height());
+      batches[b]->Mult(x, yb);
+   }
+}
+
+void BatchedElementRestriction::MultUnsigned(const Vector &x, Vector &y) const
+{
+   Vector yb;
+   for (int b = 0; b < batches.Size(); b++)
+   {
+      yb.MakeRef(y, e_offsets[b], batches[b]->Height());
+      batches[b]->MultUnsigned(x, yb);
+   }
+}
+
+void BatchedElementRestriction::MultTranspose(const Vector &x, Vector &y) const
+{
+   Vector xb;
+   tmp.SetSize(y.Size());
+   for (int b = 0; b < batches.Size(); b++)
+   {
+      xb.MakeRef(const_cast<Vector&>(x), e_offsets[b], batches[b]->Height());
+      batches[b]->MultTranspose(xb, b == 0 ? y : tmp);
+      if (b > 0) { y += tmp; }
+   }
+}
+
+void BatchedElementRestriction::MultTransposeUnsigned(const Vector &x,
+                                                      Vector &y) const
+{
+   Vector xb;
+   tmp.SetSize(y.Size());
+   for (int b = 0; b < batches.Size(); b++)
+   {
+      xb.MakeRef(const_cast<Vector&>(x), e_offsets[b], batches[b]->Height());
+      batches[b]->MultTransposeUnsigned(xb, b == 0 ? y : tmp);
+      if (b > 0) { y += tmp; }
+   }
+}
+
+BdrElementRestriction::BdrElementRestriction(const FiniteElementSpace &f)
+   : fes(f),
+     nbe(fes.GetNBE()),
+     vdim(fes.GetVDim()),
+     byvdim(fes.GetOrdering() == Ordering::byVDIM),
+     ndofs(fes.GetNDofs()),
+     dof(nbe > 0 ? fes.GetBE(0)->GetDof() : 0),
+     offsets(ndofs+1),
+     indices(nbe*dof),
+     gatherMap(nbe*dof)
+{
+   // Assuming all boundary elements are the same.
+   height = vdim*nbe*dof;
+   width = fes.GetVSize();
+   const Table &be2dTable = fes.GetBdrElementToDofTable();
+   MFEM_VERIFY(be2dTable.Size_of_connections() == nbe*dof,
+               "boundary elements with different numbers of dofs");
+   const int *bdrElementMap = be2dTable.GetJ();
+   for (int i = 0; i <= ndofs; ++i)
+   {
+      offsets[i] = 0;
+   }
+   for (int i = 0; i < nbe*dof; ++i)
+   {
+      const int sgid = bdrElementMap[i];  // signed
+      const int gid = (sgid >= 0) ? sgid : -1 - sgid;
+      ++offsets[gid + 1];
+   }
+   for (int i = 1; i <= ndofs; ++i)
+   {
+      offsets[i] += offsets[i - 1];
+   }
+   for (int lid = 0; lid < nbe*dof; ++lid)
+   {
+      const int sgid = bdrElementMap[lid];  // signed
+      const int gid = (sgid >= 0) ? sgid : -1 - sgid;
+      gatherMap[lid] = sgid;
+      indices[offsets[gid]++] = (sgid >= 0) ? lid : -1 - lid;
+   }
+   // Shift back the offsets used as counters above.
+   for (int i = ndofs; i > 0; --i)
+   {
+      offsets[i] = offsets[i - 1];
+   }
+   offsets[0] = 0;
+}
+
+void BdrElementRestriction::Mult(const Vector &x, Vector &y) const
+{
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), nd, vd, nbe);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(i, dof*nbe,
+   {
+      const int gid = d_gatherMap[i];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(i % nd, c, i / nd) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void BdrElementRestriction::MultTranspose(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void BdrElementRestriction::AddMultTranspose(const Vector &x, Vector &y) const
+{
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, nbe);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int sidx_j = d_indices[j];  // signed
+            const int idx_j = (sidx_j >= 0) ? sidx_j : -1 - sidx_j;
+            const double value = d_x(idx_j % nd, c, idx_j / nd);
+            dofValue += (sidx_j >= 0) ? value : -value;
+         }
+         d_y(t?c:i,t?i:c) += dofValue;
+      }
+   });
+}
+
 L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
    : ne(fes.GetNE()),
      vdim(fes.GetVDim()),
@@ -475,6 +689,7 @@ L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
 
 void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -494,6 +709,7 @@ void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 
 void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
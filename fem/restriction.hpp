@@ -43,8 +43,16 @@ protected:
    Array<int> indices;
    Array<int> gatherMap;
 
+   void Setup(ElementDofOrdering e_ordering, const int *elems);
+
 public:
    ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
+   /** @brief Construct the restriction to the subset @a elems of the elements
+       of the space, all of which must use the same finite element. */
+   /** The E-vector layout is ND x VDIM x NE, where NE = @a elems.Size() and
+       the elements are taken in the order given by @a elems. */
+   ElementRestriction(const FiniteElementSpace&, ElementDofOrdering,
+                      const Array<int> &elems);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -76,6 +84,75 @@ public:
    void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
 };
 
+/// Operator that converts FiniteElementSpace L-vectors to E-vectors on meshes
+/// with several element geometries.
+/** The elements are split into batches by geometry, in the order returned by
+    Mesh::GetGeometries(), and each batch is handled by an ElementRestriction
+    on the elements returned by Mesh::GetGeometryElements(). The E-vector is
+    the concatenation of the batch E-vectors, each with layout
+    ND_b x VDIM x NE_b. Batches of tensor-product elements use the requested
+    dof ordering; all other batches use ElementDofOrdering::NATIVE.
+
+    Objects of this type are typically created and owned by FiniteElementSpace
+    objects, see FiniteElementSpace::GetBatchedElementRestriction(). */
+class BatchedElementRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   Array<Geometry::Type> geoms;
+   Array<ElementRestriction*> batches;
+   Array<int> e_offsets;
+   mutable Vector tmp;
+
+public:
+   BatchedElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
+   ~BatchedElementRestriction();
+
+   /// Return the number of element batches.
+   int GetNumBatches() const { return batches.Size(); }
+   /// Return the element geometry of batch @a b.
+   Geometry::Type GetBatchGeometry(int b) const { return geoms[b]; }
+   /// Return the restriction operator of batch @a b.
+   const ElementRestriction &GetBatch(int b) const { return *batches[b]; }
+   /** @brief Return the offsets of the batches in the E-vector; the array has
+       size GetNumBatches()+1. */
+   const Array<int> &GetBatchOffsets() const { return e_offsets; }
+
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Compute Mult without applying signs based on DOF orientations.
+   void MultUnsigned(const Vector &x, Vector &y) const;
+   /// Compute MultTranspose without applying signs based on DOF orientations.
+   void MultTransposeUnsigned(const Vector &x, Vector &y) const;
+};
+
+/// Operator that converts FiniteElementSpace L-vectors to boundary E-vectors.
+/** Objects of this type are typically created and owned by FiniteElementSpace
+    objects, see FiniteElementSpace::GetBdrElementRestriction(). The dofs of
+    each boundary element use the native ordering of the boundary element and
+    the boundary E-vector layout is ND x VDIM x NBE. */
+class BdrElementRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   const int nbe;
+   const int vdim;
+   const bool byvdim;
+   const int ndofs;
+   const int dof;
+   Array<int> offsets;
+   Array<int> indices;
+   Array<int> gatherMap;
+
+public:
+   BdrElementRestriction(const FiniteElementSpace&);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   /// Add the result of MultTranspose() to @a y.
+   void AddMultTranspose(const Vector &x, Vector &y) const;
+};
+
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
     objects, see FiniteElementSpace::GetElementRestriction(). L-vectors
@@ -2190,6 +2190,37 @@ AdaptivityEvaluator::~AdaptivityEvaluator()
 #endif
 }
 
+bool TMOP_ElementGroups::Update(const FiniteElementSpace &fes_)
+{
+   if (fes == &fes_ && sequence == fes_.GetSequence()) { return false; }
+   fes = &fes_;
+   sequence = fes_.GetSequence();
+
+   for (int g = 0; g < groups.Size(); g++) { delete groups[g]; }
+   groups.SetSize(0);
+   Array<int> vdofs;
+   for (int e = 0; e < fes_.GetNE(); e++)
+   {
+      const FiniteElement *fe = fes_.GetFE(e);
+      int g = 0;
+      while (g < groups.Size() && groups[g]->fe != fe) { g++; }
+      if (g == groups.Size())
+      {
+         groups.Append(new Group);
+         groups[g]->fe = fe;
+      }
+      fes_.GetElementVDofs(e, vdofs);
+      groups[g]->elements.Append(e);
+      groups[g]->vdofs.Append(vdofs);
+   }
+   return true;
+}
+
+TMOP_ElementGroups::~TMOP_ElementGroups()
+{
+   for (int g = 0; g < groups.Size(); g++) { delete groups[g]; }
+}
+
 void TMOP_Integrator::ReleasePADeviceMemory()
 {
    if (PA.enabled)
@@ -3251,6 +3282,27 @@ double TMOPComboIntegrator::GetLocalStateEnergyPA(const Vector &xe) const
    return energy;
 }
 
+bool TMOPComboIntegrator::SetupBatchedEnergy(const FiniteElementSpace &fes,
+                                             const Vector &x)
+{
+   bool supported = true;
+   for (int i = 0; i < tmopi.Size() && supported; i++)
+   {
+      supported = tmopi[i]->SetupBatchedEnergy(fes, x);
+   }
+   return supported;
+}
+
+double TMOPComboIntegrator::GetBatchedEnergy(const Vector &x) const
+{
+   double energy = 0.0;
+   for (int i = 0; i < tmopi.Size(); i++)
+   {
+      energy += tmopi[i]->GetBatchedEnergy(x);
+   }
+   return energy;
+}
+
 void InterpolateTMOP_QualityMetric(TMOP_QualityMetric &metric,
                                    const TargetConstructor &tc,
                                    const Mesh &mesh, GridFunction &metric_gf)
@@ -1188,6 +1188,45 @@ public:
 
 class TMOPNewtonSolver;
 
+/** @brief The elements of a FiniteElementSpace grouped by finite element, with
+    the vector DOFs of their nodes.
+
+    Used by the TMOP kernels that do not require a tensor basis, e.g. on meshes
+    with simplices or with several element types: the elements of a group share
+    their shape functions and integration rule, and are processed by one
+    kernel launch. */
+class TMOP_ElementGroups
+{
+public:
+   struct Group
+   {
+      const FiniteElement *fe;
+      /// The elements of the group.
+      Array<int> elements;
+      /// The vdofs of the elements, (dof x vdim) per element.
+      Array<int> vdofs;
+   };
+
+protected:
+   const FiniteElementSpace *fes;
+   long sequence;
+   Array<Group *> groups;
+
+public:
+   TMOP_ElementGroups() : fes(NULL), sequence(-1) { }
+
+   /** @brief Groups the elements of @a fes_, unless it is the space of the
+       last call and was not modified since. Returns true if the groups were
+       rebuilt. */
+   bool Update(const FiniteElementSpace &fes_);
+
+   int Size() const { return groups.Size(); }
+
+   const Group &operator[](int g) const { return *groups[g]; }
+
+   ~TMOP_ElementGroups();
+};
+
 /** @brief A TMOP integrator class based on any given TMOP_QualityMetric and
     TargetConstructor.
 
@@ -1298,6 +1337,24 @@ protected:
       const IntegrationRule *ir;
    } PA;
 
+   // Element-batched energy, see SetupBatchedEnergy()
+   // ---------------------------------------------------
+   // The Q-vectors of the element groups are stored one after the other,
+   // group g starting at the quadrature point offsets[g].
+   //    Jtr: ref->target Jacobians, (dim x dim) Q-vector.
+   //     X0: initial positions used for limiting, (dim) Q-vector.
+   //     LD: limiting distances, scalar Q-vector.
+   //   E, O: energy and '1' Q-vectors, as in PA.
+   // lim_c0: value of the constant limiting coefficient coeff0.
+   struct
+   {
+      TMOP_ElementGroups groups;
+      Array<int> offsets;
+      double lim_c0;
+      DenseTensor Jtr;
+      mutable Vector X0, LD, E, O;
+   } EB;
+
    void ComputeNormalizationEnergies(const GridFunction &x,
                                      double &metric_energy, double &lim_energy);
 
@@ -1394,6 +1451,10 @@ protected:
    void AssemblePA_Limiting();
    void ComputeAllElementTargets(const Vector &xe = Vector()) const;
 
+   // Auxiliary element-batched energy methods, for the element group g.
+   void ComputeBatchedEnergy_2D(int g, const Vector &x) const;
+   void ComputeBatchedEnergy_3D(int g, const Vector &x) const;
+
 public:
    /** @param[in] m  TMOP_QualityMetric that will be integrated (not owned).
        @param[in] tc Target-matrix construction algorithm to use (not owned). */
@@ -1500,6 +1561,26 @@ public:
 
    virtual void AssembleGradDiagonalPA(Vector&) const;
 
+   /** @brief Prepares the computation of the energy with GetBatchedEnergy(),
+       for the L-vectors of @a fes. The positions @a x are passed to the
+       TargetConstructor. */
+   /** Returns false if the integrator is not supported by the batched
+       kernels. These require a metric that is supported by the PA kernels,
+       no metric coefficient, no adaptive limiting, and targets that do not
+       depend on the positions. When limiting is enabled, the limiter must be
+       a TMOP_QuadraticLimiter with a ConstantCoefficient.
+
+       Unlike the PA kernels, the batched kernels do not require a tensor
+       basis, and support meshes with several element types. The targets and
+       the limiting data are computed here, on the host, once for all
+       subsequent calls of GetBatchedEnergy(). */
+   bool SetupBatchedEnergy(const FiniteElementSpace &fes, const Vector &x);
+
+   /** @brief Computes the energy of the L-vector @a x of the space given to
+       SetupBatchedEnergy(), with one kernel launch per element group. */
+   /** Used by TMOPNewtonSolver to evaluate the states of its line search. */
+   double GetBatchedEnergy(const Vector &x) const;
+
    DiscreteAdaptTC *GetDiscreteAdaptTC() const { return discr_tc; }
 
    /** @brief Computes the normalization factors of the metric and limiting
@@ -1578,6 +1659,10 @@ public:
    virtual void AddMultPA(const Vector&, Vector&) const;
    virtual void AddMultGradPA(const Vector&, Vector&) const;
    virtual void AssembleGradDiagonalPA(Vector&) const;
+
+   /// Returns true if all the integrators support the batched energy.
+   bool SetupBatchedEnergy(const FiniteElementSpace &fes, const Vector &x);
+   double GetBatchedEnergy(const Vector &x) const;
 };
 
 /// Interpolates the @a metric's values at the nodes of @a metric_gf.
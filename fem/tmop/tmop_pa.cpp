@@ -319,4 +319,98 @@ double TMOP_Integrator::GetLocalStateEnergyPA(const Vector &xe) const
    return energy;
 }
 
+bool TMOP_Integrator::SetupBatchedEnergy(const FiniteElementSpace &fes,
+                                         const Vector &x)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int mid = metric->Id();
+   const bool metric_ok =
+      (dim == 2) ? (mid == 1 || mid == 2 || mid == 7 || mid == 77 ||
+                    mid == 80) :
+      (dim == 3) ? (mid == 302 || mid == 303 || mid == 315 || mid == 321 ||
+                    mid == 332) : false;
+   const ConstantCoefficient *c0 = dynamic_cast<ConstantCoefficient*>(coeff0);
+   const bool limiting_ok =
+      (coeff0 == NULL) ||
+      (c0 && dynamic_cast<TMOP_QuadraticLimiter*>(lim_func));
+   if (!metric_ok || !limiting_ok || coeff1 || zeta || discr_tc ||
+       targetC->UsesPhysicalCoordinates() || fes.GetVDim() != dim)
+   {
+      return false;
+   }
+
+   EB.groups.Update(fes);
+   const int ng = EB.groups.Size();
+   EB.offsets.SetSize(ng + 1);
+   EB.offsets[0] = 0;
+   for (int g = 0; g < ng; g++)
+   {
+      const TMOP_ElementGroups::Group &group = EB.groups[g];
+      const int nq = EnergyIntegrationRule(*group.fe).GetNPoints();
+      EB.offsets[g+1] = EB.offsets[g] + nq*group.elements.Size();
+   }
+   const int nq_all = EB.offsets[ng];
+
+   EB.E.UseDevice(true);
+   EB.E.SetSize(nq_all, Device::GetDeviceMemoryType());
+   EB.O.SetSize(nq_all, Device::GetDeviceMemoryType());
+   EB.O = 1.0;
+   EB.Jtr.SetSize(dim, dim, nq_all, Device::GetDeviceMemoryType());
+   EB.lim_c0 = c0 ? c0->constant : 0.0;
+   EB.X0.SetSize(c0 ? dim*nq_all : 0, Device::GetDeviceMemoryType());
+   EB.LD.SetSize(c0 ? nq_all : 0, Device::GetDeviceMemoryType());
+
+   // The targets and the limiting data do not depend on the positions that
+   // are passed to GetBatchedEnergy(), so they are computed on the host.
+   double *Jtr = EB.Jtr.HostWrite();
+   double *X0 = c0 ? EB.X0.HostWrite() : NULL;
+   double *LD = c0 ? EB.LD.HostWrite() : NULL;
+   Array<int> vdofs;
+   Vector elfun, shape, p0(dim), d_vals;
+   DenseMatrix pos0;
+   DenseTensor Jtr_e;
+   for (int g = 0; g < ng; g++)
+   {
+      const TMOP_ElementGroups::Group &group = EB.groups[g];
+      const FiniteElement &fe = *group.fe;
+      const IntegrationRule &ir = EnergyIntegrationRule(fe);
+      const int nq = ir.GetNPoints(), dof = fe.GetDof();
+      shape.SetSize(dof);
+      pos0.SetSize(dof, dim);
+      Vector pos0V(pos0.Data(), dof*dim);
+      for (int k = 0; k < group.elements.Size(); k++)
+      {
+         const int e = group.elements[k], q0 = EB.offsets[g] + k*nq;
+         fes.GetElementVDofs(e, vdofs);
+         x.GetSubVector(vdofs, elfun);
+         Jtr_e.UseExternalData(Jtr + dim*dim*q0, dim, dim, nq);
+         targetC->ComputeElementTargets(e, fe, ir, elfun, Jtr_e);
+         if (c0 == NULL) { continue; }
+
+         nodes0->FESpace()->GetElementVDofs(e, vdofs);
+         nodes0->GetSubVector(vdofs, pos0V);
+         if (lim_dist) { lim_dist->GetValues(e, ir, d_vals); }
+         for (int q = 0; q < nq; q++)
+         {
+            fe.CalcShape(ir.IntPoint(q), shape);
+            pos0.MultTranspose(shape, p0);
+            for (int d = 0; d < dim; d++) { X0[d + dim*(q0 + q)] = p0(d); }
+            LD[q0 + q] = lim_dist ? d_vals(q) : 1.0;
+         }
+      }
+   }
+   return true;
+}
+
+double TMOP_Integrator::GetBatchedEnergy(const Vector &x) const
+{
+   const int dim = EB.Jtr.SizeI();
+   for (int g = 0; g < EB.groups.Size(); g++)
+   {
+      if (dim == 2) { ComputeBatchedEnergy_2D(g, x); }
+      if (dim == 3) { ComputeBatchedEnergy_3D(g, x); }
+   }
+   return EB.E * EB.O;
+}
+
 } // namespace mfem
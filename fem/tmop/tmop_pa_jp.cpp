@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../tmop.hpp"
+#include "tmop_pa.hpp"
+#include "../tmop_tools.hpp"
+#include "../../general/forall.hpp"
+#include "../../linalg/kernels.hpp"
+
+namespace mfem
+{
+
+template <int DIM> MFEM_HOST_DEVICE inline
+double DetJpr(const double *J) { return kernels::Det<DIM>(J); }
+
+template <> MFEM_HOST_DEVICE inline
+double DetJpr<1>(const double *J) { return J[0]; }
+
+// Minimum over the quadrature points of det(Jpr) of the positions x - s d of a
+// group of elements, for all the scales s, see
+// TMOPNewtonSolver::MinDetJpr_Batched(). The Jacobians are computed with the
+// full (nqpt x dim x ndof) gradient matrix, so any element type is supported.
+// The positions are linear in s, so the Jacobians of x and d are computed once
+// for all the scales.
+template <int DIM>
+static void MinDetJpr_Kernel_Batched(const int NE,
+                                     const int NQ,
+                                     const int ND,
+                                     const int NS,
+                                     const int offset,
+                                     const int stride,
+                                     const Array<int> &vdofs_,
+                                     const Array<double> &g_,
+                                     const Vector &x_,
+                                     const Vector &d_,
+                                     const Vector &s_,
+                                     Vector &MinDetJ)
+{
+   const auto I = Reshape(vdofs_.Read(), ND, DIM, NE);
+   const auto g = Reshape(g_.Read(), NQ, DIM, ND);
+   const auto S = Reshape(s_.Read(), NS);
+   const double *X = x_.Read();
+   const double *D = d_.Read();
+
+   auto E = Reshape(MinDetJ.ReadWrite(), stride, NS);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jx[DIM*DIM], Jd[DIM*DIM], J[DIM*DIM];
+         for (int i = 0; i < DIM*DIM; i++) { Jx[i] = Jd[i] = 0.0; }
+         for (int j = 0; j < ND; j++)
+         {
+            for (int c = 0; c < DIM; c++)
+            {
+               const double xj = X[I(j,c,e)], dj = D[I(j,c,e)];
+               for (int k = 0; k < DIM; k++)
+               {
+                  Jx[c + DIM*k] += g(q,k,j) * xj;
+                  Jd[c + DIM*k] += g(q,k,j) * dj;
+               }
+            }
+         }
+         for (int s = 0; s < NS; s++)
+         {
+            for (int i = 0; i < DIM*DIM; i++) { J[i] = Jx[i] - S(s) * Jd[i]; }
+            const double det = DetJpr<DIM>(J);
+            E(offset + e, s) = (q == 0) ? det : fmin(E(offset + e, s), det);
+         }
+      }
+   });
+}
+
+void TMOPNewtonSolver::MinDetJpr_Batched(const FiniteElementSpace &fes,
+                                         const Vector &x, const Vector &d,
+                                         const Vector &scales,
+                                         Vector &min_det) const
+{
+   el_groups.Update(fes);
+   const int dim = fes.GetMesh()->Dimension();
+   const int NG = el_groups.Size(), NS = scales.Size();
+
+   // One minimum per element and scale.
+   Array<int> offsets(NG + 1);
+   offsets[0] = 0;
+   for (int g = 0; g < NG; g++)
+   {
+      offsets[g+1] = offsets[g] + el_groups[g].elements.Size();
+   }
+   const int stride = offsets[NG];
+
+   Vector E(stride*NS, Device::GetDeviceMemoryType());
+   E.UseDevice(true);
+   for (int g = 0; g < NG; g++)
+   {
+      const TMOP_ElementGroups::Group &group = el_groups[g];
+      const IntegrationRule &ir = GetIntegrationRule(*group.fe);
+      const DofToQuad &maps = group.fe->GetDofToQuad(ir, DofToQuad::FULL);
+      const int NE = group.elements.Size();
+      const int NQ = maps.nqpt, ND = maps.ndof;
+      const Array<int> &V = group.vdofs;
+      const Array<double> &G = maps.G;
+      const int o = offsets[g];
+      switch (dim)
+      {
+         case 1:
+            MinDetJpr_Kernel_Batched<1>(NE,NQ,ND,NS,o,stride,V,G,x,d,scales,E);
+            break;
+         case 2:
+            MinDetJpr_Kernel_Batched<2>(NE,NQ,ND,NS,o,stride,V,G,x,d,scales,E);
+            break;
+         case 3:
+            MinDetJpr_Kernel_Batched<3>(NE,NQ,ND,NS,o,stride,V,G,x,d,scales,E);
+            break;
+         default: MFEM_ABORT("Invalid dimension " << dim);
+      }
+   }
+
+   min_det.SetSize(NS);
+   Vector E_s;
+   for (int s = 0; s < NS; s++)
+   {
+      E_s.MakeRef(E, s*stride, stride);
+      E_s.UseDevice(true);
+      min_det(s) = E_s.Min();
+   }
+}
+
+} // namespace mfem
@@ -163,4 +163,120 @@ double TMOP_Integrator::GetLocalStateEnergyPA_2D(const Vector &X) const
    MFEM_LAUNCH_TMOP_KERNEL(EnergyPA_2D,id,mn,mp,M,N,J,W,B,G,X,O,E);
 }
 
+// Energy of a group of elements, see TMOP_Integrator::SetupBatchedEnergy(). The
+// Jacobians are computed with the full (nqpt x dim x ndof) gradient matrix, so
+// any element type is supported. The element DOFs are read directly from the
+// L-vector x.
+static void EnergyBatched_2D(const double metric_normal,
+                              const double metric_param,
+                              const int mid,
+                              const double lim_normal,
+                              const double lim_c0,
+                              const int NE,
+                              const int NQ,
+                              const int ND,
+                              const int offset,
+                              const Array<int> &vdofs_,
+                              const Array<double> &w_,
+                              const Array<double> &b_,
+                              const Array<double> &g_,
+                              const DenseTensor &j_,
+                              const Vector &x0_,
+                              const Vector &ld_,
+                              const Vector &x_,
+                              Vector &energy)
+{
+   MFEM_VERIFY(mid == 1 || mid == 2 || mid == 7 || mid == 77 || mid == 80,
+               "2D metric not yet implemented!");
+
+   constexpr int DIM = 2;
+   const bool limiting = lim_c0 != 0.0;
+
+   const auto I = Reshape(vdofs_.Read(), ND, DIM, NE);
+   const auto W = Reshape(w_.Read(), NQ);
+   const auto b = Reshape(b_.Read(), NQ, ND);
+   const auto g = Reshape(g_.Read(), NQ, DIM, ND);
+   const auto J = Reshape(j_.Read() + DIM*DIM*offset, DIM, DIM, NQ, NE);
+   const auto X0 = Reshape(limiting ? x0_.Read() + DIM*offset : nullptr,
+                           DIM, NQ, NE);
+   const auto LD = Reshape(limiting ? ld_.Read() + offset : nullptr, NQ, NE);
+   const double *X = x_.Read();
+
+   auto E = Reshape(energy.ReadWrite() + offset, NQ, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const double *Jtr = &J(0,0,q,e);
+         const double detJtr = kernels::Det<2>(Jtr);
+         const double weight = W(q) * detJtr;
+
+         // Jrt = Jtr^{-1}
+         double Jrt[4];
+         kernels::CalcInverse<2>(Jtr, Jrt);
+
+         // Jpr = X^t.DSh, and the position p = X^t.Sh
+         double Jpr[4], p[2];
+         for (int i = 0; i < DIM*DIM; i++) { Jpr[i] = 0.0; }
+         for (int c = 0; c < DIM; c++) { p[c] = 0.0; }
+         for (int d = 0; d < ND; d++)
+         {
+            for (int c = 0; c < DIM; c++)
+            {
+               const double x = X[I(d,c,e)];
+               p[c] += b(q,d) * x;
+               for (int k = 0; k < DIM; k++) { Jpr[c + DIM*k] += g(q,k,d) * x; }
+            }
+         }
+
+         // Jpt = X^t.DS = (X^t.DSh).Jrt = Jpr.Jrt
+         double Jpt[4];
+         kernels::Mult(2,2,2,Jpr,Jrt,Jpt);
+
+         // metric->EvalW(Jpt);
+            const double EvalW =
+               mid ==  1 ? EvalW_001(Jpt) :
+               mid ==  2 ? EvalW_002(Jpt) :
+               mid ==  7 ? EvalW_007(Jpt) :
+               mid == 77 ? EvalW_077(Jpt) :
+               mid == 80 ? EvalW_080(Jpt, metric_param) : 0.0;
+
+         double val = metric_normal * EvalW;
+         if (limiting)
+         {
+            // TMOP_QuadraticLimiter::Eval(p, p0, d)
+            double dist2 = 0.0;
+            for (int c = 0; c < DIM; c++)
+            {
+               const double dp = p[c] - X0(c,q,e);
+               dist2 += dp * dp;
+            }
+            const double d = LD(q,e);
+            val += lim_normal * lim_c0 * 0.5 * dist2 / (d * d);
+         }
+         E(q,e) = weight * val;
+      }
+   });
+}
+
+void TMOP_Integrator::ComputeBatchedEnergy_2D(int g, const Vector &x) const
+{
+   const TMOP_ElementGroups::Group &group = EB.groups[g];
+   const IntegrationRule &ir = EnergyIntegrationRule(*group.fe);
+   const DofToQuad &maps = group.fe->GetDofToQuad(ir, DofToQuad::FULL);
+   const int N = group.elements.Size();
+   const int M = metric->Id();
+   const double mn = metric_normal;
+   const double ln = lim_normal;
+   const double c0 = EB.lim_c0;
+
+   double mp = 0.0;
+   if (auto m = dynamic_cast<TMOP_Metric_080 *>(metric)) { mp = m->GetGamma(); }
+
+   EnergyBatched_2D(mn, mp, M, ln, c0, N, maps.nqpt, maps.ndof, EB.offsets[g],
+                    group.vdofs, ir.GetWeights(), maps.B, maps.G, EB.Jtr,
+                    EB.X0, EB.LD, x, EB.E);
+}
+
 } // namespace mfem
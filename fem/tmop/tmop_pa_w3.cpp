@@ -173,4 +173,120 @@ double TMOP_Integrator::GetLocalStateEnergyPA_3D(const Vector &X) const
    MFEM_LAUNCH_TMOP_KERNEL(EnergyPA_3D,id,mn,mp,M,N,J,W,B,G,O,X,E);
 }
 
+// Energy of a group of elements, see TMOP_Integrator::SetupBatchedEnergy(). The
+// Jacobians are computed with the full (nqpt x dim x ndof) gradient matrix, so
+// any element type is supported. The element DOFs are read directly from the
+// L-vector x.
+static void EnergyBatched_3D(const double metric_normal,
+                              const double metric_param,
+                              const int mid,
+                              const double lim_normal,
+                              const double lim_c0,
+                              const int NE,
+                              const int NQ,
+                              const int ND,
+                              const int offset,
+                              const Array<int> &vdofs_,
+                              const Array<double> &w_,
+                              const Array<double> &b_,
+                              const Array<double> &g_,
+                              const DenseTensor &j_,
+                              const Vector &x0_,
+                              const Vector &ld_,
+                              const Vector &x_,
+                              Vector &energy)
+{
+   MFEM_VERIFY(mid == 302 || mid == 303 || mid == 315 ||
+               mid == 321 || mid == 332, "3D metric not yet implemented!");
+
+   constexpr int DIM = 3;
+   const bool limiting = lim_c0 != 0.0;
+
+   const auto I = Reshape(vdofs_.Read(), ND, DIM, NE);
+   const auto W = Reshape(w_.Read(), NQ);
+   const auto b = Reshape(b_.Read(), NQ, ND);
+   const auto g = Reshape(g_.Read(), NQ, DIM, ND);
+   const auto J = Reshape(j_.Read() + DIM*DIM*offset, DIM, DIM, NQ, NE);
+   const auto X0 = Reshape(limiting ? x0_.Read() + DIM*offset : nullptr,
+                           DIM, NQ, NE);
+   const auto LD = Reshape(limiting ? ld_.Read() + offset : nullptr, NQ, NE);
+   const double *X = x_.Read();
+
+   auto E = Reshape(energy.ReadWrite() + offset, NQ, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         const double *Jtr = &J(0,0,q,e);
+         const double detJtr = kernels::Det<3>(Jtr);
+         const double weight = W(q) * detJtr;
+
+         // Jrt = Jtr^{-1}
+         double Jrt[9];
+         kernels::CalcInverse<3>(Jtr, Jrt);
+
+         // Jpr = X^t.DSh, and the position p = X^t.Sh
+         double Jpr[9], p[3];
+         for (int i = 0; i < DIM*DIM; i++) { Jpr[i] = 0.0; }
+         for (int c = 0; c < DIM; c++) { p[c] = 0.0; }
+         for (int d = 0; d < ND; d++)
+         {
+            for (int c = 0; c < DIM; c++)
+            {
+               const double x = X[I(d,c,e)];
+               p[c] += b(q,d) * x;
+               for (int k = 0; k < DIM; k++) { Jpr[c + DIM*k] += g(q,k,d) * x; }
+            }
+         }
+
+         // Jpt = X^t.DS = (X^t.DSh).Jrt = Jpr.Jrt
+         double Jpt[9];
+         kernels::Mult(3,3,3,Jpr,Jrt,Jpt);
+
+         // metric->EvalW(Jpt);
+            const double EvalW =
+               mid == 302 ? EvalW_302(Jpt) :
+               mid == 303 ? EvalW_303(Jpt) :
+               mid == 315 ? EvalW_315(Jpt) :
+               mid == 321 ? EvalW_321(Jpt) :
+               mid == 332 ? EvalW_332(Jpt, metric_param) : 0.0;
+
+         double val = metric_normal * EvalW;
+         if (limiting)
+         {
+            // TMOP_QuadraticLimiter::Eval(p, p0, d)
+            double dist2 = 0.0;
+            for (int c = 0; c < DIM; c++)
+            {
+               const double dp = p[c] - X0(c,q,e);
+               dist2 += dp * dp;
+            }
+            const double d = LD(q,e);
+            val += lim_normal * lim_c0 * 0.5 * dist2 / (d * d);
+         }
+         E(q,e) = weight * val;
+      }
+   });
+}
+
+void TMOP_Integrator::ComputeBatchedEnergy_3D(int g, const Vector &x) const
+{
+   const TMOP_ElementGroups::Group &group = EB.groups[g];
+   const IntegrationRule &ir = EnergyIntegrationRule(*group.fe);
+   const DofToQuad &maps = group.fe->GetDofToQuad(ir, DofToQuad::FULL);
+   const int N = group.elements.Size();
+   const int M = metric->Id();
+   const double mn = metric_normal;
+   const double ln = lim_normal;
+   const double c0 = EB.lim_c0;
+
+   double mp = 0.0;
+   if (auto m = dynamic_cast<TMOP_Metric_332 *>(metric)) { mp = m->GetGamma(); }
+
+   EnergyBatched_3D(mn, mp, M, ln, c0, N, maps.nqpt, maps.ndof, EB.offsets[g],
+                    group.vdofs, ir.GetWeights(), maps.B, maps.G, EB.Jtr,
+                    EB.X0, EB.LD, x, EB.E);
+}
+
 } // namespace mfem
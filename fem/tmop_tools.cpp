@@ -363,44 +363,76 @@ double TMOPNewtonSolver::ComputeScalingFactor(const Vector &x,
                                               const Vector &b) const
 {
    const FiniteElementSpace *fes = NULL;
-   double energy_in = 0.0;
 #ifdef MFEM_USE_MPI
    const ParNonlinearForm *p_nlf = dynamic_cast<const ParNonlinearForm *>(oper);
    MFEM_VERIFY(!(parallel && p_nlf == NULL), "Invalid Operator subclass.");
-   if (parallel)
-   {
-      fes = p_nlf->FESpace();
-      energy_in = p_nlf->GetEnergy(x);
-   }
+   if (parallel) { fes = p_nlf->FESpace(); }
 #endif
    const bool serial = !parallel;
    const NonlinearForm *nlf = dynamic_cast<const NonlinearForm *>(oper);
    MFEM_VERIFY(!(serial && nlf == NULL), "Invalid Operator subclass.");
-   if (serial)
-   {
-      fes = nlf->FESpace();
-      energy_in = nlf->GetEnergy(x);
-   }
+   if (serial) { fes = nlf->FESpace(); }
 
-   // Get the local prolongation of the solution vector.
-   Vector x_out_loc(fes->GetVSize(),
-                    (temp_mt == MemoryType::DEFAULT) ? Device::GetDeviceMemoryType() : temp_mt);
-   if (serial)
+   // Local prolongation of true-dof vectors.
+   auto prolongate = [&](const Vector &v, Vector &v_loc)
    {
-      const SparseMatrix *cP = fes->GetConformingProlongation();
-      if (!cP) { x_out_loc = x; }
-      else     { cP->Mult(x, x_out_loc); }
-   }
+      if (serial)
+      {
+         const SparseMatrix *cP = fes->GetConformingProlongation();
+         if (!cP) { v_loc = v; }
+         else     { cP->Mult(v, v_loc); }
+      }
 #ifdef MFEM_USE_MPI
-   else
+      else
+      {
+         fes->GetProlongationMatrix()->Mult(v, v_loc);
+      }
+#endif
+   };
+
+   // Get the local prolongation of the solution vector and of the update.
+   const MemoryType mt = (temp_mt == MemoryType::DEFAULT) ?
+                         Device::GetDeviceMemoryType() : temp_mt;
+   Vector x_loc(fes->GetVSize(), mt), c_loc(fes->GetVSize(), mt),
+          x_out_loc(fes->GetVSize(), mt);
+   prolongate(x, x_loc);
+   prolongate(c, c_loc);
+
+   const bool batched_energy = SetupBatchedEnergy(x_loc);
+   const double energy_in = ComputeEnergy(x_loc, batched_energy);
+
+   const double detJ_factor = (solver_type == 1) ? 0.25 : 0.5;
+
+   // The trial meshes x - scale c are checked for inverted elements in
+   // batches: the min det(T) of the next ls_batch scales of the line search
+   // is computed in one pass. The first batch also contains the starting mesh,
+   // with scale 0.
+   Vector scales, min_dets;
+   scales.SetSize(ls_batch + 1);
+   scales(0) = 0.0;
+   for (int i = 1; i <= ls_batch; i++)
    {
-      fes->GetProlongationMatrix()->Mult(x, x_out_loc);
+      scales(i) = (i == 1) ? 1.0 : scales(i-1) * detJ_factor;
    }
-#endif
+   ComputeMinDet(x_loc, c_loc, scales, *fes, min_dets);
+   auto min_det_at = [&](double s)
+   {
+      for (int i = 0; i < scales.Size(); i++)
+      {
+         if (scales(i) == s) { return min_dets(i); }
+      }
+      scales.SetSize(ls_batch);
+      for (int i = 0; i < ls_batch; i++)
+      {
+         scales(i) = (i == 0) ? s : scales(i-1) * detJ_factor;
+      }
+      ComputeMinDet(x_loc, c_loc, scales, *fes, min_dets);
+      return min_dets(0);
+   };
 
    // Check if the starting mesh (given by x) is inverted. Note that x hasn't
    // been modified by the Newton update yet.
-   const double min_detT_in = ComputeMinDet(x_out_loc, *fes);
+   const double min_detT_in = min_det_at(0.0);
    const bool untangling = (min_detT_in <= 0.0) ? true : false;
    const double untangle_factor = 1.5;
    if (untangling)
@@ -417,28 +449,14 @@ double TMOPNewtonSolver::ComputeScalingFactor(const Vector &x,
    double scale = 1.0, energy_out = 0.0, min_detT_out;
    const double norm_in = Norm(r);
 
-   const double detJ_factor = (solver_type == 1) ? 0.25 : 0.5;
-
    // Perform the line search.
    for (int i = 0; i < 12; i++)
    {
-      // Update the mesh and get the L-vector in x_out_loc.
+      // Update the mesh.
       add(x, -scale, c, x_out);
-      if (serial)
-      {
-         const SparseMatrix *cP = fes->GetConformingProlongation();
-         if (!cP) { x_out_loc = x_out; }
-         else     { cP->Mult(x_out, x_out_loc); }
-      }
-#ifdef MFEM_USE_MPI
-      else
-      {
-         fes->GetProlongationMatrix()->Mult(x_out, x_out_loc);
-      }
-#endif
 
       // Check the changes in detJ.
-      min_detT_out = ComputeMinDet(x_out_loc, *fes);
+      min_detT_out = min_det_at(scale);
       if (untangling == false && min_detT_out < 0.0)
       {
          // No untangling, and detJ got negative -- no good.
@@ -462,16 +480,8 @@ double TMOPNewtonSolver::ComputeScalingFactor(const Vector &x,
       // Check the changes in total energy.
       ProcessNewState(x_out);
 
-      if (serial)
-      {
-         energy_out = nlf->GetGridFunctionEnergy(x_out_loc);
-      }
-#ifdef MFEM_USE_MPI
-      else
-      {
-         energy_out = p_nlf->GetParGridFunctionEnergy(x_out_loc);
-      }
-#endif
+      prolongate(x_out, x_out_loc);
+      energy_out = ComputeEnergy(x_out_loc, batched_energy);
       if (energy_out > energy_in + 0.2*fabs(energy_in) ||
           std::isnan(energy_out) != 0)
       {
@@ -652,51 +662,113 @@ void TMOPNewtonSolver::UpdateDiscreteTC(const TMOP_Integrator &ti,
 double TMOPNewtonSolver::ComputeMinDet(const Vector &x_loc,
                                        const FiniteElementSpace &fes) const
 {
-   double min_detJ = infinity();
-   const int NE = fes.GetNE(), dim = fes.GetMesh()->Dimension();
-   Array<int> xdofs;
-   DenseMatrix Jpr(dim);
+   Vector scales(1), min_det;
+   scales(0) = 0.0;
+   ComputeMinDet(x_loc, x_loc, scales, fes, min_det);
+   return min_det(0);
+}
+
+void TMOPNewtonSolver::ComputeMinDet(const Vector &x_loc, const Vector &d_loc,
+                                     const Vector &scales,
+                                     const FiniteElementSpace &fes,
+                                     Vector &min_det) const
+{
+   const int ns = scales.Size(), dim = fes.GetMesh()->Dimension();
    const bool mixed_mesh = fes.GetMesh()->GetNumGeometries(dim) > 1;
    if (dim == 1 || mixed_mesh || UsesTensorBasis(fes) == false)
    {
-      for (int i = 0; i < NE; i++)
+      MinDetJpr_Batched(fes, x_loc, d_loc, scales, min_det);
+   }
+   else
+   {
+      min_det.SetSize(ns);
+      Vector x_s(x_loc.Size(), Device::GetDeviceMemoryType());
+      x_s.UseDevice(true);
+      for (int s = 0; s < ns; s++)
       {
-         const int dof = fes.GetFE(i)->GetDof();
-         DenseMatrix dshape(dof, dim), pos(dof, dim);
-         Vector posV(pos.Data(), dof * dim);
+         add(x_loc, -scales(s), d_loc, x_s);
+         min_det(s) = dim == 2 ? MinDetJpr_2D(&fes, x_s) :
+                      dim == 3 ? MinDetJpr_3D(&fes, x_s) : 0.0;
+      }
+   }
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      auto p_nlf = dynamic_cast<const ParNonlinearForm *>(oper);
+      MPI_Allreduce(MPI_IN_PLACE, min_det.HostReadWrite(), ns, MPI_DOUBLE,
+                    MPI_MIN, p_nlf->ParFESpace()->GetComm());
+   }
+#endif
+   const DenseMatrix &Wideal =
+      Geometries.GetGeomToPerfGeomJac(fes.GetFE(0)->GetGeomType());
+   min_det /= Wideal.Det();
+}
 
-         fes.GetElementVDofs(i, xdofs);
-         x_loc.GetSubVector(xdofs, posV);
+bool TMOPNewtonSolver::SetupBatchedEnergy(const Vector &x_loc) const
+{
+   const NonlinearForm *nlf = dynamic_cast<const NonlinearForm *>(oper);
+   const FiniteElementSpace &fes = *nlf->FESpace();
+   const Array<NonlinearFormIntegrator*> &integs = *nlf->GetDNFI();
 
-         const IntegrationRule &irule = GetIntegrationRule(*fes.GetFE(i));
-         const int nsp = irule.GetNPoints();
-         for (int j = 0; j < nsp; j++)
+   // With partial assembly, the energy is computed with the PA kernels.
+   bool batched = nlf->GetInteriorFaceIntegrators().Size() == 0 &&
+                  nlf->GetBdrFaceIntegrators().Size() == 0;
+   for (int i = 0; i < integs.Size() && batched; i++)
+   {
+      TMOP_Integrator *ti = dynamic_cast<TMOP_Integrator *>(integs[i]);
+      TMOPComboIntegrator *co = dynamic_cast<TMOPComboIntegrator *>(integs[i]);
+      if (ti)
+      {
+         batched = !ti->PA.enabled && ti->SetupBatchedEnergy(fes, x_loc);
+      }
+      else if (co)
+      {
+         const Array<TMOP_Integrator *> &ati = co->GetTMOPIntegrators();
+         for (int j = 0; j < ati.Size(); j++)
          {
-            fes.GetFE(i)->CalcDShape(irule.IntPoint(j), dshape);
-            MultAtB(pos, dshape, Jpr);
-            min_detJ = std::min(min_detJ, Jpr.Det());
+            batched = batched && !ati[j]->PA.enabled;
          }
+         batched = batched && co->SetupBatchedEnergy(fes, x_loc);
       }
+      else { batched = false; }
    }
-   else
+   return batched;
+}
+
+double TMOPNewtonSolver::ComputeEnergy(const Vector &x_loc, bool batched) const
+{
+   const NonlinearForm *nlf = dynamic_cast<const NonlinearForm *>(oper);
+   if (!batched)
+   {
+#ifdef MFEM_USE_MPI
+      if (parallel)
+      {
+         auto p_nlf = dynamic_cast<const ParNonlinearForm *>(oper);
+         return p_nlf->GetParGridFunctionEnergy(x_loc);
+      }
+#endif
+      return nlf->GetGridFunctionEnergy(x_loc);
+   }
+
+   const Array<NonlinearFormIntegrator*> &integs = *nlf->GetDNFI();
+   double energy = 0.0;
+   for (int i = 0; i < integs.Size(); i++)
    {
-      min_detJ = dim == 2 ? MinDetJpr_2D(&fes, x_loc) :
-                 dim == 3 ? MinDetJpr_3D(&fes, x_loc) : 0.0;
+      TMOP_Integrator *ti = dynamic_cast<TMOP_Integrator *>(integs[i]);
+      TMOPComboIntegrator *co = dynamic_cast<TMOPComboIntegrator *>(integs[i]);
+      energy += ti ? ti->GetBatchedEnergy(x_loc) : co->GetBatchedEnergy(x_loc);
    }
-   double min_detT_all = min_detJ;
 #ifdef MFEM_USE_MPI
    if (parallel)
    {
       auto p_nlf = dynamic_cast<const ParNonlinearForm *>(oper);
-      MPI_Allreduce(&min_detJ, &min_detT_all, 1, MPI_DOUBLE, MPI_MIN,
+      double energy_all;
+      MPI_Allreduce(&energy, &energy_all, 1, MPI_DOUBLE, MPI_SUM,
                     p_nlf->ParFESpace()->GetComm());
+      return energy_all;
    }
 #endif
-   const DenseMatrix &Wideal =
-      Geometries.GetGeomToPerfGeomJac(fes.GetFE(0)->GetGeomType());
-   min_detT_all /= Wideal.Det();
-
-   return min_detT_all;
+   return energy;
 }
 
 #ifdef MFEM_USE_MPI
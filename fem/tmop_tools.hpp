@@ -139,6 +139,12 @@ protected:
 
    MemoryType temp_mt = MemoryType::DEFAULT;
 
+   // Number of line search scales whose min det(T) is computed in one pass.
+   int ls_batch = 4;
+
+   // Elements grouped by finite element, used by MinDetJpr_Batched().
+   mutable TMOP_ElementGroups el_groups;
+
    const IntegrationRule &GetIntegrationRule(const FiniteElement &el) const
    {
       if (IntegRules)
@@ -153,8 +159,27 @@ protected:
    double ComputeMinDet(const Vector &x_loc,
                         const FiniteElementSpace &fes) const;
 
+   /** @brief Computes in @a min_det the minimum det(T) of the positions
+       @a x_loc - @a scales(i) @a d_loc, for all the scales. */
+   /** On meshes without a tensor basis, all the scales are checked in one
+       pass over the elements. */
+   void ComputeMinDet(const Vector &x_loc, const Vector &d_loc,
+                      const Vector &scales, const FiniteElementSpace &fes,
+                      Vector &min_det) const;
+
    double MinDetJpr_2D(const FiniteElementSpace*, const Vector&) const;
    double MinDetJpr_3D(const FiniteElementSpace*, const Vector&) const;
+   // Any dimension and element type, see ComputeMinDet().
+   void MinDetJpr_Batched(const FiniteElementSpace &fes, const Vector &x,
+                          const Vector &d, const Vector &scales,
+                          Vector &min_det) const;
+
+   // Prepares the energy computation with ComputeEnergy(). Returns true if all
+   // the integrators support TMOP_Integrator::GetBatchedEnergy().
+   bool SetupBatchedEnergy(const Vector &x_loc) const;
+
+   // The energy of the local positions x_loc.
+   double ComputeEnergy(const Vector &x_loc, bool batched) const;
 
 public:
 #ifdef MFEM_USE_MPI
@@ -180,6 +205,10 @@ public:
    // Set the memory type for temporary memory allocations.
    void SetTempMemoryType(MemoryType mt) { temp_mt = mt; }
 
+   /** @brief Set the number of scales of the line search that are checked for
+       inverted elements in one pass. The default is 4. */
+   void SetLineSearchBatchSize(int n) { ls_batch = (n > 1) ? n : 1; }
+
    virtual double ComputeScalingFactor(const Vector &x, const Vector &b) const;
 
    virtual void ProcessNewState(const Vector &x) const;
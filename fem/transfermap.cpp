@@ -0,0 +1,183 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "transfermap.hpp"
+#include "../mesh/submesh.hpp"
+#include "../general/forall.hpp"
+
+#ifdef MFEM_USE_MPI
+#include "../mesh/psubmesh.hpp"
+#include "pfespace.hpp"
+#endif
+
+namespace mfem
+{
+
+// If mesh is a SubMesh or a ParSubMesh, return its parent, and set from and
+// elements; otherwise return NULL.
+static const Mesh *GetSubMeshParent(const Mesh *mesh, SubMesh::From &from,
+                                    const Array<int> *&elements)
+{
+   const SubMesh *submesh = dynamic_cast<const SubMesh *>(mesh);
+   if (submesh)
+   {
+      from = submesh->GetFrom();
+      elements = &submesh->GetParentElementIDMap();
+      return submesh->GetParent();
+   }
+#ifdef MFEM_USE_MPI
+   const ParSubMesh *psubmesh = dynamic_cast<const ParSubMesh *>(mesh);
+   if (psubmesh)
+   {
+      from = psubmesh->GetFrom();
+      elements = &psubmesh->GetParentElementIDMap();
+      return psubmesh->GetParent();
+   }
+#endif
+   return NULL;
+}
+
+TransferMap::TransferMap(const FiniteElementSpace &src,
+                         const FiniteElementSpace &dst)
+#ifdef MFEM_USE_MPI
+   : parent_pfes(NULL)
+#endif
+{
+   SubMesh::From from = SubMesh::From::Domain;
+   const Array<int> *elements = NULL;
+   const FiniteElementSpace *sub_fes = NULL, *parent_fes = NULL;
+   if (GetSubMeshParent(dst.GetMesh(), from, elements) == src.GetMesh())
+   {
+      to_parent = false;
+      sub_fes = &dst;
+      parent_fes = &src;
+   }
+   else if (GetSubMeshParent(src.GetMesh(), from, elements) == dst.GetMesh())
+   {
+      to_parent = true;
+      sub_fes = &src;
+      parent_fes = &dst;
+   }
+   else
+   {
+      MFEM_ABORT("one of the spaces must be defined on a SubMesh of the mesh "
+                 "of the other space");
+   }
+   MFEM_VERIFY(sub_fes->GetVDim() == parent_fes->GetVDim(),
+               "the spaces must have the same vector dimension");
+
+   // The elements of a SubMesh have the same vertex ordering as the parent
+   // elements, so their local DOFs are the local DOFs of the parent elements.
+   sub_to_parent.SetSize(sub_fes->GetVSize());
+   Array<int> sub_vdofs, parent_vdofs;
+   for (int e = 0; e < elements->Size(); e++)
+   {
+      sub_fes->GetElementVDofs(e, sub_vdofs);
+      if (from == SubMesh::From::Domain)
+      {
+         parent_fes->GetElementVDofs((*elements)[e], parent_vdofs);
+      }
+      else
+      {
+         parent_fes->GetBdrElementVDofs((*elements)[e], parent_vdofs);
+      }
+      MFEM_VERIFY(sub_vdofs.Size() == parent_vdofs.Size(),
+                  "incompatible finite element spaces");
+      for (int i = 0; i < sub_vdofs.Size(); i++)
+      {
+         const int s = sub_vdofs[i], p = parent_vdofs[i];
+         const int sd = (s >= 0) ? s : -1 - s, pd = (p >= 0) ? p : -1 - p;
+         sub_to_parent[sd] = ((s >= 0) == (p >= 0)) ? pd : -1 - pd;
+      }
+   }
+
+#ifdef MFEM_USE_MPI
+   if (to_parent && dynamic_cast<const ParFiniteElementSpace *>(sub_fes))
+   {
+      parent_pfes = dynamic_cast<const ParFiniteElementSpace *>(parent_fes);
+   }
+#endif
+}
+
+void TransferMap::Transfer(const GridFunction &src, GridFunction &dst) const
+{
+   const int n = sub_to_parent.Size();
+   MFEM_VERIFY((to_parent ? src : dst).Size() == n,
+               "invalid size of the SubMesh GridFunction");
+   const auto map = sub_to_parent.Read();
+
+   if (!to_parent)
+   {
+      const auto p = src.Read();
+      auto s = dst.Write();
+      MFEM_FORALL(i, n,
+      {
+         const int j = map[i];
+         s[i] = (j >= 0) ? p[j] : -p[-1-j];
+      });
+      return;
+   }
+
+#ifdef MFEM_USE_MPI
+   if (parent_pfes)
+   {
+      // The parent DOFs on the ParSubMesh may have local copies on ranks
+      // without the adjacent elements of the ParSubMesh. Scatter the values,
+      // and an indicator of the scattered DOFs, and average them over the
+      // copies of each parent true DOF. The other true DOFs are unchanged.
+      Vector val(dst.Size()), ind(dst.Size());
+      val.UseDevice(true);
+      ind.UseDevice(true);
+      val = 0.0;
+      ind = 0.0;
+      const auto s = src.Read();
+      auto v = val.ReadWrite();
+      auto m = ind.ReadWrite();
+      MFEM_FORALL(i, n,
+      {
+         const int j = map[i];
+         const int k = (j >= 0) ? j : -1-j;
+         v[k] = (j >= 0) ? s[i] : -s[i];
+         m[k] = 1.0;
+      });
+
+      const Operator *P = parent_pfes->GetProlongationMatrix();
+      const SparseMatrix *R = parent_pfes->GetRestrictionMatrix();
+      Vector t(P->Width()), t_val(P->Width()), t_ind(P->Width());
+      t.UseDevice(true);
+      t_val.UseDevice(true);
+      t_ind.UseDevice(true);
+      R->Mult(dst, t);
+      P->MultTranspose(val, t_val);
+      P->MultTranspose(ind, t_ind);
+      const auto tv = t_val.Read();
+      const auto ti = t_ind.Read();
+      auto tt = t.ReadWrite();
+      MFEM_FORALL(i, t.Size(),
+      {
+         if (ti[i] > 0.0) { tt[i] = tv[i] / ti[i]; }
+      });
+      P->Mult(t, dst);
+      return;
+   }
+#endif
+
+   const auto s = src.Read();
+   auto p = dst.ReadWrite();
+   MFEM_FORALL(i, n,
+   {
+      const int j = map[i];
+      if (j >= 0) { p[j] = s[i]; }
+      else { p[-1-j] = -s[i]; }
+   });
+}
+
+}
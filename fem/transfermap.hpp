@@ -0,0 +1,65 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_TRANSFERMAP
+#define MFEM_TRANSFERMAP
+
+#include "../config/config.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+class ParFiniteElementSpace;
+#endif
+
+/** @brief Transfers GridFunctions between a finite element space on a SubMesh
+    (or a ParSubMesh) and a finite element space on its parent mesh.
+
+    The map from the DOFs of the SubMesh space to the DOFs of the parent space
+    is computed once, element by element, so that a transfer is a single gather
+    (to the SubMesh) or scatter (to the parent) kernel. The two spaces must use
+    the same finite element collection, or, for a SubMesh created from a
+    boundary, a collection whose elements are the traces of the parent ones,
+    e.g. H1 or ND collections of the same order and basis type. They must have
+    the same vector dimension; the orderings may differ.
+
+    A transfer to the parent only changes the parent DOFs on the SubMesh. In
+    parallel, it requires communication, to update the parent DOFs whose local
+    copies are not on the local part of the ParSubMesh, and has to be called
+    on all the ranks. */
+class TransferMap
+{
+public:
+   /** @brief Create a map from the space @a src to the space @a dst, one of
+       them being defined on a SubMesh of the mesh of the other. */
+   TransferMap(const FiniteElementSpace &src, const FiniteElementSpace &dst);
+
+   /// Transfer the GridFunction @a src to the GridFunction @a dst.
+   void Transfer(const GridFunction &src, GridFunction &dst) const;
+
+protected:
+   bool to_parent;
+
+   /** For each vector DOF of the SubMesh space, the vector DOF of the parent
+       space, encoded as -1-vdof when the two DOFs have opposite signs. */
+   Array<int> sub_to_parent;
+
+#ifdef MFEM_USE_MPI
+   // The parent space, for parallel transfers to the parent.
+   const ParFiniteElementSpace *parent_pfes;
+#endif
+};
+
+}
+
+#endif
@@ -14,6 +14,13 @@
 
 #include "../config/config.hpp"
 
+// Helpers to build unique variable names and the location of a kernel.
+#define MFEM_PERF_CONCAT_(a,b) a##b
+#define MFEM_PERF_CONCAT(a,b) MFEM_PERF_CONCAT_(a,b)
+#define MFEM_PERF_STR_(x) #x
+#define MFEM_PERF_STR(x) MFEM_PERF_STR_(x)
+#define MFEM_PERF_SITE __FILE__ ":" MFEM_PERF_STR(__LINE__)
+
 #ifdef MFEM_USE_CALIPER
 
 #include <caliper/cali.h>
@@ -21,12 +28,38 @@
 #define MFEM_PERF_FUNCTION CALI_CXX_MARK_FUNCTION
 #define MFEM_PERF_BEGIN(s) CALI_MARK_BEGIN(s)
 #define MFEM_PERF_END(s) CALI_MARK_END(s)
+#define MFEM_PERF_SCOPE(s) CALI_CXX_MARK_SCOPE(s)
+#define MFEM_PERF_WORK(bytes,flops)
 
 #else
 
-#define MFEM_PERF_FUNCTION
-#define MFEM_PERF_BEGIN(s)
-#define MFEM_PERF_END(s)
+// Without Caliper, the regions are recorded by the built-in mfem::Profiler.
+#include "profiler.hpp"
+#include "error.hpp" // _MFEM_FUNC_NAME
+
+/// Record the enclosing function as a region.
+#define MFEM_PERF_FUNCTION \
+   static mfem::Profiler::Site MFEM_PERF_CONCAT(mfem_perf_site_,__LINE__); \
+   mfem::ProfilerScope MFEM_PERF_CONCAT(mfem_perf_,__LINE__)( \
+      _MFEM_FUNC_NAME, MFEM_PERF_CONCAT(mfem_perf_site_,__LINE__))
+
+/// Open the region @a s, closed by MFEM_PERF_END(s).
+#define MFEM_PERF_BEGIN(s) \
+   do { if (mfem::Profiler::Enabled()) { mfem::Profiler::Begin(s); } } while (0)
+
+/// Close the region @a s, opened by MFEM_PERF_BEGIN(s).
+#define MFEM_PERF_END(s) mfem::Profiler::End(s)
+
+/// Record the region @a s until the end of the enclosing scope.
+#define MFEM_PERF_SCOPE(s) \
+   static mfem::Profiler::Site MFEM_PERF_CONCAT(mfem_perf_site_,__LINE__); \
+   mfem::ProfilerScope MFEM_PERF_CONCAT(mfem_perf_,__LINE__)( \
+      s, MFEM_PERF_CONCAT(mfem_perf_site_,__LINE__))
+
+/// Add estimates of the bytes moved and of the flops to the current region.
+#define MFEM_PERF_WORK(bytes,flops) \
+   do { if (mfem::Profiler::Enabled()) \
+        { mfem::Profiler::AddWork(bytes,flops); } } while (0)
 
 #endif
 
@@ -12,6 +12,21 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef MFEM_USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace mfem
 {
 namespace bin_io
@@ -103,4 +118,303 @@ void DecodeBase64(const char *src, size_t len, std::vector<char> &buf)
 size_t NumBase64Chars(size_t nbytes) { return ((4*nbytes/3) + 3) & ~3; }
 
 } // namespace mfem::bin_io
+
+
+// Layout of the binary container:
+//  - header: the signature line, padded with zeros to 32 bytes, the format
+//    version and the byte order mark (uint32), and the number of blocks
+//    (uint64);
+//  - block table: one entry of BLOCK_ENTRY_SIZE bytes per block, with the
+//    zero-padded block name, the type and compression flag (int32), and the
+//    offset, the stored size and the uncompressed size in bytes (uint64);
+//  - block data, each block starting at a multiple of BLOCK_ALIGN bytes.
+static const int SIGNATURE_SIZE = 32;
+static const uint32_t CONTAINER_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const int HEADER_SIZE = SIGNATURE_SIZE + 2*4 + 8;
+static const int BLOCK_NAME_SIZE = 32;
+static const int BLOCK_ENTRY_SIZE = BLOCK_NAME_SIZE + 2*4 + 3*8;
+static const size_t BLOCK_ALIGN = 64;
+
+// Block types, the type index gives the size of the values in bytes
+static const size_t block_type_size[3] = { 1, sizeof(int), sizeof(double) };
+
+static inline size_t AlignBlock(size_t offset)
+{
+   return (offset + BLOCK_ALIGN - 1)/BLOCK_ALIGN*BLOCK_ALIGN;
+}
+
+BinaryContainerWriter::BinaryContainerWriter(bool compress_)
+   : compress(compress_)
+{
+#ifndef MFEM_USE_ZLIB
+   MFEM_VERIFY(!compress, "ZLib not enabled in MFEM build.");
+#endif
+}
+
+BinaryContainerWriter::Block &BinaryContainerWriter::NewBlock(
+   const std::string &name, int type)
+{
+   MFEM_VERIFY(name.size() < (size_t) BLOCK_NAME_SIZE,
+               "block name is too long: " << name);
+   for (size_t i = 0; i < blocks.size(); i++)
+   {
+      MFEM_VERIFY(blocks[i].name != name, "duplicate block name: " << name);
+   }
+   blocks.push_back(Block());
+   Block &b = blocks.back();
+   b.name = name;
+   b.type = type;
+   b.data = NULL;
+   b.size = 0;
+   return b;
+}
+
+void BinaryContainerWriter::AddBlock(const std::string &name, const int *data,
+                                     size_t n)
+{
+   Block &b = NewBlock(name, 1);
+   b.data = reinterpret_cast<const char*>(data);
+   b.size = n*sizeof(int);
+}
+
+void BinaryContainerWriter::AddBlock(const std::string &name,
+                                     const double *data, size_t n)
+{
+   Block &b = NewBlock(name, 2);
+   b.data = reinterpret_cast<const char*>(data);
+   b.size = n*sizeof(double);
+}
+
+void BinaryContainerWriter::CopyBlock(const std::string &name, const int *data,
+                                      size_t n)
+{
+   Block &b = NewBlock(name, 1);
+   const char *ptr = reinterpret_cast<const char*>(data);
+   b.own_data.assign(ptr, ptr + n*sizeof(int));
+   b.size = b.own_data.size();
+}
+
+void BinaryContainerWriter::CopyBlock(const std::string &name,
+                                      const double *data, size_t n)
+{
+   Block &b = NewBlock(name, 2);
+   const char *ptr = reinterpret_cast<const char*>(data);
+   b.own_data.assign(ptr, ptr + n*sizeof(double));
+   b.size = b.own_data.size();
+}
+
+void BinaryContainerWriter::AddString(const std::string &name,
+                                      const std::string &str)
+{
+   Block &b = NewBlock(name, 0);
+   b.own_data.assign(str.begin(), str.end());
+   b.size = b.own_data.size();
+}
+
+void BinaryContainerWriter::Save(std::ostream &os) const
+{
+   const size_t nb = blocks.size();
+
+   // Compress the blocks, if requested
+   std::vector<std::vector<char> > zdata(compress ? nb : 0);
+   std::vector<size_t> offset(nb), stored_size(nb);
+   size_t pos = AlignBlock(HEADER_SIZE + nb*BLOCK_ENTRY_SIZE);
+   for (size_t i = 0; i < nb; i++)
+   {
+      const Block &b = blocks[i];
+      stored_size[i] = b.size;
+#ifdef MFEM_USE_ZLIB
+      if (compress && b.size > 0)
+      {
+         const char *src = b.own_data.size() ? b.own_data.data() : b.data;
+         uLongf zsize = compressBound(b.size);
+         zdata[i].resize(zsize);
+         const int res = compress2((Bytef*) zdata[i].data(), &zsize,
+                                   (const Bytef*) src, b.size,
+                                   Z_DEFAULT_COMPRESSION);
+         MFEM_VERIFY(res == Z_OK, "zlib compression failed");
+         zdata[i].resize(zsize);
+         stored_size[i] = zsize;
+      }
+#endif
+      offset[i] = pos;
+      pos = AlignBlock(pos + stored_size[i]);
+   }
+
+   // Header
+   char sig[SIGNATURE_SIZE];
+   std::memset(sig, 0, SIGNATURE_SIZE);
+   std::strcpy(sig, BinaryContainerReader::Signature());
+   sig[std::strlen(sig)] = '\n';
+   os.write(sig, SIGNATURE_SIZE);
+   bin_io::write<uint32_t>(os, CONTAINER_VERSION);
+   bin_io::write<uint32_t>(os, BYTE_ORDER_MARK);
+   bin_io::write<uint64_t>(os, nb);
+
+   // Block table
+   for (size_t i = 0; i < nb; i++)
+   {
+      char name[BLOCK_NAME_SIZE];
+      std::memset(name, 0, BLOCK_NAME_SIZE);
+      blocks[i].name.copy(name, BLOCK_NAME_SIZE-1);
+      os.write(name, BLOCK_NAME_SIZE);
+      bin_io::write<int32_t>(os, blocks[i].type);
+      bin_io::write<int32_t>(os, compress ? 1 : 0);
+      bin_io::write<uint64_t>(os, offset[i]);
+      bin_io::write<uint64_t>(os, stored_size[i]);
+      bin_io::write<uint64_t>(os, blocks[i].size);
+   }
+
+   // Block data
+   pos = HEADER_SIZE + nb*BLOCK_ENTRY_SIZE;
+   const std::vector<char> padding(BLOCK_ALIGN, 0);
+   for (size_t i = 0; i < nb; i++)
+   {
+      const Block &b = blocks[i];
+      os.write(padding.data(), offset[i] - pos);
+      const char *src = compress ? zdata[i].data() :
+                        b.own_data.size() ? b.own_data.data() : b.data;
+      os.write(src, stored_size[i]);
+      pos = offset[i] + stored_size[i];
+   }
+   os.flush();
+}
+
+void BinaryContainerWriter::Save(const std::string &filename) const
+{
+   std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+   MFEM_VERIFY(os, "unable to open file: " << filename);
+   Save(os);
+   MFEM_VERIFY(os, "error writing file: " << filename);
+}
+
+BinaryContainerReader::BinaryContainerReader(const std::string &filename_)
+   : filename(filename_), base(NULL), length(0), mapped(false)
+{
+#ifndef _WIN32
+   const int fd = open(filename.c_str(), O_RDONLY);
+   MFEM_VERIFY(fd >= 0, "unable to open file: " << filename);
+   struct stat st;
+   if (fstat(fd, &st) == 0 && st.st_size > 0)
+   {
+      length = st.st_size;
+      // A private writable mapping allows the views of the blocks to be
+      // modified in-place (copy-on-write) without changing the file.
+      void *ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                       fd, 0);
+      if (ptr != MAP_FAILED)
+      {
+         base = static_cast<char*>(ptr);
+         mapped = true;
+      }
+   }
+   close(fd);
+#endif
+   if (!mapped)
+   {
+      // Fallback: read the whole file into memory
+      std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+      MFEM_VERIFY(is, "unable to open file: " << filename);
+      is.seekg(0, std::ios::end);
+      length = is.tellg();
+      is.seekg(0, std::ios::beg);
+      buffer.resize(length);
+      is.read(buffer.data(), length);
+      MFEM_VERIFY(is, "error reading file: " << filename);
+      base = buffer.data();
+   }
+
+   MFEM_VERIFY(length >= (size_t) HEADER_SIZE &&
+               std::strncmp(base, Signature(), std::strlen(Signature())) == 0,
+               "not an MFEM binary container: " << filename);
+   const char *ptr = base + SIGNATURE_SIZE;
+   const uint32_t version = bin_io::read<uint32_t>(ptr);
+   const uint32_t bom = bin_io::read<uint32_t>(ptr + 4);
+   const uint64_t nb = bin_io::read<uint64_t>(ptr + 8);
+   MFEM_VERIFY(version == CONTAINER_VERSION,
+               "unsupported container version " << version);
+   MFEM_VERIFY(bom == BYTE_ORDER_MARK, "incompatible byte order in container "
+               << filename);
+   MFEM_VERIFY(length >= HEADER_SIZE + nb*BLOCK_ENTRY_SIZE,
+               "truncated container: " << filename);
+
+   ptr = base + HEADER_SIZE;
+   for (uint64_t i = 0; i < nb; i++, ptr += BLOCK_ENTRY_SIZE)
+   {
+      const std::string name(ptr, strnlen(ptr, BLOCK_NAME_SIZE));
+      Block &b = blocks[name];
+      b.type = bin_io::read<int32_t>(ptr + BLOCK_NAME_SIZE);
+      b.compressed = bin_io::read<int32_t>(ptr + BLOCK_NAME_SIZE + 4);
+      b.offset = bin_io::read<uint64_t>(ptr + BLOCK_NAME_SIZE + 8);
+      b.stored_size = bin_io::read<uint64_t>(ptr + BLOCK_NAME_SIZE + 16);
+      b.size = bin_io::read<uint64_t>(ptr + BLOCK_NAME_SIZE + 24);
+      MFEM_VERIFY(b.type >= 0 && b.type <= 2 &&
+                  b.offset + b.stored_size <= length,
+                  "invalid block '" << name << "' in " << filename);
+   }
+}
+
+BinaryContainerReader::~BinaryContainerReader()
+{
+#ifndef _WIN32
+   if (mapped) { munmap(base, length); }
+#endif
+}
+
+bool BinaryContainerReader::IsContainer(const std::string &fname)
+{
+   std::ifstream is(fname.c_str(), std::ios::in | std::ios::binary);
+   const size_t len = std::strlen(Signature());
+   std::vector<char> sig(len);
+   is.read(sig.data(), len);
+   return is && std::strncmp(sig.data(), Signature(), len) == 0;
+}
+
+const char *BinaryContainerReader::GetBlock(const std::string &name, int type,
+                                            size_t &n) const
+{
+   std::map<std::string, Block>::const_iterator it = blocks.find(name);
+   MFEM_VERIFY(it != blocks.end(),
+               "block '" << name << "' not found in " << filename);
+   const Block &b = it->second;
+   MFEM_VERIFY(b.type == type, "invalid type of block '" << name << "'");
+   n = b.size/block_type_size[type];
+   if (!b.compressed) { return base + b.offset; }
+
+#ifdef MFEM_USE_ZLIB
+   std::vector<char> &buf = inflated[name];
+   if (buf.size() != b.size)
+   {
+      buf.resize(b.size);
+      uLongf size = b.size;
+      const int res = uncompress((Bytef*) buf.data(), &size,
+                                 (const Bytef*) base + b.offset,
+                                 b.stored_size);
+      MFEM_VERIFY(res == Z_OK && size == b.size,
+                  "zlib decompression failed for block '" << name << "'");
+   }
+   return buf.data();
+#else
+   MFEM_ABORT("ZLib not enabled in MFEM build, cannot read compressed block '"
+              << name << "'");
+   return NULL;
+#endif
+}
+
+void BinaryContainerReader::GetArray(const std::string &name,
+                                     Array<int> &a) const
+{
+   size_t n;
+   const int *data = GetInts(name, n);
+   a.MakeRef(const_cast<int*>(data), n);
+}
+
+std::string BinaryContainerReader::GetString(const std::string &name) const
+{
+   size_t n;
+   const char *data = GetBlock(name, 0, n);
+   return std::string(data, n);
+}
+
 } // namespace mfem
@@ -13,9 +13,12 @@
 #define MFEM_BINARYIO
 
 #include "../config/config.hpp"
+#include "array.hpp"
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <map>
 
 namespace mfem
 {
@@ -72,6 +75,126 @@ size_t NumBase64Chars(size_t nbytes);
 
 } // namespace mfem::bin_io
 
+/** @brief Writer for the MFEM binary container format.
+
+    The container is a versioned binary file consisting of a header, a table of
+    named data blocks, and the data blocks themselves. Each block is an array of
+    bytes, 32-bit integers, or doubles, stored with 64-byte alignment so that a
+    BinaryContainerReader can provide zero-copy views of the blocks directly
+    from a memory mapping of the file. When MFEM is built with zlib support,
+    the blocks can optionally be compressed individually.
+
+    The format is used by Mesh::SaveBinary(), ParMesh::SaveBinary() and
+    GridFunction::SaveBinary(). A container holds the data of a single process:
+    in parallel, every MPI rank writes its own file. Writing the data of all
+    the ranks into one shared container, at per-rank offsets, is not
+    supported. */
+class BinaryContainerWriter
+{
+protected:
+   struct Block
+   {
+      std::string name;
+      int type;
+      const char *data;
+      size_t size;
+      std::vector<char> own_data;
+   };
+
+   std::vector<Block> blocks;
+   bool compress;
+
+   Block &NewBlock(const std::string &name, int type);
+
+public:
+   /// Create an empty container; if @a compress_ is true, the blocks will be
+   /// compressed with zlib when the container is saved.
+   explicit BinaryContainerWriter(bool compress_ = false);
+
+   /** @brief Add a block of @a n values of type int or double referencing
+       the array @a data, which must remain valid until Save() is called. */
+   void AddBlock(const std::string &name, const int *data, size_t n);
+   void AddBlock(const std::string &name, const double *data, size_t n);
+
+   /// Add a block with a copy of the contents of @a a.
+   void AddBlock(const std::string &name, const Array<int> &a)
+   { CopyBlock(name, a.HostRead(), a.Size()); }
+
+   /// Add a block with a copy of the @a n values in @a data.
+   void CopyBlock(const std::string &name, const int *data, size_t n);
+   void CopyBlock(const std::string &name, const double *data, size_t n);
+
+   /// Add a block with a copy of the string @a str.
+   void AddString(const std::string &name, const std::string &str);
+
+   /// Write the container to the given stream, which must be in binary mode.
+   void Save(std::ostream &os) const;
+
+   /// Write the container to the given file.
+   void Save(const std::string &filename) const;
+};
+
+/** @brief Reader for the MFEM binary container format written by
+    BinaryContainerWriter.
+
+    The file is mapped into memory (using mmap, when available) and the
+    uncompressed blocks are accessed in-place, without copying or parsing.
+    Compressed blocks are decompressed on first access. All pointers and views
+    returned by the reader point to memory owned by the reader, so they remain
+    valid only while the reader exists. The mapping is private: modifying the
+    viewed data does not change the file. */
+class BinaryContainerReader
+{
+protected:
+   struct Block
+   {
+      int type;
+      int compressed;
+      size_t offset, stored_size, size;
+   };
+
+   std::string filename;
+   char *base;
+   size_t length;
+   bool mapped;
+   std::vector<char> buffer;
+   std::map<std::string, Block> blocks;
+   mutable std::map<std::string, std::vector<char> > inflated;
+
+   const char *GetBlock(const std::string &name, int type, size_t &n) const;
+
+public:
+   /// Open and map the container file @a filename_.
+   explicit BinaryContainerReader(const std::string &filename_);
+
+   ~BinaryContainerReader();
+
+   /// The first line of every container file.
+   static const char *Signature() { return "MFEM binary container v1.0"; }
+
+   /// Return true if the file @a fname starts with the container signature.
+   static bool IsContainer(const std::string &fname);
+
+   const std::string &GetFileName() const { return filename; }
+
+   bool HasBlock(const std::string &name) const
+   { return blocks.find(name) != blocks.end(); }
+
+   /// Return a pointer to the data of a block of ints, and its size in @a n.
+   const int *GetInts(const std::string &name, size_t &n) const
+   { return reinterpret_cast<const int*>(GetBlock(name, 1, n)); }
+
+   /// Return a pointer to the data of a block of doubles, and its size in @a n.
+   const double *GetDoubles(const std::string &name, size_t &n) const
+   { return reinterpret_cast<const double*>(GetBlock(name, 2, n)); }
+
+   /// Make @a a a (non-owning) view of the block of ints @a name.
+   void GetArray(const std::string &name, Array<int> &a) const;
+
+   /// Return a copy of the string block @a name.
+   std::string GetString(const std::string &name) const;
+};
+
 } // namespace mfem
 
 #endif
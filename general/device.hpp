@@ -72,7 +72,12 @@ struct Backend
           (using separate host/device memory pools and host <-> device
           transfers) without any GPU hardware. As 'DEBUG' is sometimes used
           as a macro, `_DEVICE` has been added to avoid conflicts. */
-      DEBUG_DEVICE = 1 << 14
+      DEBUG_DEVICE = 1 << 14,
+      /** @brief [host] SIMD CPU backend: sequential execution on each MPI rank,
+          with the partial assembly operators of the mass, diffusion and
+          convection integrators applied to groups of elements interleaved in
+          the lanes of SIMD registers. */
+      SIMD_CPU = 1 << 15
    };
 
    /** @brief Additional useful constants. For example, the *_MASK constants can
@@ -80,10 +85,10 @@ struct Backend
    enum
    {
       /// Number of backends: from (1 << 0) to (1 << (NUM_BACKENDS-1)).
-      NUM_BACKENDS = 15,
+      NUM_BACKENDS = 16,
 
       /// Biwise-OR of all CPU backends
-      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU,
+      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU | SIMD_CPU,
       /// Biwise-OR of all CUDA backends
       CUDA_MASK = CUDA | RAJA_CUDA | OCCA_CUDA | CEED_CUDA,
       /// Biwise-OR of all HIP backends
@@ -202,7 +207,7 @@ public:
          'ceed-cuda', 'occa-cuda', 'raja-cuda', 'cuda',
          'ceed-hip', 'hip', 'debug',
          'occa-omp', 'raja-omp', 'omp',
-         'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu'.
+         'ceed-cpu', 'occa-cpu', 'raja-cpu', 'simd-cpu', 'cpu'.
        * Multiple backends can be configured at the same time.
        * Only one 'occa-*' backend can be configured at a time.
        * The backend 'occa-cuda' enables the 'cuda' backend unless 'raja-cuda'
@@ -219,6 +224,10 @@ public:
          and evaluation of operators and enables the 'hip' backend to avoid
          transfers between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The backend 'simd-cpu' interleaves the quadrature data and the
+         E-vectors of the partially assembled mass, diffusion and convection
+         integrators in groups of elements that fill a SIMD register, see
+         fem/bilininteg_simd.hpp. Other operators use the 'cpu' backend.
    */
    void Configure(const std::string &device, const int dev = 0);
 
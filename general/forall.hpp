@@ -17,6 +17,7 @@
 #include "backends.hpp"
 #include "device.hpp"
 #include "mem_manager.hpp"
+#include "annotation.hpp"
 #include "../linalg/dtensor.hpp"
 
 namespace mfem
@@ -46,20 +47,20 @@ const int MAX_Q1D = 14;
 
 // The MFEM_FORALL wrapper
 #define MFEM_FORALL(i,N,...)                             \
-   ForallWrap<1>(true,N,                                 \
+   ForallWrap<1>(MFEM_PERF_SITE,true,N,                  \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__})
 
 // MFEM_FORALL with a 2D CUDA block
 #define MFEM_FORALL_2D(i,N,X,Y,BZ,...)                   \
-   ForallWrap<2>(true,N,                                 \
+   ForallWrap<2>(MFEM_PERF_SITE,true,N,                  \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
                  X,Y,BZ)
 
 // MFEM_FORALL with a 3D CUDA block
 #define MFEM_FORALL_3D(i,N,X,Y,Z,...)                    \
-   ForallWrap<3>(true,N,                                 \
+   ForallWrap<3>(MFEM_PERF_SITE,true,N,                  \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
                  X,Y,Z)
@@ -67,7 +68,7 @@ const int MAX_Q1D = 14;
 // MFEM_FORALL with a 3D CUDA block and grid
 // With G=0, this is the same as MFEM_FORALL_3D(i,N,X,Y,Z,...)
 #define MFEM_FORALL_3D_GRID(i,N,X,Y,Z,G,...)             \
-   ForallWrap<3>(true,N,                                 \
+   ForallWrap<3>(MFEM_PERF_SITE,true,N,                  \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__},\
                  X,Y,Z,G)
@@ -76,7 +77,7 @@ const int MAX_Q1D = 14;
 // example the functions in vector.cpp, where we don't want to use the mfem
 // device for operations on small vectors.
 #define MFEM_FORALL_SWITCH(use_dev,i,N,...)              \
-   ForallWrap<1>(use_dev,N,                              \
+   ForallWrap<1>(MFEM_PERF_SITE,use_dev,N,               \
                  [=] MFEM_DEVICE (int i) {__VA_ARGS__},  \
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__})
 
@@ -394,13 +395,19 @@ void HipWrap3D(const int N, DBODY &&d_body,
 #endif // MFEM_USE_HIP
 
 
-/// The forall kernel body wrapper
+/// The forall kernel body wrapper, recorded as the profiler region @a site
+/// (Caliper builds keep their own annotations and do not record the kernels).
 template <const int DIM, typename DBODY, typename HBODY>
-inline void ForallWrap(const bool use_dev, const int N,
+inline void ForallWrap(const char *site, const bool use_dev, const int N,
                        DBODY &&d_body, HBODY &&h_body,
                        const int X=0, const int Y=0, const int Z=0,
                        const int G=0)
 {
+#ifndef MFEM_USE_CALIPER
+   MFEM_PERF_SCOPE(site);
+#else
+   MFEM_CONTRACT_VAR(site);
+#endif
    MFEM_CONTRACT_VAR(X);
    MFEM_CONTRACT_VAR(Y);
    MFEM_CONTRACT_VAR(Z);
@@ -140,6 +140,7 @@ public:
    {
    protected:
       friend class HashTable;
+      template<typename> friend class OpenHashTable;
       typedef typename Base::iterator base;
 
       iterator() { }
@@ -160,6 +161,7 @@ public:
    {
    protected:
       friend class HashTable;
+      template<typename> friend class OpenHashTable;
       typedef typename Base::const_iterator base;
 
       const_iterator() { }
@@ -187,12 +189,16 @@ protected:
    int mask;
    Array<int> unused;
 
-   // hash functions (NOTE: the constants are arbitrary)
+   // hash functions (NOTE: the constants are arbitrary; the arithmetic is
+   // unsigned to avoid signed overflow)
    inline int Hash(int p1, int p2) const
-   { return (984120265*p1 + 125965121*p2) & mask; }
+   { return (984120265u*unsigned(p1) + 125965121u*unsigned(p2)) & mask; }
 
    inline int Hash(int p1, int p2, int p3) const
-   { return (984120265*p1 + 125965121*p2 + 495698413*p3) & mask; }
+   {
+      return (984120265u*unsigned(p1) + 125965121u*unsigned(p2) +
+              495698413u*unsigned(p3)) & mask;
+   }
 
    // Delete() and Reparent() use one of these:
    inline int Hash(const Hashed2& item) const
@@ -213,6 +219,160 @@ protected:
 };
 
 
+/** OpenHashTable is a variant of HashTable with the same interface and the
+ *  same semantics, based on open addressing instead of chaining.
+ *
+ *  HashTable chains the items of each bucket through their 'next' fields, so a
+ *  lookup visits items scattered over the blocks of the BlockArray. Here, the
+ *  parent indices and the id of each item are stored in a flat table of slots
+ *  (12 bytes for Hashed2 items, 16 bytes for Hashed4 items), searched by
+ *  linear probing: a lookup scans a few consecutive slots, usually in one cache
+ *  line, and does not read the items at all.
+ *  Deleting an item shifts back the following slots of its probe sequence, so
+ *  no "deleted" markers accumulate in the table.
+ *
+ *  The slot of an item is given by the high bits of a hash that is linear in
+ *  the parent indices. Regular access patterns, e.g. to the edges of
+ *  consecutive elements, thus access the table with regular strides, and
+ *  doubling the size of the table keeps the order of the slots, so the items
+ *  are reinserted by a sequential pass over the old and the new tables.
+ *
+ *  The table is kept at most half full, so it takes 24 to 64 bytes per item,
+ *  compared to 2 to 4 bytes per item for HashTable. The 'next' field of the
+ *  items is only used to mark the unused items (next == -2).
+ */
+template<typename T>
+class OpenHashTable : public BlockArray<T>
+{
+protected:
+   typedef BlockArray<T> Base;
+
+public:
+   OpenHashTable(int block_size = 16*1024, int init_hash_size = 32*1024);
+   OpenHashTable(const OpenHashTable& other); // deep copy
+   ~OpenHashTable();
+
+   /// Get item whose parents are 'p1', 'p2'... Create it if it doesn't exist.
+   T* Get(int p1, int p2);
+   T* Get(int p1, int p2, int p3, int p4 = -1 /* p4 optional */);
+
+   /// Get id of item whose parents are p1, p2... Create it if it doesn't exist.
+   int GetId(int p1, int p2);
+   int GetId(int p1, int p2, int p3, int p4 = -1);
+
+   /// Find item whose parents are p1, p2... Return NULL if it doesn't exist.
+   T* Find(int p1, int p2);
+   T* Find(int p1, int p2, int p3, int p4 = -1);
+
+   const T* Find(int p1, int p2) const;
+   const T* Find(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// Find id of item whose parents are p1, p2... Return -1 if it doesn't exist.
+   int FindId(int p1, int p2) const;
+   int FindId(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// Return the number of elements currently stored in the OpenHashTable.
+   int Size() const { return count; }
+
+   /// Return the total number of ids (used and unused) in the OpenHashTable.
+   int NumIds() const { return Base::Size(); }
+
+   /// Return the number of free/unused ids in the OpenHashTable.
+   int NumFreeIds() const { return unused.Size(); }
+
+   /// Return true if item 'id' exists in (is used by) the container.
+   /** It is assumed that 0 <= id < NumIds(). */
+   bool IdExists(int id) const { return (Base::At(id).next != -2); }
+
+   /// Remove an item from the hash table.
+   /** Its id will be reused by newly added items. */
+   void Delete(int id);
+
+   /// Remove all items.
+   void DeleteAll();
+
+   /// Allocate an item at 'id'. Enlarge the underlying BlockArray if necessary.
+   /** This is a special purpose method used when loading data from a file.
+       Does nothing if the slot 'id' has already been allocated. */
+   void Alloc(int id, int p1, int p2);
+
+   /// Reinitialize the internal list of unallocated items.
+   /** This is a special purpose method used when loading data from a file. */
+   void UpdateUnused();
+
+   /// Make an item hashed under different parent IDs.
+   void Reparent(int id, int new_p1, int new_p2);
+   void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
+
+   /// Return total size of allocated memory (tables plus items), in bytes.
+   long MemoryUsage() const;
+
+   /// Write details of the memory usage to the mfem output stream.
+   void PrintMemoryDetail() const;
+
+   typedef typename HashTable<T>::iterator iterator;
+   typedef typename HashTable<T>::const_iterator const_iterator;
+
+   iterator begin() { return iterator(Base::begin()); }
+   iterator end() { return iterator(); }
+
+   const_iterator cbegin() const { return const_iterator(Base::cbegin()); }
+   const_iterator cend() const { return const_iterator(); }
+
+protected:
+   // A slot of the table holds the parents of an item, the third one only for
+   // Hashed4 items, and its id, or -1 if the slot is empty.
+   struct Slot2 { int p1, p2, id; };
+   struct Slot4 { int p1, p2, p3, id; };
+   typedef typename std::conditional<std::is_base_of<Hashed4, T>::value,
+           Slot4, Slot2>::type Slot;
+
+   Slot* table;
+   int mask;  // size of the table minus one
+   int shift; // 32 minus log2 of the size of the table
+   int count; // number of items in the table
+   Array<int> unused;
+
+   // hash function: the index of the home slot of an item is given by the
+   // high bits (NOTE: the constants are the ones of HashTable)
+   inline int Index(int p1, int p2, int p3) const
+   {
+      return (984120265u*unsigned(p1) + 125965121u*unsigned(p2) +
+              495698413u*unsigned(p3)) >> shift;
+   }
+
+   static inline int P3(const Slot2&) { return -1; }
+   static inline int P3(const Slot4& slot) { return slot.p3; }
+
+   static inline void SetP3(Slot2&, int) { }
+   static inline void SetP3(Slot4& slot, int p3) { slot.p3 = p3; }
+
+   inline int Index(const Slot& slot) const
+   { return Index(slot.p1, slot.p2, P3(slot)); }
+
+   // Delete() and Reparent() use one of these:
+   static inline int P3(const Hashed2&) { return -1; }
+   static inline int P3(const Hashed4& item) { return item.p3; }
+
+   /// Return the slot of the item with the given parents, or the empty slot
+   /// where it would be inserted.
+   inline int Search(int p1, int p2, int p3) const;
+
+   /// Return an unused id, or append a new item.
+   inline int NewId();
+
+   /// Create an item with the given parents in the empty slot 'idx' returned
+   /// by Search(), and return its id.
+   int NewItem(int idx, int p1, int p2, int p3);
+
+   void Insert(int p1, int p2, int p3, int id);
+   void Unlink(int p1, int p2, int p3, int id);
+
+   /// Double the size of the table.
+   void DoRehash();
+};
+
+
 /// Hash function for data sequences.
 /** Depends on GnuTLS for SHA-256 hashing. */
 class HashFunction
@@ -650,6 +810,345 @@ void HashTable<T>::PrintMemoryDetail() const
 }
 
 
+template<typename T>
+OpenHashTable<T>::OpenHashTable(int block_size, int init_hash_size)
+   : Base(block_size), count(0)
+{
+   mask = init_hash_size-1;
+   MFEM_VERIFY(init_hash_size > 1 && !(init_hash_size & mask),
+               "init_size must be a power of two, greater than one.");
+   shift = 32;
+   for (int size = init_hash_size; size > 1; size /= 2) { shift--; }
+
+   table = new Slot[init_hash_size];
+   for (int i = 0; i < init_hash_size; i++)
+   {
+      table[i].id = -1;
+   }
+}
+
+template<typename T>
+OpenHashTable<T>::OpenHashTable(const OpenHashTable& other)
+   : Base(other), mask(other.mask), shift(other.shift), count(other.count)
+{
+   int size = mask+1;
+   table = new Slot[size];
+   memcpy(table, other.table, size*sizeof(Slot));
+   other.unused.Copy(unused);
+}
+
+template<typename T>
+OpenHashTable<T>::~OpenHashTable()
+{
+   delete [] table;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2)
+{
+   return &(Base::At(GetId(p1, p2)));
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2, int p3, int p4)
+{
+   return &(Base::At(GetId(p1, p2, p3, p4)));
+}
+
+template<typename T>
+inline int OpenHashTable<T>::Search(int p1, int p2, int p3) const
+{
+   int idx = Index(p1, p2, p3);
+   for (; table[idx].id >= 0; idx = (idx+1) & mask)
+   {
+      const Slot &slot = table[idx];
+      if (slot.p1 == p1 && slot.p2 == p2 && P3(slot) == p3) { break; }
+   }
+   return idx;
+}
+
+template<typename T>
+inline int OpenHashTable<T>::NewId()
+{
+   if (unused.Size())
+   {
+      int id = unused.Last();
+      unused.DeleteLast();
+      return id;
+   }
+   return Base::Append();
+}
+
+template<typename T>
+int OpenHashTable<T>::NewItem(int idx, int p1, int p2, int p3)
+{
+   // use an unused item or create a new one
+   int new_id = NewId();
+   Base::At(new_id).next = -1;
+
+   // keep the table at most half full
+   if (2*(count+1) > mask+1)
+   {
+      DoRehash();
+      idx = Search(p1, p2, p3);
+   }
+
+   // insert into hashtable
+   Slot &slot = table[idx];
+   slot.p1 = p1;
+   slot.p2 = p2;
+   SetP3(slot, p3);
+   slot.id = new_id;
+   count++;
+
+   return new_id;
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2)
+{
+   // search for the item in the hashtable
+   if (p1 > p2) { std::swap(p1, p2); }
+   int idx = Search(p1, p2, -1);
+   if (table[idx].id >= 0) { return table[idx].id; }
+
+   // not found - create a new item
+   int new_id = NewItem(idx, p1, p2, -1);
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+
+   return new_id;
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2, int p3, int p4)
+{
+   // search for the item in the hashtable
+   internal::sort4_ext(p1, p2, p3, p4);
+   int idx = Search(p1, p2, p3);
+   if (table[idx].id >= 0) { return table[idx].id; }
+
+   // not found - create a new item
+   int new_id = NewItem(idx, p1, p2, p3);
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+   item.p3 = p3;
+
+   return new_id;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2)
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4)
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2) const
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4) const
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2) const
+{
+   if (p1 > p2) { std::swap(p1, p2); }
+   return table[Search(p1, p2, -1)].id;
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2, int p3, int p4) const
+{
+   internal::sort4_ext(p1, p2, p3, p4);
+   return table[Search(p1, p2, p3)].id;
+}
+
+template<typename T>
+void OpenHashTable<T>::Insert(int p1, int p2, int p3, int id)
+{
+   // keep the table at most half full
+   if (2*(count+1) > mask+1) { DoRehash(); }
+
+   // put the item in the first empty slot of its probe sequence
+   int idx = Index(p1, p2, p3);
+   while (table[idx].id >= 0) { idx = (idx+1) & mask; }
+   Slot &slot = table[idx];
+   slot.p1 = p1;
+   slot.p2 = p2;
+   SetP3(slot, p3);
+   slot.id = id;
+   count++;
+}
+
+template<typename T>
+void OpenHashTable<T>::Unlink(int p1, int p2, int p3, int id)
+{
+   int idx = Index(p1, p2, p3);
+   while (table[idx].id != id)
+   {
+      if (table[idx].id < 0)
+      {
+         MFEM_ABORT("OpenHashTable<>::Unlink: item not found!");
+      }
+      idx = (idx+1) & mask;
+   }
+
+   // fill the hole with the next item of the probe sequence that would not be
+   // found behind it, and repeat with the hole left by that item
+   for (int i = (idx+1) & mask; table[i].id >= 0; i = (i+1) & mask)
+   {
+      const Slot &slot = table[i];
+      int home = Index(slot);
+      if (((i - home) & mask) >= ((i - idx) & mask))
+      {
+         table[idx] = slot;
+         idx = i;
+      }
+   }
+   table[idx].id = -1;
+   count--;
+}
+
+template<typename T>
+void OpenHashTable<T>::DoRehash()
+{
+   Slot* old_table = table;
+   int old_table_size = mask+1;
+
+   // double the table size
+   int new_table_size = 2*old_table_size;
+   table = new Slot[new_table_size];
+   for (int i = 0; i < new_table_size; i++) { table[i].id = -1; }
+   mask = new_table_size-1;
+   shift--;
+
+#if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
+   mfem::out << _MFEM_FUNC_NAME << ": rehashing to size " << new_table_size
+             << std::endl;
+#endif
+
+   // reinsert all items: the home slot 'i' of the old table becomes the home
+   // slot '2*i' or '2*i+1' of the new table, so the writes are sequential too
+   for (int i = 0; i < old_table_size; i++)
+   {
+      const Slot &slot = old_table[i];
+      if (slot.id < 0) { continue; }
+      int idx = Index(slot);
+      while (table[idx].id >= 0) { idx = (idx+1) & mask; }
+      table[idx] = slot;
+   }
+   delete [] old_table;
+}
+
+template<typename T>
+void OpenHashTable<T>::Delete(int id)
+{
+   T& item = Base::At(id);
+   Unlink(item.p1, item.p2, P3(item), id);
+   item.next = -2;    // mark item as unused
+   unused.Append(id); // add its id to the unused ids
+}
+
+template<typename T>
+void OpenHashTable<T>::DeleteAll()
+{
+   Base::DeleteAll();
+   for (int i = 0; i <= mask; i++) { table[i].id = -1; }
+   count = 0;
+   unused.DeleteAll();
+}
+
+template<typename T>
+void OpenHashTable<T>::Alloc(int id, int p1, int p2)
+{
+   // enlarge the BlockArray to hold 'id'
+   while (id >= Base::Size())
+   {
+      Base::At(Base::Append()).next = -2; // append "unused" items
+   }
+
+   T& item = Base::At(id);
+   if (item.next == -2)
+   {
+      item.next = -1;
+      item.p1 = p1;
+      item.p2 = p2;
+
+      Insert(p1, p2, -1, id);
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::UpdateUnused()
+{
+   unused.DeleteAll();
+   for (int i = 0; i < Base::Size(); i++)
+   {
+      if (Base::At(i).next == -2) { unused.Append(i); }
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id, int new_p1, int new_p2)
+{
+   T& item = Base::At(id);
+   Unlink(item.p1, item.p2, -1, id);
+
+   if (new_p1 > new_p2) { std::swap(new_p1, new_p2); }
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+
+   // reinsert under new parent IDs
+   Insert(new_p1, new_p2, -1, id);
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id,
+                                int new_p1, int new_p2, int new_p3, int new_p4)
+{
+   T& item = Base::At(id);
+   Unlink(item.p1, item.p2, item.p3, id);
+
+   internal::sort4_ext(new_p1, new_p2, new_p3, new_p4);
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+   item.p3 = new_p3;
+
+   // reinsert under new parent IDs
+   Insert(new_p1, new_p2, new_p3, id);
+}
+
+template<typename T>
+long OpenHashTable<T>::MemoryUsage() const
+{
+   return (mask+1) * sizeof(Slot) + Base::MemoryUsage() + unused.MemoryUsage();
+}
+
+template<typename T>
+void OpenHashTable<T>::PrintMemoryDetail() const
+{
+   mfem::out << Base::MemoryUsage() << " + " << (mask+1) * sizeof(Slot)
+             << " + " << unused.MemoryUsage();
+}
+
 template <typename int_type_const_iter>
 HashFunction &HashFunction::EncodeAndHashInts(int_type_const_iter begin,
                                               int_type_const_iter end)
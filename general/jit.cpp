@@ -0,0 +1,282 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "jit.hpp"
+#include "error.hpp"
+
+#ifdef MFEM_USE_JIT
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef MFEM_JIT_CXX
+#define MFEM_JIT_CXX "c++"
+#endif
+
+namespace mfem
+{
+
+namespace jit
+{
+
+static const char *GetEnv(const char *name, const char *default_value)
+{
+   const char *value = std::getenv(name);
+   return (value && value[0]) ? value : default_value;
+}
+
+bool Enabled()
+{
+   static const bool enabled = std::strcmp(GetEnv("MFEM_JIT", "1"), "0");
+   return enabled;
+}
+
+// 64-bit FNV-1a hash of the string s, as a hexadecimal string.
+static std::string Hash(const std::string &s)
+{
+   unsigned long long h = 0xcbf29ce484222325ULL;
+   for (size_t i = 0; i < s.size(); i++)
+   {
+      h ^= (unsigned char) s[i];
+      h *= 0x100000001b3ULL;
+   }
+   char buf[17];
+   std::snprintf(buf, sizeof(buf), "%016llx", h);
+   return buf;
+}
+
+static bool FileExists(const std::string &name)
+{
+   struct stat st;
+   return stat(name.c_str(), &st) == 0;
+}
+
+// Return the directory from which the MFEM headers are included.
+static std::string IncludeDir()
+{
+   const std::string install_dir = MFEM_INSTALL_DIR "/include/mfem";
+   if (FileExists(install_dir + "/general/forall.hpp"))
+   {
+      return install_dir;
+   }
+   return MFEM_SOURCE_DIR;
+}
+
+// Append to @a contents the contents of the file @a name and, recursively, of
+// the files it includes with #include "...", each file at most once. Relative
+// names are looked up in the directory @a dir of the including file, then in
+// the MFEM include directory.
+static void AppendIncludes(const std::string &name, const std::string &dir,
+                           std::set<std::string> &seen, std::string &contents)
+{
+   std::string path = name;
+   if (name.empty() || name[0] != '/')
+   {
+      path = dir + "/" + name;
+      if (!FileExists(path)) { path = IncludeDir() + "/" + name; }
+   }
+   if (!seen.insert(path).second) { return; }
+   std::ifstream file(path.c_str());
+   if (!file) { return; }
+   const std::string path_dir = path.substr(0, path.find_last_of('/'));
+   std::string line;
+   while (std::getline(file, line))
+   {
+      contents += line;
+      contents += '\n';
+      const size_t p = line.find_first_not_of(" \t");
+      if (p == std::string::npos || line[p] != '#') { continue; }
+      const size_t inc = line.find("include", p);
+      const size_t b = line.find('"', p);
+      if (inc == std::string::npos || b == std::string::npos || b < inc)
+      {
+         continue;
+      }
+      const size_t e = line.find('"', b + 1);
+      if (e == std::string::npos) { continue; }
+      AppendIncludes(line.substr(b + 1, e - b - 1), path_dir, seen, contents);
+   }
+}
+
+// Return the preamble of all kernel sources: the out-of-source configuration
+// file of the build tree, if any.
+static std::string Preamble()
+{
+   std::string preamble;
+#ifdef MFEM_CONFIG_FILE
+   const std::string install_dir = MFEM_INSTALL_DIR "/include/mfem";
+   if (!FileExists(install_dir + "/general/forall.hpp"))
+   {
+      preamble += "#define MFEM_CONFIG_FILE \"" MFEM_CONFIG_FILE "\"\n";
+   }
+#endif
+   return preamble;
+}
+
+// Return the command line used to compile the kernels, without the files.
+static std::string Command()
+{
+   const std::string cxx = GetEnv("MFEM_JIT_CXX", MFEM_JIT_CXX);
+   const std::string flags = GetEnv("MFEM_JIT_CXXFLAGS", "-O3 -std=c++11");
+   return cxx + " " + flags + " -fPIC -shared -I" + IncludeDir();
+}
+
+std::string SourceHash(const std::string &source)
+{
+   std::string key = MFEM_VERSION_STRING "\n" + Command() + '\n' + source;
+   std::set<std::string> seen;
+#ifdef MFEM_CONFIG_FILE
+   AppendIncludes(MFEM_CONFIG_FILE, IncludeDir(), seen, key);
+#endif
+   std::istringstream lines(source);
+   std::string line;
+   while (std::getline(lines, line))
+   {
+      const size_t b = line.find("#include \"");
+      if (b == std::string::npos) { continue; }
+      const size_t e = line.find('"', b + 10);
+      if (e == std::string::npos) { continue; }
+      AppendIncludes(line.substr(b + 10, e - b - 10), IncludeDir(), seen, key);
+   }
+   return Hash(key);
+}
+
+void *Lookup(const std::string &symbol, const std::string &source)
+{
+   static std::map<std::string, void*> kernels;
+   const std::string key = symbol + '\n' + source;
+   std::map<std::string, void*>::iterator it = kernels.find(key);
+   if (it != kernels.end()) { return it->second; }
+   void *&kernel = kernels[key];
+   kernel = NULL;
+
+   const std::string dir = GetEnv("MFEM_JIT_CACHE_DIR", ".mfem_jit_cache");
+   const std::string command = Command();
+   const std::string base = dir + "/" + symbol + "_" + SourceHash(source);
+   const std::string lib = base + ".so";
+
+   if (!FileExists(lib))
+   {
+      if (mkdir(dir.c_str(), 0775) != 0 && !FileExists(dir))
+      {
+         MFEM_WARNING("cannot create the JIT cache directory " << dir);
+         return NULL;
+      }
+      // Several processes may compile the same kernel: each one writes its
+      // own files, and the shared object is renamed into place atomically.
+      std::ostringstream pid;
+      pid << '.' << getpid();
+      const std::string src = base + pid.str() + ".cpp";
+      const std::string tmp = base + pid.str() + ".so";
+      {
+         std::ofstream out(src.c_str());
+         out << source;
+      }
+      const std::string cmd = command + " -o " + tmp + " " + src;
+      const int status = std::system(cmd.c_str());
+      std::remove(src.c_str());
+      if (status != 0 || std::rename(tmp.c_str(), lib.c_str()) != 0)
+      {
+         std::remove(tmp.c_str());
+         MFEM_WARNING("JIT compilation of " << symbol << " failed: " << cmd);
+         return NULL;
+      }
+   }
+
+   void *handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+   if (handle) { kernel = dlsym(handle, symbol.c_str()); }
+   if (!kernel)
+   {
+      MFEM_WARNING("cannot load the JIT kernel " << symbol << " from " << lib
+                   << ": " << dlerror());
+   }
+   return kernel;
+}
+
+void *GetKernel(const char *header, const char *kernel,
+                const std::vector<int> &targs, const char *params,
+                const char *args)
+{
+   if (!Enabled()) { return NULL; }
+   std::ostringstream symbol, tlist;
+   symbol << "mfem_jit_" << kernel;
+   for (size_t i = 0; i < targs.size(); i++)
+   {
+      symbol << '_' << targs[i];
+      tlist << (i ? "," : "") << targs[i];
+   }
+   std::ostringstream source;
+   source << Preamble()
+          << "#include \"" << header << "\"\n"
+          << "extern \"C\" void " << symbol.str() << "(" << params << ")\n"
+          << "{\n"
+          << "   mfem::internal::" << kernel << "<" << tlist.str() << ">("
+          << args << ");\n"
+          << "}\n";
+   return Lookup(symbol.str(), source.str());
+}
+
+} // namespace jit
+
+} // namespace mfem
+
+#else // MFEM_USE_JIT
+
+namespace mfem
+{
+
+namespace jit
+{
+
+bool Enabled() { return false; }
+
+void *Lookup(const std::string &symbol, const std::string &source)
+{
+   MFEM_CONTRACT_VAR(symbol);
+   MFEM_CONTRACT_VAR(source);
+   MFEM_ABORT("MFEM was built without MFEM_USE_JIT");
+   return NULL;
+}
+
+std::string SourceHash(const std::string &source)
+{
+   MFEM_CONTRACT_VAR(source);
+   MFEM_ABORT("MFEM was built without MFEM_USE_JIT");
+   return std::string();
+}
+
+void *GetKernel(const char *header, const char *kernel,
+                const std::vector<int> &targs, const char *params,
+                const char *args)
+{
+   MFEM_CONTRACT_VAR(header);
+   MFEM_CONTRACT_VAR(kernel);
+   MFEM_CONTRACT_VAR(targs);
+   MFEM_CONTRACT_VAR(params);
+   MFEM_CONTRACT_VAR(args);
+   return NULL;
+}
+
+} // namespace jit
+
+} // namespace mfem
+
+#endif // MFEM_USE_JIT
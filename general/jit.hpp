@@ -0,0 +1,78 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_JIT_HPP
+#define MFEM_JIT_HPP
+
+#include "../config/config.hpp"
+
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Just-in-time compilation of host kernels, enabled with the build
+    option MFEM_USE_JIT.
+
+    Kernel templates from the MFEM headers are instantiated for the requested
+    template arguments by the host C++ compiler, at first use. The resulting
+    shared objects are stored in an on-disk cache, keyed by SourceHash(), and
+    are loaded with dlopen on subsequent runs.
+
+    The JIT kernels are the element kernels of the partially assembled mass
+    and diffusion operators, for the orders without a precompiled
+    instantiation. They run on the host, threaded with OpenMP under the 'omp'
+    backend; the QuadratureInterpolator kernels are not JIT-compiled.
+
+    The behavior can be changed at runtime with the environment variables:
+    - MFEM_JIT: set to 0 to disable the JIT compilation;
+    - MFEM_JIT_CACHE_DIR: the cache directory (default: .mfem_jit_cache);
+    - MFEM_JIT_CXX: the compiler (default: the compiler used to build MFEM);
+    - MFEM_JIT_CXXFLAGS: the compiler flags (default: "-O3 -std=c++11"). */
+namespace jit
+{
+
+/// Return true if MFEM was built with MFEM_USE_JIT and the JIT is enabled.
+bool Enabled();
+
+/** @brief Return the hash identifying the compiled @a source in the on-disk
+    cache.
+
+    The hash covers the MFEM version, the compiler command line, the source,
+    the configuration file and the contents of the headers included by the
+    source with #include "...", recursively. */
+std::string SourceHash(const std::string &source);
+
+/** @brief Return the address of the C function @a symbol defined by the C++
+    @a source, compiling it into the on-disk cache if needed.
+
+    Returns NULL, and prints a warning, if the compilation or the loading of the
+    shared object fails. The results are cached, so subsequent calls with the
+    same arguments are cheap. */
+void *Lookup(const std::string &symbol, const std::string &source);
+
+/** @brief Return the address of the instantiation of the kernel template
+    mfem::internal::@a kernel<@a targs...>, defined in the MFEM header
+    @a header (given relative to the MFEM source directory).
+
+    The kernel is wrapped in a C function with parameters @a params (e.g.
+    "const int e, const double *x"), that calls the kernel with the arguments
+    @a args (e.g. "e, x"). Returns NULL if the JIT is disabled or fails. */
+void *GetKernel(const char *header, const char *kernel,
+                const std::vector<int> &targs, const char *params,
+                const char *args);
+
+} // namespace jit
+
+} // namespace mfem
+
+#endif // MFEM_JIT_HPP
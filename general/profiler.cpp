@@ -0,0 +1,454 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "profiler.hpp"
+#include "globals.hpp"
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MFEM_PROFILER_RDTSC
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mfem
+{
+
+namespace
+{
+
+// Return false if the profiling was disabled with MFEM_PROFILE.
+bool ProfilingRequested()
+{
+   const char *env = std::getenv("MFEM_PROFILE");
+   return !env || (std::strcmp(env, "0") && std::strcmp(env, "off"));
+}
+
+} // anonymous namespace
+
+bool Profiler::enabled = ProfilingRequested();
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+// A fast, monotonic tick counter: reading the steady clock may take tens of
+// nanoseconds, which is too slow for timing small kernels. The ticks are
+// converted to seconds by comparing with the steady clock over the whole run.
+inline unsigned long long Ticks()
+{
+#ifdef MFEM_PROFILER_RDTSC
+   return __rdtsc();
+#else
+   return Clock::now().time_since_epoch().count();
+#endif
+}
+
+struct Region
+{
+   const char *key; // the name passed to Profiler::Begin()
+   std::string name; // the shortened name
+   int parent;
+   long calls;
+   double ticks, bytes, flops;
+   std::vector<int> children;
+};
+
+struct Frame
+{
+   int region;
+   unsigned long long start;
+};
+
+// Shorten a function signature "void mfem::A::f(int) const" to "mfem::A::f",
+// and a file location "/path/file.cpp:12" to "file.cpp:12".
+std::string ShortName(const char *key)
+{
+   std::string name(key);
+   const size_t paren = name.find('(');
+   if (paren != std::string::npos && paren > 0 && name[paren-1] != ' ')
+   {
+      size_t begin = name.rfind(' ', paren);
+      begin = (begin == std::string::npos) ? 0 : begin + 1;
+      return name.substr(begin, paren - begin);
+   }
+   const size_t slash = name.find_last_of("/\\");
+   if (paren == std::string::npos && slash != std::string::npos)
+   {
+      return name.substr(slash + 1);
+   }
+   return name;
+}
+
+struct Registry
+{
+   std::vector<Region> regions; // regions[0] is the root
+   std::vector<Frame> stack;
+   unsigned long generation; // incremented by Clear(), see Profiler::Site
+   Clock::time_point start;
+   unsigned long long start_ticks;
+   std::thread::id owner;
+   int report; // 0: none, 1: text, 2: JSON
+   std::string json_file;
+   bool rank_known;
+   int rank, nranks;
+
+   Registry();
+
+   void Clear();
+
+   // Return the child of 'parent' with the given key, adding it if needed.
+   int Child(int parent, const char *key);
+
+   void SetRank();
+
+   // Return the number of seconds per tick, see Ticks().
+   double TickTime() const;
+
+   // Return the time of the region 'id' in seconds.
+   double Time(int id) const { return regions[id].ticks * TickTime(); }
+};
+
+void PrintReport();
+
+Registry::Registry()
+   : generation(0), owner(std::this_thread::get_id()), report(0),
+     rank_known(false), rank(0), nranks(1)
+{
+   Clear();
+
+   const char *env = std::getenv("MFEM_PROFILE");
+   if (env)
+   {
+      const std::string mode(env);
+      if (mode.compare(0, 4, "json") == 0)
+      {
+         report = 2;
+         json_file = (mode.size() > 5 && mode[4] == ':') ?
+                     mode.substr(5) : "mfem_profile.json";
+      }
+      else if (mode != "0" && mode != "off")
+      {
+         report = 1;
+      }
+   }
+   if (report) { std::atexit(PrintReport); }
+#ifndef MFEM_USE_MPI
+   rank_known = true;
+#endif
+}
+
+void Registry::Clear()
+{
+   regions.resize(1);
+   Region &root = regions[0];
+   root.key = "";
+   root.name = "total";
+   root.parent = -1;
+   root.calls = 1;
+   root.ticks = root.bytes = root.flops = 0.0;
+   root.children.clear();
+   stack.clear();
+   generation++;
+   start = Clock::now();
+   start_ticks = Ticks();
+}
+
+int Registry::Child(int parent, const char *key)
+{
+   const std::vector<int> &children = regions[parent].children;
+   for (size_t i = 0; i < children.size(); i++)
+   {
+      if (regions[children[i]].key == key) { return children[i]; }
+   }
+   for (size_t i = 0; i < children.size(); i++)
+   {
+      if (std::strcmp(regions[children[i]].key, key) == 0)
+      {
+         return children[i];
+      }
+   }
+   Region r;
+   r.key = key;
+   r.name = ShortName(key);
+   r.parent = parent;
+   r.calls = 0;
+   r.ticks = r.bytes = r.flops = 0.0;
+   regions.push_back(r);
+   const int id = (int) regions.size() - 1;
+   regions[parent].children.push_back(id);
+   return id;
+}
+
+void Registry::SetRank()
+{
+#ifdef MFEM_USE_MPI
+   int initialized, finalized;
+   MPI_Initialized(&initialized);
+   MPI_Finalized(&finalized);
+   if (initialized && !finalized)
+   {
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+      rank_known = true;
+   }
+#endif
+}
+
+double Registry::TickTime() const
+{
+   const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+   const unsigned long long ticks = Ticks() - start_ticks;
+   return ticks ? seconds / ticks : 0.0;
+}
+
+Registry &GetRegistry()
+{
+   // Never deleted, so that the report can be printed at exit.
+   static Registry *registry = new Registry;
+   return *registry;
+}
+
+void PrintReport()
+{
+   Registry &reg = GetRegistry();
+   if (reg.report == 1)
+   {
+      Profiler::Print(mfem::out);
+   }
+   else if (reg.report == 2)
+   {
+      std::string file = reg.json_file;
+      if (reg.nranks > 1)
+      {
+         std::ostringstream suffix;
+         suffix << '.' << reg.rank;
+         file += suffix.str();
+      }
+      std::ofstream out(file.c_str());
+      Profiler::PrintJSON(out);
+   }
+}
+
+// Return the children of region 'id', by decreasing time.
+std::vector<int> SortedChildren(const Registry &reg, int id)
+{
+   std::vector<int> children = reg.regions[id].children;
+   std::stable_sort(children.begin(), children.end(), [&](int a, int b)
+   {
+      return reg.regions[a].ticks > reg.regions[b].ticks;
+   });
+   return children;
+}
+
+void PrintRegion(const Registry &reg, int id, int depth, double tick_time,
+                 std::ostream &out)
+{
+   const Region &r = reg.regions[id];
+   double self = r.ticks;
+   for (size_t i = 0; i < r.children.size(); i++)
+   {
+      self -= reg.regions[r.children[i]].ticks;
+   }
+   const double time = r.ticks * tick_time, total = reg.regions[0].ticks;
+   out << std::setw(10) << r.calls
+       << std::setw(12) << time
+       << std::setw(12) << self * tick_time
+       << std::setw(8) << std::setprecision(3)
+       << (total > 0.0 ? 100.0*r.ticks/total : 0.0)
+       << std::setprecision(4)
+       << std::setw(10) << (time > 0.0 ? 1e-9*r.bytes/time : 0.0)
+       << std::setw(10) << (time > 0.0 ? 1e-9*r.flops/time : 0.0)
+       << "  " << std::string(2*depth, ' ') << r.name << '\n';
+
+   const std::vector<int> children = SortedChildren(reg, id);
+   for (size_t i = 0; i < children.size(); i++)
+   {
+      PrintRegion(reg, children[i], depth + 1, tick_time, out);
+   }
+}
+
+void PrintJSONString(const std::string &s, std::ostream &out)
+{
+   out << '"';
+   for (size_t i = 0; i < s.size(); i++)
+   {
+      if (s[i] == '"' || s[i] == '\\') { out << '\\'; }
+      out << s[i];
+   }
+   out << '"';
+}
+
+void PrintJSONRegion(const Registry &reg, int id, int depth, double tick_time,
+                     std::ostream &out)
+{
+   const Region &r = reg.regions[id];
+   const std::string indent(2*depth, ' ');
+   out << indent << "{ \"name\": ";
+   PrintJSONString(r.name, out);
+   out << ", \"calls\": " << r.calls << ", \"time\": " << r.ticks * tick_time
+       << ", \"bytes\": " << r.bytes << ", \"flops\": " << r.flops
+       << ", \"children\": [";
+   const std::vector<int> children = SortedChildren(reg, id);
+   for (size_t i = 0; i < children.size(); i++)
+   {
+      out << (i ? ",\n" : "\n");
+      PrintJSONRegion(reg, children[i], depth + 1, tick_time, out);
+   }
+   out << (children.size() ? "\n" + indent : std::string()) << "] }";
+}
+
+} // anonymous namespace
+
+void Profiler::Enable(bool on)
+{
+   enabled = on;
+}
+
+int Profiler::Begin(const char *name)
+{
+   Registry &reg = GetRegistry();
+   if (!enabled || std::this_thread::get_id() != reg.owner) { return -1; }
+   if (!reg.rank_known) { reg.SetRank(); }
+
+   const int parent = reg.stack.empty() ? 0 : reg.stack.back().region;
+   const int id = reg.Child(parent, name);
+   Frame frame;
+   frame.region = id;
+   frame.start = Ticks();
+   reg.stack.push_back(frame);
+   return id;
+}
+
+int Profiler::Begin(const char *name, Site &site)
+{
+   Registry &reg = GetRegistry();
+   if (!enabled || std::this_thread::get_id() != reg.owner) { return -1; }
+   if (!reg.rank_known) { reg.SetRank(); }
+
+   const int parent = reg.stack.empty() ? 0 : reg.stack.back().region;
+   if (site.generation != reg.generation || site.parent != parent)
+   {
+      site.parent = parent;
+      site.region = reg.Child(parent, name);
+      site.generation = reg.generation;
+   }
+   Frame frame;
+   frame.region = site.region;
+   frame.start = Ticks();
+   reg.stack.push_back(frame);
+   return site.region;
+}
+
+void Profiler::End(int id)
+{
+   Registry &reg = GetRegistry();
+   // The region may be missing, e.g. after Reset().
+   if (reg.stack.empty() || reg.stack.back().region != id) { return; }
+
+   Region &r = reg.regions[id];
+   r.calls++;
+   const unsigned long long start = reg.stack.back().start, end = Ticks();
+   if (end > start) { r.ticks += end - start; }
+   reg.stack.pop_back();
+}
+
+void Profiler::End(const char *name)
+{
+   Registry &reg = GetRegistry();
+   if (reg.stack.empty() || std::this_thread::get_id() != reg.owner) { return; }
+
+   const int id = reg.stack.back().region;
+   const char *key = reg.regions[id].key;
+   if (key == name || std::strcmp(key, name) == 0) { End(id); }
+}
+
+void Profiler::AddWork(double bytes, double flops)
+{
+   Registry &reg = GetRegistry();
+   if (std::this_thread::get_id() != reg.owner) { return; }
+
+   Region &r = reg.regions[reg.stack.empty() ? 0 : reg.stack.back().region];
+   r.bytes += bytes;
+   r.flops += flops;
+}
+
+void Profiler::Reset()
+{
+   GetRegistry().Clear();
+}
+
+Profiler::Stats Profiler::GetStats(const char *name)
+{
+   const Registry &reg = GetRegistry();
+   Stats stats;
+   stats.calls = 0;
+   stats.time = stats.bytes = stats.flops = 0.0;
+   for (size_t i = 1; i < reg.regions.size(); i++)
+   {
+      const Region &r = reg.regions[i];
+      if (r.name != name) { continue; }
+      stats.calls += r.calls;
+      stats.time += reg.Time(i);
+      stats.bytes += r.bytes;
+      stats.flops += r.flops;
+   }
+   return stats;
+}
+
+void Profiler::Print(std::ostream &out)
+{
+   Registry &reg = GetRegistry();
+   reg.regions[0].ticks = Ticks() - reg.start_ticks;
+
+   const std::ios::fmtflags flags = out.flags();
+   const std::streamsize precision = out.precision();
+   out << std::setprecision(4)
+       << std::setw(10) << "calls"
+       << std::setw(12) << "time [s]"
+       << std::setw(12) << "self [s]"
+       << std::setw(8) << "%"
+       << std::setw(10) << "GB/s"
+       << std::setw(10) << "GFlop/s"
+       << "  region\n";
+   PrintRegion(reg, 0, 0, reg.TickTime(), out);
+   out.flags(flags);
+   out.precision(precision);
+}
+
+void Profiler::PrintJSON(std::ostream &out)
+{
+   Registry &reg = GetRegistry();
+   reg.regions[0].ticks = Ticks() - reg.start_ticks;
+
+   const std::streamsize precision = out.precision();
+   out << std::setprecision(8);
+   PrintJSONRegion(reg, 0, 0, reg.TickTime(), out);
+   out << '\n';
+   out.precision(precision);
+}
+
+} // namespace mfem
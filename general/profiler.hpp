@@ -0,0 +1,130 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+
+#include <iostream>
+
+namespace mfem
+{
+
+/** @brief A lightweight registry of timed code regions, used by the
+    MFEM_PERF_* macros from annotation.hpp when MFEM is built without Caliper.
+
+    Regions are nested: a region opened while another one is open is recorded
+    as its child, so the same region reached from two different callers gives
+    two entries. For every region, the number of calls, the inclusive wall
+    time, and optional estimates of the bytes moved and of the floating point
+    operations (see AddWork()) are accumulated.
+
+    Only the regions opened by the thread that first used the profiler are
+    recorded. Device kernels are launched asynchronously, so their time is
+    attributed to the region where the device is synchronized.
+
+    Profiling is enabled by default, and is controlled at runtime by the
+    environment variable MFEM_PROFILE, or by Enable(). The regions opened at
+    the MFEM_PERF_* call sites are cached (see Site), so that an enabled region
+    costs a few tens of nanoseconds; when disabled, a region costs a single
+    test.
+    - MFEM_PROFILE unset: record the regions, without a report at exit;
+    - MFEM_PROFILE=0 or off: do not record the regions;
+    - MFEM_PROFILE=1 or text: print the report with Print() at exit;
+    - MFEM_PROFILE=json or json:<file>: write the report in JSON format with
+      PrintJSON() at exit, to <file> (default: mfem_profile.json). In parallel,
+      the suffix .<rank> is added to the file name. */
+class Profiler
+{
+public:
+   /** @brief Cache of the region opened at a call site, see ProfilerScope.
+
+       A zero-initialized static instance is valid: it does not match any
+       region. */
+   struct Site
+   {
+      int parent, region;
+      unsigned long generation;
+   };
+
+   /// Statistics of a region, see GetStats().
+   struct Stats
+   {
+      long calls;
+      double time, bytes, flops;
+   };
+
+   /// Return true if the regions are being recorded.
+   static bool Enabled() { return enabled; }
+
+   /// Start (@a on = true) or stop recording the regions.
+   static void Enable(bool on = true);
+
+   /** @brief Open the region @a name, as a child of the innermost open region.
+       Return an identifier to be passed to End(), or -1 if the region is not
+       recorded. */
+   /** The string @a name must outlive the profiler, e.g. be a string literal.
+       Function names (see MFEM_PERF_FUNCTION) are shortened to the qualified
+       function name, and file names (see MFEM_FORALL) to the base name. */
+   static int Begin(const char *name);
+
+   /** @brief Same as Begin(const char*), using the cache @a site to skip the
+       search for the region when the call site is reached again from the same
+       parent region. */
+   static int Begin(const char *name, Site &site);
+
+   /// Close the innermost open region, returned by Begin() as @a id.
+   static void End(int id);
+
+   /// Close the innermost open region if its name is @a name.
+   static void End(const char *name);
+
+   /** @brief Add estimates of the bytes moved and of the floating point
+       operations performed to the innermost open region. */
+   static void AddWork(double bytes, double flops);
+
+   /// Clear all the recorded regions.
+   static void Reset();
+
+   /** @brief Return the statistics of all the regions with the (shortened)
+       name @a name, summed over their callers. */
+   static Stats GetStats(const char *name);
+
+   /// Print the recorded regions as an indented tree with one line per region.
+   static void Print(std::ostream &out);
+
+   /// Print the recorded regions in JSON format.
+   static void PrintJSON(std::ostream &out);
+
+private:
+   static bool enabled;
+};
+
+/// Record a region from its construction to its destruction.
+class ProfilerScope
+{
+private:
+   int id;
+
+public:
+   explicit ProfilerScope(const char *name)
+      : id(Profiler::Enabled() ? Profiler::Begin(name) : -1) { }
+
+   ProfilerScope(const char *name, Profiler::Site &site)
+      : id(Profiler::Enabled() ? Profiler::Begin(name, site) : -1) { }
+
+   ~ProfilerScope() { if (id >= 0) { Profiler::End(id); } }
+};
+
+} // namespace mfem
+
+#endif // MFEM_PROFILER_HPP
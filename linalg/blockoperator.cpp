@@ -11,8 +11,10 @@
 
 
 #include "../general/array.hpp"
+#include "../general/annotation.hpp"
 #include "operator.hpp"
 #include "blockvector.hpp"
+#include "multivector.hpp"
 #include "blockoperator.hpp"
 
 namespace mfem
@@ -71,6 +73,7 @@ void BlockOperator::SetBlock(int iRow, int iCol, Operator *opt, double c)
 // Operator application
 void BlockOperator::Mult (const Vector & x, Vector & y) const
 {
+   MFEM_PERF_FUNCTION;
    MFEM_ASSERT(x.Size() == width, "incorrect input Vector size");
    MFEM_ASSERT(y.Size() == height, "incorrect output Vector size");
 
@@ -99,6 +102,38 @@ void BlockOperator::Mult (const Vector & x, Vector & y) const
    }
 }
 
+void BlockOperator::MultMany(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_ASSERT(X.VectorSize() == width, "incorrect input MultiVector size");
+   MFEM_ASSERT(Y.VectorSize() == height && Y.NumVectors() == X.NumVectors(),
+               "incorrect output MultiVector size");
+
+   const int nv = X.NumVectors();
+   Y.UseDevice(true);
+   Y = 0.0;
+
+   // The entries of a block are not contiguous in a MultiVector, so the
+   // blocks of X and of the products are copied.
+   MultiVector xblk, yblk;
+   for (int jCol=0; jCol < nColBlocks; ++jCol)
+   {
+      bool extracted = false;
+      for (int iRow=0; iRow < nRowBlocks; ++iRow)
+      {
+         if (!op(iRow,jCol)) { continue; }
+         if (!extracted)
+         {
+            X.GetRows(col_offsets[jCol],
+                      col_offsets[jCol+1] - col_offsets[jCol], xblk);
+            extracted = true;
+         }
+         yblk.SetSize(row_offsets[iRow+1] - row_offsets[iRow], nv);
+         op(iRow,jCol)->MultMany(xblk, yblk);
+         Y.AddRows(row_offsets[iRow], yblk, coef(iRow,jCol));
+      }
+   }
+}
+
 // Action of the transpose operator
 void BlockOperator::MultTranspose (const Vector & x, Vector & y) const
 {
@@ -104,6 +104,10 @@ public:
    /// Operator application
    virtual void Mult (const Vector & x, Vector & y) const;
 
+   /** @brief Operator application to all the vectors of @a X, using the
+       MultMany() method of the blocks. */
+   virtual void MultMany(const MultiVector &X, MultiVector &Y) const;
+
    /// Action of the transpose operator
    virtual void MultTranspose (const Vector & x, Vector & y) const;
 
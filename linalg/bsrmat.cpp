@@ -0,0 +1,430 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the block compressed sparse row matrix
+
+#include "bsrmat.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+BSRMatrix::BSRMatrix(const Table &pattern, int nbcols_, int bsize_,
+                     bool byvdim_)
+   : Operator(pattern.Size()*bsize_, nbcols_*bsize_),
+     nbrows(pattern.Size()), nbcols(nbcols_), bsize(bsize_), byvdim(byvdim_)
+{
+   I.SetSize(nbrows+1);
+   for (int i = 0; i <= nbrows; i++) { I[i] = pattern.GetI()[i]; }
+   J.SetSize(I[nbrows]);
+   for (int k = 0; k < J.Size(); k++)
+   {
+      J[k] = pattern.GetJ()[k];
+      MFEM_VERIFY(0 <= J[k] && J[k] < nbcols, "invalid block column index");
+   }
+   for (int i = 0; i < nbrows; i++)
+   {
+      std::sort(J.GetData() + I[i], J.GetData() + I[i+1]);
+   }
+   A.SetSize(bsize, bsize, J.Size());
+   A = 0.0;
+}
+
+BSRMatrix::BSRMatrix(const SparseMatrix &mat, int bsize_, bool byvdim_)
+   : Operator(mat.Height(), mat.Width()),
+     nbrows(mat.Height()/bsize_), nbcols(mat.Width()/bsize_), bsize(bsize_),
+     byvdim(byvdim_)
+{
+   MFEM_VERIFY(mat.Finalized(), "the SparseMatrix must be finalized");
+   MFEM_VERIFY(nbrows*bsize == height && nbcols*bsize == width,
+               "the matrix size is not divisible by the block size");
+
+   const int *mI = mat.HostReadI();
+   const int *mJ = mat.HostReadJ();
+   const double *mA = mat.HostReadData();
+
+   // Block sparsity pattern: the union of the patterns of the scalar rows of
+   // each block row.
+   Array<int> marker(nbcols);
+   marker = -1;
+   I.SetSize(nbrows+1);
+   I[0] = 0;
+   for (int i = 0; i < nbrows; i++)
+   {
+      I[i+1] = I[i];
+      for (int c = 0; c < bsize; c++)
+      {
+         const int r = RowIndex(i, c);
+         for (int m = mI[r]; m < mI[r+1]; m++)
+         {
+            const int j = byvdim ? mJ[m]/bsize : mJ[m]%nbcols;
+            if (marker[j] != i) { marker[j] = i; I[i+1]++; }
+         }
+      }
+   }
+   marker = -1;
+   J.SetSize(I[nbrows]);
+   for (int i = 0; i < nbrows; i++)
+   {
+      int k = I[i];
+      for (int c = 0; c < bsize; c++)
+      {
+         const int r = RowIndex(i, c);
+         for (int m = mI[r]; m < mI[r+1]; m++)
+         {
+            const int j = byvdim ? mJ[m]/bsize : mJ[m]%nbcols;
+            if (marker[j] != i) { marker[j] = i; J[k++] = j; }
+         }
+      }
+      std::sort(J.GetData() + I[i], J.GetData() + I[i+1]);
+   }
+
+   A.SetSize(bsize, bsize, J.Size());
+   A = 0.0;
+   double *Ad = A.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int c = 0; c < bsize; c++)
+      {
+         const int r = RowIndex(i, c);
+         for (int m = mI[r]; m < mI[r+1]; m++)
+         {
+            const int j = byvdim ? mJ[m]/bsize : mJ[m]%nbcols;
+            const int d = byvdim ? mJ[m]%bsize : mJ[m]/nbcols;
+            Ad[c + bsize*(d + bsize*FindBlock(i, j))] += mA[m];
+         }
+      }
+   }
+}
+
+int BSRMatrix::FindBlock(int i, int j) const
+{
+   const int *begin = J.GetData() + I[i], *end = J.GetData() + I[i+1];
+   const int *pos = std::lower_bound(begin, end, j);
+   return (pos != end && *pos == j) ? int(pos - J.GetData()) : -1;
+}
+
+void BSRMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                             const DenseMatrix &subm)
+{
+   const int nr = rows.Size(), nc = cols.Size();
+   MFEM_ASSERT(subm.Height() == nr*bsize && subm.Width() == nc*bsize,
+               "invalid size of the dense matrix");
+   const int bs2 = bsize*bsize;
+   double *Ad = A.HostReadWrite();
+   for (int r = 0; r < nr; r++)
+   {
+      const int i = (rows[r] >= 0) ? rows[r] : -1-rows[r];
+      for (int s = 0; s < nc; s++)
+      {
+         const int j = (cols[s] >= 0) ? cols[s] : -1-cols[s];
+         const double sign = ((rows[r] >= 0) == (cols[s] >= 0)) ? 1.0 : -1.0;
+         const int k = FindBlock(i, j);
+         MFEM_VERIFY(k >= 0, "block (" << i << "," << j << ") is not in the "
+                     "sparsity pattern");
+         double *blk = Ad + bs2*k;
+         for (int d = 0; d < bsize; d++)
+         {
+            for (int c = 0; c < bsize; c++)
+            {
+               blk[c + bsize*d] += sign*subm(r + c*nr, s + d*nc);
+            }
+         }
+      }
+   }
+}
+
+BSRMatrix &BSRMatrix::operator=(double a)
+{
+   A = a;
+   return *this;
+}
+
+void BSRMatrix::GetDiag(Vector &d) const
+{
+   MFEM_VERIFY(nbrows == nbcols, "the matrix must be square");
+   d.SetSize(height);
+   const double *Ad = A.HostRead();
+   for (int i = 0; i < nbrows; i++)
+   {
+      const int k = FindBlock(i, i);
+      for (int c = 0; c < bsize; c++)
+      {
+         d(RowIndex(i, c)) = (k >= 0) ? Ad[c*(bsize+1) + bsize*bsize*k] : 0.0;
+      }
+   }
+}
+
+// BSR matrix-vector product y += a A x. When the block size T_BS is known at
+// compile time, the block products are unrolled and vectorized by the
+// compiler, working on local copies of the block components of x and y. The
+// strides xs and ys are the distances between the components of a block
+// column or row, xb and yb the distances between consecutive blocks.
+template <int T_BS = 0>
+static void BSRAddMult(const int nbrows, const int bs_,
+                       const int xs, const int xb, const int ys, const int yb,
+                       const int *I, const int *J, const double *A,
+                       const double *x, double *y, const double a)
+{
+   const int bs = T_BS ? T_BS : bs_;
+   const int bs2 = bs*bs;
+
+   #pragma omp parallel for
+   for (int i = 0; i < nbrows; i++)
+   {
+      double *yi = y + i*yb;
+      if (T_BS)
+      {
+         constexpr int BS = T_BS ? T_BS : 1;
+         double sum[BS], xj[BS];
+         for (int c = 0; c < BS; c++) { sum[c] = 0.0; }
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const double *Ak = A + BS*BS*k;
+            const double *xk = x + J[k]*xb;
+            for (int d = 0; d < BS; d++) { xj[d] = xk[d*xs]; }
+            for (int d = 0; d < BS; d++)
+            {
+               for (int c = 0; c < BS; c++)
+               {
+                  sum[c] += Ak[c + BS*d]*xj[d];
+               }
+            }
+         }
+         for (int c = 0; c < BS; c++) { yi[c*ys] += a*sum[c]; }
+      }
+      else
+      {
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const double *Ak = A + bs2*k;
+            const double *xk = x + J[k]*xb;
+            for (int d = 0; d < bs; d++)
+            {
+               const double xd = a*xk[d*xs];
+               for (int c = 0; c < bs; c++)
+               {
+                  yi[c*ys] += Ak[c + bs*d]*xd;
+               }
+            }
+         }
+      }
+   }
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(x.Size() == width, "invalid input size");
+   MFEM_ASSERT(y.Size() == height, "invalid output size");
+   const int xs = byvdim ? 1 : nbcols, xb = byvdim ? bsize : 1;
+   const int ys = byvdim ? 1 : nbrows, yb = byvdim ? bsize : 1;
+   const int *Ip = I.HostRead(), *Jp = J.HostRead();
+   const double *Ap = A.HostRead();
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   switch (bsize)
+   {
+      case 1: BSRAddMult<1>(nbrows,1,xs,xb,ys,yb,Ip,Jp,Ap,xp,yp,a); break;
+      case 2: BSRAddMult<2>(nbrows,2,xs,xb,ys,yb,Ip,Jp,Ap,xp,yp,a); break;
+      case 3: BSRAddMult<3>(nbrows,3,xs,xb,ys,yb,Ip,Jp,Ap,xp,yp,a); break;
+      case 4: BSRAddMult<4>(nbrows,4,xs,xb,ys,yb,Ip,Jp,Ap,xp,yp,a); break;
+      default: BSRAddMult(nbrows,bsize,xs,xb,ys,yb,Ip,Jp,Ap,xp,yp,a);
+   }
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void BSRMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a) const
+{
+   MFEM_ASSERT(x.Size() == height, "invalid input size");
+   MFEM_ASSERT(y.Size() == width, "invalid output size");
+   const int bs2 = bsize*bsize;
+   const double *Ad = A.HostRead();
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const double *Ak = Ad + bs2*k;
+         for (int d = 0; d < bsize; d++)
+         {
+            double sum = 0.0;
+            for (int c = 0; c < bsize; c++)
+            {
+               sum += Ak[c + bsize*d]*xp[RowIndex(i, c)];
+            }
+            yp[ColIndex(J[k], d)] += a*sum;
+         }
+      }
+   }
+}
+
+SparseMatrix *BSRMatrix::ToSparseMatrix() const
+{
+   int *mI = Memory<int>(height+1);
+   int *mJ = Memory<int>(J.Size()*bsize*bsize);
+   double *mA = Memory<double>(J.Size()*bsize*bsize);
+   const double *Ad = A.HostRead();
+
+   for (int r = 0; r < height; r++)
+   {
+      const int i = byvdim ? r/bsize : r%nbrows;
+      mI[r+1] = (I[i+1] - I[i])*bsize;
+   }
+   mI[0] = 0;
+   for (int r = 0; r < height; r++) { mI[r+1] += mI[r]; }
+
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int c = 0; c < bsize; c++)
+      {
+         int m = mI[RowIndex(i, c)];
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            for (int d = 0; d < bsize; d++)
+            {
+               mJ[m] = ColIndex(J[k], d);
+               mA[m] = Ad[c + bsize*(d + bsize*k)];
+               m++;
+            }
+         }
+      }
+   }
+
+   SparseMatrix *mat = new SparseMatrix(mI, mJ, mA, height, width);
+   mat->SortColumnIndices();
+   return mat;
+}
+
+
+BSRSmoother::BSRSmoother(const BSRMatrix &a, Type t, double s, int it)
+   : type(t), scale(s), iterations(it)
+{
+   SetOperator(a);
+}
+
+void BSRSmoother::SetOperator(const Operator &a)
+{
+   oper = dynamic_cast<const BSRMatrix*>(&a);
+   MFEM_VERIFY(oper != NULL, "the operator is not a BSRMatrix");
+   MFEM_VERIFY(oper->BlockHeight() == oper->BlockWidth(),
+               "the BSRMatrix must be square");
+   height = width = oper->Height();
+
+   const int nb = oper->BlockHeight(), bs = oper->BlockSize();
+   Dinv.SetSize(bs, bs, nb);
+   for (int i = 0; i < nb; i++)
+   {
+      const int k = oper->FindBlock(i, i);
+      MFEM_VERIFY(k >= 0, "missing diagonal block " << i);
+      Dinv(i) = oper->GetBlocks()(k);
+      Dinv(i).Invert();
+   }
+}
+
+void BSRSmoother::Jacobi(const Vector &x, Vector &y) const
+{
+   const int nb = oper->BlockHeight(), bs = oper->BlockSize();
+   const bool byvdim = oper->IsByVDim();
+   r = x;
+   oper->AddMult(y, r, -1.0);
+   for (int i = 0; i < nb; i++)
+   {
+      const DenseMatrix &D = Dinv(i);
+      for (int c = 0; c < bs; c++)
+      {
+         double sum = 0.0;
+         for (int d = 0; d < bs; d++)
+         {
+            sum += D(c, d)*r(byvdim ? d + i*bs : i + d*nb);
+         }
+         y(byvdim ? c + i*bs : i + c*nb) += scale*sum;
+      }
+   }
+}
+
+void BSRSmoother::GaussSeidel(const Vector &x, Vector &y, bool forward) const
+{
+   const int nb = oper->BlockHeight(), bs = oper->BlockSize();
+   const bool byvdim = oper->IsByVDim();
+   const int *I = oper->GetBlockI(), *J = oper->GetBlockJ();
+   const DenseTensor &A = oper->GetBlocks();
+   Vector ri(bs);
+   for (int n = 0; n < nb; n++)
+   {
+      const int i = forward ? n : nb-1-n;
+      for (int c = 0; c < bs; c++)
+      {
+         ri(c) = x(byvdim ? c + i*bs : i + c*nb);
+      }
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         if (j == i) { continue; }
+         const DenseMatrix &Ak = A(k);
+         for (int d = 0; d < bs; d++)
+         {
+            const double yd = y(byvdim ? d + j*bs : j + d*nb);
+            for (int c = 0; c < bs; c++) { ri(c) -= Ak(c, d)*yd; }
+         }
+      }
+      const DenseMatrix &D = Dinv(i);
+      for (int c = 0; c < bs; c++)
+      {
+         double sum = 0.0;
+         for (int d = 0; d < bs; d++) { sum += D(c, d)*ri(d); }
+         double &yc = y(byvdim ? c + i*bs : i + c*nb);
+         yc += scale*(sum - yc);
+      }
+   }
+}
+
+void BSRSmoother::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(oper != NULL, "the operator is not set");
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   x.HostRead();
+   y.HostReadWrite();
+   for (int it = 0; it < iterations; it++)
+   {
+      if (type == JACOBI)
+      {
+         Jacobi(x, y);
+         continue;
+      }
+      if (type != GAUSS_SEIDEL_BACKWARD)
+      {
+         GaussSeidel(x, y, true);
+      }
+      if (type != GAUSS_SEIDEL_FORWARD)
+      {
+         GaussSeidel(x, y, false);
+      }
+   }
+}
+
+} // namespace mfem
@@ -0,0 +1,163 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BSRMAT_HPP
+#define MFEM_BSRMAT_HPP
+
+#include "../config/config.hpp"
+#include "../general/table.hpp"
+#include "densemat.hpp"
+#include "sparsemat.hpp"
+#include "solvers.hpp"
+
+namespace mfem
+{
+
+/** @brief Sparse matrix in block compressed sparse row (BSR) format, with
+    dense square blocks of size BlockSize() x BlockSize().
+
+    The matrix has BlockHeight() x BlockWidth() blocks. The scalar index of the
+    component c of the block row (or column) i is i + c*BlockHeight() (or
+    i + c*BlockWidth()) when the components are ordered by nodes, as in a
+    FiniteElementSpace with Ordering::byNODES, and c + i*BlockSize() when they
+    are ordered by vector dimension, as with Ordering::byVDIM. Only one column
+    index is stored per block, so compared with a SparseMatrix, the memory for
+    the indices and the index traffic of Mult() are reduced by a factor of
+    BlockSize()^2.
+
+    The column indices of each block row are sorted. Block k, in the order of
+    the column index array GetBlockJ(), is stored in column-major order in
+    GetBlocks()(k). */
+class BSRMatrix : public Operator
+{
+protected:
+   int nbrows, nbcols, bsize;
+   bool byvdim;
+   /// Block row offsets and sorted block column indices.
+   Array<int> I, J;
+   /// The blocks of the matrix: A(k) is the block with column index J[k].
+   DenseTensor A;
+
+   /// Return the scalar index of the component @a c of the block row @a i.
+   int RowIndex(int i, int c) const
+   { return byvdim ? c + i*bsize : i + c*nbrows; }
+   /// Return the scalar index of the component @a c of the block column @a j.
+   int ColIndex(int j, int c) const
+   { return byvdim ? c + j*bsize : j + c*nbcols; }
+
+public:
+   /** @brief Create a BSR matrix with the block sparsity pattern given by the
+       rows of @a pattern, with @a nbcols_ block columns and blocks of size
+       @a bsize_. All entries are set to zero. */
+   /** The ordering of the components is by vector dimension if @a byvdim_ is
+       true, and by nodes otherwise. */
+   BSRMatrix(const Table &pattern, int nbcols_, int bsize_,
+             bool byvdim_ = false);
+
+   /** @brief Convert the finalized SparseMatrix @a mat to a BSR matrix with
+       blocks of size @a bsize_. */
+   /** A block is stored if the SparseMatrix stores at least one of its
+       entries. The size of @a mat must be divisible by @a bsize_. */
+   BSRMatrix(const SparseMatrix &mat, int bsize_, bool byvdim_ = false);
+
+   /// Return the number of block rows.
+   int BlockHeight() const { return nbrows; }
+   /// Return the number of block columns.
+   int BlockWidth() const { return nbcols; }
+   /// Return the size of the (square) blocks.
+   int BlockSize() const { return bsize; }
+   /// Return true if the components are ordered by vector dimension.
+   bool IsByVDim() const { return byvdim; }
+   /// Return the number of stored blocks.
+   int NumNonZeroBlocks() const { return J.Size(); }
+
+   const int *GetBlockI() const { return I.GetData(); }
+   const int *GetBlockJ() const { return J.GetData(); }
+   DenseTensor &GetBlocks() { return A; }
+   const DenseTensor &GetBlocks() const { return A; }
+
+   /** @brief Return the position of the block (@a i, @a j) in GetBlockJ(), or
+       -1 if the block is not stored. */
+   int FindBlock(int i, int j) const;
+
+   /** @brief Add the dense matrix @a subm to the rows and columns of the nodes
+       @a rows and @a cols, where @a subm is ordered by components as the
+       element matrices of a vector FiniteElementSpace: its row
+       r + c*rows.Size() corresponds to the component c of the node rows[r]. */
+   /** Negative node indices, i = -1-k, denote the node k with a sign change.
+       The blocks must be in the sparsity pattern of the matrix. */
+   void AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
+                     const DenseMatrix &subm);
+
+   /// Set all the entries of the matrix to @a a.
+   BSRMatrix &operator=(double a);
+
+   /// Return the diagonal of the matrix, which must be square.
+   void GetDiag(Vector &d) const;
+
+   /// Matrix-vector product y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+   /// y += a * A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+   /// Matrix-vector product y = A^T x.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+   /// y += a * A^T x
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+
+   /// Return a new SparseMatrix with all the entries of the stored blocks.
+   SparseMatrix *ToSparseMatrix() const;
+};
+
+/** @brief Block Jacobi and block Gauss-Seidel smoothers for a square BSRMatrix,
+    based on the inverses of its diagonal blocks. */
+class BSRSmoother : public Solver
+{
+public:
+   enum Type
+   {
+      JACOBI,                ///< Block Jacobi
+      GAUSS_SEIDEL_FORWARD,  ///< Forward block Gauss-Seidel
+      GAUSS_SEIDEL_BACKWARD, ///< Backward block Gauss-Seidel
+      GAUSS_SEIDEL_SYMMETRIC ///< Forward, then backward block Gauss-Seidel
+   };
+
+protected:
+   const BSRMatrix *oper;
+   Type type;
+   double scale;
+   int iterations;
+   /// The inverses of the diagonal blocks of #oper.
+   DenseTensor Dinv;
+   mutable Vector r;
+
+   void Jacobi(const Vector &x, Vector &y) const;
+   void GaussSeidel(const Vector &x, Vector &y, bool forward) const;
+
+public:
+   /** @brief Create a smoother of the given @a t type, relaxation parameter
+       @a s and number of iterations @a it. */
+   BSRSmoother(Type t = JACOBI, double s = 1.0, int it = 1)
+      : oper(NULL), type(t), scale(s), iterations(it) { }
+
+   BSRSmoother(const BSRMatrix &a, Type t = JACOBI, double s = 1.0,
+               int it = 1);
+
+   /// Set the BSRMatrix and compute the inverses of its diagonal blocks.
+   virtual void SetOperator(const Operator &a);
+
+   /// Apply the smoother to @a x; uses @a y as initial guess if iterative_mode.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+} // namespace mfem
+
+#endif // MFEM_BSRMAT_HPP
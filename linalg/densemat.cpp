@@ -3600,4 +3600,313 @@ void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 
 }
 
+void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, DenseTensor &X)
+{
+   const int m = Mlu.SizeI();
+   const int r = X.SizeJ();
+   const int NE = Mlu.SizeK();
+   MFEM_VERIFY(X.SizeI() == m && X.SizeK() == NE, "incompatible sizes");
+
+   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
+   auto piv_all = mfem::Reshape(P.Read(), m, NE);
+   auto x_all = mfem::Reshape(X.ReadWrite(), m, r, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < r; c++)
+      {
+         kernels::LUSolve(&data_all(0,0,e), m, &piv_all(0,e), &x_all(0,c,e));
+      }
+   });
+}
+
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv)
+{
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   if (Minv.SizeI() != m || Minv.SizeJ() != m || Minv.SizeK() != NE)
+   {
+      Minv.SetSize(m, m, NE);
+   }
+
+   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
+   auto piv_all = mfem::Reshape(P.Read(), m, NE);
+   auto inv_all = mfem::Reshape(Minv.Write(), m, m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < m; c++)
+      {
+         for (int i = 0; i < m; i++) { inv_all(i,c,e) = (i == c) ? 1.0 : 0.0; }
+         kernels::LUSolve(&data_all(0,0,e), m, &piv_all(0,e), &inv_all(0,c,e));
+      }
+   });
+}
+
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C)
+{
+   const int m = A.SizeI();
+   const int l = A.SizeJ();
+   const int r = B.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(B.SizeI() == l && B.SizeK() == NE, "incompatible sizes");
+   if (C.SizeI() != m || C.SizeJ() != r || C.SizeK() != NE)
+   {
+      C.SetSize(m, r, NE);
+   }
+
+   auto a = mfem::Reshape(A.Read(), m, l, NE);
+   auto b = mfem::Reshape(B.Read(), l, r, NE);
+   auto c = mfem::Reshape(C.Write(), m, r, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int j = 0; j < r; j++)
+      {
+         for (int i = 0; i < m; i++) { c(i,j,e) = 0.0; }
+         for (int k = 0; k < l; k++)
+         {
+            const double b_kj = b(k,j,e);
+            for (int i = 0; i < m; i++) { c(i,j,e) += a(i,k,e) * b_kj; }
+         }
+      }
+   });
+}
+
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y)
+{
+   const int m = A.SizeI();
+   const int l = A.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(x.Size() == l*NE, "incompatible sizes");
+   y.SetSize(m*NE);
+
+   auto a = mfem::Reshape(A.Read(), m, l, NE);
+   auto xx = mfem::Reshape(x.Read(), l, NE);
+   auto yy = mfem::Reshape(y.Write(), m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < m; i++) { yy(i,e) = 0.0; }
+      for (int k = 0; k < l; k++)
+      {
+         const double x_k = xx(k,e);
+         for (int i = 0; i < m; i++) { yy(i,e) += a(i,k,e) * x_k; }
+      }
+   });
+}
+
+void BatchToSoA(const DenseTensor &A, Vector &A_soa)
+{
+   const int mm = A.SizeI()*A.SizeJ();
+   const int NE = A.SizeK();
+   A_soa.SetSize(mm*NE);
+   auto a = mfem::Reshape(A.Read(), mm, NE);
+   auto a_soa = mfem::Reshape(A_soa.Write(), NE, mm);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < mm; i++) { a_soa(e,i) = a(i,e); }
+   });
+}
+
+void BatchFromSoA(const Vector &A_soa, DenseTensor &A)
+{
+   const int mm = A.SizeI()*A.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(A_soa.Size() == mm*NE, "incompatible sizes");
+   auto a_soa = mfem::Reshape(A_soa.Read(), NE, mm);
+   auto a = mfem::Reshape(A.Write(), mm, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < mm; i++) { a(i,e) = a_soa(e,i); }
+   });
+}
+
+// Number of matrices processed together by the host SoA kernels. The loops
+// over the matrices of a chunk are the innermost ones, so that they can be
+// vectorized, while the chunk of matrices stays in cache.
+static const int BATCH_SOA_CHUNK = 64;
+
+void BatchLUFactorSoA(int m, int n, Vector &Mlu, Array<int> &P,
+                      const double TOL)
+{
+   MFEM_VERIFY(Mlu.Size() == m*m*n, "incompatible sizes");
+   P.SetSize(m*n);
+
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      auto A = mfem::Reshape(Mlu.ReadWrite(), n, m, m);
+      auto ipiv = mfem::Reshape(P.Write(), n, m);
+      Array<bool> pivot_flag(1);
+      pivot_flag[0] = true;
+      bool *d_pivot_flag = pivot_flag.ReadWrite();
+      MFEM_FORALL(e, n,
+      {
+         for (int i = 0; i < m; i++)
+         {
+            int piv = i;
+            double a = fabs(A(e,i,i));
+            for (int j = i+1; j < m; j++)
+            {
+               const double b = fabs(A(e,j,i));
+               if (b > a)
+               {
+                  a = b;
+                  piv = j;
+               }
+            }
+            ipiv(e,i) = piv;
+            if (piv != i)
+            {
+               for (int j = 0; j < m; j++)
+               {
+                  kernels::internal::Swap<double>(A(e,i,j), A(e,piv,j));
+               }
+            }
+            if (fabs(A(e,i,i)) <= TOL) { d_pivot_flag[0] = false; }
+            const double a_ii_inv = 1.0 / A(e,i,i);
+            for (int j = i+1; j < m; j++) { A(e,j,i) *= a_ii_inv; }
+            for (int k = i+1; k < m; k++)
+            {
+               const double a_ik = A(e,i,k);
+               for (int j = i+1; j < m; j++) { A(e,j,k) -= a_ik * A(e,j,i); }
+            }
+         }
+      });
+      MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed");
+      return;
+   }
+
+   auto A = mfem::Reshape(Mlu.HostReadWrite(), n, m, m);
+   auto ipiv = mfem::Reshape(P.HostWrite(), n, m);
+   bool pivot_flag = true;
+   double amax[BATCH_SOA_CHUNK];
+   for (int e0 = 0; e0 < n; e0 += BATCH_SOA_CHUNK)
+   {
+      const int e1 = std::min(e0 + BATCH_SOA_CHUNK, n);
+      for (int i = 0; i < m; i++)
+      {
+         // pivoting
+         for (int e = e0; e < e1; e++)
+         {
+            ipiv(e,i) = i;
+            amax[e-e0] = fabs(A(e,i,i));
+         }
+         for (int j = i+1; j < m; j++)
+         {
+            for (int e = e0; e < e1; e++)
+            {
+               const double b = fabs(A(e,j,i));
+               if (b > amax[e-e0])
+               {
+                  amax[e-e0] = b;
+                  ipiv(e,i) = j;
+               }
+            }
+         }
+         for (int j = 0; j < m; j++)
+         {
+            for (int e = e0; e < e1; e++)
+            {
+               const int piv = ipiv(e,i);
+               const double a_ij = A(e,i,j);
+               A(e,i,j) = A(e,piv,j);
+               A(e,piv,j) = a_ij;
+            }
+         }
+
+         for (int e = e0; e < e1; e++)
+         {
+            if (fabs(A(e,i,i)) <= TOL) { pivot_flag = false; }
+            amax[e-e0] = 1.0 / A(e,i,i);
+         }
+         for (int j = i+1; j < m; j++)
+         {
+            for (int e = e0; e < e1; e++) { A(e,j,i) *= amax[e-e0]; }
+         }
+         for (int k = i+1; k < m; k++)
+         {
+            for (int j = i+1; j < m; j++)
+            {
+               for (int e = e0; e < e1; e++)
+               {
+                  A(e,j,k) -= A(e,i,k) * A(e,j,i);
+               }
+            }
+         }
+      }
+   }
+   MFEM_CONTRACT_VAR(pivot_flag);
+   MFEM_ASSERT(pivot_flag, "Batch LU factorization failed");
+}
+
+void BatchLUSolveSoA(int m, int n, const Vector &Mlu, const Array<int> &P,
+                     Vector &X)
+{
+   MFEM_VERIFY(Mlu.Size() == m*m*n && X.Size() == m*n && P.Size() == m*n,
+               "incompatible sizes");
+
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      auto A = mfem::Reshape(Mlu.Read(), n, m, m);
+      auto ipiv = mfem::Reshape(P.Read(), n, m);
+      auto x = mfem::Reshape(X.ReadWrite(), n, m);
+      MFEM_FORALL(e, n,
+      {
+         for (int i = 0; i < m; i++)
+         {
+            kernels::internal::Swap<double>(x(e,i), x(e,ipiv(e,i)));
+         }
+         for (int j = 0; j < m; j++)
+         {
+            const double x_j = x(e,j);
+            for (int i = j+1; i < m; i++) { x(e,i) -= A(e,i,j) * x_j; }
+         }
+         for (int j = m-1; j >= 0; j--)
+         {
+            const double x_j = (x(e,j) /= A(e,j,j));
+            for (int i = 0; i < j; i++) { x(e,i) -= A(e,i,j) * x_j; }
+         }
+      });
+      return;
+   }
+
+   auto A = mfem::Reshape(Mlu.HostRead(), n, m, m);
+   auto ipiv = mfem::Reshape(P.HostRead(), n, m);
+   auto x = mfem::Reshape(X.HostReadWrite(), n, m);
+   for (int e0 = 0; e0 < n; e0 += BATCH_SOA_CHUNK)
+   {
+      const int e1 = std::min(e0 + BATCH_SOA_CHUNK, n);
+      // X <- P X
+      for (int i = 0; i < m; i++)
+      {
+         for (int e = e0; e < e1; e++)
+         {
+            const int piv = ipiv(e,i);
+            const double x_i = x(e,i);
+            x(e,i) = x(e,piv);
+            x(e,piv) = x_i;
+         }
+      }
+      // X <- L^{-1} X
+      for (int j = 0; j < m; j++)
+      {
+         for (int i = j+1; i < m; i++)
+         {
+            for (int e = e0; e < e1; e++) { x(e,i) -= A(e,i,j) * x(e,j); }
+         }
+      }
+      // X <- U^{-1} X
+      for (int j = m-1; j >= 0; j--)
+      {
+         for (int e = e0; e < e1; e++) { x(e,j) /= A(e,j,j); }
+         for (int i = 0; i < j; i++)
+         {
+            for (int e = e0; e < e1; e++) { x(e,i) -= A(e,i,j) * x(e,j); }
+         }
+      }
+   }
+}
+
 } // namespace mfem
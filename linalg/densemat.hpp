@@ -918,6 +918,73 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Solve batch linear systems with multiple right-hand sides
+
+    Same as BatchLUSolve(const DenseTensor&, const Array<int>&, Vector&), but
+    each of the n factored matrices is applied to the r columns of the
+    corresponding slice of X.
+
+    @param [in] Mlu batch of LU factors for matrix M - dimension m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [in, out] X tensor storing right-hand sides and then solutions -
+    dimension m x r x n. */
+void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, DenseTensor &X);
+
+/** @brief Compute the inverses of a batch of LU factored matrices
+
+    @param [in] Mlu batch of LU factors, as computed by BatchLUFactor() -
+    dimension m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [out] Minv batch of inverse matrices - dimension m x m x n. */
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv);
+
+/** @brief Batch matrix-matrix product: C(k) = A(k) B(k) for all k.
+
+    @param [in] A batch of matrices - dimension m x l x n.
+    @param [in] B batch of matrices - dimension l x r x n.
+    @param [out] C batch of products - dimension m x r x n. */
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C);
+
+/** @brief Batch matrix-vector product: y(:,k) = A(k) x(:,k) for all k.
+
+    @param [in] A batch of matrices - dimension m x l x n.
+    @param [in] x batch of vectors - dimension l x n.
+    @param [out] y batch of vectors - dimension m x n. */
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y);
+
+/** @name Structure-of-arrays batch layout
+
+    In the structure-of-arrays (SoA) layout, the entry (i,j) of all n matrices
+    of a batch of (m x m) matrices is stored contiguously, i.e. the entry (i,j)
+    of matrix k is at offset k + n*(i + m*j). Similarly, entry i of vector k of
+    a batch of vectors is at offset k + n*i. This layout lets the innermost loop
+    run over the batch with unit stride, so that the host kernels vectorize
+    across matrices and the device kernels have coalesced memory accesses. */
+///@{
+
+/// Convert a batch of matrices from a DenseTensor to the SoA layout.
+void BatchToSoA(const DenseTensor &A, Vector &A_soa);
+
+/** @brief Convert a batch of matrices from the SoA layout to a DenseTensor
+    with preallocated sizes. */
+void BatchFromSoA(const Vector &A_soa, DenseTensor &A);
+
+/** @brief Compute the LU factorization of n (m x m) matrices stored in the
+    SoA layout, overwriting them with the LU factors.
+
+    The pivot information @a P (dimension n x m) is also stored in the SoA
+    layout. See BatchLUFactor(DenseTensor&, Array<int>&, const double). */
+void BatchLUFactorSoA(int m, int n, Vector &Mlu, Array<int> &P,
+                      const double TOL = 0.0);
+
+/** @brief Solve the batch linear systems factored by BatchLUFactorSoA() with
+    the right-hand sides @a X (dimension n x m) stored in the SoA layout. */
+void BatchLUSolveSoA(int m, int n, const Vector &Mlu, const Array<int> &P,
+                     Vector &X);
+
+///@}
+
 
 // Inline methods
 
@@ -20,9 +20,11 @@
 #include "sparsemat.hpp"
 #include "complex_operator.hpp"
 #include "blockvector.hpp"
+#include "multivector.hpp"
 #include "blockmatrix.hpp"
 #include "blockoperator.hpp"
 #include "sparsesmoothers.hpp"
+#include "bsrmat.hpp"
 #include "densemat.hpp"
 #include "symmat.hpp"
 #include "ode.hpp"
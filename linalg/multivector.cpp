@@ -0,0 +1,112 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "multivector.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+MultiVector &MultiVector::operator=(const MultiVector &mv)
+{
+   if (this != &mv)
+   {
+      SetSize(mv.vsize, mv.nvectors);
+      Vector::operator=(mv);
+   }
+   return *this;
+}
+
+void MultiVector::Dot(const MultiVector &y, Vector &d) const
+{
+   MFEM_ASSERT(y.vsize == vsize && y.nvectors == nvectors,
+               "incompatible MultiVectors");
+   d.SetSize(nvectors);
+   Vector xj, yj;
+   for (int j = 0; j < nvectors; j++)
+   {
+      GetVectorView(j, xj);
+      y.GetVectorView(j, yj);
+      d(j) = xj * yj;
+   }
+}
+
+void MultiVector::Add(const Vector &a, const MultiVector &y)
+{
+   MFEM_ASSERT(y.vsize == vsize && y.nvectors == nvectors,
+               "incompatible MultiVectors");
+   MFEM_ASSERT(a.Size() == nvectors, "invalid coefficient vector");
+   const bool use_dev = UseDevice() || y.UseDevice();
+   const int n = vsize;
+   const auto A = a.Read(use_dev);
+   const auto Y = y.Read(use_dev);
+   auto X = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, n*nvectors, X[i] += A[i/n] * Y[i]; );
+}
+
+void MultiVector::Scale(const Vector &a)
+{
+   MFEM_ASSERT(a.Size() == nvectors, "invalid coefficient vector");
+   const bool use_dev = UseDevice();
+   const int n = vsize;
+   const auto A = a.Read(use_dev);
+   auto X = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, n*nvectors, X[i] *= A[i/n]; );
+}
+
+void MultiVector::GetRows(int offset, int size, MultiVector &sub) const
+{
+   MFEM_ASSERT(offset >= 0 && offset + size <= vsize, "invalid rows");
+   sub.SetSize(size, nvectors);
+   const bool use_dev = UseDevice() || sub.UseDevice();
+   const int n = vsize;
+   const auto X = Read(use_dev);
+   auto S = sub.Write(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size*nvectors,
+   {
+      const int r = i % size, j = i / size;
+      S[i] = X[offset + r + j*n];
+   });
+}
+
+void MultiVector::SetRows(int offset, const MultiVector &sub)
+{
+   const int size = sub.vsize;
+   MFEM_ASSERT(sub.nvectors == nvectors, "incompatible MultiVectors");
+   MFEM_ASSERT(offset >= 0 && offset + size <= vsize, "invalid rows");
+   const bool use_dev = UseDevice() || sub.UseDevice();
+   const int n = vsize;
+   const auto S = sub.Read(use_dev);
+   auto X = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size*nvectors,
+   {
+      const int r = i % size, j = i / size;
+      X[offset + r + j*n] = S[i];
+   });
+}
+
+void MultiVector::AddRows(int offset, const MultiVector &sub, double a)
+{
+   const int size = sub.vsize;
+   MFEM_ASSERT(sub.nvectors == nvectors, "incompatible MultiVectors");
+   MFEM_ASSERT(offset >= 0 && offset + size <= vsize, "invalid rows");
+   const bool use_dev = UseDevice() || sub.UseDevice();
+   const int n = vsize;
+   const auto S = sub.Read(use_dev);
+   auto X = ReadWrite(use_dev);
+   MFEM_FORALL_SWITCH(use_dev, i, size*nvectors,
+   {
+      const int r = i % size, j = i / size;
+      X[offset + r + j*n] += a * S[i];
+   });
+}
+
+} // namespace mfem
@@ -0,0 +1,102 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_MULTIVECTOR
+#define MFEM_MULTIVECTOR
+
+#include "../config/config.hpp"
+#include "vector.hpp"
+
+namespace mfem
+{
+
+/** @brief A set of NumVectors() vectors of size VectorSize(), stored one after
+    the other in a single Vector, i.e. as the columns of a column-major
+    VectorSize() x NumVectors() matrix.
+
+    A MultiVector is the argument of Operator::MultMany(), which applies an
+    operator to all the vectors at once. Operators that are limited by memory
+    bandwidth, e.g. SparseMatrix, can then read their data once for all the
+    vectors. The entry i of the vector j is (*this)(i + j*VectorSize()). */
+class MultiVector : public Vector
+{
+protected:
+   int vsize, nvectors;
+
+public:
+   /// Create an empty MultiVector.
+   MultiVector() : vsize(0), nvectors(0) { }
+
+   /// Create @a num_vectors vectors of size @a size.
+   MultiVector(int size, int num_vectors)
+      : Vector(size*num_vectors), vsize(size), nvectors(num_vectors) { }
+
+   /// Copy constructor.
+   MultiVector(const MultiVector &mv)
+      : Vector(mv), vsize(mv.vsize), nvectors(mv.nvectors) { }
+
+   /// Resize to @a num_vectors vectors of size @a size.
+   /** The entries are not preserved if the total size changes. */
+   void SetSize(int size, int num_vectors)
+   {
+      Vector::SetSize(size*num_vectors);
+      vsize = size;
+      nvectors = num_vectors;
+   }
+
+   /// Return the size of each vector.
+   int VectorSize() const { return vsize; }
+   /// Return the number of vectors.
+   int NumVectors() const { return nvectors; }
+
+   /// Set all the entries to @a value.
+   MultiVector &operator=(double value)
+   { Vector::operator=(value); return *this; }
+
+   /// Copy the size and the entries of @a mv.
+   MultiVector &operator=(const MultiVector &mv);
+
+   /// Make @a v a reference to the vector @a j.
+   void GetVectorView(int j, Vector &v)
+   { v.MakeRef(*this, j*vsize, vsize); }
+
+   /// Make @a v a (read-only) reference to the vector @a j.
+   void GetVectorView(int j, Vector &v) const
+   { v.MakeRef(const_cast<MultiVector &>(*this), j*vsize, vsize); }
+
+   /// Set @a d(j) to the dot product of the vector @a j with the vector @a j
+   /// of @a y, on the local process.
+   void Dot(const MultiVector &y, Vector &d) const;
+
+   using Vector::Add;
+
+   /// Add @a a(j) times the vector @a j of @a y to the vector @a j.
+   void Add(const Vector &a, const MultiVector &y);
+
+   /// Multiply the vector @a j by @a a(j).
+   void Scale(const Vector &a);
+
+   /** @brief Copy the entries @a offset, ..., @a offset + @a size - 1 of all
+       the vectors to @a sub, which is resized to @a size x NumVectors(). */
+   void GetRows(int offset, int size, MultiVector &sub) const;
+
+   /** @brief Copy the vectors of @a sub to the entries @a offset, ...,
+       @a offset + sub.VectorSize() - 1 of all the vectors; see GetRows(). */
+   void SetRows(int offset, const MultiVector &sub);
+
+   /** @brief Add @a a times the vectors of @a sub to the entries @a offset,
+       ..., @a offset + sub.VectorSize() - 1 of all the vectors. */
+   void AddRows(int offset, const MultiVector &sub, double a = 1.0);
+};
+
+} // namespace mfem
+
+#endif // MFEM_MULTIVECTOR
@@ -11,6 +11,9 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace mfem
 {
@@ -781,6 +784,280 @@ void ESDIRK33Solver::Step(Vector &x, double &t, double &dt)
    t += dt;
 }
 
+EmbeddedRKSolver::EmbeddedRKSolver(int p_)
+   : p(p_), rtol(1e-4), atol(1e-6), safety(0.9), min_factor(0.2),
+     max_factor(5.0), kI(0.7), kP(0.4), min_dt(0.0), err_prev(1.0),
+     rejected(false), num_accepted(0), num_rejected(0) { }
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   y.SetSize(f->Width(), mem_type);
+   e.SetSize(f->Width(), mem_type);
+   err_prev = 1.0;
+   rejected = false;
+   num_accepted = num_rejected = 0;
+}
+
+double EmbeddedRKSolver::ErrorNorm(const Vector &x, const Vector &y_,
+                                   const Vector &e_) const
+{
+   const int n = e_.Size();
+   if (n == 0) { return 0.0; }
+   const double *X = x.HostRead(), *Y = y_.HostRead(), *E = e_.HostRead();
+   double sum = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      const double sc = atol + rtol*std::max(std::abs(X[i]), std::abs(Y[i]));
+      const double r = E[i]/sc;
+      sum += r*r;
+   }
+   return std::sqrt(sum/n);
+}
+
+bool EmbeddedRKSolver::AdaptiveStep(Vector &x, double &t, double &dt)
+{
+   TakeStep(x, t, dt, y, e);
+   const double err = ErrorNorm(x, y, e);
+   const double ep = 1.0/p;
+
+   if (err <= 1.0)
+   {
+      double factor = max_factor;
+      if (err > 0.0)
+      {
+         factor = safety*std::pow(err, -kI*ep)*std::pow(err_prev, kP*ep);
+      }
+      factor = std::min(max_factor, std::max(min_factor, factor));
+      if (rejected) { factor = std::min(factor, 1.0); }
+      err_prev = std::max(err, 1e-4);
+      rejected = false;
+      num_accepted++;
+
+      x = y;
+      t += dt;
+      dt *= factor;
+      StepDone(true);
+      return true;
+   }
+
+   rejected = true;
+   num_rejected++;
+   // A non-finite error, e.g. from an overflow in the stages, gives the
+   // largest reduction
+   dt *= IsFinite(err) ? std::max(min_factor, safety*std::pow(err, -ep)) :
+         min_factor;
+   StepDone(false);
+   const double dt_min =
+      std::max(min_dt, 4.0*std::numeric_limits<double>::epsilon()*std::abs(t));
+   MFEM_VERIFY(dt > dt_min, "step size " << dt << " below the minimum "
+               << dt_min << " at t = " << t << ", error estimate = " << err);
+   return false;
+}
+
+void EmbeddedRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   double dt_try = dt;
+   while (true)
+   {
+      dt = dt_try;
+      if (AdaptiveStep(x, t, dt_try)) { break; }
+   }
+}
+
+void EmbeddedRKSolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   while (t < tf)
+   {
+      const bool last = (t + dt >= tf);
+      double dt_try = last ? tf - t : dt;
+      if (AdaptiveStep(x, t, dt_try))
+      {
+         // Keep the suggestion for the full step size if the last step was
+         // shortened to reach tf
+         if (last) { t = tf; }
+         if (!last || dt_try < dt) { dt = dt_try; }
+      }
+      else { dt = dt_try; }
+   }
+}
+
+ExplicitEmbeddedRKSolver::ExplicitEmbeddedRKSolver(
+   int s_, const double *a_, const double *b_, const double *e_,
+   const double *c_, int p_, bool fsal_)
+   : EmbeddedRKSolver(p_), s(s_), a(a_), b(b_), ee(e_), c(c_), fsal(fsal_),
+     k0_valid(false)
+{
+   k = new Vector[s];
+}
+
+void ExplicitEmbeddedRKSolver::Init(TimeDependentOperator &f_)
+{
+   EmbeddedRKSolver::Init(f_);
+   const int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void ExplicitEmbeddedRKSolver::TakeStep(const Vector &x, const double t,
+                                        const double dt, Vector &y_,
+                                        Vector &e_)
+{
+   // The first stage only depends on x and t, so it is reused after a
+   // rejected step and, for FSAL methods, after an accepted step.
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      add(x, a[l++]*dt, k[0], z);
+      for (int j = 1; j < i; j++)
+      {
+         z.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(z, k[i]);
+   }
+   add(x, b[0]*dt, k[0], y_);
+   e_.Set(ee[0]*dt, k[0]);
+   for (int i = 1; i < s; i++)
+   {
+      y_.Add(b[i]*dt, k[i]);
+      e_.Add(ee[i]*dt, k[i]);
+   }
+}
+
+void ExplicitEmbeddedRKSolver::StepDone(bool accepted)
+{
+   if (!accepted) { k0_valid = true; return; }
+   // The last stage of a FSAL method is evaluated at the new solution
+   if (fsal) { k[0].Swap(k[s-1]); }
+   k0_valid = fsal;
+}
+
+ExplicitEmbeddedRKSolver::~ExplicitEmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double DP54Solver::a[] =
+{
+   1.0/5.0,
+   3.0/40.0, 9.0/40.0,
+   44.0/45.0, -56.0/15.0, 32.0/9.0,
+   19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0,
+   9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0,
+   35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0
+};
+const double DP54Solver::b[] =
+{
+   35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0
+};
+const double DP54Solver::e[] =
+{
+   71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0,
+   22.0/525.0, -1.0/40.0
+};
+const double DP54Solver::c[] =
+{
+   1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0
+};
+
+const double BS32Solver::a[] =
+{
+   1.0/2.0,
+   0.0, 3.0/4.0,
+   2.0/9.0, 1.0/3.0, 4.0/9.0
+};
+const double BS32Solver::b[] =
+{
+   2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0
+};
+const double BS32Solver::e[] =
+{
+   -5.0/72.0, 1.0/12.0, 1.0/9.0, -1.0/8.0
+};
+const double BS32Solver::c[] =
+{
+   1.0/2.0, 3.0/4.0, 1.0
+};
+
+EmbeddedSDIRKSolver::EmbeddedSDIRKSolver(int s_, const double *a_,
+                                         const double *b_, const double *e_,
+                                         const double *c_, int p_)
+   : EmbeddedRKSolver(p_), s(s_), a(a_), b(b_), ee(e_), c(c_)
+{
+   k = new Vector[s];
+}
+
+void EmbeddedSDIRKSolver::Init(TimeDependentOperator &f_)
+{
+   EmbeddedRKSolver::Init(f_);
+   const int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+}
+
+void EmbeddedSDIRKSolver::TakeStep(const Vector &x, const double t,
+                                   const double dt, Vector &y_, Vector &e_)
+{
+   for (int l = 0, i = 0; i < s; i++)
+   {
+      z = x;
+      for (int j = 0; j < i; j++)
+      {
+         z.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i]*dt);
+      f->ImplicitSolve(a[l++]*dt, z, k[i]);
+   }
+   add(x, b[0]*dt, k[0], y_);
+   e_.Set(ee[0]*dt, k[0]);
+   for (int i = 1; i < s; i++)
+   {
+      y_.Add(b[i]*dt, k[i]);
+      e_.Add(ee[i]*dt, k[i]);
+   }
+}
+
+EmbeddedSDIRKSolver::~EmbeddedSDIRKSolver()
+{
+   delete [] k;
+}
+
+const double EmbeddedSDIRK54Solver::a[] =
+{
+   1.0/4.0,
+   1.0/2.0, 1.0/4.0,
+   17.0/50.0, -1.0/25.0, 1.0/4.0,
+   371.0/1360.0, -137.0/2720.0, 15.0/544.0, 1.0/4.0,
+   25.0/24.0, -49.0/48.0, 125.0/16.0, -85.0/12.0, 1.0/4.0
+};
+const double EmbeddedSDIRK54Solver::b[] =
+{
+   25.0/24.0, -49.0/48.0, 125.0/16.0, -85.0/12.0, 1.0/4.0
+};
+const double EmbeddedSDIRK54Solver::e[] =
+{
+   25.0/24.0 - 59.0/48.0, -49.0/48.0 + 17.0/96.0, 125.0/16.0 - 225.0/32.0,
+   0.0, 1.0/4.0
+};
+const double EmbeddedSDIRK54Solver::c[] =
+{
+   1.0/4.0, 3.0/4.0, 11.0/20.0, 1.0/2.0, 1.0
+};
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &f_)
 {
    ODESolver::Init(f_);
@@ -70,6 +70,25 @@ public:
          between the two Step() calls. */
    virtual void Step(Vector &x, double &t, double &dt) = 0;
 
+   /** @brief Attempt a time step of size @a dt [in] from time @a t [in] with
+       local error control. */
+   /** @param[in,out] x   Approximate solution.
+       @param[in,out] t   Time associated with the approximate solution @a x.
+       @param[in,out] dt  Time step size.
+       @return True if the step was accepted.
+
+       If the step is accepted, @a x and @a t are advanced to the time
+       @a t [in] + @a dt [in], otherwise they are left unchanged. In both
+       cases, @a dt [out] is the step size suggested for the next attempt.
+
+       The default implementation, used by the methods without error control,
+       calls Step() and always accepts the step. */
+   virtual bool AdaptiveStep(Vector &x, double &t, double &dt)
+   {
+      Step(x, t, dt);
+      return true;
+   }
+
    /// Perform time integration from time @a t [in] to time @a tf [in].
    /** @param[in,out] x   Approximate solution.
        @param[in,out] t   Time associated with the approximate solution @a x.
@@ -502,6 +521,197 @@ public:
 };
 
 
+/** Abstract base class for Runge-Kutta methods with an embedded solution of
+    lower order, used to estimate the local error and to adapt the step size.
+
+    The error estimate e is measured in the weighted root-mean-square norm
+
+        err = sqrt( 1/n sum_i (e_i / (atol + rtol max(|x_i|, |y_i|)))^2 ),
+
+    where x and y are the solutions at the beginning and at the end of the
+    step. A step is accepted if err <= 1 and the next step size is chosen by
+    the PI controller
+
+        dt_new = dt safety err^(-kI/p) err_prev^(kP/p),
+
+    limited to [min_factor, max_factor] dt, where p is the order of the
+    embedded method plus one and err_prev is the error of the previous
+    accepted step. After a rejected step the step size is not allowed to grow.
+    A step with a non-finite error estimate is rejected and the step size is
+    reduced by min_factor. The integration is aborted if the step size falls
+    below the minimum, see SetMinStepSize().
+
+    All the stage vectors are allocated in Init(); rejected steps reuse them.
+    If the solution is modified between two calls to the methods Step() or
+    AdaptiveStep(), Init() has to be called again. */
+class EmbeddedRKSolver : public ODESolver
+{
+protected:
+   int p;
+   double rtol, atol;
+   double safety, min_factor, max_factor, kI, kP;
+   double min_dt;
+   double err_prev;
+   bool rejected;
+   int num_accepted, num_rejected;
+   Vector y, e;
+
+   /** @brief Compute the solution @a y_ at time @a t + @a dt and the local
+       error estimate @a e_ without modifying @a x. */
+   virtual void TakeStep(const Vector &x, const double t, const double dt,
+                         Vector &y_, Vector &e_) = 0;
+
+   /** @brief Called after the step computed by TakeStep() was accepted or
+       rejected. */
+   virtual void StepDone(bool accepted) { }
+
+   /// Weighted root-mean-square norm of the error estimate @a e_.
+   virtual double ErrorNorm(const Vector &x, const Vector &y_,
+                            const Vector &e_) const;
+
+public:
+   /// The parameter @a p_ is the order of the embedded method plus one.
+   EmbeddedRKSolver(int p_);
+
+   /// Set the relative and absolute tolerances, 1e-4 and 1e-6 by default.
+   void SetTolerances(double rtol_, double atol_)
+   { rtol = rtol_; atol = atol_; }
+
+   /** @brief Set the safety factor and the bounds on the step size ratio,
+       0.9, 0.2 and 5 by default. */
+   void SetControllerParameters(double safety_, double min_factor_,
+                                double max_factor_)
+   { safety = safety_; min_factor = min_factor_; max_factor = max_factor_; }
+
+   /** @brief Set the minimum step size, 0 by default. Step sizes that do not
+       advance the time, i.e. below the roundoff of t, are always rejected. */
+   void SetMinStepSize(double min_dt_) { min_dt = min_dt_; }
+
+   /** @brief Set the gains of the PI controller, 0.7 and 0.4 by default. With
+       @a kP_ = 0, the controller reduces to the classical I controller. */
+   void SetPIGains(double kI_, double kP_) { kI = kI_; kP = kP_; }
+
+   /// Number of accepted steps since the last call to Init().
+   int GetNumAccepted() const { return num_accepted; }
+
+   /// Number of rejected steps since the last call to Init().
+   int GetNumRejected() const { return num_rejected; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   bool AdaptiveStep(Vector &x, double &t, double &dt) override;
+
+   /** @brief Repeat AdaptiveStep() until the step is accepted; @a dt [out] is
+       the size of the accepted step. */
+   void Step(Vector &x, double &t, double &dt) override;
+
+   /** @brief Integrate up to @a tf with the step sizes chosen by the
+       controller; @a dt [in] is the initial step size. */
+   void Run(Vector &x, double &t, double &dt, double tf) override;
+};
+
+
+/** An explicit embedded Runge-Kutta pair, given by a Butcher tableau in the
+    format of ExplicitRKSolver with the additional error weights e = b - b^,
+    where b^ are the weights of the embedded method. For methods with the
+    first same as last (FSAL) property, the last stage is reused as the first
+    stage of the next step. */
+class ExplicitEmbeddedRKSolver : public EmbeddedRKSolver
+{
+private:
+   int s;
+   const double *a, *b, *ee, *c;
+   bool fsal, k0_valid;
+   Vector z, *k;
+
+protected:
+   void TakeStep(const Vector &x, const double t, const double dt,
+                 Vector &y_, Vector &e_) override;
+
+   void StepDone(bool accepted) override;
+
+public:
+   ExplicitEmbeddedRKSolver(int s_, const double *a_, const double *b_,
+                            const double *e_, const double *c_, int p_,
+                            bool fsal_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~ExplicitEmbeddedRKSolver();
+};
+
+
+/** The 7-stage, 5th order Dormand-Prince method with an embedded 4th order
+    method, DOPRI5(4). FSAL. */
+class DP54Solver : public ExplicitEmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], e[7], c[6];
+
+public:
+   DP54Solver() : ExplicitEmbeddedRKSolver(7, a, b, e, c, 5, true) { }
+};
+
+
+/** The 4-stage, 3rd order Bogacki-Shampine method with an embedded 2nd order
+    method. FSAL. */
+class BS32Solver : public ExplicitEmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], e[4], c[3];
+
+public:
+   BS32Solver() : ExplicitEmbeddedRKSolver(4, a, b, e, c, 3, true) { }
+};
+
+
+/** An embedded singly diagonal implicit Runge-Kutta (SDIRK) pair with the
+    Butcher tableau
+    +--------+-------------------------------+
+    | c[0]   | a[0]                          |
+    | c[1]   | a[1] a[2]                     |
+    | ...    |    ...                        |
+    | c[s-1] | ...             a[s(s+1)/2-1] |
+    +--------+-------------------------------+
+    |        | b[0] b[1] ... b[s-1]          |
+    +--------+-------------------------------+
+    and the error weights e = b - b^, where b^ are the weights of the
+    embedded method. The stages are computed with
+    TimeDependentOperator::ImplicitSolve(). */
+class EmbeddedSDIRKSolver : public EmbeddedRKSolver
+{
+private:
+   int s;
+   const double *a, *b, *ee, *c;
+   Vector z, *k;
+
+protected:
+   void TakeStep(const Vector &x, const double t, const double dt,
+                 Vector &y_, Vector &e_) override;
+
+public:
+   EmbeddedSDIRKSolver(int s_, const double *a_, const double *b_,
+                       const double *e_, const double *c_, int p_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~EmbeddedSDIRKSolver();
+};
+
+
+/** Five stage, L-stable SDIRK method of order 4 with an embedded 3rd order
+    method, SDIRK4 from Hairer and Wanner, "Solving Ordinary Differential
+    Equations II", Table 6.5. */
+class EmbeddedSDIRK54Solver : public EmbeddedSDIRKSolver
+{
+private:
+   static const double a[15], b[5], e[5], c[5];
+
+public:
+   EmbeddedSDIRK54Solver() : EmbeddedSDIRKSolver(5, a, b, e, c, 4) { }
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier-Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
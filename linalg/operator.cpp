@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "vector.hpp"
+#include "multivector.hpp"
 #include "operator.hpp"
 #include "../general/forall.hpp"
 
@@ -178,6 +179,21 @@ void Operator::FormRectangularSystemOperator(const Array<int> &trial_tdof_list,
    Aout = A;
 }
 
+void Operator::MultMany(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_ASSERT(X.VectorSize() == width, "incorrect input MultiVector size");
+   MFEM_ASSERT(Y.VectorSize() == height && Y.NumVectors() == X.NumVectors(),
+               "incorrect output MultiVector size");
+   Vector x, y;
+   for (int j = 0; j < X.NumVectors(); j++)
+   {
+      X.GetVectorView(j, x);
+      Y.GetVectorView(j, y);
+      Mult(x, y);
+      y.SyncAliasMemory(Y);
+   }
+}
+
 void Operator::FormDiscreteOperator(Operator* &Aout)
 {
    const Operator *Pin  = this->GetProlongation();
@@ -478,6 +494,7 @@ void ConstrainedOperator::EliminateRHS(const Vector &x, Vector &b) const
 
 void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
    const int csz = constraint_list.Size();
    if (csz == 0)
    {
@@ -523,6 +540,38 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void ConstrainedOperator::MultMany(const MultiVector &X, MultiVector &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->MultMany(X, Y);
+      return;
+   }
+   if (diag_policy != DIAG_ONE && diag_policy != DIAG_ZERO)
+   {
+      Operator::MultMany(X, Y);
+      return;
+   }
+
+   const int n = width, nc = csz*X.NumVectors();
+   MultiVector Z(X);
+   auto idx = constraint_list.Read();
+   auto d_z = Z.ReadWrite();
+   MFEM_FORALL(i, nc, d_z[idx[i % csz] + (i / csz)*n] = 0.0;);
+
+   A->MultMany(Z, Y);
+
+   const bool one = (diag_policy == DIAG_ONE);
+   auto d_x = X.Read();
+   auto d_y = Y.ReadWrite();
+   MFEM_FORALL(i, nc,
+   {
+      const int id = idx[i % csz] + (i / csz)*n;
+      d_y[id] = one ? d_x[id] : 0.0;
+   });
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
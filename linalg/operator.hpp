@@ -19,6 +19,7 @@ namespace mfem
 
 class ConstrainedOperator;
 class RectangularConstrainedOperator;
+class MultiVector;
 
 /// Abstract operator
 class Operator
@@ -93,6 +94,14 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Operator application to all the vectors of @a X, `Y_j=A(X_j)`.
+       The MultiVector @a Y must have Height() x X.NumVectors() entries. */
+   /** The default implementation in class Operator calls Mult() for each
+       vector. Operators that stream large amounts of data, e.g. SparseMatrix,
+       override it to read their data once for all the vectors. For a Solver,
+       MultMany() solves the systems with all the right-hand sides. */
+   virtual void MultMany(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -884,6 +893,10 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Constrained operator action on all the vectors of @a X, using
+       the MultMany() method of the unconstrained operator. */
+   virtual void MultMany(const MultiVector &X, MultiVector &Y) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
    virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
 };
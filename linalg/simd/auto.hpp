@@ -39,6 +39,10 @@ struct MFEM_AUTOSIMD_ALIGN__ AutoSIMD
       return vec[i];
    }
 
+   AutoSIMD() = default;
+
+   AutoSIMD(const AutoSIMD &) = default;
+
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
    {
       MFEM_VECTORIZE_LOOP
@@ -48,6 +48,10 @@ template <> struct AutoSIMD<double,4,32>
       return vec[i];
    }
 
+   AutoSIMD() = default;
+
+   AutoSIMD(const AutoSIMD &) = default;
+
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
    {
       m256d = v.m256d;
@@ -49,6 +49,10 @@ template <> struct AutoSIMD<double,8,64>
       return vec[i];
    }
 
+   AutoSIMD() = default;
+
+   AutoSIMD(const AutoSIMD &) = default;
+
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
    {
       m512d = v.m512d;
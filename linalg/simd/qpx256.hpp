@@ -38,6 +38,10 @@ template <> struct AutoSIMD<double,4,32>
 
    inline __ATTRS_ai const double &operator[](int i) const { return vec[i]; }
 
+   AutoSIMD() = default;
+
+   AutoSIMD(const AutoSIMD &) = default;
+
    inline __ATTRS_ai AutoSIMD &operator=(const AutoSIMD &v)
    {
       vd = v.vd;
@@ -68,6 +68,19 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::Dots(const MultiVector &x, const MultiVector &y,
+                           Vector &d) const
+{
+   x.Dot(y, d);
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, d.HostReadWrite(), d.Size(), MPI_DOUBLE,
+                    MPI_SUM, comm);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -162,7 +175,9 @@ void OperatorJacobiSmoother::SetOperator(const Operator &op)
    if (!allow_updates)
    {
       // original behavior of this method
-      oper = &op; return;
+      oper = &op;
+      if (single_precision) { UpdateSinglePrecision(); }
+      return;
    }
 
    // Treat (Par)BilinearForm objects as a special case since their
@@ -193,6 +208,34 @@ void OperatorJacobiSmoother::SetOperator(const Operator &op)
    Setup(diag);
 }
 
+OperatorJacobiSmoother::~OperatorJacobiSmoother()
+{
+   delete oper_sp;
+}
+
+void OperatorJacobiSmoother::SetSinglePrecision(bool sp)
+{
+   single_precision = sp;
+   UpdateSinglePrecision();
+}
+
+void OperatorJacobiSmoother::UpdateSinglePrecision()
+{
+   delete oper_sp;
+   oper_sp = nullptr;
+   if (!single_precision) { dinv_sp.DeleteAll(); return; }
+
+   const SparseMatrix *spmat = dynamic_cast<const SparseMatrix *>(oper);
+   if (spmat && spmat->Finalized())
+   {
+      oper_sp = new MixedPrecisionSparseMatrix(*spmat);
+   }
+   dinv_sp.SetSize(height);
+   auto DI = dinv.Read();
+   auto DS = dinv_sp.Write();
+   MFEM_FORALL(i, height, DS[i] = static_cast<float>(DI[i]); );
+}
+
 void OperatorJacobiSmoother::Setup(const Vector &diag)
 {
    residual.UseDevice(true);
@@ -205,6 +248,7 @@ void OperatorJacobiSmoother::Setup(const Vector &diag)
       auto I = ess_tdof_list->Read();
       MFEM_FORALL(i, ess_tdof_list->Size(), DI[I[i]] = delta; );
    }
+   if (single_precision) { UpdateSinglePrecision(); }
 }
 
 void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
@@ -217,7 +261,8 @@ void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
    if (iterative_mode)
    {
       MFEM_VERIFY(oper, "iterative_mode == true requires the forward operator");
-      oper->Mult(y, residual);  // r = A y
+      if (oper_sp) { oper_sp->Mult(y, residual); }
+      else { oper->Mult(y, residual); } // r = A y
       subtract(x, residual, residual); // r = x - A y
    }
    else
@@ -226,9 +271,15 @@ void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
       y.UseDevice(true);
       y = 0.0;
    }
-   auto DI = dinv.Read();
    auto R = residual.Read();
    auto Y = y.ReadWrite();
+   if (single_precision)
+   {
+      auto DS = dinv_sp.Read();
+      MFEM_FORALL(i, height, Y[i] += DS[i] * R[i]; );
+      return;
+   }
+   auto DI = dinv.Read();
    MFEM_FORALL(i, height, Y[i] += DI[i] * R[i]; );
 }
 
@@ -306,6 +357,34 @@ OperatorChebyshevSmoother::OperatorChebyshevSmoother(const Operator* oper_,
                                power_tolerance) { }
 #endif
 
+OperatorChebyshevSmoother::~OperatorChebyshevSmoother()
+{
+   delete oper_sp;
+}
+
+void OperatorChebyshevSmoother::SetSinglePrecision(bool sp)
+{
+   single_precision = sp;
+   UpdateSinglePrecision();
+}
+
+void OperatorChebyshevSmoother::UpdateSinglePrecision()
+{
+   delete oper_sp;
+   oper_sp = nullptr;
+   if (!single_precision) { dinv_sp.DeleteAll(); return; }
+
+   const SparseMatrix *spmat = dynamic_cast<const SparseMatrix *>(oper);
+   if (spmat && spmat->Finalized())
+   {
+      oper_sp = new MixedPrecisionSparseMatrix(*spmat);
+   }
+   dinv_sp.SetSize(N);
+   auto DI = dinv.Read();
+   auto DS = dinv_sp.Write();
+   MFEM_FORALL(i, N, DS[i] = static_cast<float>(DI[i]); );
+}
+
 void OperatorChebyshevSmoother::Setup()
 {
    // Invert diagonal
@@ -381,6 +460,8 @@ void OperatorChebyshevSmoother::Setup()
       default:
          MFEM_ABORT("Chebyshev smoother not implemented for order = " << order);
    }
+
+   if (single_precision) { UpdateSinglePrecision(); }
 }
 
 void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
@@ -406,15 +487,24 @@ void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
       // Apply
       if (k > 0)
       {
-         oper->Mult(residual, helperVector);
+         if (oper_sp) { oper_sp->Mult(residual, helperVector); }
+         else { oper->Mult(residual, helperVector); }
          residual = helperVector;
       }
 
       // Scale residual by inverse diagonal
       const int n = N;
-      auto Dinv = dinv.Read();
       auto R = residual.ReadWrite();
-      MFEM_FORALL(i, n, R[i] *= Dinv[i]; );
+      if (single_precision)
+      {
+         auto Dinv = dinv_sp.Read();
+         MFEM_FORALL(i, n, R[i] *= Dinv[i]; );
+      }
+      else
+      {
+         auto Dinv = dinv.Read();
+         MFEM_FORALL(i, n, R[i] *= Dinv[i]; );
+      }
 
       // Add weighted contribution to y
       auto Y = y.ReadWrite();
@@ -431,6 +521,7 @@ void SLISolver::UpdateVectors()
 
 void SLISolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    int i;
 
    // Optimized preconditioned SLI with fixed number of iterations and given
@@ -509,6 +600,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
    final_iter = max_iter;
    for (i = 1; true; )
    {
+      MFEM_PERF_SCOPE("SLI iteration");
       if (prec) //  x = x + B (b - A x)
       {
          add(x, 1.0, z, x);
@@ -615,6 +707,7 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -693,6 +786,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    final_iter = max_iter;
    for (i = 1; true; )
    {
+      MFEM_PERF_SCOPE("PCG iteration");
       alpha = nom/den;
       add(x,  alpha, d, x);     //  x = x + alpha d
       add(r, -alpha, z, r);     //  r = r - alpha A d
@@ -799,6 +893,432 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    Monitor(final_iter, final_norm, r, x, true);
 }
 
+void CGSolver::MultMany(const MultiVector &B, MultiVector &X) const
+{
+   MFEM_PERF_FUNCTION;
+   const int n = width, nv = B.NumVectors();
+   MFEM_ASSERT(X.VectorSize() == n && X.NumVectors() == nv,
+               "invalid solution MultiVector");
+   MultiVector R(n, nv), Z(n, nv), D(n, nv);
+   R.UseDevice(true);
+   Z.UseDevice(true);
+   D.UseDevice(true);
+   Vector nom, den, betanom, alpha(nv), beta(nv), r0(nv), active(nv);
+
+   X.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->MultMany(X, R);
+      subtract(B, R, R); // R = B - A X
+   }
+   else
+   {
+      R = B;
+      X = 0.0;
+   }
+
+   if (prec)
+   {
+      prec->MultMany(R, Z); // Z = B R
+      D = Z;
+   }
+   else
+   {
+      D = R;
+   }
+   Dots(D, R, nom);
+
+   // The systems with a zero (active = 0) or a nonzero (active = 1) search
+   // direction; the coefficients of the converged systems are set to zero.
+   int num_active = 0, num_failed = 0;
+   for (int j = 0; j < nv; j++)
+   {
+      MFEM_ASSERT(IsFinite(nom(j)), "nom = " << nom(j));
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      active(j) = (nom(j) > r0(j)) ? 1.0 : 0.0;
+      num_active += (active(j) != 0.0);
+      if (nom(j) < 0.0) { num_failed++; }
+   }
+   if (num_failed > 0)
+   {
+      if (print_level >= 0)
+      {
+         mfem::out << "PCG: The preconditioner is not positive definite.\n";
+      }
+      converged = 0;
+      final_iter = 0;
+      final_norm = nom.Max();
+      return;
+   }
+   D.Scale(active);
+
+   int i;
+   for (i = 1; num_active > 0 && i <= max_iter; i++)
+   {
+      MFEM_PERF_SCOPE("PCG iteration");
+      oper->MultMany(D, Z); // Z = A D
+      Dots(D, Z, den);
+      for (int j = 0; j < nv; j++)
+      {
+         alpha(j) = 0.0;
+         if (active(j) == 0.0) { continue; }
+         if (den(j) <= 0.0)
+         {
+            if (print_level >= 0)
+            {
+               mfem::out << "PCG: The operator is not positive definite. "
+                         << "(Ad, d) = " << den(j) << '\n';
+            }
+            active(j) = 0.0;
+            num_active--;
+            num_failed++;
+            continue;
+         }
+         alpha(j) = nom(j)/den(j);
+      }
+      X.Add(alpha, D); // X = X + alpha D
+      alpha.Neg();
+      R.Add(alpha, Z); // R = R - alpha A D
+
+      if (prec)
+      {
+         prec->MultMany(R, Z); // Z = B R
+         Dots(R, Z, betanom);
+      }
+      else
+      {
+         Dots(R, R, betanom);
+      }
+
+      double max_betanom = 0.0;
+      for (int j = 0; j < nv; j++)
+      {
+         beta(j) = 0.0;
+         if (active(j) == 0.0) { continue; }
+         MFEM_ASSERT(IsFinite(betanom(j)), "betanom = " << betanom(j));
+         max_betanom = std::max(max_betanom, betanom(j));
+         if (betanom(j) <= r0(j) || betanom(j) < 0.0)
+         {
+            if (betanom(j) < 0.0) { num_failed++; }
+            active(j) = 0.0;
+            num_active--;
+         }
+         else
+         {
+            beta(j) = betanom(j)/nom(j);
+         }
+         nom(j) = betanom(j);
+      }
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << max_betanom << "  active systems: " << num_active
+                   << '\n';
+      }
+
+      D.Scale(beta);
+      D.Add(active, prec ? Z : R); // D = Z + beta D
+   }
+
+   converged = (num_active == 0 && num_failed == 0);
+   final_iter = i-1;
+   final_norm = sqrt(std::max(nom.Max(), 0.0));
+   if (print_level == 2 || print_level == 3)
+   {
+      mfem::out << "Number of PCG iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+}
+
+// Number of entries reduced by each block of the device kernel of
+// PipelinedCGSolver::UpdateAndDot()
+static constexpr int PCG_DOT_BLOCK = 256;
+
+void PipelinedCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   Vector *vecs[] = { &r, &u, &w, &m, &n, &p, &s, &q, &z };
+   for (int i = 0; i < 9; i++)
+   {
+      vecs[i]->SetSize(width, mt);
+      vecs[i]->UseDevice(true);
+   }
+   dots_part.SetSize(2*((width + PCG_DOT_BLOCK - 1)/PCG_DOT_BLOCK), mt);
+   dots_part.UseDevice(true);
+}
+
+void PipelinedCGSolver::UpdateAndDot(double alpha, double beta, Vector &x,
+                                     double *dots) const
+{
+   // Without preconditioner u = r, m = w and q = s
+   const bool pr = (prec != NULL);
+   const int N = x.Size();
+   auto X = x.ReadWrite();
+   auto R = r.ReadWrite();
+   auto U = pr ? u.ReadWrite() : R;
+   auto W = w.ReadWrite();
+   auto M = pr ? m.Read() : W;
+   auto Nv = n.Read();
+   auto P = p.ReadWrite();
+   auto S = s.ReadWrite();
+   auto Q = pr ? q.ReadWrite() : S;
+   auto Z = z.ReadWrite();
+   if (Device::Allows(Backend::DEVICE_MASK))
+   {
+      // Each block updates PCG_DOT_BLOCK entries and reduces their products
+      // in shared memory. Only the partial sums of the blocks are copied to
+      // the host.
+      const int NB = (N + PCG_DOT_BLOCK - 1)/PCG_DOT_BLOCK;
+      MFEM_ASSERT(dots_part.Size() >= 2*NB, "invalid partial sums size");
+      auto D = dots_part.Write();
+      MFEM_FORALL_2D(b, NB, PCG_DOT_BLOCK, 1, 1,
+      {
+         MFEM_SHARED double s_ru[PCG_DOT_BLOCK];
+         MFEM_SHARED double s_wu[PCG_DOT_BLOCK];
+         MFEM_FOREACH_THREAD(t, x, PCG_DOT_BLOCK)
+         {
+            const int i = b*PCG_DOT_BLOCK + t;
+            double ru = 0.0, wu = 0.0;
+            if (i < N)
+            {
+               Z[i] = Nv[i] + beta*Z[i];
+               if (pr) { Q[i] = M[i] + beta*Q[i]; }
+               S[i] = W[i] + beta*S[i];
+               P[i] = U[i] + beta*P[i];
+               X[i] += alpha*P[i];
+               R[i] -= alpha*S[i];
+               if (pr) { U[i] -= alpha*Q[i]; }
+               W[i] -= alpha*Z[i];
+               ru = R[i]*U[i];
+               wu = W[i]*U[i];
+            }
+            s_ru[t] = ru;
+            s_wu[t] = wu;
+         }
+         MFEM_SYNC_THREAD;
+         for (int k = PCG_DOT_BLOCK/2; k > 0; k /= 2)
+         {
+            MFEM_FOREACH_THREAD(t, x, k)
+            {
+               s_ru[t] += s_ru[t + k];
+               s_wu[t] += s_wu[t + k];
+            }
+            MFEM_SYNC_THREAD;
+         }
+         MFEM_FOREACH_THREAD(t, x, 1)
+         {
+            D[2*b] = s_ru[0];
+            D[2*b + 1] = s_wu[0];
+         }
+      });
+      const double *h_part = dots_part.HostRead();
+      dots[0] = dots[1] = 0.0;
+      for (int b = 0; b < NB; b++)
+      {
+         dots[0] += h_part[2*b];
+         dots[1] += h_part[2*b + 1];
+      }
+      return;
+   }
+   double ru = 0.0, wu = 0.0;
+   for (int i = 0; i < N; i++)
+   {
+      Z[i] = Nv[i] + beta*Z[i];
+      if (pr) { Q[i] = M[i] + beta*Q[i]; }
+      S[i] = W[i] + beta*S[i];
+      P[i] = U[i] + beta*P[i];
+      X[i] += alpha*P[i];
+      R[i] -= alpha*S[i];
+      if (pr) { U[i] -= alpha*Q[i]; }
+      W[i] -= alpha*Z[i];
+      ru += R[i]*U[i];
+      wu += W[i]*U[i];
+   }
+   dots[0] = ru;
+   dots[1] = wu;
+}
+
+void PipelinedCGSolver::ReduceAndApply(double *dots) const
+{
+#ifdef MFEM_USE_MPI
+   const MPI_Comm comm = GetComm();
+#if MPI_VERSION >= 3
+   MPI_Request request = MPI_REQUEST_NULL;
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Iallreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, comm,
+                     &request);
+   }
+#else
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+#endif
+
+   if (prec)
+   {
+      prec->Mult(w, m); //  m = B w
+      oper->Mult(m, n); //  n = A m
+   }
+   else
+   {
+      oper->Mult(w, n); //  n = A w
+   }
+
+#if defined(MFEM_USE_MPI) && MPI_VERSION >= 3
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Wait(&request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   double dots[2], gamma, gamma_old, delta, gamma0, r0, alpha, beta;
+
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   const Vector &uu = prec ? u : r;
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   oper->Mult(uu, w);   // w = A u
+   dots[0] = r * uu;
+   dots[1] = w * uu;
+   ReduceAndApply(dots);
+   gamma0 = gamma = dots[0];
+   delta = dots[1];
+   MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << gamma << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, gamma, r, x);
+
+   converged = 0;
+   final_iter = 0;
+   final_norm = sqrt(std::abs(gamma));
+   if (gamma < 0.0)
+   {
+      if (print_level >= 0)
+      {
+         mfem::out << "PipelinedCG: The preconditioner is not positive "
+                   "definite. (Br, r) = " << gamma << '\n';
+      }
+      return;
+   }
+   r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (gamma <= r0)
+   {
+      converged = 1;
+      return;
+   }
+
+   p = 0.0; s = 0.0; q = 0.0; z = 0.0;
+   alpha = 1.0;
+   beta = 0.0;
+   final_iter = max_iter;
+   for (int i = 1; i <= max_iter; i++)
+   {
+      const double den = (i == 1) ? delta : delta - beta*gamma/alpha;
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PipelinedCG: The operator is not positive "
+                      "definite. (Ad, d) = " << den << '\n';
+         }
+         final_iter = i - 1;
+         break;
+      }
+      alpha = gamma/den;
+
+      UpdateAndDot(alpha, beta, x, dots);
+      ReduceAndApply(dots);
+      gamma_old = gamma;
+      gamma = dots[0];
+      delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+      final_norm = sqrt(std::abs(gamma));
+
+      if (gamma < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PipelinedCG: The preconditioner is not positive "
+                      "definite. (Br, r) = " << gamma << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << '\n';
+      }
+
+      Monitor(i, gamma, r, x);
+
+      if (gamma <= r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PipelinedCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << gamma << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      beta = gamma/gamma_old;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << gamma0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter
+                   << "  (B r, r) = " << gamma << '\n';
+      }
+      mfem::out << "PipelinedCG: No convergence!" << '\n';
+   }
+   if (final_iter > 0 && (print_level >= 1 || (print_level >= 0 && !converged)))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/gamma0, 0.5/final_iter) << '\n';
+   }
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
@@ -883,6 +1403,7 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
 
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    // Generalized Minimum Residual method following the algorithm
    // on p. 20 of the SIAM Templates book.
 
@@ -960,6 +1481,7 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
+         MFEM_PERF_SCOPE("GMRES iteration");
          if (prec)
          {
             oper->Mult(*v[i], r);
@@ -1068,8 +1590,216 @@ finish:
    }
 }
 
+// Update the vector c of X with the Krylov vectors c of v, see Update().
+static void UpdateMany(MultiVector &X, int c, int k, DenseMatrix &h,
+                       Vector &s, Array<MultiVector*> &v)
+{
+   Vector y(s);
+
+   // Backsolve:
+   for (int i = k; i >= 0; i--)
+   {
+      y(i) /= h(i,i);
+      for (int j = i - 1; j >= 0; j--)
+      {
+         y(j) -= h(j,i) * y(i);
+      }
+   }
+
+   Vector xc, vc;
+   X.GetVectorView(c, xc);
+   for (int j = 0; j <= k; j++)
+   {
+      v[j]->GetVectorView(c, vc);
+      xc.Add(y(j), vc);
+   }
+   xc.SyncAliasMemory(X);
+}
+
+void GMRESSolver::MultMany(const MultiVector &B, MultiVector &X) const
+{
+   MFEM_PERF_FUNCTION;
+   const int n = width, nv = B.NumVectors();
+   MFEM_ASSERT(X.VectorSize() == n && X.NumVectors() == nv,
+               "invalid solution MultiVector");
+
+   // The Hessenberg matrix, the rotations and the right-hand side of the
+   // least squares problem of system c are H(c), and the columns c of cs, sn
+   // and s.
+   DenseTensor H(m+1, m, nv);
+   DenseMatrix s(m+1, nv), cs(m+1, nv), sn(m+1, nv);
+   MultiVector R(n, nv), W(n, nv);
+   R.UseDevice(true);
+   W.UseDevice(true);
+   Array<MultiVector *> v(m+1);
+   v = NULL;
+   Vector beta, h, scale(nv), active(nv), target(nv), sc;
+
+   X.UseDevice(true);
+   if (!iterative_mode) { X = 0.0; }
+
+   // R = M (B - A X), beta = ||R||, and the systems that are not converged:
+   // a converged system is not reactivated by a restart.
+   int num_active = 0;
+   auto Residual = [&](bool first)
+   {
+      if (first && !iterative_mode)
+      {
+         if (prec) { prec->MultMany(B, R); }
+         else { R = B; }
+      }
+      else
+      {
+         oper->MultMany(X, prec ? W : R);
+         if (prec)
+         {
+            subtract(B, W, W);
+            prec->MultMany(W, R);
+         }
+         else
+         {
+            subtract(B, R, R);
+         }
+      }
+      Dots(R, R, beta);
+      num_active = 0;
+      for (int c = 0; c < nv; c++)
+      {
+         beta(c) = sqrt(beta(c));
+         MFEM_ASSERT(IsFinite(beta(c)), "beta = " << beta(c));
+         if (first)
+         {
+            target(c) = std::max(rel_tol*beta(c), abs_tol);
+            active(c) = 1.0;
+         }
+         if (beta(c) <= target(c)) { active(c) = 0.0; }
+         num_active += (active(c) != 0.0);
+      }
+   };
+   Residual(true);
+
+   int j = 1;
+   double max_resid = beta.Normlinf();
+   while (num_active > 0 && j <= max_iter)
+   {
+      if (v[0] == NULL) { v[0] = new MultiVector(n, nv); }
+      for (int c = 0; c < nv; c++)
+      {
+         scale(c) = active(c) != 0.0 ? 1.0/beta(c) : 0.0;
+      }
+      *v[0] = R;
+      v[0]->Scale(scale);
+      s = 0.0;
+      for (int c = 0; c < nv; c++) { s(0,c) = beta(c); }
+
+      int i;
+      for (i = 0; i < m && j <= max_iter && num_active > 0; i++, j++)
+      {
+         MFEM_PERF_SCOPE("GMRES iteration");
+         if (prec)
+         {
+            oper->MultMany(*v[i], R);
+            prec->MultMany(R, W); // W = M A v[i]
+         }
+         else
+         {
+            oper->MultMany(*v[i], W);
+         }
+
+         for (int k = 0; k <= i; k++)
+         {
+            Dots(W, *v[k], h);
+            for (int c = 0; c < nv; c++) { H(k,i,c) = h(c); }
+            h.Neg();
+            W.Add(h, *v[k]); // W -= H(k,i) * v[k]
+         }
+         Dots(W, W, h);
+         if (v[i+1] == NULL) { v[i+1] = new MultiVector(n, nv); }
+         for (int c = 0; c < nv; c++)
+         {
+            H(i+1,i,c) = sqrt(h(c));
+            MFEM_ASSERT(IsFinite(H(i+1,i,c)), "Norm(w) = " << H(i+1,i,c));
+            scale(c) = (active(c) != 0.0 && H(i+1,i,c) != 0.0) ?
+                       1.0/H(i+1,i,c) : 0.0;
+         }
+         *v[i+1] = W;
+         v[i+1]->Scale(scale);
+
+         max_resid = 0.0;
+         for (int c = 0; c < nv; c++)
+         {
+            if (active(c) == 0.0) { continue; }
+            for (int k = 0; k < i; k++)
+            {
+               ApplyPlaneRotation(H(k,i,c), H(k+1,i,c), cs(k,c), sn(k,c));
+            }
+            GeneratePlaneRotation(H(i,i,c), H(i+1,i,c), cs(i,c), sn(i,c));
+            ApplyPlaneRotation(H(i,i,c), H(i+1,i,c), cs(i,c), sn(i,c));
+            ApplyPlaneRotation(s(i,c), s(i+1,c), cs(i,c), sn(i,c));
+
+            const double resid = fabs(s(i+1,c));
+            MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+            max_resid = std::max(max_resid, resid);
+            if (resid <= target(c))
+            {
+               s.GetColumn(c, sc);
+               UpdateMany(X, c, i, H(c), sc, v);
+               active(c) = 0.0;
+               num_active--;
+            }
+         }
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  max ||B r|| = " << max_resid
+                      << "  active systems: " << num_active << '\n';
+         }
+      }
+
+      if (num_active == 0) { break; }
+
+      // Restart the systems that did not converge in this cycle.
+      for (int c = 0; c < nv; c++)
+      {
+         if (active(c) == 0.0) { continue; }
+         s.GetColumn(c, sc);
+         UpdateMany(X, c, i-1, H(c), sc, v);
+      }
+      if (print_level == 1 && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+      Residual(false);
+      max_resid = 0.0;
+      for (int c = 0; c < nv; c++)
+      {
+         if (active(c) != 0.0) { max_resid = std::max(max_resid, beta(c)); }
+      }
+   }
+
+   converged = (num_active == 0);
+   final_iter = j-1;
+   final_norm = max_resid;
+   if (print_level == 2 || print_level == 3)
+   {
+      mfem::out << "GMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "GMRES: No convergence!\n";
+   }
+
+   for (int i = 0; i < v.Size(); i++)
+   {
+      delete v[i];
+   }
+}
+
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    DenseMatrix H(m+1,m);
    Vector s(m+1), cs(m+1), sn(m+1);
    Vector r(b.Size());
@@ -1127,6 +1857,7 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
+         MFEM_PERF_SCOPE("FGMRES iteration");
 
          if (z[i] == NULL) { z[i] = new Vector(b.Size()); }
          (*z[i]) = 0.0;
@@ -1279,6 +2010,7 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
@@ -1318,6 +2050,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 
    for (i = 1; i <= max_iter; i++)
    {
+      MFEM_PERF_SCOPE("BiCGSTAB iteration");
       rho_1 = Dot(rtilde, r);
       if (rho_1 == 0)
       {
@@ -1452,6 +2185,7 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -1501,6 +2235,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
 
    for (it = 1; it <= max_iter; it++)
    {
+      MFEM_PERF_SCOPE("MINRES iteration");
       v1 /= beta;
       if (prec)
       {
@@ -2742,11 +3477,9 @@ void BlockILU::Factorize()
    int nblockrows = Height()/block_size;
 
    // Precompute LU factorization of diagonal blocks
-   for (int i=0; i<nblockrows; ++i)
-   {
-      LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
-      factorization.Factor(block_size);
-   }
+   BatchLUFactor(DB, ipiv);
+   DB.HostReadWrite();
+   ipiv.HostReadWrite();
 
    // Note: we use UseExternalData to extract submatrices from the tensor AB
    // instead of the DenseTensor call operator, because the call operator does
@@ -31,6 +31,7 @@ namespace mfem
 {
 
 class BilinearForm;
+class MixedPrecisionSparseMatrix;
 
 /// Abstract base class for an iterative solver monitor
 class IterativeSolverMonitor
@@ -85,6 +86,8 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /// Set @a d(j) to Dot() of the vectors @a j of @a x and @a y.
+   void Dots(const MultiVector &x, const MultiVector &y, Vector &d) const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -161,11 +164,18 @@ public:
                           const Array<int> &ess_tdof_list,
                           const double damping=1.0);
 
-   ~OperatorJacobiSmoother() {}
+   ~OperatorJacobiSmoother();
 
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const { Mult(x, y); }
 
+   /** @brief Store the inverse diagonal in single precision and, if the
+       operator is a SparseMatrix, use a single precision copy of its entries,
+       MixedPrecisionSparseMatrix, to compute the residual. */
+   /** The vectors and the arithmetic remain in double precision, so the outer
+       Krylov solver still converges to double precision tolerances. */
+   void SetSinglePrecision(bool sp = true);
+
    /** @brief Recompute the diagonal using the method AssembleDiagonal of the
        given new Operator, @a op. */
    /** Note that (Par)BilinearForm operators are treated similar to the way they
@@ -191,6 +201,12 @@ private:
    // false to disallow updating the OperatorJacobiSmoother with SetOperator.
    const bool allow_updates;
 
+   bool single_precision = false;
+   Array<float> dinv_sp;
+   MixedPrecisionSparseMatrix *oper_sp = nullptr; // owned; may be NULL
+
+   void UpdateSinglePrecision();
+
 public:
    void Setup(const Vector &diag);
 };
@@ -253,7 +269,7 @@ public:
                              double power_tolerance = 1e-8);
 #endif
 
-   ~OperatorChebyshevSmoother() {}
+   ~OperatorChebyshevSmoother();
 
    void Mult(const Vector&x, Vector &y) const;
 
@@ -262,8 +278,14 @@ public:
    void SetOperator(const Operator &op_)
    {
       oper = &op_;
+      UpdateSinglePrecision();
    }
 
+   /** @brief Store the inverse diagonal in single precision and, if the
+       operator is a SparseMatrix, apply it with a single precision copy of its
+       entries, see OperatorJacobiSmoother::SetSinglePrecision(). */
+   void SetSinglePrecision(bool sp = true);
+
    void Setup();
 
 private:
@@ -277,6 +299,12 @@ private:
    mutable Vector residual;
    mutable Vector helperVector;
    const Operator* oper;
+
+   bool single_precision = false;
+   Array<float> dinv_sp;
+   MixedPrecisionSparseMatrix *oper_sp = nullptr; // owned; may be NULL
+
+   void UpdateSinglePrecision();
 };
 
 
@@ -331,6 +359,57 @@ public:
    { IterativeSolver::SetOperator(op); UpdateVectors(); }
 
    virtual void Mult(const Vector &b, Vector &x) const;
+
+   /** @brief Solve the systems with all the right-hand sides @a B, using @a X
+       as the initial guesses if iterative_mode is true. */
+   /** The CG iterations of the systems are performed in lockstep, so that the
+       operator and the preconditioner are applied once per iteration, with
+       Operator::MultMany(), to the search directions of all the systems. The
+       systems stop being updated when they converge. GetNumIterations() and
+       GetFinalNorm() return the largest values over the systems, and
+       GetConverged() is true if all the systems converged. */
+   virtual void MultMany(const MultiVector &B, MultiVector &X) const;
+};
+
+/** Pipelined (preconditioned) conjugate gradient method, following P. Ghysels
+    and W. Vanroose, "Hiding global synchronization latency in the
+    preconditioned Conjugate Gradient algorithm", Parallel Computing, 2014.
+
+    Mathematically equivalent to CGSolver, but the two inner products of an
+    iteration are combined into a single global reduction. In parallel, the
+    reduction is non-blocking (with MPI-3) and overlaps the application of the
+    preconditioner and of the operator. The vector updates of an iteration are
+    fused into a single kernel. The recurrences require more vectors than
+    CGSolver and may result in a slightly lower attainable accuracy. */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, p, s, q, z;
+   /// Per-block partial sums of the inner products, used on the device.
+   mutable Vector dots_part;
+
+   void UpdateVectors();
+
+   /** @brief Fused update of the vectors and computation of the local parts of
+       the inner products (r, u) and (w, u), in a single kernel. */
+   void UpdateAndDot(double alpha, double beta, Vector &x,
+                     double *dots) const;
+
+   /** @brief Start the global reduction of @a dots, apply the preconditioner
+       and the operator, m = B w and n = A m, then complete the reduction. */
+   void ReduceAndApply(double *dots) const;
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
 };
 
 /// Conjugate gradient method. (tolerances are squared)
@@ -361,6 +440,15 @@ public:
    void SetKDim(int dim) { m = dim; }
 
    virtual void Mult(const Vector &b, Vector &x) const;
+
+   /** @brief Solve the systems with all the right-hand sides @a B, using @a X
+       as the initial guesses if iterative_mode is true. */
+   /** Each system has its own Krylov space, and the GMRES iterations of the
+       systems are performed in lockstep, so that the operator and the
+       preconditioner are applied once per iteration, with
+       Operator::MultMany(), to the Krylov vectors of all the systems. See
+       CGSolver::MultMany() for the reported statistics. */
+   virtual void MultMany(const MultiVector &B, MultiVector &X) const;
 };
 
 /// FGMRES method
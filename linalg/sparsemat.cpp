@@ -35,6 +35,182 @@ size_t SparseMatrix::bufferSize = 0;
 void * SparseMatrix::dBuffer = nullptr;
 #endif
 
+namespace internal
+{
+
+// CSR kernels shared by SparseMatrix and MixedPrecisionSparseMatrix. The matrix
+// entries have type T (double or float), the vectors and the arithmetic are in
+// double precision.
+
+template <typename T>
+void CSRAddMult(bool use_dev, int height, const int *d_I, const int *d_J,
+                const T *d_A, const double *d_x, double *d_y, double a)
+{
+   MFEM_FORALL_SWITCH(use_dev, i, height,
+   {
+      double d = 0.0;
+      const int end = d_I[i+1];
+      for (int j = d_I[i]; j < end; j++)
+      {
+         d += d_A[j] * d_x[d_J[j]];
+      }
+      d_y[i] += a * d;
+   });
+}
+
+template <typename T>
+void CSRGaussSeidelForw(int s, const int *Ip, const int *Jp, const T *Ap,
+                        const double *xp, double *yp, const char *error)
+{
+   for (int i = 0, j = Ip[0]; i < s; i++)
+   {
+      const int end = Ip[i+1];
+      double sum = 0.0;
+      int d = -1;
+      for ( ; j < end; j++)
+      {
+         const int c = Jp[j];
+         if (c == i)
+         {
+            d = j;
+         }
+         else
+         {
+            sum += Ap[j] * yp[c];
+         }
+      }
+
+      if (d >= 0 && Ap[d] != T(0))
+      {
+         yp[i] = (xp[i] - sum) / Ap[d];
+      }
+      else if (xp[i] == sum)
+      {
+         yp[i] = sum;
+      }
+      else
+      {
+         mfem_error(error);
+      }
+   }
+}
+
+template <typename T>
+void CSRGaussSeidelBack(int s, const int *Ip, const int *Jp, const T *Ap,
+                        const double *xp, double *yp, const char *error)
+{
+   for (int i = s-1, j = Ip[s]-1; i >= 0; i--)
+   {
+      const int beg = Ip[i];
+      double sum = 0.;
+      int d = -1;
+      for ( ; j >= beg; j--)
+      {
+         const int c = Jp[j];
+         if (c == i)
+         {
+            d = j;
+         }
+         else
+         {
+            sum += Ap[j] * yp[c];
+         }
+      }
+
+      if (d >= 0 && Ap[d] != T(0))
+      {
+         yp[i] = (xp[i] - sum) / Ap[d];
+      }
+      else if (xp[i] == sum)
+      {
+         yp[i] = sum;
+      }
+      else
+      {
+         mfem_error(error);
+      }
+   }
+}
+
+template <typename T>
+void CSRJacobi(int height, const int *Ip, const int *Jp, const T *Ap,
+               const double *bp, const double *x0p, double *x1p, double sc,
+               const char *error)
+{
+   for (int i = 0; i < height; i++)
+   {
+      int d = -1;
+      double sum = bp[i];
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         if (Jp[j] == i)
+         {
+            d = j;
+         }
+         else
+         {
+            sum -= Ap[j] * x0p[Jp[j]];
+         }
+      }
+      if (d >= 0 && Ap[d] != T(0))
+      {
+         x1p[i] = sc * (sum / Ap[d]) + (1.0 - sc) * x0p[i];
+      }
+      else
+      {
+         mfem_error(error);
+      }
+   }
+}
+
+template <typename T>
+void CSRJacobi2(int height, const int *Ip, const int *Jp, const T *Ap,
+                const double *bp, const double *x0p, double *x1p, double sc)
+{
+   for (int i = 0; i < height; i++)
+   {
+      double resi = bp[i], norm = 0.0;
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         resi -= Ap[j] * x0p[Jp[j]];
+         norm += fabs(Ap[j]);
+      }
+      if (norm > 0.0)
+      {
+         x1p[i] = x0p[i] + sc * resi / norm;
+      }
+      else
+      {
+         MFEM_ABORT("L1 norm of row " << i << " is zero.");
+      }
+   }
+}
+
+template <typename T>
+void CSRJacobi3(int height, const int *Ip, const int *Jp, const T *Ap,
+                const double *bp, const double *x0p, double *x1p, double sc)
+{
+   for (int i = 0; i < height; i++)
+   {
+      double resi = bp[i], sum = 0.0;
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         resi -= Ap[j] * x0p[Jp[j]];
+         sum  += Ap[j];
+      }
+      if (sum > 0.0)
+      {
+         x1p[i] = x0p[i] + sc * resi / sum;
+      }
+      else
+      {
+         MFEM_ABORT("sum of row " << i << " is zero.");
+      }
+   }
+}
+
+} // namespace mfem::internal
+
 void SparseMatrix::InitCuSparse()
 {
    // Initialize cuSPARSE library
@@ -623,6 +799,7 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
                << ") must match matrix width (" << width << ")");
    MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
                << ") must match matrix height (" << height << ")");
+   MFEM_PERF_FUNCTION;
 
    if (!Finalized())
    {
@@ -644,6 +821,10 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
       return;
    }
 
+   // CSR values and column indices, row offsets, x, and y read and written
+   MFEM_PERF_WORK(12.0*J.Capacity() + 4.0*height + 8.0*(width + 2.0*height),
+                  2.0*J.Capacity());
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -735,17 +916,7 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
    else
    {
       // Native version
-      MFEM_FORALL(i, height,
-      {
-         double d = 0.0;
-         const int end = d_I[i+1];
-         for (int j = d_I[i]; j < end; j++)
-         {
-            d += d_A[j] * d_x[d_J[j]];
-         }
-         d_y[i] += a * d;
-      });
-
+      internal::CSRAddMult(true, height, d_I, d_J, d_A, d_x, d_y, a);
    }
 
 #else
@@ -767,6 +938,73 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 #endif
 }
 
+void SparseMatrix::MultMany(const MultiVector &X, MultiVector &Y) const
+{
+   Y.UseDevice(true);
+   Y = 0.0;
+   AddMultMany(X, Y);
+}
+
+void SparseMatrix::AddMultMany(const MultiVector &X, MultiVector &Y,
+                               const double a) const
+{
+   MFEM_ASSERT(width == X.VectorSize(), "Input vector size ("
+               << X.VectorSize() << ") must match matrix width (" << width
+               << ")");
+   MFEM_ASSERT(height == Y.VectorSize() && X.NumVectors() == Y.NumVectors(),
+               "Output MultiVector size (" << Y.VectorSize() << " x "
+               << Y.NumVectors() << ") must match matrix height (" << height
+               << ") and the number of input vectors");
+   MFEM_PERF_FUNCTION;
+
+   if (!Finalized())
+   {
+      Vector x, y;
+      for (int j = 0; j < X.NumVectors(); j++)
+      {
+         X.GetVectorView(j, x);
+         Y.GetVectorView(j, y);
+         AddMult(x, y, a);
+      }
+      return;
+   }
+
+   const int nv = X.NumVectors();
+   MFEM_PERF_WORK(12.0*J.Capacity() + 4.0*height + 8.0*nv*(width + 2.0*height),
+                  2.0*nv*J.Capacity());
+
+   const int height = this->height;
+   const int width = this->width;
+   const int nnz = J.Capacity();
+   if (nnz == 0) { return; }
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   auto d_x = X.Read();
+   auto d_y = Y.ReadWrite();
+   // The vectors are processed in groups of up to MAX_NV, accumulated in
+   // registers, so that each entry of the matrix is read once per group.
+   constexpr int MAX_NV = 8;
+   MFEM_FORALL(i, height,
+   {
+      const int begin = d_I[i], end = d_I[i+1];
+      for (int j0 = 0; j0 < nv; j0 += MAX_NV)
+      {
+         const int nj = (nv - j0 < MAX_NV) ? nv - j0 : MAX_NV;
+         const double *x0 = d_x + j0*width;
+         double d[MAX_NV];
+         for (int c = 0; c < MAX_NV; c++) { d[c] = 0.0; }
+         for (int p = begin; p < end; p++)
+         {
+            const double v = d_A[p];
+            const double *xp = x0 + d_J[p];
+            for (int c = 0; c < nj; c++) { d[c] += v * xp[c*width]; }
+         }
+         for (int c = 0; c < nj; c++) { d_y[i + (j0+c)*height] += a * d[c]; }
+      }
+   });
+}
+
 void SparseMatrix::MultTranspose(const Vector &x, Vector &y) const
 {
    if (Finalized()) { y.UseDevice(true); }
@@ -781,6 +1019,7 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
                << ") must match matrix height (" << height << ")");
    MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
                << ") must match matrix width (" << width << ")");
+   MFEM_PERF_FUNCTION;
 
    if (!Finalized())
    {
@@ -806,6 +1045,8 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    {
       MFEM_VERIFY(Device::IsDisabled(), "transpose action on device is not "
                   "enabled; see BuildTranspose() for details.");
+      MFEM_PERF_WORK(12.0*J.Capacity() + 4.0*height + 8.0*(2.0*width + height),
+                     2.0*J.Capacity());
       for (int i = 0; i < height; i++)
       {
          const double xi = a * x[i];
@@ -2243,37 +2484,8 @@ void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
       double *yp = y.HostReadWrite();
       const double *xp = x.HostRead();
 
-      for (int i = 0, j = Ip[0]; i < s; i++)
-      {
-         const int end = Ip[i+1];
-         double sum = 0.0;
-         int d = -1;
-         for ( ; j < end; j++)
-         {
-            const int c = Jp[j];
-            if (c == i)
-            {
-               d = j;
-            }
-            else
-            {
-               sum += Ap[j] * yp[c];
-            }
-         }
-
-         if (d >= 0 && Ap[d] != 0.0)
-         {
-            yp[i] = (xp[i] - sum) / Ap[d];
-         }
-         else if (xp[i] == sum)
-         {
-            yp[i] = sum;
-         }
-         else
-         {
-            mfem_error("SparseMatrix::Gauss_Seidel_forw(...) #2");
-         }
-      }
+      internal::CSRGaussSeidelForw(s, Ip, Jp, Ap, xp, yp,
+                                   "SparseMatrix::Gauss_Seidel_forw(...) #2");
    }
 }
 
@@ -2326,37 +2538,8 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
       double *yp = y.HostReadWrite();
       const double *xp = x.HostRead();
 
-      for (int i = s-1, j = Ip[s]-1; i >= 0; i--)
-      {
-         const int beg = Ip[i];
-         double sum = 0.;
-         int d = -1;
-         for ( ; j >= beg; j--)
-         {
-            const int c = Jp[j];
-            if (c == i)
-            {
-               d = j;
-            }
-            else
-            {
-               sum += Ap[j] * yp[c];
-            }
-         }
-
-         if (d >= 0 && Ap[d] != 0.0)
-         {
-            yp[i] = (xp[i] - sum) / Ap[d];
-         }
-         else if (xp[i] == sum)
-         {
-            yp[i] = sum;
-         }
-         else
-         {
-            mfem_error("SparseMatrix::Gauss_Seidel_back(...) #2");
-         }
-      }
+      internal::CSRGaussSeidelBack(s, Ip, Jp, Ap, xp, yp,
+                                   "SparseMatrix::Gauss_Seidel_back(...) #2");
    }
 }
 
@@ -2398,30 +2581,10 @@ void SparseMatrix::Jacobi(const Vector &b, const Vector &x0, Vector &x1,
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
-   for (int i = 0; i < height; i++)
-   {
-      int d = -1;
-      double sum = b(i);
-      for (int j = I[i]; j < I[i+1]; j++)
-      {
-         if (J[j] == i)
-         {
-            d = j;
-         }
-         else
-         {
-            sum -= A[j] * x0(J[j]);
-         }
-      }
-      if (d >= 0 && A[d] != 0.0)
-      {
-         x1(i) = sc * (sum / A[d]) + (1.0 - sc) * x0(i);
-      }
-      else
-      {
-         mfem_error("SparseMatrix::Jacobi(...) #2");
-      }
-   }
+   const int nnz = J.Capacity();
+   internal::CSRJacobi(height, HostRead(I, height+1), HostRead(J, nnz),
+                       HostRead(A, nnz), b.HostRead(), x0.HostRead(),
+                       x1.HostWrite(), sc, "SparseMatrix::Jacobi(...) #2");
 }
 
 void SparseMatrix::DiagScale(const Vector &b, Vector &x, double sc) const
@@ -2466,23 +2629,10 @@ void SparseMatrix::Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
-   for (int i = 0; i < height; i++)
-   {
-      double resi = b(i), norm = 0.0;
-      for (int j = I[i]; j < I[i+1]; j++)
-      {
-         resi -= A[j] * x0(J[j]);
-         norm += fabs(A[j]);
-      }
-      if (norm > 0.0)
-      {
-         x1(i) = x0(i) + sc * resi / norm;
-      }
-      else
-      {
-         MFEM_ABORT("L1 norm of row " << i << " is zero.");
-      }
-   }
+   const int nnz = J.Capacity();
+   internal::CSRJacobi2(height, HostRead(I, height+1), HostRead(J, nnz),
+                        HostRead(A, nnz), b.HostRead(), x0.HostRead(),
+                        x1.HostWrite(), sc);
 }
 
 void SparseMatrix::Jacobi3(const Vector &b, const Vector &x0, Vector &x1,
@@ -2490,23 +2640,10 @@ void SparseMatrix::Jacobi3(const Vector &b, const Vector &x0, Vector &x1,
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
-   for (int i = 0; i < height; i++)
-   {
-      double resi = b(i), sum = 0.0;
-      for (int j = I[i]; j < I[i+1]; j++)
-      {
-         resi -= A[j] * x0(J[j]);
-         sum  += A[j];
-      }
-      if (sum > 0.0)
-      {
-         x1(i) = x0(i) + sc * resi / sum;
-      }
-      else
-      {
-         MFEM_ABORT("sum of row " << i << " is zero.");
-      }
-   }
+   const int nnz = J.Capacity();
+   internal::CSRJacobi3(height, HostRead(I, height+1), HostRead(J, nnz),
+                        HostRead(A, nnz), b.HostRead(), x0.HostRead(),
+                        x1.HostWrite(), sc);
 }
 
 void SparseMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
@@ -3424,55 +3561,35 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 }
 
 
-SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
-                    SparseMatrix *OAB)
+// Symbolic phase of the product C = A B: compute the row offsets C_i, of size
+// nrowsA+1, and return the column indices of C. The columns of each row of C
+// are listed in the order of their first appearance in the product.
+static int *SparseMatrixProductPattern(const SparseMatrix &A,
+                                       const SparseMatrix &B, int *C_i)
 {
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
-   const double *A_data, *B_data;
-   double *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
-   SparseMatrix *C;
+   const int nrowsA = A.Height();
+   const int ncolsB = B.Width();
+   const int *A_i = A.HostReadI();
+   const int *A_j = A.HostReadJ();
+   const int *B_i = B.HostReadI();
+   const int *B_j = B.HostReadJ();
 
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
-
-   MFEM_VERIFY(ncolsA == nrowsB,
-               "number of columns of A (" << ncolsA
-               << ") must equal number of rows of B (" << nrowsB << ")");
-
-   A_i    = A.HostReadI();
-   A_j    = A.HostReadJ();
-   A_data = A.HostReadData();
-   B_i    = B.HostReadI();
-   B_j    = B.HostReadJ();
-   B_data = B.HostReadData();
-
-   B_marker = new int[ncolsB];
-
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
-
-   if (OAB == NULL)
+   C_i[0] = 0;
+   #pragma omp parallel
    {
-      C_i = Memory<int>(nrowsA+1);
+      int *B_marker = new int[ncolsB];
+      for (int ib = 0; ib < ncolsB; ib++) { B_marker[ib] = -1; }
 
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+      #pragma omp for
+      for (int ic = 0; ic < nrowsA; ic++)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         int num_nonzeros = 0;
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            const int ja = A_j[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
             {
-               jb = B_j[ib];
+               const int jb = B_j[ib];
                if (B_marker[jb] != ic)
                {
                   B_marker[jb] = ic;
@@ -3482,16 +3599,117 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
          }
          C_i[ic+1] = num_nonzeros;
       }
+      delete [] B_marker;
+   }
+   for (int ic = 0; ic < nrowsA; ic++) { C_i[ic+1] += C_i[ic]; }
 
-      C_j    = Memory<int>(num_nonzeros);
-      C_data = Memory<double>(num_nonzeros);
-
-      C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
+   int *C_j = Memory<int>(C_i[nrowsA]);
+   #pragma omp parallel
+   {
+      int *B_marker = new int[ncolsB];
+      for (int ib = 0; ib < ncolsB; ib++) { B_marker[ib] = -1; }
 
-      for (ib = 0; ib < ncolsB; ib++)
+      #pragma omp for
+      for (int ic = 0; ic < nrowsA; ic++)
       {
-         B_marker[ib] = -1;
+         int counter = C_i[ic];
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         {
+            const int ja = A_j[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            {
+               const int jb = B_j[ib];
+               if (B_marker[jb] != ic)
+               {
+                  B_marker[jb] = ic;
+                  C_j[counter++] = jb;
+               }
+            }
+         }
+      }
+      delete [] B_marker;
+   }
+   return C_j;
+}
+
+// Numeric phase of the product C = A B: compute the entries of C, whose
+// sparsity pattern must contain the one of A B. Entries of C that are not in
+// the pattern of A B are set to zero. Returns the number of products of
+// entries of A and B that fall outside of the pattern of C.
+static int SparseMatrixProductValues(const SparseMatrix &A,
+                                     const SparseMatrix &B, SparseMatrix &C)
+{
+   const int nrowsA = A.Height();
+   const int ncolsB = B.Width();
+   const int *A_i = A.HostReadI();
+   const int *A_j = A.HostReadJ();
+   const double *A_data = A.HostReadData();
+   const int *B_i = B.HostReadI();
+   const int *B_j = B.HostReadJ();
+   const double *B_data = B.HostReadData();
+   const int *C_i = C.HostReadI();
+   const int *C_j = C.HostReadJ();
+   double *C_data = C.HostWriteData();
+
+   int missing = 0;
+   #pragma omp parallel reduction(+:missing)
+   {
+      // C_marker[j] is the position of the column j in the current row of C
+      int *C_marker = new int[ncolsB];
+      for (int jc = 0; jc < ncolsB; jc++) { C_marker[jc] = -1; }
+
+      #pragma omp for
+      for (int ic = 0; ic < nrowsA; ic++)
+      {
+         const int row_start = C_i[ic], row_end = C_i[ic+1];
+         for (int k = row_start; k < row_end; k++)
+         {
+            C_marker[C_j[k]] = k;
+            C_data[k] = 0.0;
+         }
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         {
+            const int ja = A_j[ia];
+            const double a_entry = A_data[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            {
+               const int k = C_marker[B_j[ib]];
+               if (row_start <= k && k < row_end)
+               {
+                  C_data[k] += a_entry*B_data[ib];
+               }
+               else
+               {
+                  missing++;
+               }
+            }
+         }
       }
+      delete [] C_marker;
+   }
+   return missing;
+}
+
+SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
+                    SparseMatrix *OAB)
+{
+   const int nrowsA = A.Height();
+   const int ncolsA = A.Width();
+   const int nrowsB = B.Height();
+   const int ncolsB = B.Width();
+
+   MFEM_VERIFY(ncolsA == nrowsB,
+               "number of columns of A (" << ncolsA
+               << ") must equal number of rows of B (" << nrowsB << ")");
+
+   SparseMatrix *C;
+   if (OAB == NULL)
+   {
+      int *C_i = Memory<int>(nrowsA+1);
+      int *C_j = SparseMatrixProductPattern(A, B, C_i);
+      double *C_data = Memory<double>(C_i[nrowsA]);
+
+      C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
    }
    else
    {
@@ -3503,51 +3721,14 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                   << ", C->Height() = " << C->Height()
                   << " ncolsB = " << ncolsB
                   << ", C->Width() = " << C->Width());
-
-      // C_i    = C->HostReadI(); // not used
-      C_j    = C->HostWriteJ();
-      C_data = C->HostWriteData();
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
-   {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
-      {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
-         {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
-            {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
-               {
-                  C_j[counter] = jb;
-               }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
-            {
-               C_data[B_marker[jb]] += a_entry*b_entry;
-            }
-         }
-      }
-   }
-
-   MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
+   const int missing = SparseMatrixProductValues(A, B, *C);
 
-   delete [] B_marker;
+   MFEM_VERIFY(missing == 0,
+               "With pre-allocated output matrix, " << missing
+               << " entries of the matrix-matrix multiply are not in the"
+               " sparsity pattern of the output matrix");
 
    return C;
 }
@@ -3715,6 +3896,149 @@ SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
    return out;
 }
 
+SparseMatrixProduct::SparseMatrixProduct(const SparseMatrix &A,
+                                         const SparseMatrix &B)
+   : height(A.Height()), width(B.Width()), inner(A.Width())
+{
+   MFEM_VERIFY(inner == B.Height(),
+               "number of columns of A (" << inner
+               << ") must equal number of rows of B (" << B.Height() << ")");
+
+   I.SetSize(height+1);
+   int *C_j = SparseMatrixProductPattern(A, B, I.GetData());
+   J.MakeRef(C_j, I[height]);
+   J.MakeDataOwner();
+}
+
+SparseMatrix *SparseMatrixProduct::Mult(const SparseMatrix &A,
+                                        const SparseMatrix &B) const
+{
+   int *C_i = Memory<int>(height+1);
+   int *C_j = Memory<int>(J.Size());
+   double *C_data = Memory<double>(J.Size());
+   std::copy(I.begin(), I.end(), C_i);
+   std::copy(J.begin(), J.end(), C_j);
+
+   SparseMatrix *C = new SparseMatrix(C_i, C_j, C_data, height, width);
+   Mult(A, B, *C);
+   return C;
+}
+
+void SparseMatrixProduct::Mult(const SparseMatrix &A, const SparseMatrix &B,
+                               SparseMatrix &C) const
+{
+   MFEM_VERIFY(A.Height() == height && A.Width() == inner &&
+               B.Height() == inner && B.Width() == width,
+               "the sizes of A and B do not match the ones of the product");
+   MFEM_VERIFY(C.Finalized() && C.Height() == height && C.Width() == width &&
+               C.NumNonZeroElems() == J.Size(),
+               "the matrix C does not have the sparsity pattern of the product");
+
+   const int missing = SparseMatrixProductValues(A, B, C);
+
+   MFEM_VERIFY(missing == 0, "the sparsity patterns of A and B do not match"
+               " the ones used to construct the product");
+}
+
+SparseMatrixRAP::SparseMatrixRAP(const SparseMatrix &Rt, const SparseMatrix &A,
+                                 const SparseMatrix &P_)
+   : P(P_), R(Transpose(Rt)), RA_prod(*R, A), RA(RA_prod.Mult(*R, A)),
+     RAP_prod(*RA, P)
+{ }
+
+SparseMatrix *SparseMatrixRAP::Mult(const SparseMatrix &A) const
+{
+   RA_prod.Mult(*R, A, *RA);
+   return RAP_prod.Mult(*RA, P);
+}
+
+void SparseMatrixRAP::Mult(const SparseMatrix &A, SparseMatrix &RAP_) const
+{
+   RA_prod.Mult(*R, A, *RA);
+   RAP_prod.Mult(*RA, P, RAP_);
+}
+
+SparseMatrixRAP::~SparseMatrixRAP()
+{
+   delete RA;
+   delete R;
+}
+
+MixedPrecisionSparseMatrix::MixedPrecisionSparseMatrix(const SparseMatrix &m)
+   : Operator(m.Height(), m.Width()), mat(m)
+{
+   MFEM_VERIFY(mat.Finalized(), "Matrix must be finalized.");
+   Update();
+}
+
+void MixedPrecisionSparseMatrix::Update()
+{
+   const int nnz = mat.NumNonZeroElems();
+   const double *Ap = mat.HostReadData();
+   A.SetSize(nnz);
+   float *Af = A.HostWrite();
+   for (int j = 0; j < nnz; j++) { Af[j] = static_cast<float>(Ap[j]); }
+}
+
+void MixedPrecisionSparseMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void MixedPrecisionSparseMatrix::AddMult(const Vector &x, Vector &y,
+                                         const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+
+   const bool use_dev = x.UseDevice() || y.UseDevice();
+   internal::CSRAddMult(use_dev, height, mat.ReadI(use_dev),
+                        mat.ReadJ(use_dev), A.Read(use_dev), x.Read(use_dev),
+                        y.ReadWrite(use_dev), a);
+}
+
+void MixedPrecisionSparseMatrix::Gauss_Seidel_forw(const Vector &x,
+                                                   Vector &y) const
+{
+   internal::CSRGaussSeidelForw(
+      height, mat.HostReadI(), mat.HostReadJ(), A.HostRead(), x.HostRead(),
+      y.HostReadWrite(), "MixedPrecisionSparseMatrix::Gauss_Seidel_forw(...)");
+}
+
+void MixedPrecisionSparseMatrix::Gauss_Seidel_back(const Vector &x,
+                                                   Vector &y) const
+{
+   internal::CSRGaussSeidelBack(
+      height, mat.HostReadI(), mat.HostReadJ(), A.HostRead(), x.HostRead(),
+      y.HostReadWrite(), "MixedPrecisionSparseMatrix::Gauss_Seidel_back(...)");
+}
+
+void MixedPrecisionSparseMatrix::Jacobi(const Vector &b, const Vector &x0,
+                                        Vector &x1, double sc) const
+{
+   internal::CSRJacobi(height, mat.HostReadI(), mat.HostReadJ(), A.HostRead(),
+                       b.HostRead(), x0.HostRead(), x1.HostWrite(), sc,
+                       "MixedPrecisionSparseMatrix::Jacobi(...)");
+}
+
+void MixedPrecisionSparseMatrix::Jacobi2(const Vector &b, const Vector &x0,
+                                         Vector &x1, double sc) const
+{
+   internal::CSRJacobi2(height, mat.HostReadI(), mat.HostReadJ(), A.HostRead(),
+                        b.HostRead(), x0.HostRead(), x1.HostWrite(), sc);
+}
+
+void MixedPrecisionSparseMatrix::Jacobi3(const Vector &b, const Vector &x0,
+                                         Vector &x1, double sc) const
+{
+   internal::CSRJacobi3(height, mat.HostReadI(), mat.HostReadJ(), A.HostRead(),
+                        b.HostRead(), x0.HostRead(), x1.HostWrite(), sc);
+}
+
 SparseMatrix *Mult_AtDA (const SparseMatrix &A, const Vector &D,
                          SparseMatrix *OAtDA)
 {
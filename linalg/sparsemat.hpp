@@ -309,6 +309,14 @@ public:
    /// y += A * x (default)  or  y += a * A * x
    void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
+   /** @brief Sparse matrix - dense matrix product (SpMM): multiply all the
+       vectors of @a X, reading the matrix once. */
+   virtual void MultMany(const MultiVector &X, MultiVector &Y) const;
+
+   /// Y_j += a * A * X_j for all the vectors of @a X, see MultMany().
+   void AddMultMany(const MultiVector &X, MultiVector &Y,
+                    const double a = 1.0) const;
+
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -707,6 +715,114 @@ SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
                         SparseMatrix *OAtDA = NULL);
 
 
+/** @brief Sparse matrix product C = A B with a reusable sparsity pattern.
+
+    The constructor computes the sparsity pattern of A B (the symbolic phase)
+    and the Mult() methods compute its entries (the numeric phase) for any
+    matrices A and B with the same sparsity patterns as the ones given to the
+    constructor, e.g. after their entries have been reassembled. Both phases
+    are parallelized over the rows of C when MFEM is built with OpenMP.
+
+    All matrices must be finalized. */
+class SparseMatrixProduct
+{
+protected:
+   int height, width, inner;
+   /// The sparsity pattern of the product, in CSR format.
+   Array<int> I, J;
+
+public:
+   /// Compute the sparsity pattern of the product A B.
+   SparseMatrixProduct(const SparseMatrix &A, const SparseMatrix &B);
+
+   int Height() const { return height; }
+   int Width() const { return width; }
+   int NumNonZeroElems() const { return J.Size(); }
+
+   /// Return a new matrix with the sparsity pattern and the entries of A B.
+   SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B) const;
+
+   /** @brief Compute the entries of A B in @a C, which must have the sparsity
+       pattern of the product, e.g. @a C was returned by Mult(A, B). */
+   void Mult(const SparseMatrix &A, const SparseMatrix &B,
+             SparseMatrix &C) const;
+};
+
+/** @brief Sparse triple product R A P, with R = Rt^T, with a reusable sparsity
+    pattern.
+
+    The matrices @a Rt and @a P are fixed: R = Rt^T is computed by the
+    constructor and @a P is referenced, so it must remain valid while the
+    object is used. The Mult() methods compute R A P for any matrix A with the
+    same sparsity pattern as the one given to the constructor, e.g. the
+    Galerkin projection P^T A P of a reassembled operator. All matrices must
+    be finalized. */
+class SparseMatrixRAP
+{
+protected:
+   const SparseMatrix &P;
+   SparseMatrix *R; // owned
+   SparseMatrixProduct RA_prod;
+   mutable SparseMatrix *RA; // owned, R A
+   SparseMatrixProduct RAP_prod;
+
+public:
+   SparseMatrixRAP(const SparseMatrix &Rt, const SparseMatrix &A,
+                   const SparseMatrix &P);
+
+   /// Return a new matrix with the sparsity pattern and the entries of R A P.
+   SparseMatrix *Mult(const SparseMatrix &A) const;
+
+   /** @brief Compute the entries of R A P in @a RAP, which must have the
+       sparsity pattern of the product, e.g. @a RAP was returned by Mult(A). */
+   void Mult(const SparseMatrix &A, SparseMatrix &RAP) const;
+
+   ~SparseMatrixRAP();
+};
+
+
+/** @brief Single precision copy of the entries of a finalized SparseMatrix,
+    for mixed precision preconditioners.
+
+    The entries are stored as float while the vectors and all the arithmetic
+    are in double precision; the row offsets and the column indices are shared
+    with the SparseMatrix. This reduces the memory traffic of memory bandwidth
+    bound kernels, such as SpMV or Gauss-Seidel sweeps, from 12 to 8 bytes per
+    nonzero entry. The SparseMatrix must outlive this object and keep its
+    sparsity pattern; call Update() after changing its entries. */
+class MixedPrecisionSparseMatrix : public Operator
+{
+protected:
+   const SparseMatrix &mat;
+   Array<float> A;
+
+public:
+   explicit MixedPrecisionSparseMatrix(const SparseMatrix &m);
+
+   /// Copy the entries of the SparseMatrix again.
+   void Update();
+
+   /// Return the SparseMatrix whose entries are copied.
+   const SparseMatrix &GetSparseMatrix() const { return mat; }
+
+   /// Matrix-vector product y = A x.
+   virtual void Mult(const Vector &x, Vector &y) const;
+   /// y += a * A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// Gauss-Seidel forward and backward sweeps, see SparseMatrix.
+   void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
+   void Gauss_Seidel_back(const Vector &x, Vector &y) const;
+
+   /// Jacobi iterations, see SparseMatrix::Jacobi(), Jacobi2() and Jacobi3().
+   void Jacobi(const Vector &b, const Vector &x0, Vector &x1, double sc) const;
+   void Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
+                double sc = 1.0) const;
+   void Jacobi3(const Vector &b, const Vector &x0, Vector &x1,
+                double sc = 1.0) const;
+};
+
+
 /// Matrix addition result = A + B.
 SparseMatrix * Add(const SparseMatrix & A, const SparseMatrix & B);
 /// Matrix addition result = a*A + b*B
@@ -29,6 +29,14 @@ void SparseSmoother::SetOperator(const Operator &a)
    }
    height = oper->Height();
    width = oper->Width();
+   SetSinglePrecision(single_precision);
+}
+
+void SparseSmoother::SetSinglePrecision(bool sp)
+{
+   single_precision = sp;
+   delete oper_sp;
+   oper_sp = (sp && oper) ? new MixedPrecisionSparseMatrix(*oper) : NULL;
 }
 
 /// Matrix vector multiplication with GS Smoother.
@@ -42,11 +50,13 @@ void GSSmoother::Mult(const Vector &x, Vector &y) const
    {
       if (type != 2)
       {
-         oper->Gauss_Seidel_forw(x, y);
+         if (oper_sp) { oper_sp->Gauss_Seidel_forw(x, y); }
+         else { oper->Gauss_Seidel_forw(x, y); }
       }
       if (type != 1)
       {
-         oper->Gauss_Seidel_back(x, y);
+         if (oper_sp) { oper_sp->Gauss_Seidel_back(x, y); }
+         else { oper->Gauss_Seidel_back(x, y); }
       }
    }
 }
@@ -63,7 +73,7 @@ DSmoother::DSmoother(const SparseMatrix &a, int t, double s, int it)
 /// Matrix vector multiplication with Jacobi smoother.
 void DSmoother::Mult(const Vector &x, Vector &y) const
 {
-   if (!iterative_mode && type == 0 && iterations == 1)
+   if (!iterative_mode && type == 0 && iterations == 1 && !oper_sp)
    {
       oper->DiagScale(x, y, scale);
       return;
@@ -90,15 +100,18 @@ void DSmoother::Mult(const Vector &x, Vector &y) const
    {
       if (type == 0)
       {
-         oper->Jacobi(x, *p, *r, scale);
+         if (oper_sp) { oper_sp->Jacobi(x, *p, *r, scale); }
+         else { oper->Jacobi(x, *p, *r, scale); }
       }
       else if (type == 1)
       {
-         oper->Jacobi2(x, *p, *r, scale);
+         if (oper_sp) { oper_sp->Jacobi2(x, *p, *r, scale); }
+         else { oper->Jacobi2(x, *p, *r, scale); }
       }
       else if (type == 2)
       {
-         oper->Jacobi3(x, *p, *r, scale);
+         if (oper_sp) { oper_sp->Jacobi3(x, *p, *r, scale); }
+         else { oper->Jacobi3(x, *p, *r, scale); }
       }
       else
       {
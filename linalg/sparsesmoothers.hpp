@@ -22,14 +22,30 @@ class SparseSmoother : public MatrixInverse
 {
 protected:
    const SparseMatrix *oper;
+   /// Single precision copy of #oper, used if not NULL.
+   MixedPrecisionSparseMatrix *oper_sp; // owned
+   bool single_precision;
 
 public:
-   SparseSmoother() { oper = NULL; }
+   SparseSmoother() { oper = NULL; oper_sp = NULL; single_precision = false; }
 
    SparseSmoother(const SparseMatrix &a)
-      : MatrixInverse(a) { oper = &a; }
+      : MatrixInverse(a)
+   { oper = &a; oper_sp = NULL; single_precision = false; }
 
    virtual void SetOperator(const Operator &a);
+
+   /** @brief Use a single precision copy of the entries of the matrix in the
+       smoother iterations, see MixedPrecisionSparseMatrix. */
+   /** The vectors and the arithmetic remain in double precision, so that the
+       smoother is a slightly perturbed, but fixed, linear operator: used as the
+       preconditioner of a Krylov solver in double precision, e.g. CGSolver, the
+       perturbation only affects the convergence rate, not the accuracy of the
+       solution. The setting can be changed before or after SetOperator(),
+       which updates the copy. */
+   void SetSinglePrecision(bool sp = true);
+
+   virtual ~SparseSmoother() { delete oper_sp; }
 };
 
 /// Data type for Gauss-Seidel smoother of sparse matrix
@@ -17,6 +17,7 @@
 #include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 #include "../general/device.hpp"
+#include "../general/forall.hpp"
 #include "../general/tic_toc.hpp"
 #include "../general/gecko.hpp"
 #include "../fem/quadinterpolator.hpp"
@@ -788,7 +789,8 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
    for (int i = 0; i < geom_factors.Size(); i++)
    {
       GeometricFactors *gf = geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
+      if (gf->IntRule == &ir && gf->geom_type == Geometry::INVALID &&
+          (gf->computed_factors & flags) == flags)
       {
          return gf;
       }
@@ -801,6 +803,28 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
    return gf;
 }
 
+const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
+                                                  const int flags,
+                                                  Geometry::Type geom,
+                                                  MemoryType d_mt)
+{
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      GeometricFactors *gf = geom_factors[i];
+      if (gf->IntRule == &ir && gf->geom_type == geom &&
+          (gf->computed_factors & flags) == flags)
+      {
+         return gf;
+      }
+   }
+
+   this->EnsureNodes();
+
+   GeometricFactors *gf = new GeometricFactors(this, ir, flags, geom, d_mt);
+   geom_factors.Append(gf);
+   return gf;
+}
+
 const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
    const IntegrationRule& ir,
    const int flags, FaceType type)
@@ -1108,6 +1132,7 @@ void Mesh::Init()
    sequence = 0;
    Nodes = NULL;
    own_nodes = 1;
+   point_locator = NULL;
    NURBSext = NULL;
    ncmesh = NULL;
    last_operation = Mesh::NONE;
@@ -1131,6 +1156,7 @@ void Mesh::DestroyTables()
    delete el_to_face;
    delete el_to_el;
    DeleteGeometricFactors();
+   DeletePointLocator();
 
    if (Dim == 3)
    {
@@ -1202,6 +1228,7 @@ void Mesh::ResetLazyData()
    delete face_edge;    face_edge = NULL;
    delete edge_vertex;  edge_vertex = NULL;
    DeleteGeometricFactors();
+   DeletePointLocator();
    nbInteriorFaces = -1;
    nbBoundaryFaces = -1;
 }
@@ -3152,6 +3179,9 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    sequence = 0;
    last_operation = Mesh::NONE;
 
+   // The spatial index is built on demand
+   point_locator = NULL;
+
    // Duplicate the elements
    elements.SetSize(NumOfElements);
    for (int i = 0; i < NumOfElements; i++)
@@ -3339,6 +3369,14 @@ Mesh::Mesh(const char *filename, int generate_edges, int refine,
    }
 }
 
+Mesh::Mesh(const BinaryContainerReader &reader, int generate_edges,
+           int refine, bool fix_orientation)
+{
+   SetEmpty();
+   BinaryLoader(reader);
+   Finalize(refine, fix_orientation);
+}
+
 Mesh::Mesh(std::istream &input, int generate_edges, int refine,
            bool fix_orientation)
 {
@@ -3636,6 +3674,15 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    {
       ReadNURBSMesh(input, curved, read_gf);
    }
+   else if (mesh_type == BinaryContainerReader::Signature())
+   {
+      named_ifgzstream *mesh_input = dynamic_cast<named_ifgzstream *>(&input);
+      MFEM_VERIFY(mesh_input, "Can not determine the binary mesh filename!"
+                  " Use mfem::named_ifgzstream for input.");
+      BinaryContainerReader reader(mesh_input->filename);
+      BinaryLoader(reader);
+      return; // done with the binary mesh construction
+   }
    else if (mesh_type == "MFEM INLINE mesh v1.0")
    {
       ReadInlineMesh(input, generate_edges);
@@ -3745,6 +3792,26 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    // Finalize(...) should be called after this, if needed.
 }
 
+void Mesh::BinaryLoader(const BinaryContainerReader &reader)
+{
+   Clear();
+
+   int curved = 0;
+   ReadBinaryMesh(reader, curved);
+
+   // don't generate any boundary elements, especially in parallel
+   FinalizeTopology(false);
+
+   if (curved)
+   {
+      // The vertex coordinates are stored in the container, so there is no
+      // need to set them from the nodes.
+      Nodes = new GridFunction(this, reader, "nodes");
+      own_nodes = 1;
+      spaceDim = Nodes->VectorDim();
+   }
+}
+
 Mesh::Mesh(Mesh *mesh_array[], int num_pieces)
 {
    int      i, j, ie, ib, iv, *v, nv;
@@ -5449,6 +5516,16 @@ void Mesh::GetGeometries(int dim, Array<Geometry::Type> &el_geoms) const
    }
 }
 
+void Mesh::GetGeometryElements(Geometry::Type geom, Array<int> &elems) const
+{
+   elems.SetSize(0);
+   if (!HasGeometry(geom)) { return; }
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      if (GetElementBaseGeometry(i) == geom) { elems.Append(i); }
+   }
+}
+
 void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
 {
    if (el_to_edge)
@@ -6474,7 +6551,8 @@ int *Mesh::CartesianPartitioning(int nxyz[])
    return partitioning;
 }
 
-int *Mesh::GeneratePartitioning(int nparts, int part_method)
+int *Mesh::GeneratePartitioning(int nparts, int part_method,
+                                const Array<double> *elem_weights)
 {
 #ifdef MFEM_USE_METIS
 
@@ -6514,9 +6592,9 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
    }
    else
    {
-      idx_t *I, *J, n;
+      idx_t *I, *J, n, *vwgt = NULL;
 #ifndef MFEM_USE_METIS_5
-      idx_t wgtflag = 0;
+      idx_t wgtflag = elem_weights ? 2 : 0; // 2: weights on vertices only
       idx_t numflag = 0;
       idx_t options[5];
 #else
@@ -6550,6 +6628,28 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          mpartitioning = new idx_t[n];
          freedata = true;
       }
+      if (elem_weights)
+      {
+         // METIS needs integer weights: scale them so that the largest one is
+         // at most 1000, while keeping the total sum well within idx_t
+         MFEM_VERIFY(elem_weights->Size() == NumOfElements,
+                     "invalid number of element weights");
+         double max_weight = 0.0;
+         for (int k = 0; k < n; k++)
+         {
+            MFEM_VERIFY((*elem_weights)[k] > 0.0,
+                        "element weights must be positive");
+            max_weight = std::max(max_weight, (*elem_weights)[k]);
+         }
+         const double max_vwgt = std::max(1.0, std::min(1000.0, 1e9/n));
+         vwgt = new idx_t[n];
+         for (int k = 0; k < n; k++)
+         {
+            vwgt[k] = std::max((idx_t) 1, (idx_t) std::round(
+                                  max_vwgt * (*elem_weights)[k] / max_weight));
+         }
+      }
+
 #ifndef MFEM_USE_METIS_5
       options[0] = 0;
 #else
@@ -6578,7 +6678,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          METIS_PartGraphRecursive(&n,
                                   I,
                                   J,
-                                  NULL,
+                                  vwgt,
                                   NULL,
                                   &wgtflag,
                                   &numflag,
@@ -6591,7 +6691,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
                                         &ncon,
                                         I,
                                         J,
-                                        NULL,
+                                        vwgt,
                                         NULL,
                                         NULL,
                                         &mparts,
@@ -6616,7 +6716,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          METIS_PartGraphKway(&n,
                              I,
                              J,
-                             NULL,
+                             vwgt,
                              NULL,
                              &wgtflag,
                              &numflag,
@@ -6629,7 +6729,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
                                    &ncon,
                                    I,
                                    J,
-                                   NULL,
+                                   vwgt,
                                    NULL,
                                    NULL,
                                    &mparts,
@@ -6654,7 +6754,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          METIS_PartGraphVKway(&n,
                               I,
                               J,
-                              NULL,
+                              vwgt,
                               NULL,
                               &wgtflag,
                               &numflag,
@@ -6668,7 +6768,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
                                    &ncon,
                                    I,
                                    J,
-                                   NULL,
+                                   vwgt,
                                    NULL,
                                    NULL,
                                    &mparts,
@@ -6706,6 +6806,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          delete[] J;
          delete[] mpartitioning;
       }
+      delete[] vwgt;
    }
 
    delete el_to_el;
@@ -7267,6 +7368,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -7287,6 +7389,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -7326,6 +7429,7 @@ void Mesh::SetNode(int i, const double *coord)
       }
 
    }
+   NodesUpdated();
 }
 
 void Mesh::MoveNodes(const Vector &displacements)
@@ -7333,6 +7437,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    if (Nodes)
    {
       (*Nodes) += displacements;
+      NodesUpdated();
    }
    else
    {
@@ -7357,6 +7462,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    if (Nodes)
    {
       (*Nodes) = node_coord;
+      NodesUpdated();
    }
    else
    {
@@ -7381,12 +7487,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
    {
       ncmesh->MakeTopologyOnly();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -8644,6 +8752,10 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
 
    mfem::Swap(geom_factors, other.geom_factors);
 
+   // The spatial indices refer to their meshes, so they are rebuilt on demand
+   DeletePointLocator();
+   other.DeletePointLocator();
+
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
 #endif
@@ -9479,6 +9591,56 @@ void Mesh::PrintXG(std::ostream &out) const
    out << flush;
 }
 
+void Mesh::AddBinaryBlocks(BinaryContainerWriter &writer) const
+{
+   MFEM_VERIFY(!NURBSext && !Nonconforming(), "the binary mesh format "
+               "supports only conforming, non-NURBS meshes");
+
+   const int info[6] = { Dim, spaceDim, NumOfVertices, NumOfElements,
+                         NumOfBdrElements, Nodes ? 1 : 0
+                       };
+   writer.CopyBlock("mesh.info", info, 6);
+
+   Vector vert(NumOfVertices*spaceDim);
+   for (int j = 0; j < NumOfVertices; j++)
+   {
+      for (int i = 0; i < spaceDim; i++)
+      {
+         vert(i + j*spaceDim) = vertices[j](i);
+      }
+   }
+   writer.CopyBlock("mesh.vertices", vert.GetData(), vert.Size());
+
+   const char *prefix[2] = { "mesh.el_", "mesh.be_" };
+   const Array<Element*> *elems[2] = { &elements, &boundary };
+   const int num_elems[2] = { NumOfElements, NumOfBdrElements };
+   for (int k = 0; k < 2; k++)
+   {
+      const std::string pre(prefix[k]);
+      const Array<Element*> &el = *elems[k];
+      Array<int> attr(num_elems[k]), geom(num_elems[k]), v;
+      v.Reserve(num_elems[k]*(Dim+1-k));
+      for (int j = 0; j < num_elems[k]; j++)
+      {
+         attr[j] = el[j]->GetAttribute();
+         geom[j] = el[j]->GetGeometryType();
+         v.Append(el[j]->GetVertices(), el[j]->GetNVertices());
+      }
+      writer.AddBlock(pre + "attr", attr);
+      writer.AddBlock(pre + "geom", geom);
+      writer.AddBlock(pre + "vert", v);
+   }
+
+   if (Nodes) { Nodes->AddBinaryBlocks(writer, "nodes"); }
+}
+
+void Mesh::SaveBinary(const std::string &fname, bool compress) const
+{
+   BinaryContainerWriter writer(compress);
+   AddBinaryBlocks(writer);
+   writer.Save(fname);
+}
+
 void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
 {
    int i, j;
@@ -11028,6 +11190,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -11052,6 +11215,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -11268,6 +11432,25 @@ void Mesh::FreeElement(Element *E)
 #endif
 }
 
+MeshPointLocator &Mesh::GetPointLocator()
+{
+   if (!point_locator) { point_locator = new MeshPointLocator(*this); }
+   else { point_locator->Update(); }
+   return *point_locator;
+}
+
+void Mesh::NodesUpdated()
+{
+   DeleteGeometricFactors();
+   if (point_locator) { point_locator->NodesUpdated(); }
+}
+
+void Mesh::DeletePointLocator()
+{
+   delete point_locator;
+   point_locator = NULL;
+}
+
 std::ostream &operator<<(std::ostream &out, const Mesh &mesh)
 {
    mesh.Print(out);
@@ -11286,99 +11469,13 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
-   double *data = point_mat.GetData();
    InverseElementTransformation *inv_tr = inv_trans;
    inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
 
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
+   // Only the elements whose bounding boxes contain a point are tested.
+   const int pts_found =
+      GetPointLocator().FindPoints(point_mat, elem_ids, ips, *inv_tr);
 
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
-   {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
-      {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
-      }
-   }
-
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
-   {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
-   }
-   if (pts_found != npts)
-   {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
-      {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
-         {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
-            {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
-         {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
-            {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-      next_point: ;
-      }
-      delete vtoel;
-   }
    if (inv_trans == NULL) { delete inv_tr; }
 
    if (warn && pts_found != npts)
@@ -11395,6 +11492,7 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   geom_type = Geometry::INVALID;
 
    MFEM_ASSERT(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
                "mixed meshes are not supported!");
@@ -11410,10 +11508,25 @@ GeometricFactors::GeometricFactors(const GridFunction &nodes,
    this->mesh = nodes.FESpace()->GetMesh();
    IntRule = &ir;
    computed_factors = flags;
+   geom_type = Geometry::INVALID;
 
    Compute(nodes, d_mt);
 }
 
+GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
+                                   int flags, Geometry::Type geom,
+                                   MemoryType d_mt)
+{
+   this->mesh = mesh;
+   IntRule = &ir;
+   computed_factors = flags;
+   geom_type = geom;
+
+   MFEM_ASSERT(mesh->GetNodes(), "meshes without nodes are not supported!");
+
+   ComputeBatch(*mesh->GetNodes(), d_mt);
+}
+
 void GeometricFactors::Compute(const GridFunction &nodes,
                                MemoryType d_mt)
 {
@@ -11469,6 +11582,93 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    }
 }
 
+void GeometricFactors::ComputeBatch(const GridFunction &nodes,
+                                    MemoryType d_mt)
+{
+   const FiniteElementSpace *fespace = nodes.FESpace();
+   Array<int> elems;
+   mesh->GetGeometryElements(geom_type, elems);
+   const int NE   = elems.Size();
+   const int dim  = Geometry::Dimension[geom_type];
+   const int sdim = fespace->GetVDim();
+   const int NQ   = IntRule->GetNPoints();
+
+   MemoryType my_d_mt = (d_mt != MemoryType::DEFAULT) ? d_mt :
+                        Device::GetDeviceMemoryType();
+   const bool need_X = computed_factors & GeometricFactors::COORDINATES;
+   const bool need_J = computed_factors & GeometricFactors::JACOBIANS;
+   const bool need_D = computed_factors & GeometricFactors::DETERMINANTS;
+   if (need_X) { X.SetSize(sdim*NQ*NE, my_d_mt); } // NQ x SDIM x NE
+   if (need_J) { J.SetSize(dim*sdim*NQ*NE, my_d_mt); } // NQ x SDIM x DIM x NE
+   if (need_D) { detJ.SetSize(NQ*NE, my_d_mt); } // NQ x NE
+   if (NE == 0) { return; }
+
+   // The elements of one geometry may use any basis, so the general (non
+   // tensor-product) maps with native dof ordering are used here.
+   const FiniteElement *fe = fespace->GetFE(elems[0]);
+   const int ND = fe->GetDof();
+   const DofToQuad &maps = fe->GetDofToQuad(*IntRule, DofToQuad::FULL);
+   ElementRestriction elem_restr(*fespace, ElementDofOrdering::NATIVE, elems);
+   Vector Enodes(sdim*ND*NE, my_d_mt);
+   elem_restr.Mult(nodes, Enodes);
+
+   MFEM_VERIFY(dim <= 3 && sdim <= 3, "invalid dimensions");
+   const auto B = Reshape(maps.B.Read(), NQ, ND);
+   const auto G = Reshape(maps.G.Read(), NQ, dim, ND);
+   const auto E = Reshape(Enodes.Read(), ND, sdim, NE);
+   auto x = Reshape(need_X ? X.Write() : nullptr, NQ, sdim, NE);
+   auto j = Reshape(need_J ? J.Write() : nullptr, NQ, sdim, dim, NE);
+   auto d = Reshape(need_D ? detJ.Write() : nullptr, NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jq[9];
+      for (int c = 0; c < sdim; c++)
+      {
+         double xc = 0.0;
+         for (int k = 0; k < dim; k++) { Jq[c+k*sdim] = 0.0; }
+         for (int n = 0; n < ND; n++)
+         {
+            const double en = E(n,c,e);
+            xc += B(q,n)*en;
+            for (int k = 0; k < dim; k++) { Jq[c+k*sdim] += G(q,k,n)*en; }
+         }
+         if (need_X) { x(q,c,e) = xc; }
+         if (need_J)
+         {
+            for (int k = 0; k < dim; k++) { j(q,c,k,e) = Jq[c+k*sdim]; }
+         }
+      }
+      if (need_D)
+      {
+         double det;
+         if (dim == sdim)
+         {
+            det = (dim == 1) ? Jq[0] :
+                  (dim == 2) ? Jq[0]*Jq[3] - Jq[1]*Jq[2] :
+                  Jq[0]*(Jq[4]*Jq[8] - Jq[5]*Jq[7]) -
+                  Jq[3]*(Jq[1]*Jq[8] - Jq[2]*Jq[7]) +
+                  Jq[6]*(Jq[1]*Jq[5] - Jq[2]*Jq[4]);
+         }
+         else if (dim == 1)
+         {
+            det = 0.0;
+            for (int c = 0; c < sdim; c++) { det += Jq[c]*Jq[c]; }
+            det = sqrt(det);
+         }
+         else // dim == 2, sdim == 3
+         {
+            const double n0 = Jq[1]*Jq[5] - Jq[2]*Jq[4];
+            const double n1 = Jq[2]*Jq[3] - Jq[0]*Jq[5];
+            const double n2 = Jq[0]*Jq[4] - Jq[1]*Jq[3];
+            det = sqrt(n0*n0 + n1*n1 + n2*n2);
+         }
+         d(q,e) = det;
+      }
+   });
+}
+
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
                                            const IntegrationRule &ir,
                                            int flags, FaceType type)
@@ -39,6 +39,9 @@ class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
 class GridFunction;
+class MeshPointLocator;
+class BinaryContainerReader;
+class BinaryContainerWriter;
 struct Refinement;
 
 /** An enum type to specify if interior or boundary faces are desired. */
@@ -176,6 +179,9 @@ protected:
    GridFunction *Nodes;
    int own_nodes;
 
+   // Optional spatial index used by FindPoints(), built on first use.
+   MeshPointLocator *point_locator;
+
    static const int vtk_quadratic_tet[10];
    static const int vtk_quadratic_wedge[18];
    static const int vtk_quadratic_hex[27];
@@ -251,6 +257,7 @@ protected:
    void ReadNURBSMesh(std::istream &input, int &curved, int &read_gf);
    void ReadInlineMesh(std::istream &input, bool generate_edges = false);
    void ReadGmshMesh(std::istream &input, int &curved, int &read_gf);
+   void ReadBinaryMesh(const BinaryContainerReader &reader, int &curved);
    /* Note NetCDF (optional library) is used for reading cubit files */
 #ifdef MFEM_USE_NETCDF
    void ReadCubit(const char *filename, int &curved, int &read_gf);
@@ -441,6 +448,12 @@ protected:
    void Loader(std::istream &input, int generate_edges = 0,
                std::string parse_tag = "");
 
+   // Load the mesh from an MFEM binary container, see SaveBinary().
+   void BinaryLoader(const BinaryContainerReader &reader);
+
+   // Add the mesh blocks, including the nodes, to a binary container.
+   void AddBinaryBlocks(BinaryContainerWriter &writer) const;
+
    // If NURBS mesh, write NURBS format. If NCMesh, write mfem v1.1 format.
    // If section_delimiter is empty, write mfem v1.0 format. Otherwise, write
    // mfem v1.2 format with the given section_delimiter at the end.
@@ -804,6 +817,11 @@ public:
    explicit Mesh(std::istream &input, int generate_edges = 0, int refine = 1,
                  bool fix_orientation = true);
 
+   /** Creates mesh from an MFEM binary container, see SaveBinary(). Files in
+       this format are also recognized by Mesh(const char*, int, int, bool). */
+   explicit Mesh(const BinaryContainerReader &reader, int generate_edges = 0,
+                 int refine = 1, bool fix_orientation = true);
+
    /// Create a disjoint mesh from the given mesh array
    Mesh(Mesh *mesh_array[], int num_pieces);
 
@@ -885,6 +903,19 @@ public:
       const int flags,
       MemoryType d_mt = MemoryType::DEFAULT);
 
+   /** @brief Return the mesh geometric factors corresponding to the given
+       integration rule, restricted to the elements with geometry @a geom.
+
+       The elements are taken in the order returned by GetGeometryElements().
+       This variant supports meshes with several element geometries, where
+       @a ir must be a rule for @a geom. The same lifetime requirements on
+       @a ir apply as above. */
+   const GeometricFactors* GetGeometricFactors(
+      const IntegrationRule& ir,
+      const int flags,
+      Geometry::Type geom,
+      MemoryType d_mt = MemoryType::DEFAULT);
+
    /** @brief Return the mesh geometric factors for the faces corresponding
        to the given integration rule.
 
@@ -990,6 +1021,11 @@ public:
        The returned geometries are sorted. */
    void GetGeometries(int dim, Array<Geometry::Type> &el_geoms) const;
 
+   /// Return the indices of all elements with the given geometry @a geom.
+   /** The returned indices are sorted. This is the element order used by the
+       per-geometry element batches of partial assembly on mixed meshes. */
+   void GetGeometryElements(Geometry::Type geom, Array<int> &elems) const;
+
    /// List of mesh geometries stored as Array<Geometry::Type>.
    class GeometryList : public Array<Geometry::Type>
    {
@@ -1230,7 +1266,14 @@ public:
    virtual void ReorientTetMesh();
 
    int *CartesianPartitioning(int nxyz[]);
-   int *GeneratePartitioning(int nparts, int part_method = 1);
+   /** @brief Partition the mesh into @a nparts parts with METIS.
+
+       If @a elem_weights is given, it holds a positive cost per element (see
+       e.g. FiniteElementSpace::GetElementCosts()) and the parts are balanced
+       with respect to their total cost instead of their number of elements.
+       The returned array must be deleted by the caller. */
+   int *GeneratePartitioning(int nparts, int part_method = 1,
+                             const Array<double> *elem_weights = NULL);
    void CheckPartitioning(int *partitioning_);
 
    void CheckDisplacements(const Vector &displacements, double &tmax);
@@ -1267,6 +1310,14 @@ public:
        with the given ones. */
    void SwapNodes(GridFunction *&nodes, int &own_nodes_);
 
+   /** @brief Notify the Mesh that the coordinates of its nodes (or vertices)
+       were modified, e.g. through GetNodes(). The cached GeometricFactors
+       are deleted and the spatial index of GetPointLocator() then recomputes
+       the element boxes without checking the coordinates. The Mesh methods
+       that move the nodes, e.g. MoveNodes() and Transform(), call this
+       method. */
+   void NodesUpdated();
+
    /// Return the mesh nodes/vertices projected on the given GridFunction.
    void GetNodes(GridFunction &nodes) const;
    /** Replace the internal node GridFunction with a new GridFunction defined
@@ -1390,6 +1441,17 @@ public:
    /// used for ASCII output.
    virtual void Save(const char *fname, int precision=16) const;
 
+   /** @brief Save the mesh to the file @a fname in the MFEM binary container
+       format, see BinaryContainerWriter.
+
+       The binary format is much faster to load than the ASCII formats, since
+       the element and vertex data are read directly from a memory mapping of
+       the file. It supports conforming, non-NURBS meshes, including curved
+       meshes. If @a compress is true, the data blocks are compressed with zlib
+       (requires MFEM_USE_ZLIB). */
+   virtual void SaveBinary(const std::string &fname,
+                           bool compress = false) const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &out) const;
@@ -1524,12 +1586,28 @@ public:
 
        @returns The total number of points that were found.
 
+       The candidate elements for each point are selected with the spatial
+       index returned by GetPointLocator(), so that the element transformation
+       inversion is only attempted for the few elements whose bounding boxes
+       contain the point.
+
        @note This method is not 100 percent reliable, i.e. it is not guaranteed
        to find a point, even if it lies inside a mesh element. */
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
                           InverseElementTransformation *inv_trans = NULL);
 
+   /** @brief Return the spatial index of the mesh elements used by
+       FindPoints(), building it if necessary.
+
+       The index is updated automatically when the mesh is refined or its
+       nodes are moved, including in place through GetNodes(), see
+       MeshPointLocator::Update(). */
+   MeshPointLocator &GetPointLocator();
+
+   /// Delete the spatial index of the mesh elements, if it was built.
+   void DeletePointLocator();
+
    /// Swaps internal data with another mesh. By default, non-geometry members
    /// like 'ncmesh' and 'NURBSExt' are only swapped when 'non_geometry' is set.
    void Swap(Mesh& other, bool non_geometry);
@@ -1559,10 +1637,16 @@ private:
    void Compute(const GridFunction &nodes,
                 MemoryType d_mt = MemoryType::DEFAULT);
 
+   void ComputeBatch(const GridFunction &nodes,
+                     MemoryType d_mt = MemoryType::DEFAULT);
+
 public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
    int computed_factors;
+   /** @brief Element geometry of the elements covered by this object, or
+       Geometry::INVALID when all mesh elements are covered. */
+   Geometry::Type geom_type;
 
    enum FactorFlags
    {
@@ -1578,6 +1662,14 @@ public:
                     int flags,
                     MemoryType d_mt = MemoryType::DEFAULT);
 
+   /** @brief Compute the factors only for the elements of @a mesh with
+       geometry @a geom, see Mesh::GetGeometryElements(). */
+   /** In this case NE in the layouts below is the number of such elements.
+       The mesh may contain several element geometries. */
+   GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags,
+                    Geometry::Type geom,
+                    MemoryType d_mt = MemoryType::DEFAULT);
+
    /// Mapped (physical) coordinates of all quadrature points.
    /** This array uses a column-major layout with dimensions (NQ x SDIM x NE)
        where
@@ -25,8 +25,10 @@
 #include "ncmesh.hpp"
 #include "mesh.hpp"
 #include "mesh_operators.hpp"
+#include "point_locator.hpp"
 #include "nurbs.hpp"
 #include "wedge.hpp"
+#include "submesh.hpp"
 
 #ifdef MFEM_USE_MESQUITE
 #include "mesquite.hpp"
@@ -35,6 +37,7 @@
 #ifdef MFEM_USE_MPI
 #include "pncmesh.hpp"
 #include "pmesh.hpp"
+#include "psubmesh.hpp"
 #endif
 
 #ifdef MFEM_USE_PUMI
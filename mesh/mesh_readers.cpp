@@ -105,6 +105,57 @@ void Mesh::ReadMFEMMesh(std::istream &input, int version, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+void Mesh::ReadBinaryMesh(const BinaryContainerReader &reader, int &curved)
+{
+   // Read the mesh blocks of an MFEM binary container, see AddBinaryBlocks()
+   size_t n;
+   const int *info = reader.GetInts("mesh.info", n);
+   MFEM_VERIFY(n == 6, "invalid binary mesh: " << reader.GetFileName());
+   Dim = info[0];
+   spaceDim = info[1];
+   NumOfVertices = info[2];
+   NumOfElements = info[3];
+   NumOfBdrElements = info[4];
+   curved = info[5];
+
+   const double *vert = reader.GetDoubles("mesh.vertices", n);
+   MFEM_VERIFY(n == (size_t) NumOfVertices*spaceDim, "invalid binary mesh");
+   vertices.SetSize(NumOfVertices);
+   for (int j = 0; j < NumOfVertices; j++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         vertices[j](i) = (i < spaceDim) ? vert[i + j*spaceDim] : 0.0;
+      }
+   }
+
+   const char *prefix[2] = { "mesh.el_", "mesh.be_" };
+   Array<Element*> *elems[2] = { &elements, &boundary };
+   const int num_elems[2] = { NumOfElements, NumOfBdrElements };
+   for (int k = 0; k < 2; k++)
+   {
+      const std::string pre(prefix[k]);
+      size_t na, ng, nv;
+      const int *attr = reader.GetInts(pre + "attr", na);
+      const int *geom = reader.GetInts(pre + "geom", ng);
+      const int *v = reader.GetInts(pre + "vert", nv);
+      MFEM_VERIFY(na == (size_t) num_elems[k] && ng == na,
+                  "invalid binary mesh");
+      Array<Element*> &el = *elems[k];
+      el.SetSize(num_elems[k]);
+      size_t offset = 0;
+      for (int j = 0; j < num_elems[k]; j++)
+      {
+         el[j] = NewElement(geom[j]);
+         MFEM_VERIFY(offset + el[j]->GetNVertices() <= nv,
+                     "invalid binary mesh");
+         el[j]->SetVertices(v + offset);
+         el[j]->SetAttribute(attr[j]);
+         offset += el[j]->GetNVertices();
+      }
+   }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
@@ -18,10 +18,13 @@
 #include "../general/sets.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/globals.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
@@ -847,6 +850,573 @@ void ParMesh::BuildSharedVertMapping(int nvert,
 }
 
 
+ParMesh::ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+                 const Array<HYPRE_BigInt> &vertex_ids, bool refine)
+   : Mesh(local_mesh, true)
+   , glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   MFEM_VERIFY(local_mesh.Conforming() && !local_mesh.NURBSext,
+               "the local mesh must be conforming and not NURBS");
+   MFEM_VERIFY(vertex_ids.Size() == NumOfVertices,
+               "invalid number of global vertex indices");
+   for (int i = 1; i < vertex_ids.Size(); i++)
+   {
+      MFEM_VERIFY(vertex_ids[i-1] < vertex_ids[i],
+                  "the global vertex indices must be increasing");
+   }
+   MFEM_VERIFY(NumOfElements == 0 || faces_info.Size() > 0,
+               "the topology of the local mesh is not finalized");
+
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   FindSharedEntities(vertex_ids);
+
+   Finalize(refine, true);
+
+   EnsureParNodes();
+
+   // make the lists 'attributes' and 'bdr_attributes' global
+   SetAttributes();
+}
+
+namespace
+{
+
+// A vertex, an edge or a face identified by its sorted global vertex indices,
+// the unused indices being -1. Used by ParMesh::FindSharedEntities().
+struct EntityKey
+{
+   HYPRE_BigInt v[4];
+   int index; // local face index, MPI rank or group
+
+   void Set(const Array<HYPRE_BigInt> &vertex_ids, const int *lv, int n,
+            int index_)
+   {
+      for (int i = 0; i < 4; i++) { v[i] = (i < n) ? vertex_ids[lv[i]] : -1; }
+      std::sort(v, v + n);
+      index = index_;
+   }
+
+   int Size() const
+   {
+      int n = 0;
+      while (n < 4 && v[n] >= 0) { n++; }
+      return n;
+   }
+
+   // The rank holding this entity in the distributed hash table.
+   int Owner(int nranks) const
+   {
+      unsigned long long h = 0;
+      for (int i = 0; i < 4 && v[i] >= 0; i++)
+      {
+         h = 1000003ull*h + (unsigned long long) v[i];
+      }
+      return (int) (h % (unsigned long long) nranks);
+   }
+
+   bool SameEntity(const EntityKey &other) const
+   {
+      return std::equal(v, v + 4, other.v);
+   }
+
+   bool operator<(const EntityKey &other) const
+   {
+      for (int i = 0; i < 4; i++)
+      {
+         if (v[i] != other.v[i]) { return v[i] < other.v[i]; }
+      }
+      return index < other.index;
+   }
+};
+
+// Sort the entities, removing the duplicates.
+void SortEntities(Array<EntityKey> &keys)
+{
+   keys.Sort();
+   int n = 0;
+   for (int i = 0; i < keys.Size(); i++)
+   {
+      if (n == 0 || !keys[i].SameEntity(keys[n-1])) { keys[n++] = keys[i]; }
+   }
+   keys.SetSize(n);
+}
+
+// Send sbuf[soffsets[r]:soffsets[r+1]] to each rank r, and receive the data
+// from rank r in rbuf[roffsets[r]:roffsets[r+1]].
+void ExchangeEntities(MPI_Comm comm, const Array<HYPRE_BigInt> &sbuf,
+                      const Array<int> &soffsets, Array<HYPRE_BigInt> &rbuf,
+                      Array<int> &roffsets)
+{
+   const int nranks = soffsets.Size() - 1;
+   Array<int> scounts(nranks), rcounts(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      scounts[r] = soffsets[r+1] - soffsets[r];
+   }
+   MPI_Alltoall(scounts.GetData(), 1, MPI_INT, rcounts.GetData(), 1, MPI_INT,
+                comm);
+
+   roffsets.SetSize(nranks + 1);
+   roffsets[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      roffsets[r+1] = roffsets[r] + rcounts[r];
+   }
+   rbuf.SetSize(roffsets[nranks]);
+   MPI_Alltoallv(sbuf.GetData(), scounts.GetData(), soffsets.GetData(),
+                 HYPRE_MPI_BIG_INT, rbuf.GetData(), rcounts.GetData(),
+                 roffsets.GetData(), HYPRE_MPI_BIG_INT, comm);
+}
+
+int LocalVertex(const Array<HYPRE_BigInt> &vertex_ids, HYPRE_BigInt gv)
+{
+   const HYPRE_BigInt *begin = vertex_ids.GetData();
+   const HYPRE_BigInt *end = begin + vertex_ids.Size();
+   const HYPRE_BigInt *v = std::lower_bound(begin, end, gv);
+   MFEM_ASSERT(v != end && *v == gv, "unknown vertex " << gv);
+   return (int) (v - begin);
+}
+
+// Fill the table of the shared entities of each group, the group of shared
+// entity i being entity_group[i].
+void MakeGroupTable(int ngroups, const Array<int> &entity_group,
+                    Table &group_table)
+{
+   group_table.MakeI(ngroups);
+   for (int i = 0; i < entity_group.Size(); i++)
+   {
+      group_table.AddAColumnInRow(entity_group[i]);
+   }
+   group_table.MakeJ();
+   for (int i = 0; i < entity_group.Size(); i++)
+   {
+      group_table.AddConnection(entity_group[i], i);
+   }
+   group_table.ShiftUpI();
+}
+
+} // anonymous namespace
+
+void ParMesh::FindSharedEntities(const Array<HYPRE_BigInt> &vertex_ids)
+{
+   // The candidates are the entities on the boundary of the local part of the
+   // mesh: the faces with one local element, their edges and their vertices.
+   Array<EntityKey> local;
+   {
+      Array<int> fv;
+      EntityKey key;
+      for (int f = 0; f < GetNumFaces(); f++)
+      {
+         if (faces_info[f].Elem2No >= 0) { continue; }
+         GetFaceVertices(f, fv);
+         const int n = fv.Size();
+         for (int i = 0; i < n; i++)
+         {
+            key.Set(vertex_ids, &fv[i], 1, -1);
+            local.Append(key);
+         }
+         if (Dim == 3)
+         {
+            for (int i = 0; i < n; i++)
+            {
+               const int ev[2] = { fv[i], fv[(i+1)%n] };
+               key.Set(vertex_ids, ev, 2, -1);
+               local.Append(key);
+            }
+         }
+         if (Dim > 1)
+         {
+            key.Set(vertex_ids, fv, n, f);
+            local.Append(key);
+         }
+      }
+   }
+   SortEntities(local);
+
+   // Send the candidates to their owners in the distributed hash table.
+   Array<HYPRE_BigInt> sbuf, rbuf;
+   Array<int> soffsets(NRanks + 1), roffsets, next;
+   soffsets = 0;
+   for (int i = 0; i < local.Size(); i++)
+   {
+      soffsets[local[i].Owner(NRanks) + 1] += 4;
+   }
+   soffsets.PartialSum();
+   soffsets.Copy(next);
+   sbuf.SetSize(soffsets[NRanks]);
+   for (int i = 0; i < local.Size(); i++)
+   {
+      const int owner = local[i].Owner(NRanks);
+      for (int j = 0; j < 4; j++) { sbuf[next[owner]++] = local[i].v[j]; }
+   }
+   ExchangeEntities(MyComm, sbuf, soffsets, rbuf, roffsets);
+
+   // As the owner, find the ranks of each entity. The entities found on more
+   // than one rank are shared: send them back to their ranks, followed by the
+   // number of ranks and the ranks.
+   {
+      Array<EntityKey> owned(rbuf.Size()/4);
+      for (int r = 0; r < NRanks; r++)
+      {
+         for (int k = roffsets[r]; k < roffsets[r+1]; k += 4)
+         {
+            EntityKey &key = owned[k/4];
+            for (int j = 0; j < 4; j++) { key.v[j] = rbuf[k+j]; }
+            key.index = r;
+         }
+      }
+      owned.Sort();
+
+      // the ranges [a,b) of 'owned' with the same shared entity
+      Array<int> ranges;
+      for (int a = 0, b; a < owned.Size(); a = b)
+      {
+         for (b = a+1; b < owned.Size() && owned[b].SameEntity(owned[a]); b++)
+         { }
+         if (b - a > 1) { ranges.Append(a); ranges.Append(b); }
+      }
+
+      soffsets = 0;
+      for (int k = 0; k < ranges.Size(); k += 2)
+      {
+         const int a = ranges[k], b = ranges[k+1];
+         for (int i = a; i < b; i++)
+         {
+            soffsets[owned[i].index + 1] += 5 + b - a;
+         }
+      }
+      soffsets.PartialSum();
+      soffsets.Copy(next);
+      sbuf.SetSize(soffsets[NRanks]);
+      for (int k = 0; k < ranges.Size(); k += 2)
+      {
+         const int a = ranges[k], b = ranges[k+1];
+         for (int i = a; i < b; i++)
+         {
+            HYPRE_BigInt *buf = &sbuf[next[owned[i].index]];
+            for (int j = 0; j < 4; j++) { buf[j] = owned[a].v[j]; }
+            buf[4] = b - a;
+            for (int j = a; j < b; j++) { buf[5+j-a] = owned[j].index; }
+            next[owned[i].index] += 5 + b - a;
+         }
+      }
+   }
+   ExchangeEntities(MyComm, sbuf, soffsets, rbuf, roffsets);
+   sbuf.DeleteAll();
+
+   // Order the shared entities by their global vertex indices, so that the
+   // order within each group is the same on all of its ranks.
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   // the first group is the local one
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+
+   Array<EntityKey> shared;
+   Array<int> ranks;
+   for (int k = 0; k < rbuf.Size(); )
+   {
+      EntityKey key;
+      for (int j = 0; j < 4; j++) { key.v[j] = rbuf[k+j]; }
+      ranks.SetSize((int) rbuf[k+4]);
+      for (int i = 0; i < ranks.Size(); i++) { ranks[i] = (int) rbuf[k+5+i]; }
+      group.Recreate(ranks.Size(), ranks.GetData());
+      key.index = groups.Insert(group) - 1;
+      shared.Append(key);
+      k += 5 + ranks.Size();
+   }
+   rbuf.DeleteAll();
+   shared.Sort();
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+
+   // Local vertex indices follow the global ones, so the shared edges and
+   // triangles are oriented from their lowest global vertex index, and the
+   // shared quadrilaterals start from it, on all ranks.
+   Array<int> svert_group, sedge_group, stria_group, squad_group;
+   for (int i = 0; i < shared.Size(); i++)
+   {
+      const EntityKey &key = shared[i];
+      int lv[4];
+      for (int j = 0; j < key.Size(); j++)
+      {
+         lv[j] = LocalVertex(vertex_ids, key.v[j]);
+      }
+      switch (key.Size())
+      {
+         case 1:
+            svert_lvert.Append(lv[0]);
+            svert_group.Append(key.index);
+            break;
+
+         case 2:
+            shared_edges.Append(new Segment(lv[0], lv[1], 1));
+            sedge_group.Append(key.index);
+            break;
+
+         case 3:
+            shared_trias.Append(Vert3(lv[0], lv[1], lv[2]));
+            stria_group.Append(key.index);
+            break;
+
+         case 4:
+         {
+            EntityKey face = key;
+            face.index = -1;
+            const EntityKey *f =
+               std::lower_bound(local.GetData(),
+                                local.GetData() + local.Size(), face);
+            MFEM_ASSERT(f->SameEntity(face), "unknown shared face");
+            const int *fv = faces[f->index]->GetVertices();
+            int i0 = 0;
+            for (int j = 1; j < 4; j++) { if (fv[j] < fv[i0]) { i0 = j; } }
+            const int d = (fv[(i0+1)%4] < fv[(i0+3)%4]) ? 1 : 3;
+            shared_quads.Append(Vert4(fv[i0], fv[(i0+d)%4], fv[(i0+2*d)%4],
+                                      fv[(i0+3*d)%4]));
+            squad_group.Append(key.index);
+            break;
+         }
+      }
+   }
+
+   // fill out group_svert, group_sedge, group_stria, group_squad
+   const int ngroups = groups.Size()-1;
+   MakeGroupTable(ngroups, svert_group, group_svert);
+   MakeGroupTable(ngroups, sedge_group, group_sedge);
+   MakeGroupTable(ngroups, stria_group, group_stria);
+   MakeGroupTable(ngroups, squad_group, group_squad);
+}
+
+namespace
+{
+
+// Return the element owning the boundary element 'be', as in
+// ParMesh::BuildLocalBoundary().
+int BdrElementOwner(const Mesh &mesh, int be)
+{
+   int face, el1, el2;
+   if (mesh.Dimension() == 3)
+   {
+      int o;
+      mesh.GetBdrElementFace(be, &face, &o);
+      mesh.GetFaceElements(face, &el1, &el2);
+      return (o % 2 == 0 || el2 < 0) ? el1 : el2;
+   }
+   mesh.GetFaceElements(mesh.GetBdrElementEdgeIndex(be), &el1, &el2);
+   return el1;
+}
+
+// Pack the part of the serial 'mesh' on 'rank', for ParMesh::MakeDistributed().
+// The integers are the numbers of vertices, elements and boundary elements,
+// the global vertex indices, and the geometry, attribute and local vertices of
+// each element and boundary element. The doubles are the vertex coordinates,
+// followed by the nodes of each element if the mesh is curved.
+void PackMeshPart(const Mesh &mesh, const Table &rank_elem,
+                  const Table &rank_bdr, int rank, Array<int> &vert_local,
+                  Array<int> &ibuf, Array<double> &dbuf)
+{
+   const int *elems = rank_elem.GetRow(rank), ne = rank_elem.RowSize(rank);
+   const int *bdr = rank_bdr.GetRow(rank), nbe = rank_bdr.RowSize(rank);
+
+   // number the local vertices in the global order; the boundary elements
+   // only use vertices of their owning elements
+   Array<int> verts;
+   for (int i = 0; i < ne; i++)
+   {
+      const Element *el = mesh.GetElement(elems[i]);
+      verts.Append(el->GetVertices(), el->GetNVertices());
+   }
+   verts.Sort();
+   verts.Unique();
+   for (int i = 0; i < verts.Size(); i++) { vert_local[verts[i]] = i; }
+
+   ibuf.SetSize(0);
+   ibuf.Append(verts.Size());
+   ibuf.Append(ne);
+   ibuf.Append(nbe);
+   ibuf.Append(verts);
+   for (int i = 0; i < ne + nbe; i++)
+   {
+      const Element *el = (i < ne) ? mesh.GetElement(elems[i]) :
+                          mesh.GetBdrElement(bdr[i-ne]);
+      ibuf.Append(el->GetGeometryType());
+      ibuf.Append(el->GetAttribute());
+      const int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         ibuf.Append(vert_local[v[j]]);
+      }
+   }
+
+   dbuf.SetSize(0);
+   for (int i = 0; i < verts.Size(); i++)
+   {
+      dbuf.Append(mesh.GetVertex(verts[i]), mesh.SpaceDimension());
+   }
+   if (mesh.GetNodes())
+   {
+      const GridFunction &nodes = *mesh.GetNodes();
+      Array<int> vdofs;
+      Vector el_nodes;
+      for (int i = 0; i < ne; i++)
+      {
+         nodes.FESpace()->GetElementVDofs(elems[i], vdofs);
+         nodes.GetSubVector(vdofs, el_nodes);
+         dbuf.Append(el_nodes.GetData(), el_nodes.Size());
+      }
+   }
+}
+
+// Create the local mesh and its global vertex indices from the data packed by
+// PackMeshPart(). The info array contains the dimension, the space dimension,
+// and the vector dimension and ordering of the nodes.
+Mesh UnpackMeshPart(const int *info, const std::string &fec_name,
+                    const Array<int> &ibuf, Array<double> &dbuf,
+                    Array<HYPRE_BigInt> &vertex_ids)
+{
+   const int nv = ibuf[0], ne = ibuf[1], nbe = ibuf[2], sdim = info[1];
+   Mesh mesh(info[0], nv, ne, nbe, sdim);
+
+   int pos = 3;
+   vertex_ids.SetSize(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      vertex_ids[i] = ibuf[pos++];
+      mesh.AddVertex(&dbuf[i*sdim]);
+   }
+   for (int i = 0; i < ne + nbe; i++)
+   {
+      Element *el = mesh.NewElement(ibuf[pos]);
+      el->SetAttribute(ibuf[pos+1]);
+      el->SetVertices(&ibuf[pos+2]);
+      pos += 2 + el->GetNVertices();
+      if (i < ne) { mesh.AddElement(el); }
+      else { mesh.AddBdrElement(el); }
+   }
+   mesh.FinalizeTopology(false);
+
+   if (fec_name.size())
+   {
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      FiniteElementSpace *fes =
+         new FiniteElementSpace(&mesh, fec, info[2], info[3]);
+      GridFunction *nodes = new GridFunction(fes);
+      nodes->MakeOwner(fec); // nodes will own fec and fes
+      Array<int> vdofs;
+      int offset = nv*sdim;
+      for (int i = 0; i < ne; i++)
+      {
+         fes->GetElementVDofs(i, vdofs);
+         nodes->SetSubVector(vdofs, &dbuf[offset]);
+         offset += vdofs.Size();
+      }
+      mesh.NewNodes(*nodes, true);
+   }
+   return mesh;
+}
+
+} // anonymous namespace
+
+ParMesh ParMesh::MakeDistributed(MPI_Comm comm, Mesh *mesh,
+                                 const int *partitioning, int root)
+{
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // dimension, space dimension, vdim and ordering of the nodes, length of the
+   // name of the nodal FiniteElementCollection
+   int info[5] = { 0, 0, 0, 0, 0 };
+   std::string fec_name;
+   if (rank == root)
+   {
+      MFEM_VERIFY(mesh && mesh->Conforming() && !mesh->NURBSext,
+                  "the mesh must be conforming and not NURBS");
+      info[0] = mesh->Dimension();
+      info[1] = mesh->SpaceDimension();
+      if (mesh->GetNodes())
+      {
+         const FiniteElementSpace *fes = mesh->GetNodes()->FESpace();
+         info[2] = fes->GetVDim();
+         info[3] = fes->GetOrdering();
+         fec_name = fes->FEColl()->Name();
+         info[4] = (int) fec_name.size();
+      }
+   }
+   MPI_Bcast(info, 5, MPI_INT, root, comm);
+   fec_name.resize(info[4]);
+   if (info[4])
+   {
+      MPI_Bcast(&fec_name[0], info[4], MPI_CHAR, root, comm);
+   }
+
+   const int itag = 823, dtag = 824;
+   Array<int> ibuf;
+   Array<double> dbuf;
+   if (rank == root)
+   {
+      const int *part = partitioning ? partitioning :
+                        mesh->GeneratePartitioning(nranks);
+      Table rank_elem, rank_bdr;
+      {
+         Array<int> elem_rank(const_cast<int*>(part), mesh->GetNE());
+         Transpose(elem_rank, rank_elem, nranks);
+         Array<int> bdr_rank(mesh->GetNBE());
+         for (int i = 0; i < bdr_rank.Size(); i++)
+         {
+            bdr_rank[i] = part[BdrElementOwner(*mesh, i)];
+         }
+         Transpose(bdr_rank, rank_bdr, nranks);
+      }
+      if (part != partitioning) { delete [] part; }
+
+      // stream the parts of the other ranks, one at a time
+      Array<int> vert_local(mesh->GetNV());
+      for (int r = 0; r < nranks; r++)
+      {
+         if (r == root) { continue; }
+         PackMeshPart(*mesh, rank_elem, rank_bdr, r, vert_local, ibuf, dbuf);
+         MPI_Send(ibuf.GetData(), ibuf.Size(), MPI_INT, r, itag, comm);
+         MPI_Send(dbuf.GetData(), dbuf.Size(), MPI_DOUBLE, r, dtag, comm);
+      }
+      PackMeshPart(*mesh, rank_elem, rank_bdr, root, vert_local, ibuf, dbuf);
+   }
+   else
+   {
+      MPI_Status status;
+      int count;
+      MPI_Probe(root, itag, comm, &status);
+      MPI_Get_count(&status, MPI_INT, &count);
+      ibuf.SetSize(count);
+      MPI_Recv(ibuf.GetData(), count, MPI_INT, root, itag, comm,
+               MPI_STATUS_IGNORE);
+      MPI_Probe(root, dtag, comm, &status);
+      MPI_Get_count(&status, MPI_DOUBLE, &count);
+      dbuf.SetSize(count);
+      MPI_Recv(dbuf.GetData(), count, MPI_DOUBLE, root, dtag, comm,
+               MPI_STATUS_IGNORE);
+   }
+
+   Array<HYPRE_BigInt> vertex_ids;
+   Mesh local_mesh = UnpackMeshPart(info, fec_name, ibuf, dbuf, vertex_ids);
+   ibuf.DeleteAll();
+   dbuf.DeleteAll();
+
+   return ParMesh(comm, local_mesh, vertex_ids);
+}
+
 // protected method, used by Nonconforming(De)Refinement and Rebalance
 ParMesh::ParMesh(const ParNCMesh &pncmesh)
    : MyComm(pncmesh.MyComm)
@@ -934,6 +1504,31 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    Load(input, gen_edges, refine, true);
 }
 
+ParMesh::ParMesh(MPI_Comm comm, const BinaryContainerReader &reader,
+                 bool refine)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   BinaryLoader(reader);
+
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   std::istringstream shared(reader.GetString("pmesh.shared"));
+   LoadSharedEntities(shared);
+
+   Finalize(refine, true);
+
+   EnsureParNodes();
+}
+
 void ParMesh::Load(istream &input, int generate_edges, int refine,
                    bool fix_orientation)
 {
@@ -3609,7 +4204,35 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Array<double> &elem_weights)
+{
+   RebalanceImpl(NULL, &elem_weights); // weighted SFC-based partition
+}
+
+double ParMesh::GetLoadImbalance(const Array<double> *elem_weights) const
+{
+   if (pncmesh) { return pncmesh->GetLoadImbalance(elem_weights); }
+
+   MFEM_VERIFY(!elem_weights || elem_weights->Size() == GetNE(),
+               "invalid number of element weights");
+   double local_load = 0.0, max_load = 0.0, total_load = 0.0;
+   for (int i = 0; i < GetNE(); i++)
+   {
+      local_load += elem_weights ? (*elem_weights)[i] : 1.0;
+   }
+   MPI_Allreduce(&local_load, &max_load, 1, MPI_DOUBLE, MPI_MAX, MyComm);
+   MPI_Allreduce(&local_load, &total_load, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   return (total_load > 0.0) ? max_load * NRanks / total_load : 1.0;
+}
+
+void ParMesh::GetRebalanceImbalance(double &before, double &after) const
+{
+   MFEM_VERIFY(pncmesh, "only nonconforming meshes can be rebalanced");
+   pncmesh->GetRebalanceImbalance(before, after);
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Array<double> *elem_weights)
 {
    if (Conforming())
    {
@@ -3626,7 +4249,7 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   pncmesh->Rebalance(partition, elem_weights);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -5543,6 +6166,15 @@ void ParMesh::ParPrint(ostream &out) const
    // be adding additional parallel mesh information.
    Printer(out, "mfem_serial_mesh_end");
 
+   // write out group topology info and the shared entities.
+   PrintSharedEntities(out);
+
+   // Write out section end tag for mesh.
+   out << "\nmfem_mesh_end" << endl;
+}
+
+void ParMesh::PrintSharedEntities(std::ostream &out) const
+{
    // write out group topology info.
    gtopo.Save(out);
 
@@ -5600,9 +6232,16 @@ void ParMesh::ParPrint(ostream &out) const
          }
       }
    }
+}
 
-   // Write out section end tag for mesh.
-   out << "\nmfem_mesh_end" << endl;
+void ParMesh::SaveBinary(const std::string &fname, bool compress) const
+{
+   BinaryContainerWriter writer(compress);
+   AddBinaryBlocks(writer);
+   std::ostringstream shared;
+   PrintSharedEntities(shared);
+   writer.AddString("pmesh.shared", shared.str());
+   writer.Save(fname);
 }
 
 void ParMesh::PrintVTU(std::string pathname,
@@ -145,7 +145,8 @@ protected:
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Array<double> *elem_weights = NULL);
 
    void DeleteFaceNbrData();
 
@@ -196,11 +197,19 @@ protected:
    void BuildSharedVertMapping(int nvert, const Table* vert_element,
                                const Array<int> &vert_global_local);
 
+   /** Find the shared entities and the group topology of a mesh given by its
+       local parts, using a distributed hash table of the entities on the
+       boundary of the local parts. */
+   void FindSharedEntities(const Array<HYPRE_BigInt> &vertex_ids);
+
    /// Ensure that bdr_attributes and attributes agree across processors
    void DistributeAttributes(Array<int> &attr);
 
    void LoadSharedEntities(std::istream &input);
 
+   /// Print the group topology and the shared entities, see ParPrint().
+   void PrintSharedEntities(std::ostream &out) const;
+
    /// If the mesh is curved, make sure 'Nodes' is ParGridFunction.
    /** Note that this method is not related to the public 'Mesh::EnsureNodes`.*/
    void EnsureParNodes();
@@ -229,6 +238,22 @@ public:
    ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_ = NULL,
            int part_method = 1);
 
+   /** @brief Create a parallel mesh from the local parts of a conforming mesh,
+       each MPI rank providing its part as the serial Mesh @a local_mesh. */
+   /** The array @a vertex_ids contains the global indices of the vertices of
+       @a local_mesh, which must be increasing; the vertices with the same
+       global index on different ranks are identified. The topology of
+       @a local_mesh must be finalized, see Mesh::FinalizeTopology(), and its
+       boundary elements should not include the faces shared with other ranks.
+
+       The shared vertices, edges and faces are found with a distributed hash
+       table of their global vertex indices, so that no rank stores the whole
+       mesh: this constructor can be used by parallel mesh readers, see also
+       MakeDistributed(). The @a refine parameter is passed to the method
+       Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+           const Array<HYPRE_BigInt> &vertex_ids, bool refine = true);
+
    /** Copy constructor. Performs a deep copy of (almost) all data, so that the
        source mesh can be modified (e.g. deleted, refined) without affecting the
        new mesh. If 'copy_nodes' is false, use a shallow (pointer) copy for the
@@ -239,6 +264,12 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Read a parallel mesh, each MPI rank from its own MFEM binary
+       container, see SaveBinary(). */
+   /** The @a refine parameter is passed to the method Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const BinaryContainerReader &reader,
+           bool refine = true);
+
    /// Deprecated: see @a ParMesh::MakeRefined
    MFEM_DEPRECATED
    ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type);
@@ -269,6 +300,22 @@ public:
        See @a Mesh::MakeSimplicial for more details. */
    static ParMesh MakeSimplicial(ParMesh &orig_mesh);
 
+   /** @brief Create a parallel mesh by streaming the parts of the serial
+       @a mesh, given on the rank @a root only, to the ranks of @a comm. */
+   /** Unlike ParMesh(MPI_Comm, Mesh &, int *, int), the serial mesh and the
+       partitioning are only needed on @a root (they are ignored, and may be
+       NULL, on the other ranks), which sends to each rank its elements,
+       vertices and boundary elements, one rank at a time. The other ranks only
+       store their local part, see ParMesh(MPI_Comm, const Mesh &,
+       const Array<HYPRE_BigInt> &, bool).
+
+       The optional array @a partitioning contains the rank of each element; by
+       default, it is computed with Mesh::GeneratePartitioning(). The mesh must
+       be conforming and not NURBS; curved meshes are supported. */
+   static ParMesh MakeDistributed(MPI_Comm comm, Mesh *mesh,
+                                  const int *partitioning = NULL,
+                                  int root = 0);
+
    virtual void Finalize(bool refine = false, bool fix_orientation = false);
 
    virtual void SetAttributes();
@@ -384,9 +431,33 @@ public:
        for 0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh by splitting the global space-filling
+       sequence of elements into segments of equal total weight. The positive
+       weight @a elem_weights[i] is the cost of the local element 'i', for
+       0 <= i < GetNE(), see e.g. FiniteElementSpace::GetElementCosts(). */
+   void Rebalance(const Array<double> &elem_weights);
+
+   /** Return the load imbalance factor, i.e. the maximum load of a processor
+       divided by the average load. The load is the sum of @a elem_weights over
+       the local elements, or their number if @a elem_weights is NULL. */
+   double GetLoadImbalance(const Array<double> *elem_weights = NULL) const;
+
+   /** Return the load imbalance factors (see GetLoadImbalance()) before and
+       after the last Rebalance(), as measured with its element weights. */
+   void GetRebalanceImbalance(double &before, double &after) const;
+
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
+   /** @brief Save the part of the mesh in the calling processor, including the
+       parallel data, to the file @a fname in the MFEM binary container format.
+
+       Each rank must use its own file: a single file shared by all the ranks is
+       not supported. Only conforming meshes are supported. See
+       Mesh::SaveBinary(). */
+   virtual void SaveBinary(const std::string &fname,
+                           bool compress = false) const;
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
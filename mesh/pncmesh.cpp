@@ -27,6 +27,8 @@ using namespace bin_io;
 
 ParNCMesh::ParNCMesh(MPI_Comm comm, const NCMesh &ncmesh, int *part)
    : NCMesh(ncmesh)
+   , imbalance_before(1.0)
+   , imbalance_after(1.0)
 {
    MyComm = comm;
    MPI_Comm_size(MyComm, &NRanks);
@@ -49,6 +51,8 @@ ParNCMesh::ParNCMesh(MPI_Comm comm, const NCMesh &ncmesh, int *part)
 ParNCMesh::ParNCMesh(MPI_Comm comm, std::istream &input, int version,
                      int &curved, int &is_nc)
    : NCMesh(input, version, curved, is_nc)
+   , imbalance_before(1.0)
+   , imbalance_after(1.0)
 {
    MyComm = comm;
    MPI_Comm_size(MyComm, &NRanks);
@@ -78,6 +82,8 @@ ParNCMesh::ParNCMesh(const ParNCMesh &other)
    : NCMesh(other)
    , MyComm(other.MyComm)
    , NRanks(other.NRanks)
+   , imbalance_before(other.imbalance_before)
+   , imbalance_after(other.imbalance_after)
 {
    Update(); // mark all secondary stuff for recalculation
 }
@@ -1649,37 +1655,88 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 //// Rebalance /////////////////////////////////////////////////////////////////
 
-void ParNCMesh::Rebalance(const Array<int> *custom_partition)
+static double SumWeights(const Array<double> &elem_weights)
+{
+   double sum = 0.0;
+   for (int i = 0; i < elem_weights.Size(); i++) { sum += elem_weights[i]; }
+   return sum;
+}
+
+void ParNCMesh::Rebalance(const Array<int> *custom_partition,
+                          const Array<double> *elem_weights)
 {
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
 
+   MFEM_VERIFY(!elem_weights || elem_weights->Size() == NElements,
+               "Size of the weight array must match the number "
+               "of local mesh elements (ParMesh::GetNE()).");
+
    Array<int> old_elements;
    leaf_elements.GetSubArray(0, NElements, old_elements);
 
+   double local_load = elem_weights ? SumWeights(*elem_weights) : NElements;
+   imbalance_before = LoadImbalance(local_load);
+
+   Array<int> new_ranks;
+   int target_elements = -1;
+   double new_load = 0.0;
+
    if (!custom_partition) // SFC based partitioning
    {
-      Array<int> new_ranks(leaf_elements.Size());
+      new_ranks.SetSize(leaf_elements.Size());
       new_ranks = -1;
 
-      // figure out new assignments for Element::rank
-      long local_elems = NElements, total_elems = 0;
-      MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+      if (!elem_weights)
+      {
+         // figure out new assignments for Element::rank
+         long local_elems = NElements, total_elems = 0;
+         MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM,
+                       MyComm);
 
-      long first_elem_global = 0;
-      MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
-      first_elem_global -= local_elems;
+         long first_elem_global = 0;
+         MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM,
+                  MyComm);
+         first_elem_global -= local_elems;
 
-      for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
-      {
-         if (elements[leaf_elements[i]].rank == MyRank)
+         for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
          {
-            new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+            if (elements[leaf_elements[i]].rank == MyRank)
+            {
+               new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+            }
          }
+
+         target_elements = PartitionFirstIndex(MyRank+1, total_elems)
+                           - PartitionFirstIndex(MyRank, total_elems);
+         new_load = target_elements;
       }
+      else
+      {
+         // split the SFC sequence into segments of equal total weight: each
+         // element goes to the rank whose segment contains its midpoint
+         double total_load = 0.0, first_load = 0.0;
+         MPI_Allreduce(&local_load, &total_load, 1, MPI_DOUBLE, MPI_SUM,
+                       MyComm);
+         MPI_Scan(&local_load, &first_load, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+         first_load -= local_load;
 
-      int target_elements = PartitionFirstIndex(MyRank+1, total_elems)
-                            - PartitionFirstIndex(MyRank, total_elems);
+         for (int i = 0; i < leaf_elements.Size(); i++)
+         {
+            if (elements[leaf_elements[i]].rank == MyRank)
+            {
+               const double w = (*elem_weights)[i];
+               MFEM_VERIFY(w > 0.0, "element weights must be positive");
+               new_ranks[i] = WeightedPartition(first_load + 0.5*w,
+                                                total_load);
+               first_load += w;
+            }
+         }
+
+         // the SFC termination condition needs the number of elements we
+         // are going to own
+         GetNewLoad(new_ranks, elem_weights, target_elements, new_load);
+      }
 
       // assign the new ranks and send elements (plus ghosts) to new owners
       RedistributeElements(new_ranks, target_elements, true);
@@ -1690,13 +1747,17 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
                   "Size of the partition array must match the number "
                   "of local mesh elements (ParMesh::GetNE()).");
 
-      Array<int> new_ranks;
       custom_partition->Copy(new_ranks);
       new_ranks.SetSize(leaf_elements.Size(), -1); // make room for ghosts
 
+      int new_elements;
+      GetNewLoad(new_ranks, elem_weights, new_elements, new_load);
+
       RedistributeElements(new_ranks, -1, true);
    }
 
+   imbalance_after = LoadImbalance(new_load);
+
    // set up the old index array
    old_index_or_rank.SetSize(NElements);
    old_index_or_rank = -1;
@@ -1710,6 +1771,49 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    Prune();
 }
 
+double ParNCMesh::LoadImbalance(double local_load) const
+{
+   double max_load = 0.0, total_load = 0.0;
+   MPI_Allreduce(&local_load, &max_load, 1, MPI_DOUBLE, MPI_MAX, MyComm);
+   MPI_Allreduce(&local_load, &total_load, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   return (total_load > 0.0) ? max_load * NRanks / total_load : 1.0;
+}
+
+double ParNCMesh::GetLoadImbalance(const Array<double> *elem_weights) const
+{
+   MFEM_VERIFY(!elem_weights || elem_weights->Size() == NElements,
+               "Size of the weight array must match the number "
+               "of local mesh elements (ParMesh::GetNE()).");
+   return LoadImbalance(elem_weights ? SumWeights(*elem_weights) : NElements);
+}
+
+void ParNCMesh::GetNewLoad(const Array<int> &new_ranks,
+                           const Array<double> *elem_weights,
+                           int &new_elements, double &new_load) const
+{
+   // accumulate what we send to each rank, then sum over all senders
+   Array<int> send_elements(NRanks);
+   Array<double> send_load(NRanks);
+   send_elements = 0;
+   send_load = 0.0;
+
+   for (int i = 0; i < leaf_elements.Size(); i++)
+   {
+      if (elements[leaf_elements[i]].rank == MyRank)
+      {
+         const int rank = new_ranks[i];
+         MFEM_ASSERT(rank >= 0 && rank < NRanks, "invalid rank " << rank);
+         send_elements[rank]++;
+         send_load[rank] += elem_weights ? (*elem_weights)[i] : 1.0;
+      }
+   }
+
+   MPI_Reduce_scatter_block(send_elements.GetData(), &new_elements, 1,
+                            MPI_INT, MPI_SUM, MyComm);
+   MPI_Reduce_scatter_block(send_load.GetData(), &new_load, 1,
+                            MPI_DOUBLE, MPI_SUM, MyComm);
+}
+
 void ParNCMesh::RedistributeElements(Array<int> &new_ranks, int target_elements,
                                      bool record_comm)
 {
@@ -100,8 +100,23 @@ public:
        The default partitioning strategy is based on equal splitting of the
        space-filling sequence of leaf elements (custom_partition == NULL).
        Alternatively, a used-defined element-rank assignment array can be
-       passed. */
-   void Rebalance(const Array<int> *custom_partition = NULL);
+       passed. If @a elem_weights is given (one positive weight per local
+       element), the default strategy splits the space-filling sequence into
+       segments of equal total weight instead of equal element counts. */
+   void Rebalance(const Array<int> *custom_partition = NULL,
+                  const Array<double> *elem_weights = NULL);
+
+   /** Return the load imbalance factors (maximum rank load divided by the
+       average rank load) before and after the last Rebalance(). The load of a
+       rank is the sum of its element weights, or its number of elements if no
+       weights were given. */
+   void GetRebalanceImbalance(double &before, double &after) const
+   { before = imbalance_before; after = imbalance_after; }
+
+   /** Return the load imbalance factor of the current partitioning, see
+       GetRebalanceImbalance(). @a elem_weights, if given, must have one entry
+       per local element. */
+   double GetLoadImbalance(const Array<double> *elem_weights = NULL) const;
 
 
    // interface for ParFiniteElementSpace
@@ -301,6 +316,14 @@ protected: // implementation
    int Partition(long index, long total_elements) const
    { return index * NRanks / total_elements; }
 
+   /** Return the processor number for the point @a load in [0, total_load)
+       of a sequence split into segments of equal weight. */
+   int WeightedPartition(double load, double total_load) const
+   {
+      int rank = (int) (load * NRanks / total_load);
+      return std::min(std::max(rank, 0), NRanks-1);
+   }
+
    /// Helper to get the partitioning when the serial mesh gets split initially
    int InitialPartition(int index) const
    { return Partition(index, leaf_elements.Size()); }
@@ -522,6 +545,18 @@ protected: // implementation
    void RedistributeElements(Array<int> &new_ranks, int target_elements,
                              bool record_comm);
 
+   /// Load imbalance factors recorded by the last Rebalance().
+   double imbalance_before, imbalance_after;
+
+   /// Return max(local_load) / avg(local_load) over all ranks.
+   double LoadImbalance(double local_load) const;
+
+   /** Return the number of elements and their total weight that this rank
+       will own after elements are migrated according to @a new_ranks. */
+   void GetNewLoad(const Array<int> &new_ranks,
+                   const Array<double> *elem_weights,
+                   int &new_elements, double &new_load) const;
+
    /** Recorded communication pattern from last Rebalance. Used by
        Send/RecvRebalanceDofs to ship element DOFs. */
    RebalanceDofMessage::Map send_rebalance_dofs;
@@ -0,0 +1,428 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace mfem
+{
+
+MeshPointLocator::MeshPointLocator(Mesh &mesh_, double box_tol_,
+                                   double bin_tol_)
+   : mesh(&mesh_), mesh_sequence(-1), nodes(NULL), nodes_updated(false),
+     coords_checksum(0), sdim(0), NE(0), box_tol(box_tol_), bin_tol(bin_tol_), num_rebuilds(0),
+     num_box_updates(0), num_bin_searches(0)
+{
+   for (int d = 0; d < 3; d++)
+   {
+      grid_min[d] = grid_max[d] = grid_hinv[d] = 0.0;
+      grid_n[d] = 1;
+   }
+   Rebuild();
+}
+
+unsigned long long MeshPointLocator::CoordinatesChecksum() const
+{
+   // FNV-1a over the bits of the coordinates: any change of a coordinate, or
+   // of the order of the coordinates, changes the checksum.
+   unsigned long long h = 14695981039346656037ULL;
+   auto add = [&h](double x)
+   {
+      unsigned long long bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      h = (h ^ bits) * 1099511628211ULL;
+   };
+   const GridFunction *nodes_ = mesh->GetNodes();
+   if (nodes_)
+   {
+      const double *nd = nodes_->HostRead();
+      for (int i = 0; i < nodes_->Size(); i++) { add(nd[i]); }
+   }
+   else
+   {
+      const int sdim_ = mesh->SpaceDimension();
+      for (int i = 0; i < mesh->GetNV(); i++)
+      {
+         const double *x = mesh->GetVertex(i);
+         for (int d = 0; d < sdim_; d++) { add(x[d]); }
+      }
+   }
+   return h;
+}
+
+void MeshPointLocator::ComputeBoxes()
+{
+   sdim = mesh->SpaceDimension();
+   NE = mesh->GetNE();
+   MFEM_VERIFY(sdim <= 3, "invalid space dimension: " << sdim);
+
+   box_min.SetSize(sdim, NE);
+   box_max.SetSize(sdim, NE);
+
+   nodes = mesh->GetNodes();
+   nodes_updated = false;
+   coords_checksum = CoordinatesChecksum();
+   num_box_updates++;
+   const double *nd = nodes ? nodes->HostRead() : NULL;
+   const FiniteElementSpace *nfes = nodes ? nodes->FESpace() : NULL;
+   Array<int> dofs;
+   for (int e = 0; e < NE; e++)
+   {
+      double *bmin = box_min.GetColumn(e), *bmax = box_max.GetColumn(e);
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] = std::numeric_limits<double>::infinity();
+         bmax[d] = -std::numeric_limits<double>::infinity();
+      }
+      if (nodes)
+      {
+         // The element vdofs are ordered by component, regardless of the
+         // ordering of the nodes GridFunction.
+         nfes->GetElementVDofs(e, dofs);
+         const int nd_e = dofs.Size()/sdim;
+         for (int d = 0; d < sdim; d++)
+         {
+            for (int j = 0; j < nd_e; j++)
+            {
+               const double x = nd[dofs[j + d*nd_e]];
+               bmin[d] = std::min(bmin[d], x);
+               bmax[d] = std::max(bmax[d], x);
+            }
+         }
+      }
+      else
+      {
+         mesh->GetElementVertices(e, dofs);
+         for (int j = 0; j < dofs.Size(); j++)
+         {
+            const double *x = mesh->GetVertex(dofs[j]);
+            for (int d = 0; d < sdim; d++)
+            {
+               bmin[d] = std::min(bmin[d], x[d]);
+               bmax[d] = std::max(bmax[d], x[d]);
+            }
+         }
+      }
+      // Enlarge the box by a fraction of its largest extent to account for
+      // curved element boundaries and round-off in flat directions.
+      double ext = 0.0;
+      for (int d = 0; d < sdim; d++) { ext = std::max(ext, bmax[d]-bmin[d]); }
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] -= box_tol*ext;
+         bmax[d] += box_tol*ext;
+      }
+   }
+}
+
+void MeshPointLocator::BinElements()
+{
+   bin_min.SetSize(sdim, NE);
+   bin_max.SetSize(sdim, NE);
+   for (int e = 0; e < NE; e++)
+   {
+      const double *bmin = box_min.GetColumn(e), *bmax = box_max.GetColumn(e);
+      double ext = 0.0;
+      for (int d = 0; d < sdim; d++) { ext = std::max(ext, bmax[d]-bmin[d]); }
+      for (int d = 0; d < sdim; d++)
+      {
+         bin_min(d,e) = bmin[d] - bin_tol*ext;
+         bin_max(d,e) = bmax[d] + bin_tol*ext;
+      }
+   }
+
+   // Grid bounding box
+   for (int d = 0; d < 3; d++)
+   {
+      grid_min[d] = grid_max[d] = grid_hinv[d] = 0.0;
+      grid_n[d] = 1;
+   }
+   if (NE == 0)
+   {
+      bin_offsets.SetSize(2);
+      bin_offsets = 0;
+      bin_elements.SetSize(0);
+      num_rebuilds++;
+      return;
+   }
+   for (int d = 0; d < sdim; d++)
+   {
+      grid_min[d] = std::numeric_limits<double>::infinity();
+      grid_max[d] = -std::numeric_limits<double>::infinity();
+      for (int e = 0; e < NE; e++)
+      {
+         grid_min[d] = std::min(grid_min[d], bin_min(d,e));
+         grid_max[d] = std::max(grid_max[d], bin_max(d,e));
+      }
+   }
+
+   // Choose the bin size so that the number of bins is about the number of
+   // elements. Directions with a vanishing extent, e.g. for surface meshes,
+   // get a single bin.
+   double vol = 1.0, max_ext = 0.0;
+   int num_dirs = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      max_ext = std::max(max_ext, grid_max[d] - grid_min[d]);
+   }
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = grid_max[d] - grid_min[d];
+      if (ext > 1e-12*max_ext) { vol *= ext; num_dirs++; }
+   }
+   const double h = num_dirs ? std::pow(vol/NE, 1.0/num_dirs) : 1.0;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double ext = grid_max[d] - grid_min[d];
+      if (ext > 1e-12*max_ext)
+      {
+         const double n = std::ceil(ext/h);
+         grid_n[d] = (int) std::max(1.0, std::min(n, (double) NE));
+         grid_hinv[d] = grid_n[d]/ext;
+      }
+   }
+
+   // Bin the elements: first count, then fill.
+   const int nbins = GetNumBins();
+   bin_offsets.SetSize(nbins+1);
+   bin_offsets = 0;
+   int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int e = 0; e < NE; e++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            lo[d] = GetBinCoord(d, bin_min(d,e));
+            hi[d] = GetBinCoord(d, bin_max(d,e));
+         }
+         for (int k = lo[2]; k <= hi[2]; k++)
+         {
+            for (int j = lo[1]; j <= hi[1]; j++)
+            {
+               for (int i = lo[0]; i <= hi[0]; i++)
+               {
+                  const int b = i + grid_n[0]*(j + grid_n[1]*k);
+                  if (pass == 0) { bin_offsets[b+1]++; }
+                  else { bin_elements[bin_offsets[b]++] = e; }
+               }
+            }
+         }
+      }
+      if (pass == 0)
+      {
+         bin_offsets.PartialSum();
+         bin_elements.SetSize(bin_offsets[nbins]);
+      }
+      else
+      {
+         // Shift the offsets back after the fill pass.
+         for (int b = nbins; b > 0; b--) { bin_offsets[b] = bin_offsets[b-1]; }
+         bin_offsets[0] = 0;
+      }
+   }
+   num_rebuilds++;
+}
+
+void MeshPointLocator::Rebuild()
+{
+   ComputeBoxes();
+   BinElements();
+   mesh_sequence = mesh->GetSequence();
+}
+
+void MeshPointLocator::Update()
+{
+   if (mesh->GetSequence() != mesh_sequence || mesh->GetNE() != NE ||
+       mesh->SpaceDimension() != sdim || mesh->GetNodes() != nodes)
+   {
+      Rebuild();
+      return;
+   }
+   if (!nodes_updated && CoordinatesChecksum() == coords_checksum) { return; }
+
+   // The topology did not change, check if the elements moved out of the
+   // boxes they were binned with.
+   ComputeBoxes();
+   for (int e = 0; e < NE; e++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         if (box_min(d,e) < bin_min(d,e) || box_max(d,e) > bin_max(d,e))
+         {
+            BinElements();
+            return;
+         }
+      }
+   }
+}
+
+void MeshPointLocator::GetCandidates(const double *x, Array<int> &elems) const
+{
+   num_bin_searches++;
+   elems.SetSize(0);
+   int b = 0;
+   for (int d = sdim-1; d >= 0; d--)
+   {
+      if (x[d] < grid_min[d] || x[d] > grid_max[d]) { return; }
+      b = b*grid_n[d] + GetBinCoord(d, x[d]);
+   }
+   for (int k = bin_offsets[b]; k < bin_offsets[b+1]; k++)
+   {
+      const int e = bin_elements[k];
+      bool inside = true;
+      for (int d = 0; d < sdim; d++)
+      {
+         if (x[d] < box_min(d,e) || x[d] > box_max(d,e))
+         {
+            inside = false;
+            break;
+         }
+      }
+      if (inside) { elems.Append(e); }
+   }
+}
+
+int MeshPointLocator::FindPoints(const DenseMatrix &point_mat,
+                                 Array<int> &elem_ids,
+                                 Array<IntegrationPoint> &ips,
+                                 InverseElementTransformation &inv_tr) const
+{
+   MFEM_VERIFY(point_mat.Height() == sdim, "Invalid points matrix");
+   const int npts = point_mat.Width();
+   Array<int> cand;
+   Vector pt;
+   int pts_found = 0;
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] != -1) { continue; }
+      const double *x = point_mat.GetColumn(k);
+      GetCandidates(x, cand);
+      pt.SetDataAndSize(const_cast<double*>(x), sdim);
+      for (int i = 0; i < cand.Size(); i++)
+      {
+         inv_tr.SetTransformation(*mesh->GetElementTransformation(cand[i]));
+         const int res = inv_tr.Transform(pt, ips[k]);
+         if (res == InverseElementTransformation::Inside)
+         {
+            elem_ids[k] = cand[i];
+            pts_found++;
+            break;
+         }
+      }
+   }
+   return pts_found;
+}
+
+
+// Squared distance from the point x to the box [bmin(:,e), bmax(:,e)] and,
+// in d_center, the squared distance from x to the center of the box.
+static double BoxDistance(const DenseMatrix &bmin, const DenseMatrix &bmax,
+                          int e, const double *x, double &d_center)
+{
+   double d_box = 0.0;
+   d_center = 0.0;
+   for (int d = 0; d < bmin.Height(); d++)
+   {
+      const double lo = bmin(d,e), hi = bmax(d,e);
+      const double dx = (x[d] < lo) ? lo - x[d] : (x[d] > hi ? x[d] - hi : 0.0);
+      const double dc = x[d] - 0.5*(lo + hi);
+      d_box += dx*dx;
+      d_center += dc*dc;
+   }
+   return d_box;
+}
+
+int MeshPointLocator::FindPoints(const DenseMatrix &point_mat,
+                                 const Array<int> &hints,
+                                 Array<int> &elem_ids,
+                                 Array<IntegrationPoint> &ips,
+                                 InverseElementTransformation &inv_tr,
+                                 int max_steps) const
+{
+   MFEM_VERIFY(point_mat.Height() == sdim, "Invalid points matrix");
+   const int npts = point_mat.Width();
+   MFEM_VERIFY(hints.Size() == npts, "Invalid hints array");
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+
+   const Table &el_to_el = mesh->ElementToElementTable();
+   Array<int> tried, cand;
+   Vector pt;
+   int pts_found = 0;
+   for (int k = 0; k < npts; k++)
+   {
+      elem_ids[k] = -1;
+      const double *x = point_mat.GetColumn(k);
+      pt.SetDataAndSize(const_cast<double*>(x), sdim);
+
+      // Walk from the hint toward the point, moving to the face-neighbor whose
+      // bounding box is the closest to the point.
+      tried.SetSize(0);
+      int e = (hints[k] >= 0 && hints[k] < NE) ? hints[k] : -1;
+      for (int step = 0; e >= 0 && step < max_steps; step++)
+      {
+         tried.Append(e);
+         double dc;
+         if (BoxDistance(box_min, box_max, e, x, dc) == 0.0)
+         {
+            inv_tr.SetTransformation(*mesh->GetElementTransformation(e));
+            if (inv_tr.Transform(pt, ips[k]) ==
+                InverseElementTransformation::Inside)
+            {
+               elem_ids[k] = e;
+               break;
+            }
+         }
+         const int *nbr = el_to_el.GetRow(e);
+         const int num_nbr = el_to_el.RowSize(e);
+         double best_box = std::numeric_limits<double>::infinity();
+         double best_center = best_box;
+         e = -1;
+         for (int i = 0; i < num_nbr; i++)
+         {
+            if (tried.Find(nbr[i]) >= 0) { continue; }
+            const double db = BoxDistance(box_min, box_max, nbr[i], x, dc);
+            if (db < best_box || (db == best_box && dc < best_center))
+            {
+               best_box = db;
+               best_center = dc;
+               e = nbr[i];
+            }
+         }
+      }
+
+      // Fall back to the candidates from the bins
+      if (elem_ids[k] == -1)
+      {
+         GetCandidates(x, cand);
+         for (int i = 0; i < cand.Size(); i++)
+         {
+            if (tried.Find(cand[i]) >= 0) { continue; }
+            inv_tr.SetTransformation(*mesh->GetElementTransformation(cand[i]));
+            if (inv_tr.Transform(pt, ips[k]) ==
+                InverseElementTransformation::Inside)
+            {
+               elem_ids[k] = cand[i];
+               break;
+            }
+         }
+      }
+      if (elem_ids[k] != -1) { pts_found++; }
+   }
+   return pts_found;
+}
+
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_POINT_LOCATOR
+#define MFEM_POINT_LOCATOR
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../linalg/densemat.hpp"
+#include "../fem/intrules.hpp"
+
+namespace mfem
+{
+
+class Mesh;
+class GridFunction;
+class InverseElementTransformation;
+
+/** @brief Spatial index over the elements of a Mesh used to locate physical
+    points, see Mesh::FindPoints().
+
+    The index is a uniform grid of bins covering the bounding box of the mesh.
+    Every bin stores the elements whose bounding boxes overlap it, so that the
+    candidate elements for a point are the elements of its bin whose boxes
+    contain the point. The number of bins is proportional to the number of
+    elements, which makes the cost of a query independent of the mesh size for
+    reasonably graded meshes.
+
+    The element bounding boxes are computed from the element vertices or, for
+    curved meshes, from the element nodes. They are enlarged by the relative
+    tolerance @a box_tol to account for the curvature of the element boundary.
+    Elements are binned with boxes that are enlarged further by the relative
+    tolerance @a bin_tol, so that when the mesh nodes move by a small amount,
+    Update() only needs to recompute the element boxes and the bins are kept.
+
+    The element boxes are not recomputed when the mesh is unchanged. Changes of
+    the mesh sequence or of the node GridFunction are detected directly, and
+    changes of the node (or vertex) coordinates, including in-place changes
+    through Mesh::GetNodes(), are detected with a checksum of the coordinates,
+    which costs a single pass over them. */
+class MeshPointLocator
+{
+protected:
+   Mesh *mesh;
+   long mesh_sequence; ///< Mesh sequence at the time of the last binning.
+   const GridFunction *nodes; ///< Mesh nodes at the time of the last binning.
+   bool nodes_updated; ///< The mesh nodes moved since the last Update().
+   /// Checksum of the node (or vertex) coordinates of the element boxes.
+   unsigned long long coords_checksum;
+   int sdim; ///< Space dimension of the mesh.
+   int NE; ///< Number of binned elements.
+   double box_tol, bin_tol;
+
+   /// Element bounding boxes used to select candidates: sdim x NE.
+   DenseMatrix box_min, box_max;
+   /// Enlarged element bounding boxes used for the binning: sdim x NE.
+   DenseMatrix bin_min, bin_max;
+
+   /// Bounding box of the grid, number of bins and inverse bin sizes.
+   double grid_min[3], grid_max[3], grid_hinv[3];
+   int grid_n[3];
+
+   /// Elements in each bin, in CSR format.
+   Array<int> bin_offsets, bin_elements;
+
+   /// Statistics: number of full rebuilds and re-binnings.
+   int num_rebuilds;
+   /// Statistics: number of computations of the element boxes.
+   int num_box_updates;
+   /// Statistics: number of point searches in the bins.
+   mutable int num_bin_searches;
+
+   /// Return a checksum of the current node (or vertex) coordinates.
+   unsigned long long CoordinatesChecksum() const;
+
+   /// Compute the (enlarged by box_tol) element bounding boxes.
+   void ComputeBoxes();
+
+   /// Compute the grid dimensions and bin all elements.
+   void BinElements();
+
+   /// Index of the bin containing the coordinate @a x in direction @a d.
+   inline int GetBinCoord(int d, double x) const
+   {
+      const int i = (int)((x - grid_min[d])*grid_hinv[d]);
+      return (i < 0) ? 0 : (i >= grid_n[d] ? grid_n[d]-1 : i);
+   }
+
+public:
+   /// Build the index for the given @a mesh.
+   MeshPointLocator(Mesh &mesh, double box_tol = 0.1, double bin_tol = 0.25);
+
+   /** @brief Update the index after the mesh was modified.
+
+       If the mesh sequence, the number of elements or the node GridFunction
+       changed, the index is rebuilt from scratch. Otherwise, if the node
+       coordinates changed or NodesUpdated() was called, the element boxes are
+       recomputed from the current mesh nodes and the elements are re-binned
+       only if at least one of them moved out of its binning box. Otherwise,
+       the index is kept as is. */
+   void Update();
+
+   /** @brief Mark the element boxes for recomputation by the next Update(),
+       after the mesh nodes (or vertices) moved. This is not required, but it
+       skips the checksum of the coordinates. */
+   void NodesUpdated() { nodes_updated = true; }
+
+   /// Recompute the element boxes and bin all elements.
+   void Rebuild();
+
+   /** @brief Return in @a elems the elements whose bounding boxes contain the
+       point @a x, i.e. the candidates for the element containing @a x. */
+   void GetCandidates(const double *x, Array<int> &elems) const;
+
+   /** @brief Locate the points given as the columns of @a point_mat, see
+       Mesh::FindPoints(). Only the points with elem_ids[i] == -1 on entry are
+       searched for.
+
+       @returns The number of points that were found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips,
+                  InverseElementTransformation &inv_tr) const;
+
+   /** @brief Locate the points given as the columns of @a point_mat, starting
+       from the given @a hints.
+
+       For each point, @a hints holds an element close to the point, e.g. the
+       element found by a previous search, or -1. The search first tries the
+       hint element and then walks over its face-neighbors toward the point,
+       trying at most @a max_steps elements, before falling back to the bins.
+       On return, @a elem_ids holds the elements containing the points, or -1.
+
+       @returns The number of points that were found. */
+   int FindPoints(const DenseMatrix &point_mat, const Array<int> &hints,
+                  Array<int> &elem_ids, Array<IntegrationPoint> &ips,
+                  InverseElementTransformation &inv_tr,
+                  int max_steps = 8) const;
+
+   /// Return the number of bins in the grid.
+   int GetNumBins() const { return grid_n[0]*grid_n[1]*grid_n[2]; }
+
+   /// Return the number of times the elements were (re-)binned.
+   int GetNumRebuilds() const { return num_rebuilds; }
+
+   /// Return the number of times the element boxes were computed.
+   int GetNumBoxUpdates() const { return num_box_updates; }
+
+   /** @brief Return the number of points searched for in the bins, i.e. not
+       found from their hints. */
+   int GetNumBinSearches() const { return num_bin_searches; }
+
+   /// Return the mesh associated with the index.
+   Mesh *GetMesh() const { return mesh; }
+};
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "psubmesh.hpp"
+#include "../general/sort_pairs.hpp"
+
+namespace mfem
+{
+
+ParSubMesh ParSubMesh::CreateFromDomain(const ParMesh &parent,
+                                        const Array<int> &attributes)
+{
+   return ParSubMesh(parent,
+                     MakeLocalPart(parent, SubMesh::From::Domain, attributes));
+}
+
+ParSubMesh ParSubMesh::CreateFromBoundary(const ParMesh &parent,
+                                          const Array<int> &attributes)
+{
+   return ParSubMesh(parent,
+                     MakeLocalPart(parent, SubMesh::From::Boundary, attributes));
+}
+
+ParSubMesh::ParSubMesh(const ParMesh &parent_, const LocalPart &local)
+   : ParMesh(parent_.GetComm(), *local.mesh, local.vertex_ids, false),
+     parent(&parent_), from(local.mesh->GetFrom()),
+     parent_element_ids(local.mesh->GetParentElementIDMap()),
+     parent_vertex_ids(local.mesh->GetParentVertexIDMap())
+{
+   delete local.mesh;
+}
+
+ParSubMesh::LocalPart ParSubMesh::MakeLocalPart(const ParMesh &parent,
+                                                SubMesh::From from,
+                                                const Array<int> &attributes)
+{
+   ParMesh &pmesh = const_cast<ParMesh &>(parent);
+   const int dim = parent.Dimension();
+
+   // Order the vertices of the local part by their global indices, as
+   // required by the ParMesh constructor.
+   Array<HYPRE_Int> global_vertex;
+   parent.GetGlobalVertexIndices(global_vertex);
+   const int nv = parent.GetNV();
+   Array<Pair<HYPRE_Int, int> > order(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      order[i] = Pair<HYPRE_Int, int>(global_vertex[i], i);
+   }
+   SortPairs<HYPRE_Int, int>(order, nv);
+   Array<int> vertex_key(nv);
+   for (int i = 0; i < nv; i++) { vertex_key[order[i].two] = i; }
+
+   // Count the elements of the ParSubMesh adjacent to its faces on all the
+   // ranks sharing them: the faces with one adjacent element are boundary
+   // faces.
+   Array<int> elements, face_count;
+   SubMesh::SelectElements(parent, from, attributes, elements);
+   SubMesh::CountFaces(parent, from, elements, face_count);
+
+   const int face_dim = (from == SubMesh::From::Domain) ? dim - 1 : dim - 2;
+   Array<int> face_group(face_count.Size());
+   face_group = 0;
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      int f, o;
+      if (face_dim == 2)
+      {
+         for (int i = 0; i < pmesh.GroupNTriangles(g); i++)
+         {
+            pmesh.GroupTriangle(g, i, f, o);
+            face_group[f] = g;
+         }
+         for (int i = 0; i < pmesh.GroupNQuadrilaterals(g); i++)
+         {
+            pmesh.GroupQuadrilateral(g, i, f, o);
+            face_group[f] = g;
+         }
+      }
+      else if (face_dim == 1)
+      {
+         for (int i = 0; i < pmesh.GroupNEdges(g); i++)
+         {
+            pmesh.GroupEdge(g, i, f, o);
+            face_group[f] = g;
+         }
+      }
+      else
+      {
+         for (int i = 0; i < pmesh.GroupNVertices(g); i++)
+         {
+            face_group[pmesh.GroupVertex(g, i)] = g;
+         }
+      }
+   }
+   GroupCommunicator gcomm(pmesh.gtopo);
+   gcomm.Create(face_group);
+   gcomm.Reduce<int>(face_count, GroupCommunicator::Sum);
+   gcomm.Bcast(face_count);
+
+   LocalPart local;
+   local.mesh = new SubMesh(parent, from, attributes, &vertex_key,
+                            &face_count);
+   const Array<int> &vertices = local.mesh->GetParentVertexIDMap();
+   local.vertex_ids.SetSize(vertices.Size());
+   for (int i = 0; i < vertices.Size(); i++)
+   {
+      local.vertex_ids[i] = global_vertex[vertices[i]];
+   }
+   return local;
+}
+
+}
+
+#endif // MFEM_USE_MPI
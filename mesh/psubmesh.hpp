@@ -0,0 +1,91 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PSUBMESH
+#define MFEM_PSUBMESH
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "pmesh.hpp"
+#include "submesh.hpp"
+
+namespace mfem
+{
+
+/** @brief A parallel mesh made of a subset of the elements, or of the boundary
+    elements, of a parent ParMesh, see SubMesh.
+
+    Each rank owns the part of the ParSubMesh made of its parent elements, or
+    boundary elements, so that the maps to the parent elements and vertices
+    are local, and the transfer of ParGridFunctions with TransferMap only
+    requires communication for the transfer to the parent. The shared entities
+    of the ParSubMesh are found with the ParMesh constructor from local parts,
+    see ParMesh(MPI_Comm, const Mesh &, const Array<HYPRE_BigInt> &, bool). */
+class ParSubMesh : public ParMesh
+{
+public:
+   /** @brief Create a ParSubMesh from the elements of @a parent whose
+       attribute is in @a attributes. */
+   static ParSubMesh CreateFromDomain(const ParMesh &parent,
+                                      const Array<int> &attributes);
+
+   /** @brief Create a ParSubMesh, of dimension one less than @a parent, from
+       the boundary elements of @a parent whose attribute is in
+       @a attributes. */
+   static ParSubMesh CreateFromBoundary(const ParMesh &parent,
+                                        const Array<int> &attributes);
+
+   /// Return the parent mesh.
+   const ParMesh *GetParent() const { return parent; }
+
+   /// Return the kind of parent entities the ParSubMesh is made of.
+   SubMesh::From GetFrom() const { return from; }
+
+   /** @brief Return the map from the local elements of the ParSubMesh to the
+       local elements, or boundary elements, of the parent mesh. */
+   const Array<int> &GetParentElementIDMap() const
+   { return parent_element_ids; }
+
+   /** @brief Return the map from the local vertices of the ParSubMesh to the
+       local parent vertices. */
+   const Array<int> &GetParentVertexIDMap() const
+   { return parent_vertex_ids; }
+
+protected:
+   const ParMesh *parent;
+   SubMesh::From from;
+
+   Array<int> parent_element_ids;
+   Array<int> parent_vertex_ids;
+
+   // The local part of a ParSubMesh and the global indices of its vertices.
+   struct LocalPart
+   {
+      SubMesh *mesh;
+      Array<HYPRE_BigInt> vertex_ids;
+   };
+
+   /** @brief Create the local part of the ParSubMesh: the faces shared with
+       other ranks are not boundary faces of the local part. */
+   static LocalPart MakeLocalPart(const ParMesh &parent, SubMesh::From from,
+                                  const Array<int> &attributes);
+
+   /// Create a ParSubMesh from its local part, deleting @a local.mesh.
+   ParSubMesh(const ParMesh &parent, const LocalPart &local);
+};
+
+}
+
+#endif // MFEM_USE_MPI
+
+#endif
@@ -0,0 +1,247 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "submesh.hpp"
+#include "../fem/fem.hpp"
+#include "../general/sort_pairs.hpp"
+
+namespace mfem
+{
+
+SubMesh SubMesh::CreateFromDomain(const Mesh &parent,
+                                  const Array<int> &attributes)
+{
+   return SubMesh(parent, From::Domain, attributes);
+}
+
+SubMesh SubMesh::CreateFromBoundary(const Mesh &parent,
+                                    const Array<int> &attributes)
+{
+   return SubMesh(parent, From::Boundary, attributes);
+}
+
+SubMesh::SubMesh(const Mesh &parent_, From from_, const Array<int> &attributes,
+                 const Array<int> *vertex_key, const Array<int> *face_count)
+   : parent(&parent_), from(from_)
+{
+   MFEM_VERIFY(parent->Conforming() && !parent->NURBSext,
+               "the parent mesh must be conforming and not NURBS");
+   MFEM_VERIFY(from == From::Domain || parent->Dimension() > 1,
+               "a SubMesh cannot be created from the boundary of a 1D mesh");
+
+   SelectElements(*parent, from, attributes, parent_element_ids);
+   const int ne = parent_element_ids.Size();
+
+   // Find the parent vertices of the SubMesh, ordered by vertex_key.
+   Array<int> v, parent_to_child_vertex(parent->GetNV());
+   parent_to_child_vertex = -1;
+   for (int i = 0; i < ne; i++)
+   {
+      const int pe = parent_element_ids[i];
+      if (from == From::Domain) { parent->GetElementVertices(pe, v); }
+      else { parent->GetBdrElementVertices(pe, v); }
+      for (int j = 0; j < v.Size(); j++) { parent_to_child_vertex[v[j]] = 0; }
+   }
+   Array<Pair<int, int> > vertices;
+   for (int i = 0; i < parent_to_child_vertex.Size(); i++)
+   {
+      if (parent_to_child_vertex[i] < 0) { continue; }
+      vertices.Append(Pair<int, int>(vertex_key ? (*vertex_key)[i] : i, i));
+   }
+   SortPairs<int, int>(vertices, vertices.Size());
+   const int nv = vertices.Size();
+   parent_vertex_ids.SetSize(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      parent_vertex_ids[i] = vertices[i].two;
+      parent_to_child_vertex[vertices[i].two] = i;
+   }
+
+   const int dim = (from == From::Domain) ? parent->Dimension() :
+                   parent->Dimension() - 1;
+   InitMesh(dim, parent->SpaceDimension(), nv, ne, 0);
+
+   for (int i = 0; i < nv; i++)
+   {
+      AddVertex(parent->GetVertex(parent_vertex_ids[i]));
+   }
+
+   // The elements keep the vertex ordering of the parent elements, so that
+   // their local DOFs match the ones of the parent elements.
+   for (int i = 0; i < ne; i++)
+   {
+      const int pe = parent_element_ids[i];
+      const Element *pel = (from == From::Domain) ? parent->GetElement(pe) :
+                           parent->GetBdrElement(pe);
+      Element *el = pel->Duplicate(this);
+      int *ev = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         ev[j] = parent_to_child_vertex[ev[j]];
+      }
+      AddElement(el);
+   }
+
+   Array<int> count;
+   if (!face_count) { CountFaces(*parent, from, parent_element_ids, count); }
+   SetBoundary(parent_element_ids, face_count ? *face_count : count,
+               parent_to_child_vertex);
+
+   FinalizeTopology(false);
+   Finalize(false, false);
+   CheckBdrElementOrientation(true);
+   SetAttributes();
+
+   SetNodes();
+}
+
+void SubMesh::SelectElements(const Mesh &parent, From from,
+                             const Array<int> &attributes,
+                             Array<int> &elements)
+{
+   const int n = (from == From::Domain) ? parent.GetNE() : parent.GetNBE();
+   elements.SetSize(0);
+   for (int i = 0; i < n; i++)
+   {
+      const int attr = (from == From::Domain) ? parent.GetAttribute(i) :
+                       parent.GetBdrAttribute(i);
+      if (attributes.Find(attr) >= 0) { elements.Append(i); }
+   }
+}
+
+void SubMesh::CountFaces(const Mesh &parent, From from,
+                         const Array<int> &elements, Array<int> &count)
+{
+   if (from == From::Domain)
+   {
+      Array<int> selected(parent.GetNE());
+      selected = 0;
+      for (int i = 0; i < elements.Size(); i++) { selected[elements[i]] = 1; }
+
+      count.SetSize(parent.GetNumFaces());
+      for (int f = 0; f < count.Size(); f++)
+      {
+         int e1, e2;
+         parent.GetFaceElements(f, &e1, &e2);
+         count[f] = ((e1 >= 0) ? selected[e1] : 0) +
+                    ((e2 >= 0) ? selected[e2] : 0);
+      }
+   }
+   else
+   {
+      const int pdim = parent.Dimension();
+      count.SetSize((pdim == 3) ? parent.GetNEdges() : parent.GetNV());
+      count = 0;
+      Array<int> faces, ori;
+      for (int i = 0; i < elements.Size(); i++)
+      {
+         if (pdim == 3) { parent.GetBdrElementEdges(elements[i], faces, ori); }
+         else { parent.GetBdrElementVertices(elements[i], faces); }
+         for (int j = 0; j < faces.Size(); j++) { count[faces[j]]++; }
+      }
+   }
+}
+
+void SubMesh::SetBoundary(const Array<int> &elements,
+                          const Array<int> &face_count,
+                          const Array<int> &parent_to_child_vertex)
+{
+   Array<int> local_count, v;
+   CountFaces(*parent, from, elements, local_count);
+
+   // Add a boundary element with the given parent vertices.
+   auto add_boundary = [&](Geometry::Type geom, int attr)
+   {
+      Element *el = NewElement(geom);
+      for (int j = 0; j < v.Size(); j++)
+      {
+         v[j] = parent_to_child_vertex[v[j]];
+      }
+      el->SetVertices(v);
+      el->SetAttribute(attr);
+      AddBdrElement(el);
+   };
+
+   if (from == From::Domain)
+   {
+      // The parent boundary elements adjacent to the SubMesh.
+      Array<int> on_parent_boundary(local_count.Size());
+      on_parent_boundary = 0;
+      for (int i = 0; i < parent->GetNBE(); i++)
+      {
+         const int f = parent->GetBdrElementEdgeIndex(i);
+         if (local_count[f] == 0) { continue; }
+         parent->GetBdrElementVertices(i, v);
+         add_boundary(parent->GetBdrElementGeometry(i),
+                      parent->GetBdrAttribute(i));
+         on_parent_boundary[f] = 1;
+      }
+
+      // The faces on the interface with the rest of the parent mesh.
+      const int attr = parent->bdr_attributes.Size() ?
+                       parent->bdr_attributes.Max() + 1 : 1;
+      for (int f = 0; f < local_count.Size(); f++)
+      {
+         if (local_count[f] != 1 || face_count[f] != 1 ||
+             on_parent_boundary[f]) { continue; }
+         parent->GetFaceVertices(f, v);
+         add_boundary((Dim == 1) ? Geometry::POINT : parent->GetFaceGeometry(f),
+                      attr);
+      }
+   }
+   else
+   {
+      const bool edges = (parent->Dimension() == 3);
+      for (int f = 0; f < local_count.Size(); f++)
+      {
+         if (local_count[f] == 0 || face_count[f] != 1) { continue; }
+         if (edges) { parent->GetEdgeVertices(f, v); }
+         else { v.SetSize(1); v[0] = f; }
+         add_boundary(edges ? Geometry::SEGMENT : Geometry::POINT, 1);
+      }
+   }
+}
+
+void SubMesh::SetNodes()
+{
+   const GridFunction *parent_nodes = parent->GetNodes();
+   if (!parent_nodes) { return; }
+
+   const FiniteElementSpace *parent_fes = parent_nodes->FESpace();
+   const FiniteElementCollection *parent_fec = parent_fes->FEColl();
+   FiniteElementCollection *fec;
+   if (from == From::Domain)
+   {
+      fec = FiniteElementCollection::New(parent_fec->Name());
+   }
+   else
+   {
+      const H1_FECollection *h1_fec =
+         dynamic_cast<const H1_FECollection *>(parent_fec);
+      MFEM_VERIFY(h1_fec, "a SubMesh created from a boundary requires "
+                  "continuous parent nodes");
+      fec = new H1_FECollection(h1_fec->GetOrder(), Dim,
+                                h1_fec->GetBasisType());
+   }
+   FiniteElementSpace *fes =
+      new FiniteElementSpace(this, fec, spaceDim, parent_fes->GetOrdering());
+   SetNodalFESpace(fes);
+   Nodes->MakeOwner(fec);
+
+   TransferMap(*parent_fes, *fes).Transfer(*parent_nodes, *Nodes);
+}
+
+void SubMesh::Transfer(const GridFunction &src, GridFunction &dst)
+{
+   TransferMap(*src.FESpace(), *dst.FESpace()).Transfer(src, dst);
+}
+
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SUBMESH
+#define MFEM_SUBMESH
+
+#include "../config/config.hpp"
+#include "mesh.hpp"
+
+namespace mfem
+{
+
+class GridFunction;
+
+/** @brief A mesh made of a subset of the elements, or of the boundary
+    elements, of a parent Mesh.
+
+    A SubMesh is created from the elements of the parent mesh with the given
+    attributes, see CreateFromDomain(), or from the boundary elements of the
+    parent mesh with the given boundary attributes, see CreateFromBoundary().
+    It keeps the map from its elements and vertices to the ones of the parent
+    mesh, which is used by TransferMap to transfer GridFunctions between the
+    SubMesh and its parent.
+
+    The elements of a SubMesh have the same vertex ordering as the elements of
+    the parent mesh they are made of, and its vertices are numbered in the
+    order of the parent vertices, so e.g. a SubMesh of a tetrahedral mesh fixed
+    with ReorientTetMesh() supports Nedelec spaces of any order. The boundary of a SubMesh created from a
+    domain consists of the parent boundary elements adjacent to the SubMesh,
+    which keep their attribute, and of the parent faces on the interface with
+    the rest of the domain, which get the attribute one plus the maximum parent
+    boundary attribute. The boundary of a SubMesh created from a boundary has
+    the attribute 1.
+
+    Curved parent meshes are supported: the nodes of the SubMesh are copied
+    from the ones of the parent mesh. Nonconforming and NURBS meshes are not
+    supported. */
+class SubMesh : public Mesh
+{
+public:
+   /// The kind of parent entities a SubMesh is made of.
+   enum class From
+   {
+      Domain,  ///< The SubMesh is made of parent elements.
+      Boundary ///< The SubMesh is made of parent boundary elements.
+   };
+
+   /** @brief Create a SubMesh from the elements of @a parent whose attribute is
+       in @a attributes. */
+   static SubMesh CreateFromDomain(const Mesh &parent,
+                                   const Array<int> &attributes);
+
+   /** @brief Create a SubMesh, of dimension one less than @a parent, from the
+       boundary elements of @a parent whose attribute is in @a attributes. */
+   static SubMesh CreateFromBoundary(const Mesh &parent,
+                                     const Array<int> &attributes);
+
+   /// Return the parent mesh.
+   const Mesh *GetParent() const { return parent; }
+
+   /// Return the kind of parent entities the SubMesh is made of.
+   From GetFrom() const { return from; }
+
+   /** @brief Return the map from the elements of the SubMesh to the elements,
+       or the boundary elements, of the parent mesh. */
+   const Array<int> &GetParentElementIDMap() const
+   { return parent_element_ids; }
+
+   /// Return the map from the vertices of the SubMesh to the parent vertices.
+   const Array<int> &GetParentVertexIDMap() const
+   { return parent_vertex_ids; }
+
+   /** @brief Transfer the GridFunction @a src, defined on a SubMesh or on its
+       parent, to the GridFunction @a dst, defined on the other mesh. */
+   /** The transfer map is built on every call: use TransferMap to transfer
+       GridFunctions between the same spaces several times. */
+   static void Transfer(const GridFunction &src, GridFunction &dst);
+
+protected:
+   const Mesh *parent;
+   From from;
+
+   Array<int> parent_element_ids;
+   Array<int> parent_vertex_ids;
+
+   /** @brief Create the SubMesh of @a parent made of the entities given by
+       @a from, with the given @a attributes. */
+   /** The vertices of the SubMesh are ordered by the increasing values of
+       @a vertex_key on the parent vertices, by default their indices. The
+       array @a face_count contains the number of SubMesh elements adjacent to
+       the parent entities that are faces of the SubMesh, see CountFaces(); by
+       default, it is computed with CountFaces(). */
+   SubMesh(const Mesh &parent, From from, const Array<int> &attributes,
+           const Array<int> *vertex_key = NULL,
+           const Array<int> *face_count = NULL);
+
+   /** @brief Return in @a elements the parent elements, or boundary elements,
+       with the given @a attributes. */
+   static void SelectElements(const Mesh &parent, From from,
+                              const Array<int> &attributes,
+                              Array<int> &elements);
+
+   /** @brief Return in @a count the number of the parent @a elements adjacent
+       to each of the parent entities that are the faces of a SubMesh. */
+   /** These entities are the parent faces for a SubMesh created from a domain
+       and, for a SubMesh created from a boundary, the parent edges in 3D and
+       the parent vertices in 2D. */
+   static void CountFaces(const Mesh &parent, From from,
+                          const Array<int> &elements, Array<int> &count);
+
+   void SetBoundary(const Array<int> &elements, const Array<int> &face_count,
+                    const Array<int> &parent_to_child_vertex);
+
+   void SetNodes();
+
+   friend class ParSubMesh;
+};
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+//                  MFEM Mixed Precision Preconditioners Benchmark
+//
+// Compile with: make mixed-precision
+//
+// Sample runs:  mixed-precision
+//               mixed-precision -m ../../data/inline-quad.mesh -r 5 -o 2
+//               mixed-precision -m ../../data/inline-hex.mesh -r 3 -o 3
+//
+// Description:  This miniapp compares the preconditioned conjugate gradient
+//               solution of a Poisson problem, with the matrix and the
+//               smoothers stored in double precision, and with smoothers that
+//               use a single precision copy of the matrix entries and of the
+//               inverse diagonal (see SetSinglePrecision()). In both cases the
+//               vectors, the accumulations and the CG iteration are in double
+//               precision, so the outer solver corrects the perturbation of the
+//               preconditioner and reaches the same tolerance, as in iterative
+//               refinement. For each smoother, we report the number of CG
+//               iterations, the time to solution, the estimated number of
+//               bytes read from the matrix and the inverse diagonal in one
+//               application of the preconditioner, and the difference between
+//               the double and the mixed precision solutions.
+
+#include "mfem.hpp"
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+// Bytes of the CSR arrays read by one sweep over a matrix with n rows and nnz
+// entries of size val_size.
+static double SweepBytes(int n, int nnz, int val_size)
+{
+   return double(nnz)*(val_size + sizeof(int)) + double(n + 1)*sizeof(int);
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/inline-hex.mesh";
+   int ref_levels = 2;
+   int order = 2;
+   double rel_tol = 1e-12;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of times to refine the mesh uniformly.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&rel_tol, "-tol", "--rel-tol",
+                  "Relative tolerance of the CG solver.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh, define the H1 finite element space and
+   //    assemble the Poisson problem with homogeneous Dirichlet conditions.
+   Mesh mesh(mesh_file, 1, 1);
+   const int dim = mesh.Dimension();
+   for (int l = 0; l < ref_levels; l++) { mesh.UniformRefinement(); }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fespace);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   BilinearForm a(&fespace);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+
+   GridFunction x(&fespace);
+   x = 0.0;
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   const int n = A.Height(), nnz = A.NumNonZeroElems();
+   cout << "Number of finite element unknowns: " << n << '\n'
+        << "Number of matrix entries: " << nnz << endl;
+
+   Vector diag;
+   A.GetDiag(diag);
+
+   // 3. Solve with each smoother as the preconditioner of CG, in double and in
+   //    mixed precision, and compare the iterations, times and solutions.
+   const char *names[] = { "GSSmoother", "DSmoother", "Jacobi", "Chebyshev" };
+   // Number of sweeps over the matrix in one application of each smoother.
+   const int sweeps[] = { 2, 3, 0, 2 };
+   cout << setw(12) << "smoother" << setw(8) << "prec" << setw(8) << "iter"
+        << setw(12) << "time (s)" << setw(14) << "bytes/apply"
+        << setw(14) << "difference" << endl;
+   for (int s = 0; s < 4; s++)
+   {
+      Vector X_double;
+      for (int sp = 0; sp < 2; sp++)
+      {
+         Solver *prec = NULL;
+         switch (s)
+         {
+            case 0:
+            {
+               GSSmoother *gs = new GSSmoother(A);
+               gs->SetSinglePrecision(sp);
+               prec = gs;
+               break;
+            }
+            case 1:
+            {
+               DSmoother *ds = new DSmoother(A, 0, 2.0/3.0, sweeps[s]);
+               ds->SetSinglePrecision(sp);
+               prec = ds;
+               break;
+            }
+            case 2:
+            {
+               OperatorJacobiSmoother *jac =
+                  new OperatorJacobiSmoother(diag, ess_tdof_list);
+               jac->SetOperator(A);
+               jac->SetSinglePrecision(sp);
+               prec = jac;
+               break;
+            }
+            case 3:
+            {
+               OperatorChebyshevSmoother *cheb =
+                  new OperatorChebyshevSmoother(A, diag, ess_tdof_list, 3);
+               cheb->SetSinglePrecision(sp);
+               prec = cheb;
+               break;
+            }
+         }
+
+         const int val_size = sp ? sizeof(float) : sizeof(double);
+         const double bytes =
+            sweeps[s]*SweepBytes(n, nnz, val_size) + (s >= 2 ? n*val_size : 0);
+
+         CGSolver cg;
+         cg.SetRelTol(rel_tol);
+         cg.SetMaxIter(2000);
+         cg.SetOperator(A);
+         cg.SetPreconditioner(*prec);
+         X = 0.0;
+         StopWatch sw;
+         sw.Start();
+         cg.Mult(B, X);
+         sw.Stop();
+
+         double difference = 0.0;
+         if (sp == 0) { X_double = X; }
+         else
+         {
+            Vector dX(X);
+            dX -= X_double;
+            difference = dX.Normlinf() / X_double.Normlinf();
+         }
+         cout << setw(12) << names[s] << setw(8) << (sp ? "mixed" : "double")
+              << setw(8) << cg.GetNumIterations()
+              << setw(12) << sw.RealTime() << setw(14) << bytes
+              << setw(14) << difference << endl;
+         delete prec;
+         if (!cg.GetConverged() || difference > 1e3*rel_tol) { return 2; }
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,173 @@
+//                MFEM Nonconforming Mesh Refinement Benchmark
+//
+// Compile with: make ncmesh-refine
+//
+// Sample runs:  ncmesh-refine
+//               ncmesh-refine -d 2 -n 64 -r 5
+//               ncmesh-refine -d 3 -n 16 -r 3 -f 0.5
+//
+// Description:  This miniapp measures the throughput of the refinement and the
+//               derefinement of a nonconforming mesh (NCMesh), in millions of
+//               elements per second. Starting from a Cartesian mesh, a fraction
+//               of the leaf elements is refined at each level, then all the
+//               levels are derefined, one at a time. The refinements access the
+//               nodes and the faces of the NCMesh through their parents,
+//               millions of times on large meshes. The miniapp also compares
+//               the throughput of the two containers that support such
+//               accesses: HashTable, based on chaining, and OpenHashTable,
+//               based on open addressing, which NCMesh uses.
+
+#include "mfem.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+struct Edge : public Hashed2 { int refc; };
+
+// Create the mid-edge items of an n x n grid of vertices, as in a uniform
+// refinement, look them up in random order, and delete them. Print the number
+// of millions of operations per second of each phase.
+template <typename Table>
+void BenchmarkTable(const char *name, int n, const Array<int> &order)
+{
+   Table table;
+   const int nv = n*n;
+   StopWatch sw;
+
+   sw.Start();
+   for (int i = 0; i < nv; i++)
+   {
+      if ((i+1) % n) { table.Get(i, i+1)->refc = 1; }
+      if (i+n < nv) { table.Get(i, i+n)->refc = 1; }
+   }
+   sw.Stop();
+   const int ne = table.Size();
+   const double t_get = sw.RealTime();
+
+   sw.Clear();
+   sw.Start();
+   int found = 0;
+   for (int k = 0; k < order.Size(); k++)
+   {
+      const int i = order[k];
+      found += (table.FindId(i+1, i) >= 0);
+      found += (table.FindId(i+n, i) >= 0);
+   }
+   sw.Stop();
+   const double t_find = sw.RealTime();
+   MFEM_VERIFY(found == ne, "invalid number of edges found");
+
+   sw.Clear();
+   sw.Start();
+   for (int k = 0; k < order.Size(); k++)
+   {
+      const int i = order[k];
+      int id = table.FindId(i, i+1);
+      if (id >= 0) { table.Delete(id); }
+      id = table.FindId(i, i+n);
+      if (id >= 0) { table.Delete(id); }
+   }
+   sw.Stop();
+   const double t_delete = sw.RealTime();
+   MFEM_VERIFY(table.Size() == 0, "invalid number of edges deleted");
+
+   cout << setw(15) << left << name << right << fixed << setprecision(2)
+        << setw(10) << 1e-6*ne/t_get
+        << setw(10) << 1e-6*2*order.Size()/t_find
+        << setw(10) << 1e-6*ne/t_delete << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int dim = 2;
+   int nx = 16;
+   int ref_levels = 4;
+   double fraction = 1.0;
+   int table_size = 1000;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&dim, "-d", "--dimension",
+                  "Dimension of the Cartesian mesh: 2 or 3.");
+   args.AddOption(&nx, "-n", "--elements",
+                  "Number of elements of the initial mesh in each direction.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of levels of refinement.");
+   args.AddOption(&fraction, "-f", "--fraction",
+                  "Fraction of the leaf elements refined at each level.");
+   args.AddOption(&table_size, "-t", "--table-size",
+                  "Size of the grid of vertices of the HashTable benchmark.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Compare the containers on the lookups of a uniform refinement.
+   Array<int> order(table_size*table_size);
+   for (int i = 0; i < order.Size(); i++) { order[i] = i; }
+   srand(1);
+   for (int i = order.Size()-1; i > 0; i--)
+   {
+      std::swap(order[i], order[rand() % (i+1)]);
+   }
+   cout << "\nMillions of operations per second:\n"
+        << setw(15) << left << "Container" << right << setw(10) << "Get"
+        << setw(10) << "Find" << setw(10) << "Delete" << endl;
+   BenchmarkTable<HashTable<Edge> >("HashTable", table_size, order);
+   BenchmarkTable<OpenHashTable<Edge> >("OpenHashTable", table_size, order);
+
+   // 3. Create the initial Cartesian mesh and its NCMesh.
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(nx, nx, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(nx, nx, nx, Element::HEXAHEDRON);
+   NCMesh ncmesh(&mesh);
+
+   // 4. Refine a random fraction of the leaf elements at each level. Forced
+   //    refinements may be needed to keep the mesh valid.
+   cout << "\nMillions of elements per second:\n"
+        << setw(8) << "Level" << setw(12) << "Elements"
+        << setw(10) << "Refine" << endl;
+   StopWatch sw;
+   for (int l = 0; l < ref_levels; l++)
+   {
+      const int ne = ncmesh.GetNElements();
+      Array<Refinement> refs;
+      for (int i = 0; i < ne; i++)
+      {
+         if (rand() < fraction*(RAND_MAX + 1.0)) { refs.Append(Refinement(i)); }
+      }
+      sw.Clear();
+      sw.Start();
+      ncmesh.Refine(refs);
+      sw.Stop();
+      const int new_ne = ncmesh.GetNElements();
+      cout << setw(8) << l+1 << setw(12) << new_ne << setw(10)
+           << 1e-6*(new_ne - ne)/sw.RealTime() << endl;
+   }
+
+   // 5. Derefine all the possible elements, one level at a time.
+   cout << '\n' << setw(8) << "Level" << setw(12) << "Elements"
+        << setw(10) << "Derefine" << endl;
+   for (int l = ref_levels; l > 0; l--)
+   {
+      const int ne = ncmesh.GetNElements();
+      sw.Clear();
+      sw.Start();
+      const Table &derefs = ncmesh.GetDerefinementTable();
+      Array<int> rows(derefs.Size());
+      for (int i = 0; i < rows.Size(); i++) { rows[i] = i; }
+      ncmesh.Derefine(rows);
+      sw.Stop();
+      const int new_ne = ncmesh.GetNElements();
+      cout << setw(8) << l-1 << setw(12) << new_ne << setw(10)
+           << 1e-6*(ne - new_ne)/sw.RealTime() << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,125 @@
+//                  MFEM Partial Assembly Kernels Benchmark
+//
+// Compile with: make pa-kernels
+//
+// Sample runs:  pa-kernels -d cpu
+//               pa-kernels -d simd-cpu
+//               pa-kernels -m ../../data/inline-quad.mesh -o 5 -d simd-cpu
+//               pa-kernels -m ../../data/inline-hex.mesh -r 3 -o 2 -d cpu
+//
+// Description:  This miniapp measures the throughput of the partially assembled
+//               mass, diffusion and convection operators, in millions of
+//               degrees of freedom per second, on the given device. Running it
+//               with '-d cpu' and with '-d simd-cpu' compares the default CPU
+//               kernels, which process one element at a time, with the kernels
+//               of the 'simd-cpu' backend, which process groups of elements
+//               interleaved in the lanes of SIMD registers. The timings only
+//               include the element kernels, applied to E-vectors. The result
+//               of each operator is checked against its fully assembled
+//               version.
+
+#include "mfem.hpp"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+static BilinearFormIntegrator *NewIntegrator(const char *name,
+                                             VectorCoefficient &velocity)
+{
+   if (!strcmp(name, "mass")) { return new MassIntegrator; }
+   if (!strcmp(name, "diffusion")) { return new DiffusionIntegrator; }
+   return new ConvectionIntegrator(velocity);
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/inline-hex.mesh";
+   int ref_levels = 2;
+   int order = 3;
+   int max_iter = 50;
+   const char *device_config = "cpu";
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of times to refine the mesh uniformly.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&max_iter, "-n", "--iterations",
+                  "Number of operator applications to time.");
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Enable hardware devices such as GPUs, and programming models such as
+   //    CUDA, OCCA, RAJA and OpenMP based on command line options.
+   Device device(device_config);
+   device.Print();
+
+   // 3. Read and refine the mesh, and define the H1 finite element space.
+   Mesh mesh(mesh_file, 1, 1);
+   const int dim = mesh.Dimension();
+   for (int l = 0; l < ref_levels; l++) { mesh.UniformRefinement(); }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+   cout << "Number of elements: " << mesh.GetNE() << '\n'
+        << "Number of finite element unknowns: " << fespace.GetTrueVSize()
+        << endl;
+
+   const Operator *R =
+      fespace.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   Vector x(fespace.GetVSize()), x_e(R->Height()), y_e(R->Height());
+   x.Randomize(1);
+   R->Mult(x, x_e);
+
+   // 4. For each integrator, time the partially assembled element kernels and
+   //    check the partially assembled operator against the full assembly.
+   Vector v(dim);
+   for (int d = 0; d < dim; d++) { v(d) = 1.0 + d; }
+   VectorConstantCoefficient velocity(v);
+   const char *names[] = { "mass", "diffusion", "convection" };
+   for (const char *name : names)
+   {
+      BilinearFormIntegrator *integ = NewIntegrator(name, velocity);
+      integ->AssemblePA(fespace);
+      y_e = 0.0;
+      integ->AddMultPA(x_e, y_e);
+      StopWatch sw;
+      sw.Start();
+      for (int i = 0; i < max_iter; i++) { integ->AddMultPA(x_e, y_e); }
+      y_e.HostRead();
+      sw.Stop();
+      const double mdofs = 1e-6 * x_e.Size() * max_iter / sw.RealTime();
+
+      BilinearForm a_pa(&fespace), a_fa(&fespace);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_pa.AddDomainIntegrator(NewIntegrator(name, velocity));
+      a_fa.AddDomainIntegrator(NewIntegrator(name, velocity));
+      a_pa.Assemble();
+      a_fa.Assemble();
+      a_fa.Finalize();
+      Vector y_pa(x.Size()), y_fa(x.Size());
+      a_pa.Mult(x, y_pa);
+      a_fa.Mult(x, y_fa);
+      y_pa -= y_fa;
+      const double error = y_pa.Normlinf() / y_fa.Normlinf();
+
+      cout << setw(12) << name << ": " << mdofs << " MDof/s (E-vector), "
+           << "relative error " << error << endl;
+      delete integ;
+      if (error > 1e-10) { return 2; }
+   }
+
+   return 0;
+}
@@ -147,4 +147,77 @@ TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    }
 } // test case
 
+static double mixed_coeff(const Vector &x) { return 1.0 + x(0)*x(0); }
+
+void test_pa_mixed_mesh(const char *meshname, int order, bool dg, int pb)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", DG=" << dg
+        << ", pb=" << pb);
+   Mesh mesh(meshname, 1, 1);
+   const int dim = mesh.Dimension();
+
+   FiniteElementCollection *fec;
+   if (dg)
+   {
+      fec = new L2_FECollection(order, dim, BasisType::GaussLobatto);
+   }
+   else
+   {
+      fec = new H1_FECollection(order, dim);
+   }
+   FiniteElementSpace fespace(&mesh, fec);
+
+   BilinearForm k_ref(&fespace), k_test(&fespace);
+   FunctionCoefficient coeff(mixed_coeff);
+   if (pb == 0)
+   {
+      k_ref.AddDomainIntegrator(new MassIntegrator(coeff));
+      k_test.AddDomainIntegrator(new MassIntegrator(coeff));
+   }
+   else
+   {
+      k_ref.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      k_test.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   }
+   k_ref.Assemble();
+   k_ref.Finalize();
+   k_test.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_test.Assemble();
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+   x.Randomize(1);
+   k_ref.Mult(x, y_ref);
+   k_test.Mult(x, y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Normlinf() < 1.e-12 * y_ref.Normlinf());
+
+   Vector diag_ref(fespace.GetVSize()), diag_test(fespace.GetVSize());
+   k_ref.SpMat().GetDiag(diag_ref);
+   k_test.AssembleDiagonal(diag_test);
+   diag_test -= diag_ref;
+   REQUIRE(diag_test.Normlinf() < 1.e-12 * diag_ref.Normlinf());
+
+   delete fec;
+}
+
+TEST_CASE("PA Mixed Meshes", "[AssemblyLevel], [PartialAssembly]")
+{
+   auto pb = GENERATE(0, 1);
+   auto order = GENERATE(1, 2, 3);
+
+   SECTION("2D")
+   {
+      test_pa_mixed_mesh("../../data/star-mixed.mesh", order, false, pb);
+      test_pa_mixed_mesh("../../data/star-mixed-p2.mesh", order, false, pb);
+      test_pa_mixed_mesh("../../data/square-mixed.mesh", order, true, 0);
+      test_pa_mixed_mesh("../../data/star.mesh", order, false, pb);
+   }
+
+   SECTION("3D")
+   {
+      test_pa_mixed_mesh("../../data/fichera-mixed.mesh", order, false, pb);
+      test_pa_mixed_mesh("../../data/escher.mesh", order, false, pb);
+   }
+} // test case
+
 } // namespace pa_kernels
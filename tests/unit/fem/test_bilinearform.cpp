@@ -142,3 +142,61 @@ TEST_CASE("FormLinearSystem/SolutionScope",
       REQUIRE(AsConst(sol)(bdr_dof) == 0.0);
    }
 }
+
+TEST_CASE("Threaded legacy assembly", "[BilinearForm]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(4, 3, Element::QUADRILATERAL);
+   mesh.GetElement(0)->SetAttribute(2);
+   mesh.SetAttributes();
+   const int order = 2, dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+
+   ConstantCoefficient one(1.0);
+   ConstantCoefficient two(2.0);
+   Array<int> attr(2); attr = 0; attr[1] = 1;
+
+   for (int vdim = 1; vdim <= dim; vdim++)
+   {
+      FiniteElementSpace fes(&mesh, &fec, vdim);
+      for (int mode = 0; mode < 3; mode++)
+      {
+         BilinearForm a(&fes), b(&fes);
+         for (int k = 0; k < 2; k++)
+         {
+            BilinearForm &f = k ? b : a;
+            if (vdim == 1)
+            {
+               f.AddDomainIntegrator(new DiffusionIntegrator(one));
+               f.AddDomainIntegrator(new MassIntegrator(two), attr);
+               f.AddBoundaryIntegrator(new MassIntegrator(one));
+            }
+            else
+            {
+               f.AddDomainIntegrator(new ElasticityIntegrator(one, two));
+               f.AddDomainIntegrator(new VectorMassIntegrator(two), attr);
+               f.AddBoundaryIntegrator(new VectorMassIntegrator(one));
+            }
+         }
+         if (mode > 0) { b.EnableThreadedAssembly(mode == 1); }
+         a.Assemble(0);
+         a.Finalize(0);
+         b.Assemble(0);
+         b.Finalize(0);
+
+         SparseMatrix *diff = Add(1.0, a.SpMat(), -1.0, b.SpMat());
+         REQUIRE(diff->MaxNorm() == MFEM_Approx(0.0));
+         delete diff;
+
+         if (mode == 1)
+         {
+            // Re-assembling in the deterministic mode gives the same values
+            Vector vals(b.SpMat().GetData(), b.SpMat().NumNonZeroElems());
+            Vector vals0(vals);
+            b = 0.0;
+            b.Assemble(0);
+            vals -= vals0;
+            REQUIRE(vals.Normlinf() == 0.0);
+         }
+      }
+   }
+}
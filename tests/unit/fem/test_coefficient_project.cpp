@@ -0,0 +1,209 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace coefficient_project
+{
+
+static double f_scalar(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += (d + 1)*x(d)*x(d); }
+   return s;
+}
+
+static double f_scalar_td(const Vector &x, double t)
+{
+   return t*f_scalar(x);
+}
+
+static void f_vector(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++)
+   {
+      v(d) = sin(x(0) + d) + x(d % x.Size());
+   }
+}
+
+static void f_matrix(const Vector &x, DenseMatrix &M)
+{
+   for (int i = 0; i < M.Height(); i++)
+   {
+      for (int j = 0; j < M.Width(); j++)
+      {
+         M(i,j) = x(i % x.Size()) + 2.0*j + i*x(j % x.Size());
+      }
+   }
+}
+
+static double Difference(const Vector &a, const Vector &b)
+{
+   Vector d(a);
+   d -= b;
+   return d.Normlinf();
+}
+
+static void TestProject(Mesh &mesh, int order)
+{
+   const int dim = mesh.Dimension();
+   const int sdim = mesh.SpaceDimension();
+   QuadratureSpace qs(&mesh, order);
+   QuadratureFunction qf(&qs), qf_ref(&qs);
+
+   Vector pw(mesh.attributes.Max());
+   for (int i = 0; i < pw.Size(); i++) { pw(i) = i + 1.5; }
+
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec, sdim);
+   GridFunction gf(&fes);
+   VectorFunctionCoefficient gf_coeff(sdim, f_vector);
+   gf.ProjectCoefficient(gf_coeff);
+
+   ConstantCoefficient c_coeff(2.5);
+   PWConstCoefficient pw_coeff(pw);
+   FunctionCoefficient f_coeff(f_scalar);
+   FunctionCoefficient td_coeff(f_scalar_td);
+   td_coeff.SetTime(0.5);
+   GridFunctionCoefficient g_coeff(&gf, 2);
+   Coefficient *scalar_coeffs[] =
+   { &c_coeff, &pw_coeff, &f_coeff, &td_coeff, &g_coeff };
+
+   for (Coefficient *coeff : scalar_coeffs)
+   {
+      coeff->Project(qf);
+      coeff->Coefficient::Project(qf_ref);
+      REQUIRE(Difference(qf, qf_ref) == MFEM_Approx(0.0, 1e-12));
+   }
+
+   Vector v(3);
+   v(0) = 1.0; v(1) = -2.0; v(2) = 0.5;
+   VectorConstantCoefficient vc_coeff(v);
+   VectorFunctionCoefficient vf_coeff(3, f_vector, &f_coeff);
+   VectorGridFunctionCoefficient vg_coeff(&gf);
+   VectorCoefficient *vector_coeffs[] = { &vc_coeff, &vf_coeff, &vg_coeff };
+
+   for (VectorCoefficient *coeff : vector_coeffs)
+   {
+      QuadratureFunction vqf(&qs, coeff->GetVDim());
+      QuadratureFunction vqf_ref(&qs, coeff->GetVDim());
+      coeff->Project(vqf);
+      coeff->VectorCoefficient::Project(vqf_ref);
+      REQUIRE(Difference(vqf, vqf_ref) == MFEM_Approx(0.0, 1e-12));
+   }
+
+   DenseMatrix M(2, 3);
+   f_matrix(v, M);
+   MatrixConstantCoefficient mc_coeff(M);
+   MatrixFunctionCoefficient mf_coeff(dim, f_matrix, &pw_coeff);
+   MatrixCoefficient *matrix_coeffs[] = { &mc_coeff, &mf_coeff };
+
+   for (MatrixCoefficient *coeff : matrix_coeffs)
+   {
+      for (bool transpose : { false, true })
+      {
+         const int vdim = coeff->GetHeight()*coeff->GetWidth();
+         QuadratureFunction mqf(&qs, vdim), mqf_ref(&qs, vdim);
+         coeff->Project(mqf, transpose);
+         coeff->MatrixCoefficient::Project(mqf_ref, transpose);
+         REQUIRE(Difference(mqf, mqf_ref) == MFEM_Approx(0.0, 1e-12));
+      }
+   }
+}
+
+// Compare Project on the points of the elements with geometry geom only, as
+// used by the partial assembly of mixed meshes, with the base class Project.
+static void TestProjectGeometry(Mesh &mesh, int order, Geometry::Type geom)
+{
+   const IntegrationRule &ir = IntRules.Get(geom, order);
+   QuadratureSpace qs(&mesh, ir, geom);
+   QuadratureFunction qf(&qs), qf_ref(&qs);
+   Array<int> elems;
+   mesh.GetGeometryElements(geom, elems);
+   REQUIRE(qf.Size() == ir.GetNPoints()*elems.Size());
+
+   FunctionCoefficient f_coeff(f_scalar);
+   f_coeff.Project(qf);
+   f_coeff.Coefficient::Project(qf_ref);
+   REQUIRE(Difference(qf, qf_ref) == MFEM_Approx(0.0, 1e-12));
+
+   // QuadratureFunctionCoefficient on the space of all elements
+   QuadratureSpace qs_all(&mesh, order);
+   QuadratureFunction qf_all(&qs_all);
+   f_coeff.Project(qf_all);
+   QuadratureFunctionCoefficient qf_coeff(qf_all);
+   qf_coeff.Project(qf);
+   qf_coeff.Coefficient::Project(qf_ref);
+   REQUIRE(Difference(qf, qf_ref) == MFEM_Approx(0.0, 1e-12));
+}
+
+TEST_CASE("Coefficient Project", "[Coefficient][QuadratureFunction]")
+{
+   const int order = GENERATE(2, 5);
+
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL, true,
+                                        1.0, 2.0);
+      mesh.SetAttribute(1, 2);
+      mesh.SetAttributes();
+      TestProject(mesh, order);
+      mesh.SetCurvature(3);
+      TestProject(mesh, order);
+   }
+
+   SECTION("Triangles")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(2, 2, Element::TRIANGLE);
+      mesh.EnsureNodes();
+      TestProject(mesh, order);
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+      mesh.SetCurvature(2);
+      TestProject(mesh, order);
+   }
+
+   SECTION("Mixed mesh")
+   {
+      Mesh mesh("../../data/star-mixed.mesh");
+      mesh.EnsureNodes();
+      TestProject(mesh, order);
+      TestProjectGeometry(mesh, order, Geometry::TRIANGLE);
+      TestProjectGeometry(mesh, order, Geometry::SQUARE);
+   }
+
+   SECTION("Moved mesh")
+   {
+      // The coordinates of the quadrature points are cached by the mesh and
+      // must be updated when the nodes move.
+      Mesh mesh = Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL);
+      mesh.SetCurvature(2);
+      QuadratureSpace qs(&mesh, order);
+      QuadratureFunction qf(&qs), qf_ref(&qs);
+      FunctionCoefficient f_coeff(f_scalar);
+      f_coeff.Project(qf);
+
+      Vector displacements(mesh.GetNodes()->Size());
+      displacements = 0.25;
+      mesh.MoveNodes(displacements);
+      f_coeff.Project(qf);
+      f_coeff.Coefficient::Project(qf_ref);
+      REQUIRE(Difference(qf, qf_ref) == MFEM_Approx(0.0, 1e-12));
+   }
+}
+
+} // namespace coefficient_project
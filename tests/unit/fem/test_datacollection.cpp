@@ -11,6 +11,7 @@
 
 #include "mfem.hpp"
 #include "unit_tests.hpp"
+#include "general/text.hpp"
 #include "general/tinyxml2.h"
 #include <stdio.h>
 
@@ -144,6 +145,68 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 
+      SECTION("Binary MFEM format")
+      {
+         std::cout<<"Testing binary MFEM format"<<std::endl;
+
+         VisItDataCollection dc("base", &mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.RegisterQField("qs",qs);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+         dc.SetPadDigits(5);
+         dc.SetFormat(DataCollection::BINARY_FORMAT);
+         dc.Save();
+         REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+         // The root file records that the mesh files contain serial data
+         {
+            std::ifstream root_file("base_00005.mfem_root");
+            std::stringstream root;
+            root << root_file.rdbuf();
+            REQUIRE(root.str().find("\"parallel\": false") != std::string::npos);
+         }
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigits(5);
+         dc_new.Load(dc.GetCycle());
+         REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+         Mesh *mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         QuadratureFunction *qs_new = dc_new.GetQField("qs");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(qs_new);
+         REQUIRE(dc.GetTime() == dc_new.GetTime());
+
+         REQUIRE(mesh.GetNE() == mesh_new->GetNE());
+         REQUIRE(mesh.GetNBE() == mesh_new->GetNBE());
+         Vector vert, vert_diff;
+         mesh.GetVertices(vert);
+         mesh_new->GetVertices(vert_diff);
+         vert_diff -= vert;
+         REQUIRE(vert_diff.Normlinf() == 0.0);
+
+         Vector u_diff(*u_new), v_diff(*v_new), qs_diff(*qs_new);
+         u_diff -= *u;
+         v_diff -= *v;
+         qs_diff -= *qs;
+         REQUIRE(u_diff.Normlinf() == 0.0);
+         REQUIRE(v_diff.Normlinf() == 0.0);
+         REQUIRE(qs_diff.Normlinf() < 1e-10);
+
+         // Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(remove("base_00005/qs.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+
 #ifdef MFEM_USE_ZLIB
       SECTION("Compressed MFEM format")
       {
@@ -319,3 +382,56 @@ TEST_CASE("ParaView restart mode", "[ParaView]")
    REQUIRE(remove("ParaView/ParaView.pvd") == 0);
    REQUIRE(rmdir("ParaView") == 0);
 }
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Save and load binary parallel VisIt collections",
+          "[DataCollection], [Parallel]")
+{
+   int num_procs, myid;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+   // On one rank, the collection must still be reloaded as a ParMesh
+   Mesh mesh = Mesh::MakeCartesian2D(4, 3, Element::QUADRILATERAL);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, pmesh.Dimension());
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   ParGridFunction u(&pfes);
+   for (int i = 0; i < u.Size(); i++) { u(i) = double(i); }
+
+   VisItDataCollection dc("pbase", &pmesh);
+   dc.RegisterField("u", &u);
+   dc.SetCycle(3);
+   dc.SetFormat(DataCollection::BINARY_FORMAT);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   VisItDataCollection dc_new(MPI_COMM_WORLD, "pbase");
+   dc_new.Load(dc.GetCycle());
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   ParMesh *pmesh_new = dynamic_cast<ParMesh*>(dc_new.GetMesh());
+   REQUIRE(pmesh_new);
+   REQUIRE(pmesh_new->GetGlobalNE() == pmesh.GetGlobalNE());
+   REQUIRE(pmesh_new->GetNSharedFaces() == pmesh.GetNSharedFaces());
+   ParGridFunction *u_new = dynamic_cast<ParGridFunction*>(dc_new.GetField("u"));
+   REQUIRE(u_new);
+   Vector u_diff(*u_new);
+   u_diff -= u;
+   REQUIRE(u_diff.Normlinf() == 0.0);
+
+   // Cleanup all the files
+   MPI_Barrier(MPI_COMM_WORLD);
+   std::string rank_ext = "." + to_padded_string(myid, 6);
+   REQUIRE(remove(("pbase_000003/mesh" + rank_ext).c_str()) == 0);
+   REQUIRE(remove(("pbase_000003/u" + rank_ext).c_str()) == 0);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (myid == 0)
+   {
+      REQUIRE(remove("pbase_000003.mfem_root") == 0);
+      REQUIRE(rmdir("pbase_000003") == 0);
+   }
+}
+
+#endif // MFEM_USE_MPI
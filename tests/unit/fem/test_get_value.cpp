@@ -4978,4 +4978,68 @@ TEST_CASE("3D GetDivergence",
              << npts << " 3D points" << std::endl;
 }
 
+TEST_CASE("GetValues at physical points",
+          "[GridFunction]")
+{
+   const int dim = GENERATE(2, 3);
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(6, 5, Element::TRIANGLE, true) :
+               Mesh::MakeCartesian3D(4, 3, 5, Element::HEXAHEDRON);
+
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FiniteElementSpace vfes(&mesh, &fec, dim);
+   GridFunction u(&fes), v(&vfes);
+   double (*u_func)(const Vector&) = (dim == 2) ? func_2D_quad : func_3D_quad;
+   void (*v_func)(const Vector&, Vector&) =
+      (dim == 2) ? Func_2D_quad : Func_3D_quad;
+   FunctionCoefficient u_coeff(u_func);
+   VectorFunctionCoefficient v_coeff(dim, v_func);
+   u.ProjectCoefficient(u_coeff);
+   v.ProjectCoefficient(v_coeff);
+
+   // Points inside the unit cube, and one point outside of the mesh
+   const int npts = 40;
+   DenseMatrix pts(dim, npts);
+   Vector rnd(dim*npts);
+   rnd.Randomize(1);
+   for (int j = 0; j < npts; j++)
+   {
+      for (int d = 0; d < dim; d++) { pts(d,j) = 0.05 + 0.9*rnd(d + dim*j); }
+   }
+   pts(0,npts-1) = 2.0;
+
+   MeshPointLocator &locator = mesh.GetPointLocator();
+   const int num_box_updates = locator.GetNumBoxUpdates();
+   for (int step = 0; step < 3; step++)
+   {
+      // After the first step, only the point outside of the mesh, which has no
+      // hint, is searched for in the bins.
+      Vector u_vals, v_vals, x, val(dim);
+      const int num_searches = locator.GetNumBinSearches();
+      REQUIRE(u.GetValues(pts, u_vals) == npts-1);
+      REQUIRE(locator.GetNumBinSearches() - num_searches ==
+              ((step == 0) ? npts : 1));
+      REQUIRE(v.GetValues(pts, v_vals) == npts-1);
+      REQUIRE(u.GetPointElements()[npts-1] == -1);
+      REQUIRE(u_vals(npts-1) == 0.0);
+      for (int j = 0; j < npts-1; j++)
+      {
+         pts.GetColumnReference(j, x);
+         REQUIRE(u.GetPointElements()[j] >= 0);
+         REQUIRE(u_vals(j) == MFEM_Approx(u_func(x)));
+         v_func(x, val);
+         for (int d = 0; d < dim; d++)
+         {
+            REQUIRE(v_vals(d + dim*j) == MFEM_Approx(val(d)));
+         }
+      }
+
+      // Move the points a little; the previous elements are used as hints
+      for (int j = 0; j < npts-1; j++) { pts(0,j) += 0.02; }
+   }
+   // The mesh did not change, so the index was not updated.
+   REQUIRE(locator.GetNumBoxUpdates() == num_box_updates);
+}
+
 } // namespace get_value
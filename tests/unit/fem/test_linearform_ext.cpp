@@ -0,0 +1,140 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace linearform_ext
+{
+
+static double f(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += (d+1)*x(d)*x(d); }
+   return s;
+}
+
+static void vf(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = f(x) + d; }
+}
+
+static Mesh MakeMesh(int dim, Element::Type type)
+{
+   return (dim == 2) ? Mesh::MakeCartesian2D(3, 4, type, true, 1.0, 1.5) :
+          Mesh::MakeCartesian3D(2, 3, 2, type, 1.0, 1.5, 0.5);
+}
+
+// Compare the legacy and the device assembly of the linear form b.
+static void CompareAssembly(LinearForm &b)
+{
+   b.Assemble();
+   Vector b_legacy(b);
+   b.UseFastAssembly(true);
+   b.Assemble();
+   b -= b_legacy;
+   REQUIRE(b.Normlinf() == MFEM_Approx(0.0, 1e-11));
+}
+
+TEST_CASE("LinearForm device assembly", "[LinearForm][LinearFormExtension]")
+{
+   const bool constant_coeff = GENERATE(true, false);
+   const int dim = GENERATE(2, 3);
+   const int order = GENERATE(1, 3);
+   const int type = GENERATE(0, 1);
+   const bool curved = GENERATE(false, true);
+
+   Element::Type el_type = (type == 0) ?
+                           (dim == 2 ? Element::QUADRILATERAL :
+                            Element::HEXAHEDRON) :
+                           (dim == 2 ? Element::TRIANGLE : Element::TETRAHEDRON);
+   Mesh mesh = MakeMesh(dim, el_type);
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      GridFunction &nodes = *mesh.GetNodes();
+      Vector disp(nodes.Size());
+      disp.Randomize(1);
+      disp *= 0.02;
+      nodes += disp;
+   }
+
+   ConstantCoefficient c_coeff(2.5);
+   FunctionCoefficient f_coeff(f);
+   Coefficient &coeff = constant_coeff ? (Coefficient&) c_coeff :
+                        (Coefficient&) f_coeff;
+   Vector cvec(dim);
+   for (int d = 0; d < dim; d++) { cvec(d) = 1.0 + d; }
+   VectorConstantCoefficient c_vcoeff(cvec);
+   VectorFunctionCoefficient f_vcoeff(dim, vf);
+   VectorCoefficient &vcoeff = constant_coeff ? (VectorCoefficient&) c_vcoeff :
+                               (VectorCoefficient&) f_vcoeff;
+
+   H1_FECollection fec(order, dim);
+
+   SECTION("Scalar integrators")
+   {
+      FiniteElementSpace fes(&mesh, &fec);
+      Array<int> elem_marker(mesh.attributes.Max());
+      elem_marker = 1;
+      Array<int> bdr_marker(mesh.bdr_attributes.Max());
+      bdr_marker = 0;
+      bdr_marker[0] = 1;
+
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(coeff));
+      b.AddDomainIntegrator(new DomainLFIntegrator(coeff), elem_marker);
+      b.AddDomainIntegrator(new DomainLFGradIntegrator(vcoeff));
+      b.AddBoundaryIntegrator(new BoundaryLFIntegrator(coeff));
+      b.AddBoundaryIntegrator(new BoundaryLFIntegrator(coeff), bdr_marker);
+      CompareAssembly(b);
+   }
+
+   SECTION("Vector integrators")
+   {
+      FiniteElementSpace fes(&mesh, &fec, dim, Ordering::byVDIM);
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new VectorDomainLFIntegrator(vcoeff));
+      CompareAssembly(b);
+   }
+}
+
+TEST_CASE("LinearForm device assembly fallback",
+          "[LinearForm][LinearFormExtension]")
+{
+   // Unsupported integrators fall back to the legacy assembly
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   RT_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Vector cvec(2);
+   cvec = 1.0;
+   VectorConstantCoefficient vcoeff(cvec);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(vcoeff));
+   CompareAssembly(b);
+
+   // Variable order spaces also use the legacy assembly
+   mesh.EnsureNCMesh();
+   H1_FECollection h1_fec(1, 2);
+   FiniteElementSpace var_fes(&mesh, &h1_fec);
+   var_fes.SetElementOrder(4, 2);
+   var_fes.Update(false);
+   REQUIRE(var_fes.IsVariableOrder());
+   FunctionCoefficient f_coeff(f);
+   LinearForm var_b(&var_fes);
+   var_b.AddDomainIntegrator(new DomainLFIntegrator(f_coeff));
+   var_b.AddBoundaryIntegrator(new BoundaryLFIntegrator(f_coeff));
+   CompareAssembly(var_b);
+}
+
+} // namespace linearform_ext
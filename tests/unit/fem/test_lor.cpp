@@ -0,0 +1,98 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace lor_test
+{
+
+void Perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(M_PI*x(1));
+   y(1) += 0.05*sin(M_PI*x(0));
+}
+
+double Coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+}
+
+TEST_CASE("LOR Batched Assembly", "[LOR]")
+{
+   const int dim = GENERATE(2, 3);
+   const int space = GENERATE(0, 1, 2); // H1, ND, RT
+   const bool curved = GENERATE(false, true);
+   const int order = (dim == 2) ? 3 : 2;
+   CAPTURE(dim, space, curved);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 1, Element::HEXAHEDRON);
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      mesh.Transform(lor_test::Perturb);
+   }
+
+   const int b1 = BasisType::GaussLobatto, b2 = BasisType::IntegratedGLL;
+   FiniteElementCollection *fec;
+   if (space == 0) { fec = new H1_FECollection(order, dim); }
+   else if (space == 1) { fec = new ND_FECollection(order, dim, b1, b2); }
+   else { fec = new RT_FECollection(order-1, dim, b1, b2); }
+   FiniteElementSpace fes(&mesh, fec);
+
+   Array<int> ess_dofs, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+
+   FunctionCoefficient coeff(lor_test::Coeff);
+   ConstantCoefficient two(2.0);
+   BilinearForm a(&fes);
+   if (space == 0)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+      a.AddDomainIntegrator(new DiffusionIntegrator(two));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new VectorFEMassIntegrator(coeff));
+      if (space == 1) { a.AddDomainIntegrator(new CurlCurlIntegrator); }
+      else { a.AddDomainIntegrator(new DivDivIntegrator); }
+   }
+
+   LORDiscretization lor_batched(a, ess_dofs);
+   LORDiscretization lor_legacy(fes);
+   lor_legacy.LegacyAssembleSystem(a, ess_dofs);
+   SparseMatrix &A_legacy = lor_legacy.GetAssembledMatrix();
+   const double tol = 1e-12*A_legacy.MaxNorm();
+
+   // Both systems use the LOR DOF numbering
+   REQUIRE(lor_batched.RequiresDofPermutation() ==
+           lor_legacy.RequiresDofPermutation());
+   SparseMatrix &A_batched = lor_batched.GetAssembledMatrix();
+   REQUIRE(A_batched.Height() == A_legacy.Height());
+   SparseMatrix *diff = Add(1.0, A_batched, -1.0, A_legacy);
+   REQUIRE(diff->MaxNorm() == MFEM_Approx(0.0, tol));
+   delete diff;
+
+   // Constructing the LOR space does not change the assembled system
+   const Operator *A_ptr = lor_batched.GetAssembledSystem().Ptr();
+   lor_batched.GetFESpace();
+   REQUIRE(lor_batched.GetAssembledSystem().Ptr() == A_ptr);
+
+   delete fec;
+}
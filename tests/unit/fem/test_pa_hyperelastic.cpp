@@ -0,0 +1,98 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace pa_hyperelastic
+{
+
+static double mu_func(const Vector &x) { return 1.0 + 0.5*x(0)*x(1); }
+
+static double K_func(const Vector &x) { return 2.0 + x(0); }
+
+static void identity(const Vector &x, Vector &y) { y = x; }
+
+static void TestHyperelasticPA(int dim, int order, bool simplex, int model_id)
+{
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(2, 3, simplex ? Element::TRIANGLE :
+                                     Element::QUADRILATERAL, true, 1.0, 1.5) :
+               Mesh::MakeCartesian3D(2, 2, 2, simplex ? Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+   mesh.SetCurvature(order);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+
+   FunctionCoefficient mu(mu_func), K(K_func);
+   InverseHarmonicModel ih_model;
+   NeoHookeanModel neo_model(0.5, 3.0);
+   NeoHookeanModel neo_coeff_model(mu, K);
+   HyperelasticModel *model =
+      (model_id == 0) ? (HyperelasticModel*) &ih_model :
+      (model_id == 1) ? (HyperelasticModel*) &neo_model :
+      (HyperelasticModel*) &neo_coeff_model;
+
+   // Deformed configuration: the identity map plus a small perturbation
+   GridFunction x(&fes);
+   VectorFunctionCoefficient id_coeff(dim, identity);
+   x.ProjectCoefficient(id_coeff);
+   Vector dx(x.Size());
+   dx.Randomize(1);
+   x.Add(0.05, dx);
+
+   NonlinearForm nlf_fa(&fes);
+   nlf_fa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+
+   NonlinearForm nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf_pa.Setup();
+
+   const double energy_fa = nlf_fa.GetEnergy(x);
+   const double energy_pa = nlf_pa.GetEnergy(x);
+   REQUIRE(energy_pa == MFEM_Approx(energy_fa));
+
+   Vector y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   nlf_fa.Mult(x, y_fa);
+   nlf_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+
+   Vector v(fes.GetVSize());
+   v.Randomize(2);
+   Operator &grad_fa = nlf_fa.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+
+   Vector diag_fa(fes.GetVSize()), diag_pa(fes.GetVSize());
+   dynamic_cast<SparseMatrix&>(grad_fa).GetDiag(diag_fa);
+   grad_pa.AssembleDiagonal(diag_pa);
+   diag_pa -= diag_fa;
+   REQUIRE(diag_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+}
+
+TEST_CASE("PA Hyperelastic", "[PartialAssembly][NonlinearPA]")
+{
+   const int dim = GENERATE(2, 3);
+   const int order = GENERATE(1, 2);
+   const bool simplex = GENERATE(false, true);
+   const int model_id = GENERATE(0, 1, 2);
+   TestHyperelasticPA(dim, order, simplex, model_id);
+}
+
+} // namespace pa_hyperelastic
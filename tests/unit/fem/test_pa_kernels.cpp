@@ -453,4 +453,83 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
 
 } // test case
 
+double elasticity_coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+void test_pa_elasticity(int dim, int order, bool curved, bool func_coeff)
+{
+   Mesh mesh =
+      (dim == 2) ?
+      Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL, 0, 1.0, 1.0):
+      Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      GridFunction &nodes = *mesh.GetNodes();
+      Vector disp(nodes.Size());
+      disp.Randomize(1);
+      disp *= 0.05;
+      nodes += disp;
+   }
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+
+   ConstantCoefficient lambda_c(2.0), mu_c(0.5);
+   FunctionCoefficient lambda_f(elasticity_coeff);
+   Coefficient &lambda = func_coeff ? (Coefficient&) lambda_f :
+                         (Coefficient&) lambda_c;
+
+   for (int variant = 0; variant < 2; variant++)
+   {
+      auto make_integ = [&]()
+      {
+         return (variant == 0) ? new ElasticityIntegrator(lambda, mu_c) :
+                new ElasticityIntegrator(lambda, 1.0, 0.5);
+      };
+
+      BilinearForm blf_fa(&fes);
+      blf_fa.AddDomainIntegrator(make_integ());
+      blf_fa.Assemble();
+      blf_fa.Finalize();
+
+      BilinearForm blf_pa(&fes);
+      blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      blf_pa.AddDomainIntegrator(make_integ());
+      blf_pa.Assemble();
+
+      GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+      x.Randomize(1);
+      blf_fa.Mult(x, y_fa);
+      blf_pa.Mult(x, y_pa);
+      y_pa -= y_fa;
+      REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+
+      Vector diag_fa(fes.GetTrueVSize()), diag_pa(fes.GetTrueVSize());
+      blf_fa.SpMat().GetDiag(diag_fa);
+      blf_pa.AssembleDiagonal(diag_pa);
+      diag_pa -= diag_fa;
+      REQUIRE(diag_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+   }
+}
+
+TEST_CASE("PA Elasticity", "[PartialAssembly], [VectorPA]")
+{
+   auto order = GENERATE(1, 2, 3);
+   auto curved = GENERATE(false, true);
+   auto func_coeff = GENERATE(false, true);
+
+   SECTION("2D")
+   {
+      test_pa_elasticity(2, order, curved, func_coeff);
+   }
+
+   SECTION("3D")
+   {
+      test_pa_elasticity(3, order, curved, func_coeff);
+   }
+}
+
 } // namespace pa_kernels
@@ -0,0 +1,221 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem/bilininteg_simd.hpp"
+#include "fem/bilininteg_mass_kernels.hpp"
+#include "fem/bilininteg_diffusion_kernels.hpp"
+#include "fem/bilininteg_convection_kernels.hpp"
+
+using namespace mfem;
+using internal::simd_pa_t;
+
+namespace pa_simd
+{
+
+// Element data of a PA operator, with random values.
+struct PAData
+{
+   const int dim, D1D, Q1D, NE, ND, NQ;
+   Vector B, Bt, G, Gt, D, X;
+
+   PAData(int dim_, int D1D_, int Q1D_, int NE_, int nd_per_q)
+      : dim(dim_), D1D(D1D_), Q1D(Q1D_), NE(NE_),
+        ND(dim == 2 ? D1D*D1D : D1D*D1D*D1D),
+        NQ(dim == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D),
+        B(Q1D*D1D), Bt(Q1D*D1D), G(Q1D*D1D), Gt(Q1D*D1D),
+        D(nd_per_q*NQ*NE), X(ND*NE)
+   {
+      B.Randomize(1);
+      G.Randomize(2);
+      D.Randomize(3);
+      X.Randomize(4);
+      for (int q = 0; q < Q1D; q++)
+      {
+         for (int d = 0; d < D1D; d++)
+         {
+            Bt(d + D1D*q) = B(q + Q1D*d);
+            Gt(d + D1D*q) = G(q + Q1D*d);
+         }
+      }
+   }
+};
+
+// Apply the element kernel to all the elements, one at a time and then in
+// interleaved groups, and return the difference between the two results.
+template <typename Kernel, typename SimdKernel>
+static double ApplyDifference(const PAData &pa, Kernel kernel,
+                              SimdKernel simd_kernel)
+{
+   const int NE = pa.NE, NG = internal::SimdPAGroups(NE);
+   Vector y(pa.ND*NE), y_simd(pa.ND*NE);
+   y = 0.0;
+   y_simd = 1.0;
+   for (int e = 0; e < NE; e++) { kernel(e, y.HostReadWrite()); }
+
+   Vector d_simd, x_simd, z_simd;
+   internal::SimdPAInterleave(pa.D.Size()/NE, NE, pa.D, d_simd);
+   internal::SimdPAInterleave(pa.ND, NE, pa.X, x_simd);
+   z_simd.SetSize(x_simd.Size(), MemoryType::HOST_64);
+   z_simd = 0.0;
+   const simd_pa_t *D = reinterpret_cast<const simd_pa_t*>(d_simd.HostRead());
+   const simd_pa_t *X = reinterpret_cast<const simd_pa_t*>(x_simd.HostRead());
+   simd_pa_t *Z = reinterpret_cast<simd_pa_t*>(z_simd.HostReadWrite());
+   for (int g = 0; g < NG; g++) { simd_kernel(g, D, X, Z); }
+   internal::SimdPADeinterleave(pa.ND, NE, z_simd, y_simd, true);
+
+   y_simd -= 1.0;
+   y_simd -= y;
+   return y_simd.Normlinf() / y.Normlinf();
+}
+
+TEST_CASE("PA SIMD interleave", "[PartialAssembly][SIMD]")
+{
+   const int NE = GENERATE(1, 5, 2*internal::SIMD_PA_LANES);
+   const int N = 3;
+   Vector x(N*NE), x_simd, y(N*NE);
+   x.Randomize(1);
+   internal::SimdPAInterleave(N, NE, x, x_simd);
+   REQUIRE(x_simd.Size() ==
+           N*internal::SimdPAGroups(NE)*internal::SIMD_PA_LANES);
+   for (int e = 0; e < NE; e++)
+   {
+      const int l = e % internal::SIMD_PA_LANES;
+      const int g = e / internal::SIMD_PA_LANES;
+      for (int i = 0; i < N; i++)
+      {
+         REQUIRE(x_simd((g*N + i)*internal::SIMD_PA_LANES + l) == x(i + N*e));
+      }
+   }
+   internal::SimdPADeinterleave(N, NE, x_simd, y);
+   y -= x;
+   REQUIRE(y.Normlinf() == 0.0);
+}
+
+TEST_CASE("PA SIMD kernels", "[PartialAssembly][SIMD]")
+{
+   const int dim = GENERATE(2, 3);
+   const int D1D = GENERATE(2, 3);
+   const int Q1D = D1D + 1;
+   const int NE = 2*internal::SIMD_PA_LANES + 1;
+   const double tol = 1e-12;
+
+   SECTION("Mass")
+   {
+      PAData pa(dim, D1D, Q1D, NE, 1);
+      const double *B = pa.B.HostRead(), *Bt = pa.Bt.HostRead();
+      const double *D = pa.D.HostRead(), *X = pa.X.HostRead();
+      auto kernel = [&](int e, double *Y)
+      {
+         if (dim == 2)
+         {
+            internal::PAMassApply2D_Element(e, NE, B, Bt, D, X, Y, D1D, Q1D);
+         }
+         else
+         {
+            internal::PAMassApply3D_Element(e, NE, B, Bt, D, X, Y, D1D, Q1D);
+         }
+      };
+      const int NG = internal::SimdPAGroups(NE);
+      auto simd_kernel = [&](int g, const simd_pa_t *DS, const simd_pa_t *XS,
+                             simd_pa_t *YS)
+      {
+         if (dim == 2)
+         {
+            internal::PAMassApply2D_Element(g, NG, B, Bt, DS, XS, YS, D1D, Q1D);
+         }
+         else
+         {
+            internal::PAMassApply3D_Element(g, NG, B, Bt, DS, XS, YS, D1D, Q1D);
+         }
+      };
+      REQUIRE(ApplyDifference(pa, kernel, simd_kernel) < tol);
+   }
+
+   SECTION("Diffusion")
+   {
+      const bool symm = GENERATE(true, false);
+      const int nd = dim == 2 ? (symm ? 3 : 4) : (symm ? 6 : 9);
+      PAData pa(dim, D1D, Q1D, NE, nd);
+      const double *B = pa.B.HostRead(), *Bt = pa.Bt.HostRead();
+      const double *G = pa.G.HostRead(), *Gt = pa.Gt.HostRead();
+      const double *D = pa.D.HostRead(), *X = pa.X.HostRead();
+      auto kernel = [&](int e, double *Y)
+      {
+         if (dim == 2)
+         {
+            internal::PADiffusionApply2D_Element(e, NE, symm, B, G, Bt, Gt, D,
+                                                 X, Y, D1D, Q1D);
+         }
+         else
+         {
+            internal::PADiffusionApply3D_Element(e, NE, symm, B, G, Bt, Gt, D,
+                                                 X, Y, D1D, Q1D);
+         }
+      };
+      const int NG = internal::SimdPAGroups(NE);
+      auto simd_kernel = [&](int g, const simd_pa_t *DS, const simd_pa_t *XS,
+                             simd_pa_t *YS)
+      {
+         if (dim == 2)
+         {
+            internal::PADiffusionApply2D_Element(g, NG, symm, B, G, Bt, Gt, DS,
+                                                 XS, YS, D1D, Q1D);
+         }
+         else
+         {
+            internal::PADiffusionApply3D_Element(g, NG, symm, B, G, Bt, Gt, DS,
+                                                 XS, YS, D1D, Q1D);
+         }
+      };
+      REQUIRE(ApplyDifference(pa, kernel, simd_kernel) < tol);
+   }
+
+   SECTION("Convection")
+   {
+      PAData pa(dim, D1D, Q1D, NE, dim);
+      const double *B = pa.B.HostRead(), *Bt = pa.Bt.HostRead();
+      const double *G = pa.G.HostRead();
+      const double *D = pa.D.HostRead(), *X = pa.X.HostRead();
+      auto kernel = [&](int e, double *Y)
+      {
+         if (dim == 2)
+         {
+            internal::PAConvectionApply2D_Element(e, NE, B, G, Bt, D, X, Y,
+                                                  D1D, Q1D);
+         }
+         else
+         {
+            internal::PAConvectionApply3D_Element(e, NE, B, G, Bt, D, X, Y,
+                                                  D1D, Q1D);
+         }
+      };
+      const int NG = internal::SimdPAGroups(NE);
+      auto simd_kernel = [&](int g, const simd_pa_t *DS, const simd_pa_t *XS,
+                             simd_pa_t *YS)
+      {
+         if (dim == 2)
+         {
+            internal::PAConvectionApply2D_Element(g, NG, B, G, Bt, DS, XS, YS,
+                                                  D1D, Q1D);
+         }
+         else
+         {
+            internal::PAConvectionApply3D_Element(g, NG, B, G, Bt, DS, XS, YS,
+                                                  D1D, Q1D);
+         }
+      };
+      REQUIRE(ApplyDifference(pa, kernel, simd_kernel) < tol);
+   }
+}
+
+} // namespace pa_simd
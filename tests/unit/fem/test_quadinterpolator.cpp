@@ -251,3 +251,39 @@ TEST_CASE("QuadratureInterpolator",
    const auto nz = 3; // number of element in z
    testQuadratureInterpolator(d, p, q, l, nx, ny, nz);
 } // TEST_CASE "QuadratureInterpolator"
+
+TEST_CASE("QuadratureInterpolator high order values",
+          "[QuadratureInterpolator]")
+{
+   // 3D orders above 7 use the host fall-back of the tensor values kernel
+   const auto p = GENERATE(8, 9); // element order
+   const auto l = GENERATE(QVectorLayout::byNODES, QVectorLayout::byVDIM);
+   const int dim = 3, q = p + 1;
+
+   Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   const H1_FECollection fec(p, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+   GridFunction x(&fes);
+   x.Randomize(0x100001b3);
+
+   const IntegrationRule &ir = IntRules.Get(Geometry::CUBE, 2*q-1);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(l);
+   const int NE = mesh.GetNE(), NQ = ir.GetNPoints();
+   const Operator *RN = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   const Operator *RL =
+      fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+
+   Vector xe(RN->Height()), val_f(dim*NQ*NE), val_t(dim*NQ*NE);
+   RN->Mult(x, xe);
+   qi->DisableTensorProducts();
+   qi->Values(xe, val_f);
+   RL->Mult(x, xe);
+   qi->EnableTensorProducts();
+   qi->Values(xe, val_t);
+   qi->DisableTensorProducts();
+
+   const double norm = val_f.Normlinf();
+   val_f -= val_t;
+   REQUIRE(val_f.Normlinf() <= 1e-12*norm);
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace tmop_test
+{
+
+void Perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int d = 0; d < x.Size(); d++)
+   {
+      y(d) += 0.02*sin(M_PI*x((d+1) % x.Size()));
+   }
+}
+
+void Direction(const Vector &x, Vector &y)
+{
+   for (int d = 0; d < x.Size(); d++)
+   {
+      y(d) = 0.1*cos(M_PI*(d+1)*x(0));
+   }
+}
+
+// Exposes the line search helpers of TMOPNewtonSolver.
+class LineSearchSolver : public TMOPNewtonSolver
+{
+public:
+   LineSearchSolver(IntegrationRules &irules, int order)
+      : TMOPNewtonSolver(irules.Get(Geometry::SQUARE, order))
+   {
+      SetIntegrationRules(irules, order);
+   }
+   using TMOPNewtonSolver::ComputeMinDet;
+};
+
+// The minimum det(T) of the positions x - s d, computed element by element.
+double MinDet(const FiniteElementSpace &fes, IntegrationRules &irules,
+              int order, const Vector &x, const Vector &d, double s)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   double min_det = infinity();
+   Array<int> vdofs;
+   Vector xe, de;
+   DenseMatrix dshape, P, J(dim);
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      const FiniteElement &fe = *fes.GetFE(e);
+      const IntegrationRule &ir = irules.Get(fe.GetGeomType(), order);
+      const int nd = fe.GetDof();
+      fes.GetElementVDofs(e, vdofs);
+      x.GetSubVector(vdofs, xe);
+      d.GetSubVector(vdofs, de);
+      xe.Add(-s, de);
+      P.UseExternalData(xe.GetData(), nd, dim);
+      dshape.SetSize(nd, dim);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         fe.CalcDShape(ir.IntPoint(q), dshape);
+         MultAtB(P, dshape, J);
+         min_det = std::min(min_det, J.Det());
+      }
+   }
+   const DenseMatrix &Wideal =
+      Geometries.GetGeomToPerfGeomJac(fes.GetFE(0)->GetGeomType());
+   return min_det / Wideal.Det();
+}
+
+}
+
+TEST_CASE("TMOP Batched Line Search", "[TMOP]")
+{
+   const char *mesh_file =
+      GENERATE("../../data/inline-tri.mesh", "../../data/inline-tet.mesh",
+               "../../data/star-mixed.mesh", "../../data/fichera-mixed.mesh");
+   const bool limiting = GENERATE(false, true);
+   const int order = 2;
+   CAPTURE(mesh_file, limiting);
+
+   Mesh mesh(mesh_file);
+   const int dim = mesh.Dimension();
+   mesh.SetCurvature(order, false, dim, Ordering::byNODES);
+   mesh.Transform(tmop_test::Perturb);
+
+   GridFunction &x = *mesh.GetNodes();
+   FiniteElementSpace &fes = *x.FESpace();
+   GridFunction x0(&fes);
+   x0 = x;
+
+   TMOP_QualityMetric *metric = (dim == 2) ?
+                                (TMOP_QualityMetric *) new TMOP_Metric_002 :
+                                (TMOP_QualityMetric *) new TMOP_Metric_302;
+   TargetConstructor tc(TargetConstructor::IDEAL_SHAPE_UNIT_SIZE);
+   IntegrationRules irules(0, Quadrature1D::GaussLobatto);
+   const int quad_order = 2*order + 2;
+
+   TMOP_Integrator *ti = new TMOP_Integrator(metric, &tc);
+   ti->SetIntegrationRules(irules, quad_order);
+   ConstantCoefficient lim_coeff(0.5);
+   H1_FECollection dist_fec(order, dim);
+   FiniteElementSpace dist_fes(&mesh, &dist_fec);
+   GridFunction lim_dist(&dist_fes);
+   lim_dist = 0.1;
+   if (limiting) { ti->EnableLimiting(x0, lim_dist, lim_coeff); }
+
+   NonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(ti);
+
+   VectorFunctionCoefficient dir(dim, tmop_test::Direction);
+   GridFunction d(&fes);
+   d.ProjectCoefficient(dir);
+
+   SECTION("Energy")
+   {
+      GridFunction xs(&fes);
+      xs = x;
+      xs.Add(-0.5, d);
+
+      REQUIRE(ti->SetupBatchedEnergy(fes, x));
+      const double energy = nlf.GetGridFunctionEnergy(xs);
+      REQUIRE(ti->GetBatchedEnergy(xs) == MFEM_Approx(energy, 1e-12));
+   }
+
+   SECTION("Min det(T)")
+   {
+      tmop_test::LineSearchSolver solver(irules, quad_order);
+      Vector scales(4);
+      scales(0) = 0.0; scales(1) = 1.0; scales(2) = 0.5; scales(3) = 0.25;
+      Vector min_det;
+      solver.ComputeMinDet(x, d, scales, fes, min_det);
+      REQUIRE(min_det.Size() == scales.Size());
+      for (int s = 0; s < scales.Size(); s++)
+      {
+         const double ref =
+            tmop_test::MinDet(fes, irules, quad_order, x, d, scales(s));
+         REQUIRE(min_det(s) == MFEM_Approx(ref, 1e-12));
+      }
+   }
+
+   delete metric;
+}
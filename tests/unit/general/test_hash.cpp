@@ -0,0 +1,173 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <map>
+#include <vector>
+
+using namespace mfem;
+
+namespace hash_test
+{
+
+struct Edge : public Hashed2 { int value; };
+struct Quad : public Hashed4 { int value; };
+
+// Insert, find, delete and reparent a few thousand items, with small initial
+// tables to go through several rehashes, and check the items against a
+// std::map. Return the sequence of ids, to compare different tables.
+template <typename Table>
+std::vector<int> CheckEdges()
+{
+   Table table(64, 16);
+   std::map<std::pair<int, int>, int> ref;
+   std::vector<int> ids;
+
+   const int n = 50;
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < n; j++)
+      {
+         const int id = table.GetId(j, i*n); // unordered parents
+         table[id].value = i*n + j;
+         ref[std::make_pair(std::min(i*n, j), std::max(i*n, j))] = id;
+         ids.push_back(id);
+      }
+   }
+   // Get() of an existing item does not create a new one
+   REQUIRE(table.GetId(n*n-n, n-1) == table.FindId(n-1, n*n-n));
+   REQUIRE(table.Size() == int(ref.size()));
+
+   // delete every third item
+   int k = 0;
+   for (auto it = ref.begin(); it != ref.end(); k++)
+   {
+      if (k % 3) { ++it; continue; }
+      table.Delete(it->second);
+      REQUIRE_FALSE(table.IdExists(it->second));
+      REQUIRE(table.FindId(it->first.first, it->first.second) < 0);
+      it = ref.erase(it);
+   }
+   REQUIRE(table.Size() == int(ref.size()));
+
+   // reparent every other item, the new items reuse the deleted ids
+   k = 0;
+   std::map<std::pair<int, int>, int> moved;
+   for (const auto &r : ref)
+   {
+      if (k++ % 2) { moved.insert(r); continue; }
+      const int p1 = r.first.first + 1000000, p2 = r.first.second;
+      table.Reparent(r.second, p2, p1);
+      REQUIRE(table.FindId(r.first.first, r.first.second) < 0);
+      moved[std::make_pair(p2, p1)] = r.second;
+   }
+   for (int i = 0; i < n; i++)
+   {
+      ids.push_back(table.GetId(-1, i));
+      moved[std::make_pair(-1, i)] = ids.back();
+   }
+
+   REQUIRE(table.Size() == int(moved.size()));
+   for (const auto &m : moved)
+   {
+      REQUIRE(table.FindId(m.first.second, m.first.first) == m.second);
+      REQUIRE(table.Find(m.first.first, m.first.second) == &table[m.second]);
+   }
+   int count = 0;
+   for (auto it = table.begin(); it != table.end(); ++it)
+   {
+      REQUIRE(table.FindId(it->p1, it->p2) == it.index());
+      count++;
+   }
+   REQUIRE(count == table.Size());
+
+   // copies are independent
+   Table copy(table);
+   table.DeleteAll();
+   REQUIRE(table.Size() == 0);
+   REQUIRE(table.FindId(-1, 0) < 0);
+   REQUIRE(copy.FindId(-1, 0) == moved[std::make_pair(-1, 0)]);
+   REQUIRE(copy.Size() == int(moved.size()));
+
+   return ids;
+}
+
+template <typename Table>
+std::vector<int> CheckQuads()
+{
+   Table table(64, 16);
+   std::vector<int> ids;
+
+   const int n = 20;
+   for (int i = 0; i < n*n; i++)
+   {
+      // the smallest three indices identify the item
+      ids.push_back(table.GetId(i+3, i, i+2*n, i+1));
+      REQUIRE(table.FindId(i+1, i+2*n, i, i+3) == ids.back());
+   }
+   for (int i = 0; i < n*n; i += 2)
+   {
+      table.Delete(ids[i]);
+   }
+   for (int i = 0; i < n*n; i++)
+   {
+      const int id = table.FindId(i, i+1, i+2*n, i+3);
+      REQUIRE(id == ((i % 2) ? ids[i] : -1));
+   }
+   for (int i = 1; i < n*n; i += 2)
+   {
+      table.Reparent(ids[i], -i, i, 0);
+      REQUIRE(table.Find(0, -i, i) == &table[ids[i]]);
+      REQUIRE(table.FindId(i, i+1, i+2*n, i+3) < 0);
+   }
+   REQUIRE(table.Size() == n*n/2);
+   return ids;
+}
+
+} // namespace hash_test
+
+TEST_CASE("OpenHashTable", "[HashTable]")
+{
+   using namespace hash_test;
+
+   SECTION("Hashed2")
+   {
+      std::vector<int> ids = CheckEdges<OpenHashTable<Edge> >();
+      // same ids as HashTable, including the reused ones
+      REQUIRE(ids == CheckEdges<HashTable<Edge> >());
+   }
+
+   SECTION("Hashed4")
+   {
+      std::vector<int> ids = CheckQuads<OpenHashTable<Quad> >();
+      REQUIRE(ids == CheckQuads<HashTable<Quad> >());
+   }
+
+   SECTION("Alloc")
+   {
+      OpenHashTable<Edge> table(16, 16);
+      for (int i = 40; i >= 0; i -= 2) { table.Alloc(i, i, i); }
+      table.Alloc(10, 0, 1); // already allocated: no-op
+      table.UpdateUnused();
+      REQUIRE(table.Size() == 21);
+      REQUIRE(table.NumIds() == 41);
+      REQUIRE(table.NumFreeIds() == 20);
+      for (int i = 0; i <= 40; i++)
+      {
+         REQUIRE(table.IdExists(i) == !(i % 2));
+         REQUIRE(table.FindId(i, i) == ((i % 2) ? -1 : i));
+      }
+      // new items use the unused ids
+      REQUIRE(table.GetId(100, 200) % 2 == 1);
+   }
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "general/jit.hpp"
+#include "unit_tests.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h> // getcwd
+
+using namespace mfem;
+
+#ifdef MFEM_USE_JIT
+
+TEST_CASE("JIT cache key", "[JIT]")
+{
+   char cwd[4096];
+   REQUIRE(getcwd(cwd, sizeof(cwd)) != NULL);
+   const std::string inner = std::string(cwd) + "/jit_test_inner.hpp";
+   const std::string outer = std::string(cwd) + "/jit_test_outer.hpp";
+
+   // The source includes outer, which includes inner with a relative name
+   {
+      std::ofstream out(outer.c_str());
+      out << "#include \"jit_test_inner.hpp\"\n";
+   }
+   {
+      std::ofstream out(inner.c_str());
+      out << "#define JIT_TEST_VALUE 1\n";
+   }
+   const std::string source = "#include \"" + outer + "\"\n"
+                              "extern \"C\" int f() { return JIT_TEST_VALUE; }\n";
+   const std::string h1 = jit::SourceHash(source);
+   REQUIRE(jit::SourceHash(source) == h1);
+
+   // Changing an included header changes the key
+   {
+      std::ofstream out(inner.c_str());
+      out << "#define JIT_TEST_VALUE 2\n";
+   }
+   const std::string h2 = jit::SourceHash(source);
+   REQUIRE(h2 != h1);
+
+   REQUIRE(std::remove(inner.c_str()) == 0);
+   REQUIRE(std::remove(outer.c_str()) == 0);
+}
+
+#endif // MFEM_USE_JIT
@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+using namespace mfem;
+
+#ifndef MFEM_USE_CALIPER
+
+TEST_CASE("Profiler", "[Profiler]")
+{
+   const bool enabled = Profiler::Enabled();
+   // The regions are recorded by default.
+   if (!std::getenv("MFEM_PROFILE")) { REQUIRE(enabled); }
+   Profiler::Enable();
+   Profiler::Reset();
+
+   SECTION("Nested regions")
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         MFEM_PERF_BEGIN("outer");
+         {
+            MFEM_PERF_SCOPE("inner");
+            MFEM_PERF_WORK(16.0, 2.0);
+         }
+         MFEM_PERF_END("outer");
+      }
+      {
+         MFEM_PERF_SCOPE("inner");
+      }
+
+      REQUIRE(Profiler::GetStats("outer").calls == 3);
+      const Profiler::Stats inner = Profiler::GetStats("inner");
+      REQUIRE(inner.calls == 4);
+      REQUIRE(inner.bytes == 48.0);
+      REQUIRE(inner.flops == 6.0);
+      REQUIRE(inner.time >= 0.0);
+
+      // "inner" is reached from two places: it appears twice in the report.
+      std::ostringstream text, json;
+      Profiler::Print(text);
+      Profiler::PrintJSON(json);
+      const std::string report = text.str();
+      REQUIRE(report.find("outer") != std::string::npos);
+      REQUIRE(report.find("inner") != report.rfind("inner"));
+      REQUIRE(json.str().find("\"name\": \"outer\", \"calls\": 3") !=
+              std::string::npos);
+   }
+
+   SECTION("Call sites")
+   {
+      // The same call site reached from two parent regions gives two regions.
+      auto kernel = []() { MFEM_PERF_SCOPE("kernel"); };
+      for (int i = 0; i < 3; i++)
+      {
+         kernel();
+         MFEM_PERF_SCOPE("caller");
+         kernel();
+      }
+      REQUIRE(Profiler::GetStats("kernel").calls == 6);
+      REQUIRE(Profiler::GetStats("caller").calls == 3);
+      std::ostringstream text;
+      Profiler::Print(text);
+      const std::string report = text.str();
+      REQUIRE(report.find("kernel") != report.rfind("kernel"));
+
+      // The regions cached by the call sites are cleared by Reset().
+      Profiler::Reset();
+      kernel();
+      REQUIRE(Profiler::GetStats("kernel").calls == 1);
+      REQUIRE(Profiler::GetStats("caller").calls == 0);
+   }
+
+   SECTION("Library regions")
+   {
+      const int n = 10;
+      SparseMatrix A(n);
+      for (int i = 0; i < n; i++) { A.Set(i, i, 2.0); }
+      A.Finalize();
+      Vector x(n), y(n);
+      x = 1.0;
+
+      for (int i = 0; i < 5; i++) { A.Mult(x, y); }
+      const Profiler::Stats stats =
+         Profiler::GetStats("mfem::SparseMatrix::AddMult");
+      REQUIRE(stats.calls == 5);
+      REQUIRE(stats.flops == 5*2.0*n);
+      REQUIRE(stats.bytes > 0.0);
+
+      // The MFEM_FORALL kernel is recorded with its location.
+      std::ostringstream text;
+      Profiler::Print(text);
+      REQUIRE(text.str().find("sparsemat.cpp:") != std::string::npos);
+   }
+
+   SECTION("Disabled")
+   {
+      Profiler::Enable(false);
+      {
+         MFEM_PERF_SCOPE("disabled");
+      }
+      REQUIRE(Profiler::GetStats("disabled").calls == 0);
+   }
+
+   Profiler::Reset();
+   Profiler::Enable(enabled);
+}
+
+#endif // MFEM_USE_CALIPER
@@ -0,0 +1,123 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("BSRMatrix", "[BSRMatrix]")
+{
+   const int dim = GENERATE(2, 3);
+   const auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+   const int order = 2;
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, ordering);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+   a.AddDomainIntegrator(new VectorMassIntegrator);
+   a.AddBoundaryIntegrator(new VectorMassIntegrator);
+   a.Assemble(0);
+   a.Finalize(0);
+   const SparseMatrix &A = a.SpMat();
+
+   BSRMatrix *A_bsr = a.AssembleBSR();
+   REQUIRE(A_bsr->Height() == A.Height());
+   REQUIRE(A_bsr->BlockSize() == dim);
+   REQUIRE(A_bsr->NumNonZeroBlocks()*dim*dim == A.NumNonZeroElems());
+
+   const int n = A.Height();
+   Vector x(n), y(n), y_bsr(n);
+   x.Randomize(1);
+
+   SECTION("Mult")
+   {
+      A.Mult(x, y);
+      A_bsr->Mult(x, y_bsr);
+      y_bsr -= y;
+      REQUIRE(y_bsr.Normlinf() == MFEM_Approx(0.0));
+
+      A.MultTranspose(x, y);
+      A_bsr->MultTranspose(x, y_bsr);
+      y_bsr -= y;
+      REQUIRE(y_bsr.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   SECTION("Conversion")
+   {
+      SparseMatrix *A_csr = A_bsr->ToSparseMatrix();
+      REQUIRE(A_csr->NumNonZeroElems() == A.NumNonZeroElems());
+      A_csr->Add(-1.0, A);
+      REQUIRE(A_csr->MaxNorm() == MFEM_Approx(0.0));
+      delete A_csr;
+
+      BSRMatrix A_conv(A, dim, ordering == Ordering::byVDIM);
+      REQUIRE(A_conv.NumNonZeroBlocks() == A_bsr->NumNonZeroBlocks());
+      A.Mult(x, y);
+      A_conv.Mult(x, y_bsr);
+      y_bsr -= y;
+      REQUIRE(y_bsr.Normlinf() == MFEM_Approx(0.0));
+
+      Vector d, d_bsr;
+      A.GetDiag(d);
+      A_bsr->GetDiag(d_bsr);
+      d_bsr -= d;
+      REQUIRE(d_bsr.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   SECTION("Smoothers")
+   {
+      const auto type = GENERATE(BSRSmoother::JACOBI,
+                                 BSRSmoother::GAUSS_SEIDEL_FORWARD,
+                                 BSRSmoother::GAUSS_SEIDEL_SYMMETRIC);
+      const double scale = (type == BSRSmoother::JACOBI) ? 0.5 : 1.0;
+      BSRSmoother S(*A_bsr, type, scale);
+      S.iterative_mode = true;
+
+      // The energy norm of the error decreases at each iteration.
+      Vector b(n), e(n), Ae(n);
+      A.Mult(x, b);
+      y = 0.0;
+      double err_prev = sqrt(A.InnerProduct(x, x));
+      for (int it = 0; it < 5; it++)
+      {
+         S.Mult(b, y);
+         subtract(y, x, e);
+         A.Mult(e, Ae);
+         const double err = sqrt(e*Ae);
+         REQUIRE(err < err_prev);
+         err_prev = err;
+      }
+
+      if (type == BSRSmoother::GAUSS_SEIDEL_SYMMETRIC)
+      {
+         CGSolver cg;
+         cg.SetOperator(*A_bsr);
+         cg.SetPreconditioner(S);
+         cg.SetRelTol(1e-12);
+         cg.SetMaxIter(500);
+         S.iterative_mode = false;
+         y = 0.0;
+         cg.Mult(b, y);
+         REQUIRE(cg.GetConverged());
+         y -= x;
+         REQUIRE(y.Normlinf() < 1e-8);
+      }
+   }
+
+   delete A_bsr;
+}
@@ -341,3 +341,99 @@ TEST_CASE("DenseTensor copy", "[DenseMatrix][DenseTensor]")
       REQUIRE(t3.Data()[i] == t1.Data()[i]);
    }
 }
+
+TEST_CASE("DenseTensor batch operations", "[DenseMatrix][DenseTensor]")
+{
+   const int m = 5, r = 3, NE = 70;
+   const double tol = 1e-12;
+
+   DenseTensor A(m,m,NE), B(m,r,NE);
+   Vector rnd(A.TotalSize());
+   rnd.Randomize(1);
+   for (int i = 0; i < A.TotalSize(); i++) { A.Data()[i] = rnd(i); }
+   // Make the matrices diagonally dominant, with some pivoting still needed
+   for (int e = 0; e < NE; e++) { A(e%m, (e+1)%m, e) += m; }
+   rnd.SetSize(B.TotalSize());
+   rnd.Randomize(2);
+   for (int i = 0; i < B.TotalSize(); i++) { B.Data()[i] = rnd(i); }
+
+   SECTION("Mult")
+   {
+      DenseTensor C;
+      BatchMult(A, B, C);
+      Vector x(m*NE), y;
+      x.Randomize(3);
+      BatchMult(A, x, y);
+      for (int e = 0; e < NE; e++)
+      {
+         DenseMatrix Ce(m,r);
+         Mult(A(e), B(e), Ce);
+         Ce -= C(e);
+         REQUIRE(Ce.MaxMaxNorm() < tol);
+
+         Vector xe(x.GetData() + e*m, m), ye(y.GetData() + e*m, m), ze(m);
+         A(e).Mult(xe, ze);
+         ze -= ye;
+         REQUIRE(ze.Normlinf() < tol);
+      }
+   }
+
+   SECTION("LU solve and inverse")
+   {
+      DenseTensor LU(A), X(B), Ainv;
+      Array<int> P;
+      BatchLUFactor(LU, P);
+      BatchLUSolve(LU, P, X);
+      BatchInverseMatrix(LU, P, Ainv);
+      for (int e = 0; e < NE; e++)
+      {
+         DenseMatrix AX(m,r);
+         Mult(A(e), X(e), AX);
+         AX -= B(e);
+         REQUIRE(AX.MaxMaxNorm() < tol);
+
+         DenseMatrix AAinv(m);
+         Mult(A(e), Ainv(e), AAinv);
+         for (int i = 0; i < m; i++) { AAinv(i,i) -= 1.0; }
+         REQUIRE(AAinv.MaxMaxNorm() < tol);
+      }
+   }
+
+   SECTION("SoA layout")
+   {
+      Vector A_soa;
+      BatchToSoA(A, A_soa);
+      DenseTensor A2(m,m,NE);
+      BatchFromSoA(A_soa, A2);
+      for (int i = 0; i < A.TotalSize(); i++)
+      {
+         REQUIRE(A2.Data()[i] == A.Data()[i]);
+      }
+
+      Array<int> P;
+      BatchLUFactorSoA(m, NE, A_soa, P);
+      Vector X(m*NE), B_soa(m*NE);
+      X.Randomize(4);
+      auto x_soa = Reshape(B_soa.HostWrite(), NE, m);
+      auto x = Reshape(X.HostRead(), m, NE);
+      for (int e = 0; e < NE; e++)
+      {
+         for (int i = 0; i < m; i++) { x_soa(e,i) = x(i,e); }
+      }
+      BatchLUSolveSoA(m, NE, A_soa, P, B_soa);
+
+      DenseTensor LU(A);
+      Array<int> P_aos;
+      BatchLUFactor(LU, P_aos);
+      BatchLUSolve(LU, P_aos, X);
+      auto xs = Reshape(B_soa.HostRead(), NE, m);
+      auto xa = Reshape(X.HostRead(), m, NE);
+      for (int e = 0; e < NE; e++)
+      {
+         for (int i = 0; i < m; i++)
+         {
+            REQUIRE(xs(e,i) == MFEM_Approx(xa(i,e)));
+         }
+      }
+   }
+}
@@ -83,4 +83,166 @@ TEST_CASE("SparseMatrixAbsMult", "[SparseMatrixAbsMult]")
    }
 }
 
+TEST_CASE("SparseMatrixProduct", "[SparseMatrix]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   Array<Refinement> refs;
+   refs.Append(Refinement(0));
+   refs.Append(Refinement(5));
+   mesh.GeneralRefinement(refs);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   const SparseMatrix &P = *fes.GetConformingProlongation();
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix &A = a.SpMat();
+
+   Vector x(P.Width()), y(P.Width()), z(P.Width());
+   x.Randomize(1);
+
+   SECTION("Product")
+   {
+      SparseMatrix *AP = Mult(A, P);
+      SparseMatrixProduct AP_prod(A, P);
+      REQUIRE(AP_prod.NumNonZeroElems() == AP->NumNonZeroElems());
+      SparseMatrix *AP_new = AP_prod.Mult(A, P);
+
+      Vector u(A.Height()), v(A.Height());
+      AP->Mult(x, u);
+      AP_new->Mult(x, v);
+      v -= u;
+      REQUIRE(v.Normlinf() == MFEM_Approx(0.0));
+
+      // Reuse the pattern of both AP and AP_new with the scaled A.
+      A *= 2.0;
+      Mult(A, P, AP);
+      AP_prod.Mult(A, P, *AP_new);
+      AP->Mult(x, v);
+      v.Add(-2.0, u);
+      REQUIRE(v.Normlinf() == MFEM_Approx(0.0));
+      AP_new->Mult(x, v);
+      v.Add(-2.0, u);
+      REQUIRE(v.Normlinf() == MFEM_Approx(0.0));
+
+      delete AP_new;
+      delete AP;
+   }
+
+   SECTION("RAP")
+   {
+      SparseMatrix *PtAP = RAP(P, A, P);
+      SparseMatrixRAP PtAP_prod(P, A, P);
+      SparseMatrix *PtAP_new = PtAP_prod.Mult(A);
+
+      PtAP->Mult(x, y);
+      PtAP_new->Mult(x, z);
+      z -= y;
+      REQUIRE(z.Normlinf() == MFEM_Approx(0.0));
+
+      A *= 3.0;
+      PtAP_prod.Mult(A, *PtAP_new);
+      PtAP_new->Mult(x, z);
+      z.Add(-3.0, y);
+      REQUIRE(z.Normlinf() == MFEM_Approx(0.0));
+
+      delete PtAP_new;
+      delete PtAP;
+   }
+}
+
+TEST_CASE("MixedPrecisionSparseMatrix", "[SparseMatrix]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+   const int n = A.Height();
+   MixedPrecisionSparseMatrix A_sp(A);
+
+   Vector x(n), y(n), y_sp(n), z(n), b(n);
+   x.Randomize(1);
+   A.Mult(x, b);
+
+   SECTION("Mult")
+   {
+      A.Mult(x, y);
+      A_sp.Mult(x, y_sp);
+      y_sp -= y;
+      REQUIRE(y_sp.Normlinf() < 1e-6*y.Normlinf());
+   }
+
+   SECTION("Preconditioners")
+   {
+      Vector diag;
+      A.GetDiag(diag);
+      // Single precision may be set before or after the operator.
+      GSSmoother gs;
+      gs.SetSinglePrecision();
+      gs.SetOperator(A);
+      DSmoother ds(A, 0, 2.0/3.0, 2), ds1(A);
+      ds.SetSinglePrecision();
+      ds1.SetSinglePrecision();
+      OperatorJacobiSmoother jac(diag, ess_tdof_list);
+      jac.SetSinglePrecision();
+      jac.SetOperator(A);
+      OperatorChebyshevSmoother cheb(A, diag, ess_tdof_list, 2);
+      cheb.SetSinglePrecision();
+      Solver *precs[] = { &gs, &ds, &ds1, &jac, &cheb };
+
+      GSSmoother gs_d(A);
+      DSmoother ds_d(A, 0, 2.0/3.0, 2), ds1_d(A);
+      OperatorJacobiSmoother jac_d(diag, ess_tdof_list);
+      jac_d.SetOperator(A);
+      OperatorChebyshevSmoother cheb_d(A, diag, ess_tdof_list, 2);
+      Solver *precs_d[] = { &gs_d, &ds_d, &ds1_d, &jac_d, &cheb_d };
+
+      // The single precision entries perturb the output at the level of the
+      // float round-off.
+      for (int i = 0; i < 5; i++)
+      {
+         precs[i]->Mult(b, y);
+         precs_d[i]->Mult(b, z);
+         z -= y;
+         REQUIRE(z.Normlinf() > 0.0);
+         REQUIRE(z.Normlinf() < 1e-5*y.Normlinf());
+      }
+
+      // The Gauss-Seidel sweep is the one of the float matrix.
+      y = 0.0;
+      A_sp.Gauss_Seidel_forw(b, y);
+      A_sp.Gauss_Seidel_back(b, y);
+      gs.Mult(b, z);
+      z -= y;
+      REQUIRE(z.Normlinf() == 0.0);
+
+      // The outer solver in double precision reaches the double precision
+      // tolerance with the single precision preconditioners.
+      for (Solver *prec : precs)
+      {
+         CGSolver cg;
+         cg.SetOperator(A);
+         cg.SetPreconditioner(*prec);
+         cg.SetRelTol(1e-14);
+         cg.SetMaxIter(500);
+         y = 0.0;
+         cg.Mult(b, y);
+         REQUIRE(cg.GetConverged());
+         y -= x;
+         REQUIRE(y.Normlinf() < 1e-10*x.Normlinf());
+      }
+   }
+}
+
 } // namespace mfem
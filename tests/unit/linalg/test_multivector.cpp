@@ -0,0 +1,146 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+// Return the largest difference between op.MultMany(X) and op.Mult(X_j).
+static double MultManyError(const Operator &op, const MultiVector &X)
+{
+   MultiVector Y(op.Height(), X.NumVectors());
+   op.MultMany(X, Y);
+   double error = 0.0;
+   Vector x, y, y_j(op.Height());
+   for (int j = 0; j < X.NumVectors(); j++)
+   {
+      X.GetVectorView(j, x);
+      Y.GetVectorView(j, y);
+      op.Mult(x, y_j);
+      y_j -= y;
+      error = std::max(error, y_j.Normlinf());
+   }
+   return error;
+}
+
+TEST_CASE("MultiVector", "[MultiVector]")
+{
+   const int dim = GENERATE(2, 3);
+   const int nv = 11;
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   const int n = fes.GetTrueVSize();
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   MultiVector X(n, nv);
+   X.Randomize(1);
+
+   SECTION("Operators")
+   {
+      BilinearForm a_fa(&fes), a_pa(&fes);
+      for (BilinearForm *a : { &a_fa, &a_pa })
+      {
+         a->AddDomainIntegrator(new DiffusionIntegrator);
+         a->AddDomainIntegrator(new MassIntegrator);
+      }
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_fa.Assemble();
+      a_fa.Finalize();
+      a_pa.Assemble();
+
+      const SparseMatrix &A = a_fa.SpMat();
+      REQUIRE(MultManyError(A, X) == MFEM_Approx(0.0));
+      REQUIRE(MultManyError(a_pa, X) == MFEM_Approx(0.0));
+
+      OperatorHandle A_pa;
+      a_pa.FormSystemMatrix(ess_tdof_list, A_pa);
+      REQUIRE(MultManyError(*A_pa, X) == MFEM_Approx(0.0));
+
+      // Block operator with a zero block.
+      Array<int> offsets(3);
+      offsets[0] = 0;
+      offsets[1] = n;
+      offsets[2] = 2*n;
+      BlockOperator block_op(offsets);
+      block_op.SetBlock(0, 0, const_cast<SparseMatrix *>(&A));
+      block_op.SetBlock(0, 1, &a_pa, 2.0);
+      block_op.SetBlock(1, 1, const_cast<SparseMatrix *>(&A), -1.0);
+      MultiVector X2(2*n, nv);
+      X2.Randomize(2);
+      REQUIRE(MultManyError(block_op, X2) == MFEM_Approx(0.0));
+   }
+
+   SECTION("Solvers")
+   {
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      SparseMatrix A;
+      a.FormSystemMatrix(ess_tdof_list, A);
+
+      MultiVector B(n, nv);
+      A.MultMany(X, B);
+      // The right-hand side 0 is zero, and the last one is a multiple of the
+      // right-hand side 1.
+      Vector b;
+      B.GetVectorView(0, b);
+      b = 0.0;
+      Vector b1, b_last;
+      B.GetVectorView(1, b1);
+      B.GetVectorView(nv-1, b_last);
+      b_last.Set(3.0, b1);
+
+      GSSmoother prec(A);
+      CGSolver cg;
+      GMRESSolver gmres;
+      gmres.SetKDim(10);
+      for (IterativeSolver *solver : { (IterativeSolver *) &cg,
+                                       (IterativeSolver *) &gmres })
+      {
+         solver->SetOperator(A);
+         solver->SetPreconditioner(prec);
+         solver->SetRelTol(1e-12);
+         solver->SetMaxIter(500);
+
+         // Zero initial guesses (iterative_mode is on by default).
+         MultiVector Y(n, nv);
+         Y = 0.0;
+         solver->MultMany(B, Y);
+         REQUIRE(solver->GetConverged());
+         const int iterations = solver->GetNumIterations();
+
+         // Compare with separate solves.
+         int max_iterations = 0;
+         Vector y, y_j(n);
+         for (int j = 0; j < nv; j++)
+         {
+            B.GetVectorView(j, b);
+            Y.GetVectorView(j, y);
+            y_j = 0.0;
+            solver->Mult(b, y_j);
+            REQUIRE(solver->GetConverged());
+            max_iterations = std::max(max_iterations,
+                                      solver->GetNumIterations());
+            y_j -= y;
+            REQUIRE(y_j.Normlinf() < 1e-8);
+         }
+         REQUIRE(iterations == max_iterations);
+      }
+   }
+}
@@ -412,3 +412,140 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 5.0);
    }
 }
+
+TEST_CASE("Embedded Runge-Kutta methods",
+          "[ODE1]")
+{
+   // du/dt = (-u_1, u_0), with solution u(pi) = -u(0)
+   class Rotation : public TimeDependentOperator
+   {
+   public:
+      Rotation() : TimeDependentOperator(2, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = -u(1);
+         dudt(1) = u(0);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         // Solve dudt = f(u + dt dudt)
+         const double det = 1.0 + dt*dt;
+         dudt(0) = (-u(1) - dt*u(0))/det;
+         dudt(1) = (u(0) - dt*u(1))/det;
+      }
+   };
+
+   Rotation oper;
+   Vector u0(2);
+   u0 = 1.0;
+
+   // Error at t = pi with n fixed steps, all of them accepted
+   auto fixed_step_error = [&](EmbeddedRKSolver &solver, int n)
+   {
+      solver.SetTolerances(1e10, 1e10);
+      solver.Init(oper);
+      Vector u(u0);
+      double t = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         double dt = M_PI/n;
+         REQUIRE(solver.AdaptiveStep(u, t, dt));
+      }
+      REQUIRE(t == MFEM_Approx(M_PI));
+      u += u0;
+      return u.Norml2();
+   };
+
+   auto check = [&](EmbeddedRKSolver &solver, double order)
+   {
+      const double err1 = fixed_step_error(solver, 8);
+      const double err2 = fixed_step_error(solver, 16);
+      REQUIRE(log(err1/err2)/log(2.0) + 0.2 > order);
+
+      // A rejected step leaves the solution unchanged and reduces dt
+      solver.SetTolerances(1e-8, 1e-10);
+      solver.Init(oper);
+      Vector u(u0);
+      double t = 0.0, dt = M_PI;
+      REQUIRE(!solver.AdaptiveStep(u, t, dt));
+      REQUIRE(t == 0.0);
+      REQUIRE(dt < M_PI);
+      u -= u0;
+      REQUIRE(u.Normlinf() == 0.0);
+
+      // Adaptive integration up to t = pi
+      solver.Init(oper);
+      u = u0;
+      t = 0.0;
+      dt = M_PI;
+      solver.Run(u, t, dt, M_PI);
+      REQUIRE(t == M_PI);
+      REQUIRE(solver.GetNumRejected() > 0);
+      u += u0;
+      REQUIRE(u.Norml2() < 1e-6);
+
+      // Step() only returns after an accepted step
+      solver.Init(oper);
+      u = u0;
+      t = 0.0;
+      dt = M_PI;
+      solver.Step(u, t, dt);
+      REQUIRE(t == MFEM_Approx(dt));
+      REQUIRE(solver.GetNumAccepted() == 1);
+   };
+
+   SECTION("DP54Solver")
+   {
+      DP54Solver solver;
+      check(solver, 5.0);
+   }
+
+   SECTION("BS32Solver")
+   {
+      BS32Solver solver;
+      check(solver, 3.0);
+   }
+
+   SECTION("EmbeddedSDIRK54Solver")
+   {
+      EmbeddedSDIRK54Solver solver;
+      check(solver, 4.0);
+   }
+
+   SECTION("Non-finite error estimate")
+   {
+      // du/dt = u, undefined after t = 1
+      class Blowup : public TimeDependentOperator
+      {
+      public:
+         Blowup() : TimeDependentOperator(1, 0.0) { }
+
+         virtual void Mult(const Vector &u, Vector &dudt) const
+         {
+            dudt(0) = (GetTime() <= 1.0) ? u(0) :
+                      std::numeric_limits<double>::quiet_NaN();
+         }
+      };
+
+      Blowup blowup;
+      DP54Solver solver;
+      solver.Init(blowup);
+      Vector u(1);
+      u = 1.0;
+      double t = 0.0, dt = 2.0;
+      REQUIRE(!solver.AdaptiveStep(u, t, dt));
+      REQUIRE(t == 0.0);
+      REQUIRE(dt == MFEM_Approx(0.4));
+      REQUIRE(u(0) == 1.0);
+
+#ifdef MFEM_USE_EXCEPTIONS
+      // The steps are rejected until the step size is below the minimum
+      solver.SetMinStepSize(1e-3);
+      REQUIRE_THROWS(solver.Run(u, t, dt, 2.0));
+      REQUIRE(t <= 1.0);
+#endif
+   }
+}
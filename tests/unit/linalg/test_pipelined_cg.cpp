@@ -0,0 +1,74 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("PipelinedCGSolver", "[PipelinedCG]")
+{
+   const bool use_prec = GENERATE(false, true);
+
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   ConstantCoefficient one(1.0);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   DSmoother jacobi(A);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(500);
+   cg.SetOperator(A);
+   if (use_prec) { cg.SetPreconditioner(jacobi); }
+   Vector X_cg(X.Size());
+   X_cg = 0.0;
+   cg.Mult(B, X_cg);
+
+   PipelinedCGSolver pcg;
+   pcg.SetRelTol(1e-12);
+   pcg.SetMaxIter(500);
+   pcg.SetOperator(A);
+   if (use_prec) { pcg.SetPreconditioner(jacobi); }
+   Vector X_pcg(X.Size());
+   X_pcg = 0.0;
+   pcg.Mult(B, X_pcg);
+
+   REQUIRE(cg.GetConverged());
+   REQUIRE(pcg.GetConverged());
+   // The recurrences differ only in rounding, so the iteration counts match
+   // up to a few iterations
+   REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+
+   Vector r(B.Size());
+   A.Mult(X_pcg, r);
+   r -= B;
+   REQUIRE(r.Normlinf() < 1e-9 * B.Normlinf());
+   X_pcg -= X_cg;
+   REQUIRE(X_pcg.Normlinf() < 1e-9 * X_cg.Normlinf());
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace find_points
+{
+
+// Check that the points were found in elements that contain them.
+static void CheckFound(Mesh &mesh, const DenseMatrix &pts,
+                       const Array<int> &elem_ids,
+                       const Array<IntegrationPoint> &ips)
+{
+   Vector x;
+   for (int i = 0; i < pts.Width(); i++)
+   {
+      REQUIRE(elem_ids[i] >= 0);
+      mesh.GetElementTransformation(elem_ids[i])->Transform(ips[i], x);
+      for (int d = 0; d < pts.Height(); d++)
+      {
+         REQUIRE(x(d) == MFEM_Approx(pts(d,i), 1e-8));
+      }
+   }
+}
+
+static void RandomPoints(int sdim, int npts, double lo, double hi,
+                         DenseMatrix &pts)
+{
+   pts.SetSize(sdim, npts);
+   Vector pts_vec(pts.GetData(), sdim*npts);
+   pts_vec.Randomize(1);
+   pts_vec *= (hi - lo);
+   pts_vec += lo;
+}
+
+TEST_CASE("Mesh::FindPoints", "[Mesh][FindPoints]")
+{
+   const int npts = 100;
+
+   SECTION("Straight 2D and 3D meshes")
+   {
+      for (int dim = 2; dim <= 3; dim++)
+      {
+         Mesh mesh = (dim == 2) ?
+                     Mesh::MakeCartesian2D(7, 5, Element::TRIANGLE) :
+                     Mesh::MakeCartesian3D(4, 3, 5, Element::HEXAHEDRON);
+         DenseMatrix pts;
+         RandomPoints(dim, npts, 0.0, 1.0, pts);
+         Array<int> elem_ids;
+         Array<IntegrationPoint> ips;
+         REQUIRE(mesh.FindPoints(pts, elem_ids, ips) == npts);
+         CheckFound(mesh, pts, elem_ids, ips);
+
+         // Points outside of the mesh are not found
+         RandomPoints(dim, npts, 1.5, 2.0, pts);
+         REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) == 0);
+      }
+   }
+
+   SECTION("Curved mesh with moving nodes")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+      mesh.SetCurvature(2);
+      MeshPointLocator &locator = mesh.GetPointLocator();
+      const int num_rebuilds = locator.GetNumRebuilds();
+
+      DenseMatrix pts;
+      RandomPoints(2, npts, 0.0, 1.0, pts);
+      Array<int> elem_ids;
+      Array<IntegrationPoint> ips;
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips) == npts);
+      CheckFound(mesh, pts, elem_ids, ips);
+
+      // A small perturbation of the nodes does not need re-binning
+      GridFunction &nodes = *mesh.GetNodes();
+      Vector disp(nodes.Size());
+      disp.Randomize(2);
+      disp *= 1e-3;
+      mesh.MoveNodes(disp);
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) > 0);
+      REQUIRE(locator.GetNumRebuilds() == num_rebuilds);
+
+      // Without changes, the index is not updated
+      const int num_box_updates = locator.GetNumBoxUpdates();
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) > 0);
+      REQUIRE(locator.GetNumBoxUpdates() == num_box_updates);
+
+      // Scaling the mesh requires re-binning. Modifying the nodes in place is
+      // detected without notifying the mesh.
+      nodes *= 2.0;
+      RandomPoints(2, npts, 0.1, 1.9, pts);
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips) == npts);
+      CheckFound(mesh, pts, elem_ids, ips);
+      REQUIRE(locator.GetNumRebuilds() > num_rebuilds);
+   }
+
+   SECTION("Refined mesh")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+      mesh.EnsureNCMesh();
+      Array<Refinement> refs;
+      refs.Append(Refinement(0));
+      refs.Append(Refinement(4));
+      mesh.GeneralRefinement(refs);
+
+      DenseMatrix pts;
+      RandomPoints(2, npts, 0.0, 1.0, pts);
+      Array<int> elem_ids;
+      Array<IntegrationPoint> ips;
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips) == npts);
+      CheckFound(mesh, pts, elem_ids, ips);
+   }
+}
+
+} // namespace find_points
@@ -180,3 +180,132 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    // on the original mesh, but it doesn't happen for these test cases.
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
+
+TEST_CASE("Element costs", "[Mesh][FiniteElementSpace]")
+{
+   // 2-element quad mesh with a quadratic second element
+   Mesh mesh = Mesh::MakeCartesian2D(2, 1, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   H1_FECollection fec(1, mesh.Dimension());
+   FiniteElementSpace fespace(&mesh, &fec);
+   fespace.SetElementOrder(1, 2);
+   fespace.Update(false);
+
+   // The cost is the number of dofs times the number of quadrature points
+   Array<double> costs;
+   fespace.GetElementCosts(costs);
+   REQUIRE(costs.Size() == 2);
+   REQUIRE(costs[0] == 4*4);
+   REQUIRE(costs[1] == 9*9);
+
+   // Vector dofs are counted
+   FiniteElementSpace vfespace(&mesh, &fec, 2);
+   vfespace.GetElementCosts(costs);
+   REQUIRE(costs.Size() == 2);
+   REQUIRE(costs[0] == 2*4*4);
+   REQUIRE(costs[1] == 2*4*4);
+}
+
+#ifdef MFEM_USE_METIS
+TEST_CASE("Weighted partitioning", "[Mesh]")
+{
+   const int part_method = GENERATE(0, 1);
+   const int nparts = 4;
+
+   // The elements in the left quarter of the mesh are 20 times more expensive
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   Array<double> weights(mesh.GetNE());
+   double total = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      Vector center;
+      mesh.GetElementCenter(i, center);
+      weights[i] = (center(0) < 0.25) ? 20.0 : 1.0;
+      total += weights[i];
+   }
+
+   int *partitioning = mesh.GeneratePartitioning(nparts, part_method,
+                                                 &weights);
+
+   Array<double> part_cost(nparts);
+   Array<int> part_size(nparts);
+   part_cost = 0.0;
+   part_size = 0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      REQUIRE(partitioning[i] >= 0);
+      REQUIRE(partitioning[i] < nparts);
+      part_cost[partitioning[i]] += weights[i];
+      part_size[partitioning[i]]++;
+   }
+   delete [] partitioning;
+
+   // The cost is balanced (up to METIS' tolerance and one element), while the
+   // number of elements is not
+   REQUIRE(part_cost.Max() * nparts / total <= 1.1);
+   REQUIRE(double(part_size.Max()) * nparts / mesh.GetNE() > 1.5);
+}
+#endif
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   const bool compress = GENERATE(false, true);
+#ifndef MFEM_USE_ZLIB
+   if (compress) { return; }
+#endif
+   const char *mesh_file = "binary_mesh_test.mesh";
+   const char *gf_file = "binary_mesh_test.gf";
+
+   Mesh mesh = Mesh::MakeCartesian3D(2, 3, 2, Element::WEDGE);
+   mesh.SetCurvature(2);
+   GridFunction &nodes = *mesh.GetNodes();
+   for (int i = 0; i < nodes.Size(); i++)
+   {
+      nodes(i) += 0.01*sin(double(i));
+   }
+   mesh.SaveBinary(mesh_file, compress);
+
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+   GridFunction gf(&fes);
+   for (int i = 0; i < gf.Size(); i++) { gf(i) = i; }
+   gf.SaveBinary(gf_file, compress);
+
+   // Binary files are recognized by the file constructor
+   Mesh mesh2(mesh_file);
+   REQUIRE(mesh2.Dimension() == mesh.Dimension());
+   REQUIRE(mesh2.GetNE() == mesh.GetNE());
+   REQUIRE(mesh2.GetNBE() == mesh.GetNBE());
+   REQUIRE(mesh2.GetNEdges() == mesh.GetNEdges());
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      REQUIRE(mesh2.GetElementBaseGeometry(e) ==
+              mesh.GetElementBaseGeometry(e));
+      REQUIRE(mesh2.GetAttribute(e) == mesh.GetAttribute(e));
+   }
+   for (int be = 0; be < mesh.GetNBE(); be++)
+   {
+      REQUIRE(mesh2.GetBdrAttribute(be) == mesh.GetBdrAttribute(be));
+   }
+   Vector vert, vert2;
+   mesh.GetVertices(vert);
+   mesh2.GetVertices(vert2);
+   vert2 -= vert;
+   REQUIRE(vert2.Normlinf() == 0.0);
+   REQUIRE(mesh2.GetNodes());
+   Vector nodes2(*mesh2.GetNodes());
+   nodes2 -= nodes;
+   REQUIRE(nodes2.Normlinf() == 0.0);
+
+   {
+      BinaryContainerReader reader(gf_file);
+      GridFunction gf2(&mesh2, reader, "gf", !compress);
+      REQUIRE(gf2.FESpace()->GetVDim() == 2);
+      REQUIRE(gf2.FESpace()->GetOrdering() == Ordering::byVDIM);
+      gf2 -= gf;
+      REQUIRE(gf2.Normlinf() == 0.0);
+   }
+
+   REQUIRE(remove(mesh_file) == 0);
+   REQUIRE(remove(gf_file) == 0);
+}
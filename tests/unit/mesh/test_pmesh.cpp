@@ -189,6 +189,158 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+TEST_CASE("ParMeshMakeDistributed", "[Parallel], [ParMesh]")
+{
+   // Test that ParMesh::MakeDistributed, where only rank 0 stores the serial
+   // mesh, gives the same parallel mesh as the ParMesh constructor.
+   int num_procs, rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   const int type = GENERATE(0, 1, 2);
+   Mesh mesh = (type == 0) ?
+               Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(3, 3, 3, (type == 1) ?
+                                     Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON);
+   const int dim = mesh.Dimension();
+   mesh.SetCurvature(2);
+   mesh.Transform([](const Vector &x, Vector &y)
+   {
+      y = x;
+      y(0) += 0.1*sin(3.0*x(1));
+   });
+
+   // a partitioning with many shared entities
+   Array<int> partitioning(mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      partitioning[i] = i % num_procs;
+   }
+
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning.GetData());
+   ParMesh dmesh = ParMesh::MakeDistributed(
+                      MPI_COMM_WORLD, (rank == 0) ? &mesh : NULL,
+                      (rank == 0) ? partitioning.GetData() : NULL);
+
+   REQUIRE(dmesh.GetNE() == pmesh.GetNE());
+   REQUIRE(dmesh.GetNV() == pmesh.GetNV());
+   REQUIRE(dmesh.GetNBE() == pmesh.GetNBE());
+   REQUIRE(dmesh.GetNGroups() == pmesh.GetNGroups());
+   REQUIRE(dmesh.GetNSharedFaces() == pmesh.GetNSharedFaces());
+   REQUIRE(dmesh.GetGlobalNE() == mesh.GetNE());
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+
+   // the groups may be numbered differently, compare the shared entity counts
+   int pcounts[4] = { 0, 0, 0, 0 }, dcounts[4] = { 0, 0, 0, 0 };
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      pcounts[0] += pmesh.GroupNVertices(g);
+      pcounts[1] += pmesh.GroupNEdges(g);
+      pcounts[2] += pmesh.GroupNTriangles(g);
+      pcounts[3] += pmesh.GroupNQuadrilaterals(g);
+   }
+   for (int g = 1; g < dmesh.GetNGroups(); g++)
+   {
+      dcounts[0] += dmesh.GroupNVertices(g);
+      dcounts[1] += dmesh.GroupNEdges(g);
+      dcounts[2] += dmesh.GroupNTriangles(g);
+      dcounts[3] += dmesh.GroupNQuadrilaterals(g);
+   }
+   for (int k = 0; k < 4; k++) { REQUIRE(dcounts[k] == pcounts[k]); }
+
+   H1_FECollection h1_fec(2, dim);
+   ND_FECollection nd_fec(1, dim);
+   for (FiniteElementCollection *fec : { (FiniteElementCollection *) &h1_fec,
+                                         (FiniteElementCollection *) &nd_fec })
+   {
+      ParFiniteElementSpace pfes(&pmesh, fec), dfes(&dmesh, fec);
+      REQUIRE(dfes.GlobalTrueVSize() == pfes.GlobalTrueVSize());
+   }
+
+   // the curved geometry is transferred
+   double volume = 0.0, serial_volume = 0.0;
+   for (int i = 0; i < dmesh.GetNE(); i++)
+   {
+      volume += dmesh.GetElementVolume(i);
+   }
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      serial_volume += mesh.GetElementVolume(i);
+   }
+   double global_volume;
+   MPI_Allreduce(&volume, &global_volume, 1, MPI_DOUBLE, MPI_SUM,
+                 MPI_COMM_WORLD);
+   REQUIRE(global_volume == MFEM_Approx(serial_volume));
+}
+
+// Cost of the element i of @a pmesh: the elements in the left quarter of the
+// unit square are 20 times more expensive.
+static void ElementCosts(ParMesh &pmesh, Array<double> &costs)
+{
+   costs.SetSize(pmesh.GetNE());
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      Vector center;
+      pmesh.GetElementCenter(i, center);
+      costs[i] = (center(0) < 0.25) ? 20.0 : 1.0;
+   }
+}
+
+TEST_CASE("ParMeshWeightedRebalance", "[Parallel], [ParMesh]")
+{
+   // Test that ParMesh::Rebalance with element weights balances the total cost
+   // of the ranks, rather than their number of elements, and that the load
+   // imbalance is reported correctly.
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+
+   // start from vertical strips with the same number of elements, where the
+   // first rank gets all the expensive ones
+   Array<int> partitioning(mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      Vector center;
+      mesh.GetElementCenter(i, center);
+      partitioning[i] = std::min(int(center(0) * num_procs), num_procs - 1);
+   }
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning.GetData());
+
+   Array<double> costs;
+   ElementCosts(pmesh, costs);
+   const double imbalance = pmesh.GetLoadImbalance(&costs);
+
+   double total_cost = 0.0, max_cost = 0.0;
+   for (int i = 0; i < costs.Size(); i++) { total_cost += costs[i]; }
+   MPI_Allreduce(MPI_IN_PLACE, &total_cost, 1, MPI_DOUBLE, MPI_SUM,
+                 MPI_COMM_WORLD);
+   REQUIRE(total_cost == 4*16*20.0 + 12*16*1.0);
+
+   pmesh.Rebalance(costs);
+   REQUIRE(pmesh.ReduceInt(pmesh.GetNE()) == mesh.GetNE());
+
+   // the measured costs of the new partition match the reported imbalance
+   ElementCosts(pmesh, costs);
+   for (int i = 0; i < costs.Size(); i++) { max_cost += costs[i]; }
+   MPI_Allreduce(MPI_IN_PLACE, &max_cost, 1, MPI_DOUBLE, MPI_MAX,
+                 MPI_COMM_WORLD);
+   const double new_imbalance = pmesh.GetLoadImbalance(&costs);
+   REQUIRE(new_imbalance == MFEM_Approx(max_cost * num_procs / total_cost));
+
+   double before, after;
+   pmesh.GetRebalanceImbalance(before, after);
+   REQUIRE(before == MFEM_Approx(imbalance));
+   REQUIRE(after == MFEM_Approx(new_imbalance));
+
+   // the cost was unbalanced, and now each rank is within one most expensive
+   // element of the average cost
+   if (num_procs > 1) { REQUIRE(imbalance > 1.5); }
+   REQUIRE(max_cost <= total_cost / num_procs + 20.0);
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem
@@ -0,0 +1,307 @@
+// Copyright (c) 2010-2021, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace submesh_test
+{
+
+void Perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(M_PI*x(1));
+   y(1) += 0.05*sin(M_PI*x(0));
+}
+
+void Vectorial(const Vector &x, Vector &y)
+{
+   for (int d = 0; d < x.Size(); d++)
+   {
+      y(d) = 1.0 + (d+1)*x(0) - x((d+1) % x.Size());
+   }
+}
+
+Mesh MakeMesh(int dim, Element::Type type, bool curved)
+{
+   Mesh mesh = (dim == 2) ? Mesh::MakeCartesian2D(4, 4, type) :
+               Mesh::MakeCartesian3D(3, 3, 3, type);
+   // Mark the elements with x < 1/2 with attribute 2.
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      Vector center;
+      mesh.GetElementCenter(e, center);
+      mesh.SetAttribute(e, (center(0) < 0.5) ? 2 : 1);
+   }
+   mesh.SetAttributes();
+   // Support Nedelec spaces of order > 1 on tetrahedra.
+   if (type == Element::TETRAHEDRON) { mesh.ReorientTetMesh(); }
+   if (curved)
+   {
+      mesh.SetCurvature(2);
+      mesh.Transform(Perturb);
+   }
+   return mesh;
+}
+
+double MaxDiff(const GridFunction &a, const GridFunction &b)
+{
+   Vector diff(a);
+   diff -= b;
+   return diff.Normlinf();
+}
+
+}
+
+TEST_CASE("SubMesh", "[SubMesh]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const bool curved = GENERATE(false, true);
+   const bool boundary = GENERATE(false, true);
+   CAPTURE(dim, simplex, curved, boundary);
+
+   const Element::Type type =
+      (dim == 2) ? (simplex ? Element::TRIANGLE : Element::QUADRILATERAL) :
+      (simplex ? Element::TETRAHEDRON : Element::HEXAHEDRON);
+   Mesh parent = submesh_test::MakeMesh(dim, type, curved);
+
+   Array<int> attributes(1);
+   attributes[0] = boundary ? 1 : 2;
+   SubMesh submesh = boundary ?
+                     SubMesh::CreateFromBoundary(parent, attributes) :
+                     SubMesh::CreateFromDomain(parent, attributes);
+
+   const int sub_dim = boundary ? dim - 1 : dim;
+   const Array<int> &parent_elements = submesh.GetParentElementIDMap();
+   REQUIRE(submesh.Dimension() == sub_dim);
+   REQUIRE(submesh.SpaceDimension() == dim);
+   REQUIRE(submesh.GetParent() == &parent);
+   REQUIRE(parent_elements.Size() == submesh.GetNE());
+
+   int ne = 0;
+   const int parent_ne = boundary ? parent.GetNBE() : parent.GetNE();
+   for (int i = 0; i < parent_ne; i++)
+   {
+      const int attr = boundary ? parent.GetBdrAttribute(i) :
+                       parent.GetAttribute(i);
+      ne += (attr == attributes[0]);
+   }
+   REQUIRE(submesh.GetNE() == ne);
+   if (!boundary)
+   {
+      // The interface with the rest of the mesh has a new attribute.
+      REQUIRE(submesh.bdr_attributes.Max() == parent.bdr_attributes.Max() + 1);
+   }
+
+   // The elements have the same geometry as the parent elements.
+   for (int e = 0; e < submesh.GetNE(); e++)
+   {
+      const IntegrationPoint &ip =
+         Geometries.GetCenter(submesh.GetElementBaseGeometry(e));
+      ElementTransformation *T = submesh.GetElementTransformation(e);
+      ElementTransformation *pT = boundary ?
+                                  parent.GetBdrElementTransformation(
+                                     parent_elements[e]) :
+                                  parent.GetElementTransformation(
+                                     parent_elements[e]);
+      Vector x, px;
+      T->Transform(ip, x);
+      pT->Transform(ip, px);
+      x -= px;
+      REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   if (!boundary)
+   {
+      // A volume SubMesh covers the volume of its parent elements.
+      double volume = 0.0, parent_volume = 0.0;
+      for (int e = 0; e < submesh.GetNE(); e++)
+      {
+         volume += submesh.GetElementVolume(e);
+         parent_volume += parent.GetElementVolume(parent_elements[e]);
+      }
+      REQUIRE(volume == MFEM_Approx(parent_volume));
+      REQUIRE(volume > 0.0);
+   }
+
+   SECTION("H1")
+   {
+      for (int order = 1; order <= 4; order++)
+      {
+         CAPTURE(order);
+         H1_FECollection fec(order, dim), sub_fec(order, sub_dim);
+         FiniteElementSpace fes(&parent, &fec, dim, Ordering::byNODES);
+         FiniteElementSpace sub_fes(&submesh, &sub_fec, dim, Ordering::byVDIM);
+         VectorFunctionCoefficient coeff(dim, submesh_test::Vectorial);
+
+         GridFunction u(&fes), sub_u(&sub_fes), sub_exact(&sub_fes);
+         u.ProjectCoefficient(coeff);
+         sub_exact.ProjectCoefficient(coeff);
+         TransferMap to_sub(fes, sub_fes);
+         to_sub.Transfer(u, sub_u);
+         REQUIRE(submesh_test::MaxDiff(sub_u, sub_exact) == MFEM_Approx(0.0));
+
+         // Transfer back: only the parent DOFs on the SubMesh are set.
+         GridFunction v(&fes);
+         v = infinity();
+         TransferMap(sub_fes, fes).Transfer(sub_u, v);
+         int set = 0;
+         for (int i = 0; i < v.Size(); i++)
+         {
+            if (v(i) == infinity()) { continue; }
+            REQUIRE(v(i) == MFEM_Approx(u(i)));
+            set++;
+         }
+         REQUIRE(set == sub_u.Size());
+      }
+   }
+
+   SECTION("ND")
+   {
+      // Only edge DOFs on the boundary of 3D meshes.
+      if (boundary && dim == 2) { return; }
+      const int max_order = boundary ? 1 : 3;
+      for (int order = 1; order <= max_order; order++)
+      {
+         CAPTURE(order);
+         ND_FECollection fec(order, dim), sub_fec(order, sub_dim);
+         FiniteElementSpace fes(&parent, &fec);
+         FiniteElementSpace sub_fes(&submesh, &sub_fec);
+         VectorFunctionCoefficient coeff(dim, submesh_test::Vectorial);
+
+         GridFunction u(&fes), sub_u(&sub_fes), sub_exact(&sub_fes);
+         u.ProjectCoefficient(coeff);
+         sub_exact.ProjectCoefficient(coeff);
+         SubMesh::Transfer(u, sub_u);
+         REQUIRE(submesh_test::MaxDiff(sub_u, sub_exact) == MFEM_Approx(0.0));
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("ParSubMesh", "[Parallel], [SubMesh]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const bool boundary = GENERATE(false, true);
+   CAPTURE(dim, simplex, boundary);
+
+   const Element::Type type =
+      (dim == 2) ? (simplex ? Element::TRIANGLE : Element::QUADRILATERAL) :
+      (simplex ? Element::TETRAHEDRON : Element::HEXAHEDRON);
+   Mesh mesh = submesh_test::MakeMesh(dim, type, true);
+   ParMesh parent(MPI_COMM_WORLD, mesh);
+   // Support Nedelec spaces of order > 1 on tetrahedra.
+   if (type == Element::TETRAHEDRON) { parent.ReorientTetMesh(); }
+
+   Array<int> attributes(1);
+   attributes[0] = boundary ? 1 : 2;
+   SubMesh serial = boundary ?
+                    SubMesh::CreateFromBoundary(mesh, attributes) :
+                    SubMesh::CreateFromDomain(mesh, attributes);
+   ParSubMesh submesh = boundary ?
+                        ParSubMesh::CreateFromBoundary(parent, attributes) :
+                        ParSubMesh::CreateFromDomain(parent, attributes);
+
+   const int sub_dim = boundary ? dim - 1 : dim;
+   REQUIRE(submesh.Dimension() == sub_dim);
+   REQUIRE(submesh.GetParent() == &parent);
+   REQUIRE(submesh.GetParentElementIDMap().Size() == submesh.GetNE());
+   REQUIRE(submesh.GetGlobalNE() == serial.GetNE());
+
+   SECTION("H1")
+   {
+      const int order = 3;
+      H1_FECollection fec(order, dim), sub_fec(order, sub_dim);
+      ParFiniteElementSpace fes(&parent, &fec, dim, Ordering::byNODES);
+      ParFiniteElementSpace sub_fes(&submesh, &sub_fec, dim, Ordering::byVDIM);
+      FiniteElementSpace serial_fes(&serial, &sub_fec, dim);
+
+      // The shared entities of the ParSubMesh are consistent
+      REQUIRE(sub_fes.GlobalTrueVSize() == serial_fes.GetTrueVSize());
+
+      VectorFunctionCoefficient coeff(dim, submesh_test::Vectorial);
+      ParGridFunction u(&fes), sub_u(&sub_fes), sub_exact(&sub_fes);
+      u.ProjectCoefficient(coeff);
+      sub_exact.ProjectCoefficient(coeff);
+      TransferMap(fes, sub_fes).Transfer(u, sub_u);
+      double diff = submesh_test::MaxDiff(sub_u, sub_exact);
+      MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+      REQUIRE(diff == MFEM_Approx(0.0));
+
+      // Transfer back to a zero parent GridFunction: the parent DOFs on the
+      // SubMesh, including their copies on ranks without adjacent SubMesh
+      // elements, get the values of u, the other DOFs stay zero. The
+      // transferred ones mark the parent DOFs on the SubMesh.
+      ParGridFunction v(&fes), marker(&fes);
+      ParGridFunction sub_ones(&sub_fes);
+      v = 0.0;
+      marker = 0.0;
+      sub_ones = 1.0;
+      TransferMap to_parent(sub_fes, fes);
+      to_parent.Transfer(sub_u, v);
+      to_parent.Transfer(sub_ones, marker);
+
+      double error = 0.0;
+      for (int i = 0; i < v.Size(); i++)
+      {
+         error = std::max(error, std::abs(v(i) - marker(i)*u(i)));
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+      REQUIRE(error == MFEM_Approx(0.0));
+
+      // The number of marked parent true DOFs is the size of the serial space
+      Vector t_marker(fes.GetTrueVSize());
+      marker.GetTrueDofs(t_marker);
+      double marked = t_marker.Sum();
+      MPI_Allreduce(MPI_IN_PLACE, &marked, 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      REQUIRE(marked == MFEM_Approx(serial_fes.GetTrueVSize()));
+   }
+
+   SECTION("ND")
+   {
+      // Only edge DOFs on the boundary of 3D meshes.
+      if (boundary && dim == 2) { return; }
+      const int order = boundary ? 1 : 2;
+      ND_FECollection fec(order, dim), sub_fec(order, sub_dim);
+      ParFiniteElementSpace fes(&parent, &fec);
+      ParFiniteElementSpace sub_fes(&submesh, &sub_fec);
+      FiniteElementSpace serial_fes(&serial, &sub_fec);
+      REQUIRE(sub_fes.GlobalTrueVSize() == serial_fes.GetTrueVSize());
+
+      VectorFunctionCoefficient coeff(dim, submesh_test::Vectorial);
+      ParGridFunction u(&fes), sub_u(&sub_fes), sub_exact(&sub_fes);
+      u.ProjectCoefficient(coeff);
+      sub_exact.ProjectCoefficient(coeff);
+      TransferMap(fes, sub_fes).Transfer(u, sub_u);
+      double diff = submesh_test::MaxDiff(sub_u, sub_exact);
+      MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+      REQUIRE(diff == MFEM_Approx(0.0));
+
+      // Transfer back: the DOFs of u on the SubMesh are unchanged
+      ParGridFunction v(u);
+      TransferMap(sub_fes, fes).Transfer(sub_u, v);
+      diff = submesh_test::MaxDiff(v, u);
+      MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+      REQUIRE(diff == MFEM_Approx(0.0));
+   }
+}
+
+#endif // MFEM_USE_MPI